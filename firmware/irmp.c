@@ -24,38 +24,38 @@
 
 #include "irmp.h"
 
-#if IRMP_SUPPORT_GRUNDIG_PROTOCOL == 1 || IRMP_SUPPORT_NOKIA_PROTOCOL == 1 || IRMP_SUPPORT_IR60_PROTOCOL == 1
-#  define IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL  1
+#if IRMP_USE_EDGE_ISR == 1 || IRMP_USE_CONTEXT == 1
+#  define IRMP_ISR_SAMPLE                           1                           // irmp_ISR() reads the pin, irmp_ISR_sample() decodes
 #else
-#  define IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL  0
+#  define IRMP_ISR_SAMPLE                           0
 #endif
 
-#if IRMP_SUPPORT_SIEMENS_PROTOCOL == 1 || IRMP_SUPPORT_RUWIDO_PROTOCOL == 1
-#  define IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL   1
+#if IRMP_QUEUE_LEN > 0
+#  define IRMP_FRAME_PENDING                        (irmp_queue_write != irmp_queue_read)  // irmp_get_data() has a frame
 #else
-#  define IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL   0
-#endif
-
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 ||                   \
-    IRMP_SUPPORT_S100_PROTOCOL == 1 ||                  \
-    IRMP_SUPPORT_RC6_PROTOCOL == 1 ||                   \
-    IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1 ||    \
-    IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1 ||     \
-    IRMP_SUPPORT_IR60_PROTOCOL == 1 ||                  \
-    IRMP_SUPPORT_A1TVBOX_PROTOCOL == 1 ||               \
-    IRMP_SUPPORT_MERLIN_PROTOCOL == 1 ||                \
-    IRMP_SUPPORT_ORTEK_PROTOCOL == 1
-#  define IRMP_SUPPORT_MANCHESTER                   1
+#  define IRMP_FRAME_PENDING                        (irmp_ir_detected)
+#endif
+
+#if IRMP_USE_COUNTERS == 1                                                      // saturating, see IRMP_COUNTERS
+#  define IRMP_COUNT(c)                             do { if (irmp_counters.c < 0xFFFF) { irmp_counters.c++; } } while (0)
 #else
-#  define IRMP_SUPPORT_MANCHESTER                   0
+#  define IRMP_COUNT(c)
 #endif
 
-#if IRMP_SUPPORT_NETBOX_PROTOCOL == 1
-#  define IRMP_SUPPORT_SERIAL                       1
+#if IRMP_TRACE_LEN > 0 || defined (ANALYZE)                                    // analyzer: text of ./irmp -v, see irmp_trace_text()
+#  define IRMP_TRACE(e, a, v)                       irmp_trace (IRMP_CTX_ARG_ e, a, v)
+#else
+#  define IRMP_TRACE(e, a, v)
+#endif
+
+#if (IRMP_TRACE_LEN > 0 && IRMP_TRACE_DETAIL == 1) || defined (ANALYZE)
+#  define IRMP_TRACE_DETAIL_EVENT(e, a, v)          irmp_trace (IRMP_CTX_ARG_ e, a, v)
 #else
-#  define IRMP_SUPPORT_SERIAL                       0
+#  define IRMP_TRACE_DETAIL_EVENT(e, a, v)
 #endif
 
+#define IRMP_ERROR(c, n, v)                         { IRMP_COUNT (c); IRMP_TRACE (IRMP_TRACE_ERROR, n, v); }        // decode error number n
+
 #define IRMP_KEY_REPETITION_LEN                 (uint_fast16_t)(F_INTERRUPTS * 150.0e-3 + 0.5)           // autodetect key repetition within 150 msec
 
 #define MIN_TOLERANCE_00                        1.0                           // -0%
@@ -541,7 +541,7 @@
 
 #define AUTO_FRAME_REPETITION_LEN               (uint_fast16_t)(F_INTERRUPTS * AUTO_FRAME_REPETITION_TIME + 0.5)       // use uint_fast16_t!
 
-#ifdef ANALYZE
+#ifdef ANALYZE                                                                  // text output of the analyzer, data bits see irmp_trace_text()
 #  define ANALYZE_PUTCHAR(a)                    { if (! silent)             { putchar (a);          } }
 #  define ANALYZE_ONLY_NORMAL_PUTCHAR(a)        { if (! silent && !verbose) { putchar (a);          } }
 #  define ANALYZE_PRINTF(...)                   { if (verbose)              { printf (__VA_ARGS__); } }
@@ -550,6 +550,21 @@
 static int                                      silent;
 static int                                      time_counter;
 static int                                      verbose;
+#if IRMP_USE_EDGE_ISR == 1
+static long                                     isr_samples;                                // calls of irmp_ISR_sample(), see -b and -m
+#endif
+#if IRMP_USE_START_BIT_TABLE == 1
+static int                                      start_bit_table_lookups;
+static int                                      start_bit_table_checks;                     // table entries compared, see -p
+static int                                      start_bit_table_found;                      // start bits accepted, see -w
+static int                                      start_bit_table_masked;                     // entries disabled, classification differs
+static int                                      start_bit_table_errors;
+#endif
+#if IRMP_CANDIDATES > 1
+static uint_fast8_t                             candidates_limit = IRMP_CANDIDATES - 1;     // max. number of candidates, see -c
+static uint_fast8_t                             candidates_forced;                          // > 0: copies of decoded protocol as candidates
+static long                                     candidates_switches;                        // number of switches to a candidate
+#endif
 
 /*******************************                not every PIC compiler knows variadic macros :-(
 #else
@@ -625,6 +640,9 @@ static const char proto_technics[]      PROGMEM = "TECHNICS";
 static const char proto_panasonic[]     PROGMEM = "PANASONIC";
 
 static const char proto_radio1[]        PROGMEM = "RADIO1";
+static const char proto_dynamic1[]      PROGMEM = "DYN1";
+static const char proto_dynamic2[]      PROGMEM = "DYN2";
+static const char proto_hash[]          PROGMEM = "HASH";
 
 const char * const
 irmp_protocol_names[IRMP_N_PROTOCOLS + 1] PROGMEM =
@@ -678,7 +696,10 @@ irmp_protocol_names[IRMP_N_PROTOCOLS + 1] PROGMEM =
     proto_acp24,
     proto_technics,
     proto_panasonic,
-    proto_radio1
+    proto_radio1,
+    proto_dynamic1,
+    proto_dynamic2,
+    proto_hash
 };
 
 #endif
@@ -1031,27 +1052,6 @@ irmp_log (uint_fast8_t val)
 #define irmp_log(val)
 #endif //IRMP_LOGGING
 
-typedef struct
-{
-    uint_fast8_t    protocol;                                                // ir protocol
-    uint_fast8_t    pulse_1_len_min;                                         // minimum length of pulse with bit value 1
-    uint_fast8_t    pulse_1_len_max;                                         // maximum length of pulse with bit value 1
-    uint_fast8_t    pause_1_len_min;                                         // minimum length of pause with bit value 1
-    uint_fast8_t    pause_1_len_max;                                         // maximum length of pause with bit value 1
-    uint_fast8_t    pulse_0_len_min;                                         // minimum length of pulse with bit value 0
-    uint_fast8_t    pulse_0_len_max;                                         // maximum length of pulse with bit value 0
-    uint_fast8_t    pause_0_len_min;                                         // minimum length of pause with bit value 0
-    uint_fast8_t    pause_0_len_max;                                         // maximum length of pause with bit value 0
-    uint_fast8_t    address_offset;                                          // address offset
-    uint_fast8_t    address_end;                                             // end of address
-    uint_fast8_t    command_offset;                                          // command offset
-    uint_fast8_t    command_end;                                             // end of command
-    uint_fast8_t    complete_len;                                            // complete length of frame
-    uint_fast8_t    stop_bit;                                                // flag: frame has stop bit
-    uint_fast8_t    lsb_first;                                               // flag: LSB first
-    uint_fast8_t    flags;                                                   // some flags
-} IRMP_PARAMETER;
-
 #if IRMP_SUPPORT_SIRCS_PROTOCOL == 1
 
 static const PROGMEM IRMP_PARAMETER sircs_param =
@@ -1551,8 +1551,6 @@ static const PROGMEM IRMP_PARAMETER bang_olufsen_param =
 
 #if IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
 
-static uint_fast8_t first_bit;
-
 static const PROGMEM IRMP_PARAMETER grundig_param =
 {
     IRMP_GRUNDIG_PROTOCOL,                                              // protocol:        ir protocol
@@ -2007,20 +2005,110 @@ static const PROGMEM IRMP_PARAMETER radio1_param =
 
 #endif
 
-static uint_fast8_t                             irmp_bit;                   // current bit position
-static IRMP_PARAMETER                           irmp_param;
+static IRMP_CONTEXT                             irmp_context =              // context of irmp_ISR() and irmp_get_data(), see also irmp_init_ctx()
+{
+    .last_irmp_address      = 0xFFFF,
+    .last_irmp_command      = 0xFFFF,
+#if IRMP_SUPPORT_DENON_PROTOCOL == 1
+    .irmp_denon_repetition_len = 0xFFFF,
+#endif
+#if IRMP_USE_EDGE_ISR == 1
+    .irmp_last_input        = 1,
+#endif
+};
 
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
-static IRMP_PARAMETER                           irmp_param2;
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Decoder state
+ *  @details  all decoder variables live in an IRMP_CONTEXT, the macros below map their names to it. With IRMP_USE_CONTEXT, the decoder
+ *            functions get the context as 1st parameter ctx, else they use irmp_context.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#if IRMP_USE_CONTEXT == 1
+#  define IRMP_CTX                              (*ctx)
+#  define IRMP_CTX_PARAM                        IRMP_CONTEXT * ctx
+#  define IRMP_CTX_PARAM_                       IRMP_CONTEXT * ctx,
+#  define IRMP_CTX_ARG                          ctx
+#  define IRMP_CTX_ARG_                         ctx,
+#else
+#  define IRMP_CTX                              irmp_context
+#  define IRMP_CTX_PARAM                        void
+#  define IRMP_CTX_PARAM_
+#  define IRMP_CTX_ARG
+#  define IRMP_CTX_ARG_
 #endif
 
-static volatile uint_fast8_t                     irmp_ir_detected = FALSE;
-static volatile uint_fast8_t                     irmp_protocol;
-static volatile uint_fast16_t                    irmp_address;
-static volatile uint_fast16_t                    irmp_command;
-static volatile uint_fast16_t                    irmp_id;                    // only used for SAMSUNG protocol
-static volatile uint_fast8_t                     irmp_flags;
-// static volatile uint_fast8_t                  irmp_busy_flag;
+#define irmp_bit                                IRMP_CTX.irmp_bit
+#define irmp_param                              IRMP_CTX.irmp_param
+#define irmp_param2                             IRMP_CTX.irmp_param2
+#define irmp_ir_detected                        IRMP_CTX.irmp_ir_detected
+#define irmp_protocol                           IRMP_CTX.irmp_protocol
+#define irmp_address                            IRMP_CTX.irmp_address
+#define irmp_command                            IRMP_CTX.irmp_command
+#define irmp_id                                 IRMP_CTX.irmp_id
+#define irmp_flags                              IRMP_CTX.irmp_flags
+#define irmp_tmp_address                        IRMP_CTX.irmp_tmp_address
+#define irmp_tmp_command                        IRMP_CTX.irmp_tmp_command
+#define irmp_tmp_address2                       IRMP_CTX.irmp_tmp_address2
+#define irmp_tmp_command2                       IRMP_CTX.irmp_tmp_command2
+#define irmp_lgair_address                      IRMP_CTX.irmp_lgair_address
+#define irmp_lgair_command                      IRMP_CTX.irmp_lgair_command
+#define irmp_tmp_id                             IRMP_CTX.irmp_tmp_id
+#define irmp_xor_check                          IRMP_CTX.irmp_xor_check
+#define irmp_genre2                             IRMP_CTX.irmp_genre2
+#define irmp_parity                             IRMP_CTX.irmp_parity
+#define irmp_first_bit                          IRMP_CTX.irmp_first_bit
+#define irmp_start_bit_detected                 IRMP_CTX.irmp_start_bit_detected
+#define irmp_pulse_time                         IRMP_CTX.irmp_pulse_time
+#define irmp_repetition_ticks                   IRMP_CTX.irmp_repetition_ticks
+#define last_irmp_denon_command                 IRMP_CTX.last_irmp_denon_command
+#define irmp_denon_repetition_len               IRMP_CTX.irmp_denon_repetition_len
+#define irmp_wait_for_space                     IRMP_CTX.irmp_wait_for_space
+#define irmp_wait_for_start_space               IRMP_CTX.irmp_wait_for_start_space
+#define irmp_pause_time                         IRMP_CTX.irmp_pause_time
+#define last_irmp_address                       IRMP_CTX.last_irmp_address
+#define last_irmp_command                       IRMP_CTX.last_irmp_command
+#define irmp_repetition_frame_number            IRMP_CTX.irmp_repetition_frame_number
+#define irmp_rc5_cmd_bit6                       IRMP_CTX.irmp_rc5_cmd_bit6
+#define irmp_last_pause                         IRMP_CTX.irmp_last_pause
+#define irmp_last_value                         IRMP_CTX.irmp_last_value
+#define irmp_early_protocol                     IRMP_CTX.irmp_early_protocol
+#define irmp_hash                               IRMP_CTX.irmp_hash
+#define irmp_hash_len                           IRMP_CTX.irmp_hash_len
+#define irmp_hash_last                          IRMP_CTX.irmp_hash_last
+#define irmp_hash_light                         IRMP_CTX.irmp_hash_light
+#define irmp_hash_count                         IRMP_CTX.irmp_hash_count
+#define irmp_hash_decoded                       IRMP_CTX.irmp_hash_decoded
+#define irmp_counters                           IRMP_CTX.irmp_counters
+#define irmp_trace_buf                          IRMP_CTX.irmp_trace_buf
+#define irmp_trace_write                        IRMP_CTX.irmp_trace_write
+#define irmp_trace_read                         IRMP_CTX.irmp_trace_read
+#define irmp_key_protocol                       IRMP_CTX.irmp_key_protocol
+#define irmp_key_address                        IRMP_CTX.irmp_key_address
+#define irmp_key_command                        IRMP_CTX.irmp_key_command
+#define irmp_key_hold                           IRMP_CTX.irmp_key_hold
+#define irmp_tmp_raw                            IRMP_CTX.irmp_tmp_raw
+#define irmp_tmp_raw_len                        IRMP_CTX.irmp_tmp_raw_len
+#define irmp_raw_pending                        IRMP_CTX.irmp_raw_pending
+#define irmp_queue_raw                          IRMP_CTX.irmp_queue_raw
+#define irmp_queue_raw_len                      IRMP_CTX.irmp_queue_raw_len
+#define irmp_queue_hold                         IRMP_CTX.irmp_queue_hold
+#define irmp_tmp_quality                        IRMP_CTX.irmp_tmp_quality
+#define irmp_queue_quality                      IRMP_CTX.irmp_queue_quality
+#define irmp_check_failed                       IRMP_CTX.irmp_check_failed
+#define irmp_candidate                          IRMP_CTX.irmp_candidate
+#define irmp_candidate_count                    IRMP_CTX.irmp_candidate_count
+#define irmp_filter_light                       IRMP_CTX.irmp_filter_light
+#define irmp_filter_count                       IRMP_CTX.irmp_filter_count
+#define irmp_last_input                         IRMP_CTX.irmp_last_input
+#define irmp_ticks_ahead                        IRMP_CTX.irmp_ticks_ahead
+#define irmp_last_inverted_input                IRMP_CTX.irmp_last_inverted_input
+#define irmp_queue                              IRMP_CTX.irmp_queue
+#define irmp_queue_write                        IRMP_CTX.irmp_queue_write
+#define irmp_queue_read                         IRMP_CTX.irmp_queue_read
+#define irmp_queue_overflows                    IRMP_CTX.irmp_queue_overflows
+#define irmp_ticks                              IRMP_CTX.irmp_ticks
+#define irmp_frame_ticks                        IRMP_CTX.irmp_frame_ticks
+#define irmp_queue_ticks                        IRMP_CTX.irmp_queue_ticks
 
 #ifdef ANALYZE
 #define input(x)                            (x)
@@ -2029,3178 +2117,8326 @@ static uint_fast8_t                              radio;
 #endif
 
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
- *  Initialize IRMP decoder
- *  @details  Configures IRMP input pin
+ *  Start bit table
+ *  @details  (pulse, pause) windows of the start bits of all enabled protocols, in the order of the classification in irmp_ISR().
+ *            If windows overlap, the entry with the lowest index wins. irmp_start_bit_init() sorts an index by pulse_min, so
+ *            irmp_start_bit_lookup() can stop at the first entry with a longer minimum pulse.
  *---------------------------------------------------------------------------------------------------------------------------------------------------
  */
-#ifndef ANALYZE
-void
-irmp_init (void)
-{
-#if defined(PIC_CCS) || defined(PIC_C18)                                // PIC: do nothing
-#elif defined (ARM_STM32)                                               // STM32
-    GPIO_InitTypeDef     GPIO_InitStructure;
+#if IRMP_USE_START_BIT_TABLE == 1
+
+#define IRMP_START_BIT_FLAG_AFTER_JVC           0x01                        // entry only valid if last protocol was JVC
+#define IRMP_START_BIT_FLAG_DYNAMIC             0x02                        // entry and parameters in RAM, see irmp_set_dynamic_protocol()
+                                                                            // and irmp_set_learned_windows()
+#define IRMP_START_BIT_SETUP_MASK               0x70                        // additional setup after start bit, see irmp_ISR():
+#define IRMP_START_BIT_SETUP_NONE               0x00                        //   nothing
+#define IRMP_START_BIT_SETUP_MANCHESTER         0x10                        //   irmp_last_pause = 0, irmp_last_value = 1
+#define IRMP_START_BIT_SETUP_LAST_PAUSE         0x20                        //   irmp_last_pause = pause, irmp_last_value = 1
+#define IRMP_START_BIT_SETUP_RC5                0x30                        //   RC5: 2nd start bit, FDC/RCCAR
+#define IRMP_START_BIT_SETUP_S100               0x40                        //   S100: 2nd start bit
+#define IRMP_START_BIT_SETUP_BANG_OLUFSEN       0x50                        //   irmp_last_value = 0
+#define IRMP_START_BIT_SETUP_ORTEK              0x60                        //   irmp_last_pause = 0, irmp_last_value = 1, irmp_parity = 0
 
-    /* GPIOx clock enable */
-#  if defined (ARM_STM32L1XX)
-    RCC_AHBPeriphClockCmd(IRMP_PORT_RCC, ENABLE);
-#  elif defined (ARM_STM32F10X)
-    RCC_APB2PeriphClockCmd(IRMP_PORT_RCC, ENABLE);
-#  elif defined (ARM_STM32F4XX)
-    RCC_AHB1PeriphClockCmd(IRMP_PORT_RCC, ENABLE);
+typedef struct
+{
+    uint8_t                     pulse_min;                                  // minimum length of start bit pulse
+    uint8_t                     pulse_max;                                  // maximum length of start bit pulse
+    PAUSE_LEN                   pause_min;                                  // minimum length of start bit pause
+    PAUSE_LEN                   pause_max;                                  // maximum length of start bit pause
+    uint8_t                     flags;                                      // IRMP_START_BIT_FLAG_xxx | IRMP_START_BIT_SETUP_xxx
+    const IRMP_PARAMETER *      param_p;                                    // protocol parameters
+} IRMP_START_BIT;
+
+static const PROGMEM IRMP_START_BIT irmp_start_bits[] =
+{
+#if IRMP_SUPPORT_SIRCS_PROTOCOL == 1
+    { SIRCS_START_BIT_PULSE_LEN_MIN, SIRCS_START_BIT_PULSE_LEN_MAX, SIRCS_START_BIT_PAUSE_LEN_MIN, SIRCS_START_BIT_PAUSE_LEN_MAX, 0, &sircs_param },
+#endif
+#if IRMP_SUPPORT_JVC_PROTOCOL == 1                                                                                  // JVC repeat frame
+    { JVC_START_BIT_PULSE_LEN_MIN, JVC_START_BIT_PULSE_LEN_MAX, JVC_REPEAT_START_BIT_PAUSE_LEN_MIN, JVC_REPEAT_START_BIT_PAUSE_LEN_MAX, IRMP_START_BIT_FLAG_AFTER_JVC, &nec_param },
+#endif
+#if IRMP_SUPPORT_NEC_PROTOCOL == 1
+#  if IRMP_SUPPORT_NEC42_PROTOCOL == 1
+    { NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX, NEC_START_BIT_PAUSE_LEN_MIN, NEC_START_BIT_PAUSE_LEN_MAX, 0, &nec42_param },
+#  else
+    { NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX, NEC_START_BIT_PAUSE_LEN_MIN, NEC_START_BIT_PAUSE_LEN_MAX, 0, &nec_param },
 #  endif
-
-    /* GPIO Configuration */
-    GPIO_InitStructure.GPIO_Pin = IRMP_BIT;
-#  if defined (ARM_STM32L1XX) || defined (ARM_STM32F4XX)
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN;
-    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_2MHz;
-    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
-    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL;
-#  elif defined (ARM_STM32F10X)
-    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_2MHz;
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
+#  if IRMP_SUPPORT_JVC_PROTOCOL == 1                                                                                // JVC repeat frame type 2
+    { NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX, NEC_REPEAT_START_BIT_PAUSE_LEN_MIN, NEC_REPEAT_START_BIT_PAUSE_LEN_MAX, IRMP_START_BIT_FLAG_AFTER_JVC, &nec_param },
 #  endif
-    GPIO_Init(IRMP_PORT, &GPIO_InitStructure);
+    { NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX, NEC_REPEAT_START_BIT_PAUSE_LEN_MIN, NEC_REPEAT_START_BIT_PAUSE_LEN_MAX, 0, &nec_rep_param },
+#  if IRMP_SUPPORT_JVC_PROTOCOL == 1                                                                                // JVC repeat frame type 3
+    { NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX, NEC_0_PAUSE_LEN_MIN, NEC_0_PAUSE_LEN_MAX, IRMP_START_BIT_FLAG_AFTER_JVC, &nec_param },
+#  endif
+#endif
+#if IRMP_SUPPORT_TELEFUNKEN_PROTOCOL == 1
+    { TELEFUNKEN_START_BIT_PULSE_LEN_MIN, TELEFUNKEN_START_BIT_PULSE_LEN_MAX, TELEFUNKEN_START_BIT_PAUSE_LEN_MIN, TELEFUNKEN_START_BIT_PAUSE_LEN_MAX, 0, &telefunken_param },
+#endif
+#if IRMP_SUPPORT_ROOMBA_PROTOCOL == 1
+    { ROOMBA_START_BIT_PULSE_LEN_MIN, ROOMBA_START_BIT_PULSE_LEN_MAX, ROOMBA_START_BIT_PAUSE_LEN_MIN, ROOMBA_START_BIT_PAUSE_LEN_MAX, 0, &roomba_param },
+#endif
+#if IRMP_SUPPORT_ACP24_PROTOCOL == 1
+    { ACP24_START_BIT_PULSE_LEN_MIN, ACP24_START_BIT_PULSE_LEN_MAX, ACP24_START_BIT_PAUSE_LEN_MIN, ACP24_START_BIT_PAUSE_LEN_MAX, 0, &acp24_param },
+#endif
+#if IRMP_SUPPORT_PENTAX_PROTOCOL == 1
+    { PENTAX_START_BIT_PULSE_LEN_MIN, PENTAX_START_BIT_PULSE_LEN_MAX, PENTAX_START_BIT_PAUSE_LEN_MIN, PENTAX_START_BIT_PAUSE_LEN_MAX, 0, &pentax_param },
+#endif
+#if IRMP_SUPPORT_NIKON_PROTOCOL == 1
+    { NIKON_START_BIT_PULSE_LEN_MIN, NIKON_START_BIT_PULSE_LEN_MAX, NIKON_START_BIT_PAUSE_LEN_MIN, NIKON_START_BIT_PAUSE_LEN_MAX, 0, &nikon_param },
+#endif
+#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+    { SAMSUNG_START_BIT_PULSE_LEN_MIN, SAMSUNG_START_BIT_PULSE_LEN_MAX, SAMSUNG_START_BIT_PAUSE_LEN_MIN, SAMSUNG_START_BIT_PAUSE_LEN_MAX, 0, &samsung_param },
+#endif
+#if IRMP_SUPPORT_MATSUSHITA_PROTOCOL == 1
+    { MATSUSHITA_START_BIT_PULSE_LEN_MIN, MATSUSHITA_START_BIT_PULSE_LEN_MAX, MATSUSHITA_START_BIT_PAUSE_LEN_MIN, MATSUSHITA_START_BIT_PAUSE_LEN_MAX, 0, &matsushita_param },
+#endif
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+    { KASEIKYO_START_BIT_PULSE_LEN_MIN, KASEIKYO_START_BIT_PULSE_LEN_MAX, KASEIKYO_START_BIT_PAUSE_LEN_MIN, KASEIKYO_START_BIT_PAUSE_LEN_MAX, 0, &kaseikyo_param },
+#endif
+#if IRMP_SUPPORT_PANASONIC_PROTOCOL == 1
+    { PANASONIC_START_BIT_PULSE_LEN_MIN, PANASONIC_START_BIT_PULSE_LEN_MAX, PANASONIC_START_BIT_PAUSE_LEN_MIN, PANASONIC_START_BIT_PAUSE_LEN_MAX, 0, &panasonic_param },
+#endif
+#if IRMP_SUPPORT_RADIO1_PROTOCOL == 1
+    { RADIO1_START_BIT_PULSE_LEN_MIN, RADIO1_START_BIT_PULSE_LEN_MAX, RADIO1_START_BIT_PAUSE_LEN_MIN, RADIO1_START_BIT_PAUSE_LEN_MAX, 0, &radio1_param },
+#endif
+#if IRMP_SUPPORT_RECS80_PROTOCOL == 1
+    { RECS80_START_BIT_PULSE_LEN_MIN, RECS80_START_BIT_PULSE_LEN_MAX, RECS80_START_BIT_PAUSE_LEN_MIN, RECS80_START_BIT_PAUSE_LEN_MAX, 0, &recs80_param },
+#endif
+#if IRMP_SUPPORT_S100_PROTOCOL == 1                                                                                 // pulse and pause: 1 or 2 bit times
+    { S100_START_BIT_LEN_MIN,     S100_START_BIT_LEN_MAX,     S100_START_BIT_LEN_MIN,     S100_START_BIT_LEN_MAX,     IRMP_START_BIT_SETUP_S100, &s100_param },
+    { S100_START_BIT_LEN_MIN,     S100_START_BIT_LEN_MAX,     2 * S100_START_BIT_LEN_MIN, 2 * S100_START_BIT_LEN_MAX, IRMP_START_BIT_SETUP_S100, &s100_param },
+    { 2 * S100_START_BIT_LEN_MIN, 2 * S100_START_BIT_LEN_MAX, S100_START_BIT_LEN_MIN,     S100_START_BIT_LEN_MAX,     IRMP_START_BIT_SETUP_S100, &s100_param },
+    { 2 * S100_START_BIT_LEN_MIN, 2 * S100_START_BIT_LEN_MAX, 2 * S100_START_BIT_LEN_MIN, 2 * S100_START_BIT_LEN_MAX, IRMP_START_BIT_SETUP_S100, &s100_param },
+#endif
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1                                                                                  // pulse and pause: 1 or 2 bit times
+    { RC5_START_BIT_LEN_MIN,      RC5_START_BIT_LEN_MAX,      RC5_START_BIT_LEN_MIN,      RC5_START_BIT_LEN_MAX,      IRMP_START_BIT_SETUP_RC5, &rc5_param },
+    { RC5_START_BIT_LEN_MIN,      RC5_START_BIT_LEN_MAX,      2 * RC5_START_BIT_LEN_MIN,  2 * RC5_START_BIT_LEN_MAX,  IRMP_START_BIT_SETUP_RC5, &rc5_param },
+    { 2 * RC5_START_BIT_LEN_MIN,  2 * RC5_START_BIT_LEN_MAX,  RC5_START_BIT_LEN_MIN,      RC5_START_BIT_LEN_MAX,      IRMP_START_BIT_SETUP_RC5, &rc5_param },
+    { 2 * RC5_START_BIT_LEN_MIN,  2 * RC5_START_BIT_LEN_MAX,  2 * RC5_START_BIT_LEN_MIN,  2 * RC5_START_BIT_LEN_MAX,  IRMP_START_BIT_SETUP_RC5, &rc5_param },
+#endif
+#if IRMP_SUPPORT_DENON_PROTOCOL == 1                                                                                // pause: 1 or 0 bit
+    { DENON_PULSE_LEN_MIN, DENON_PULSE_LEN_MAX, DENON_1_PAUSE_LEN_MIN, DENON_1_PAUSE_LEN_MAX, 0, &denon_param },
+    { DENON_PULSE_LEN_MIN, DENON_PULSE_LEN_MAX, DENON_0_PAUSE_LEN_MIN, DENON_0_PAUSE_LEN_MAX, 0, &denon_param },
+#endif
+#if IRMP_SUPPORT_THOMSON_PROTOCOL == 1                                                                              // pause: 1 or 0 bit
+    { THOMSON_PULSE_LEN_MIN, THOMSON_PULSE_LEN_MAX, THOMSON_1_PAUSE_LEN_MIN, THOMSON_1_PAUSE_LEN_MAX, 0, &thomson_param },
+    { THOMSON_PULSE_LEN_MIN, THOMSON_PULSE_LEN_MAX, THOMSON_0_PAUSE_LEN_MIN, THOMSON_0_PAUSE_LEN_MAX, 0, &thomson_param },
+#endif
+#if IRMP_SUPPORT_BOSE_PROTOCOL == 1
+    { BOSE_START_BIT_PULSE_LEN_MIN, BOSE_START_BIT_PULSE_LEN_MAX, BOSE_START_BIT_PAUSE_LEN_MIN, BOSE_START_BIT_PAUSE_LEN_MAX, 0, &bose_param },
+#endif
+#if IRMP_SUPPORT_RC6_PROTOCOL == 1
+    { RC6_START_BIT_PULSE_LEN_MIN, RC6_START_BIT_PULSE_LEN_MAX, RC6_START_BIT_PAUSE_LEN_MIN, RC6_START_BIT_PAUSE_LEN_MAX, IRMP_START_BIT_SETUP_MANCHESTER, &rc6_param },
+#endif
+#if IRMP_SUPPORT_RECS80EXT_PROTOCOL == 1
+    { RECS80EXT_START_BIT_PULSE_LEN_MIN, RECS80EXT_START_BIT_PULSE_LEN_MAX, RECS80EXT_START_BIT_PAUSE_LEN_MIN, RECS80EXT_START_BIT_PAUSE_LEN_MAX, 0, &recs80ext_param },
+#endif
+#if IRMP_SUPPORT_NUBERT_PROTOCOL == 1
+    { NUBERT_START_BIT_PULSE_LEN_MIN, NUBERT_START_BIT_PULSE_LEN_MAX, NUBERT_START_BIT_PAUSE_LEN_MIN, NUBERT_START_BIT_PAUSE_LEN_MAX, 0, &nubert_param },
+#endif
+#if IRMP_SUPPORT_FAN_PROTOCOL == 1
+    { FAN_START_BIT_PULSE_LEN_MIN, FAN_START_BIT_PULSE_LEN_MAX, FAN_START_BIT_PAUSE_LEN_MIN, FAN_START_BIT_PAUSE_LEN_MAX, 0, &fan_param },
+#endif
+#if IRMP_SUPPORT_SPEAKER_PROTOCOL == 1
+    { SPEAKER_START_BIT_PULSE_LEN_MIN, SPEAKER_START_BIT_PULSE_LEN_MAX, SPEAKER_START_BIT_PAUSE_LEN_MIN, SPEAKER_START_BIT_PAUSE_LEN_MAX, 0, &speaker_param },
+#endif
+#if IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
+    { BANG_OLUFSEN_START_BIT1_PULSE_LEN_MIN, BANG_OLUFSEN_START_BIT1_PULSE_LEN_MAX, BANG_OLUFSEN_START_BIT1_PAUSE_LEN_MIN, BANG_OLUFSEN_START_BIT1_PAUSE_LEN_MAX,
+      IRMP_START_BIT_SETUP_BANG_OLUFSEN, &bang_olufsen_param },
+#endif
+#if IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
+    { GRUNDIG_NOKIA_IR60_START_BIT_LEN_MIN, GRUNDIG_NOKIA_IR60_START_BIT_LEN_MAX, GRUNDIG_NOKIA_IR60_PRE_PAUSE_LEN_MIN, GRUNDIG_NOKIA_IR60_PRE_PAUSE_LEN_MAX,
+      IRMP_START_BIT_SETUP_LAST_PAUSE, &grundig_param },
+#endif
+#if IRMP_SUPPORT_MERLIN_PROTOCOL == 1                                                                               // check MERLIN before RUWIDO!
+    { MERLIN_START_BIT_PULSE_LEN_MIN, MERLIN_START_BIT_PULSE_LEN_MAX, MERLIN_START_BIT_PAUSE_LEN_MIN, MERLIN_START_BIT_PAUSE_LEN_MAX, IRMP_START_BIT_SETUP_MANCHESTER, &merlin_param },
+#endif
+#if IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1                                                                    // pulse and pause: 1 or 2 bit times
+    { SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN,     SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX,     SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN,     SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX,
+      IRMP_START_BIT_SETUP_LAST_PAUSE, &ruwido_param },
+    { SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN,     SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX,     2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN, 2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX,
+      IRMP_START_BIT_SETUP_LAST_PAUSE, &ruwido_param },
+    { 2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN, 2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX, SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN,     SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX,
+      IRMP_START_BIT_SETUP_LAST_PAUSE, &ruwido_param },
+    { 2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN, 2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX, 2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN, 2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX,
+      IRMP_START_BIT_SETUP_LAST_PAUSE, &ruwido_param },
+#endif
+#if IRMP_SUPPORT_FDC_PROTOCOL == 1
+    { FDC_START_BIT_PULSE_LEN_MIN, FDC_START_BIT_PULSE_LEN_MAX, FDC_START_BIT_PAUSE_LEN_MIN, FDC_START_BIT_PAUSE_LEN_MAX, 0, &fdc_param },
+#endif
+#if IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+    { RCCAR_START_BIT_PULSE_LEN_MIN, RCCAR_START_BIT_PULSE_LEN_MAX, RCCAR_START_BIT_PAUSE_LEN_MIN, RCCAR_START_BIT_PAUSE_LEN_MAX, 0, &rccar_param },
+#endif
+#if IRMP_SUPPORT_KATHREIN_PROTOCOL == 1
+    { KATHREIN_START_BIT_PULSE_LEN_MIN, KATHREIN_START_BIT_PULSE_LEN_MAX, KATHREIN_START_BIT_PAUSE_LEN_MIN, KATHREIN_START_BIT_PAUSE_LEN_MAX, 0, &kathrein_param },
+#endif
+#if IRMP_SUPPORT_NETBOX_PROTOCOL == 1
+    { NETBOX_START_BIT_PULSE_LEN_MIN, NETBOX_START_BIT_PULSE_LEN_MAX, NETBOX_START_BIT_PAUSE_LEN_MIN, NETBOX_START_BIT_PAUSE_LEN_MAX, 0, &netbox_param },
+#endif
+#if IRMP_SUPPORT_LEGO_PROTOCOL == 1
+    { LEGO_START_BIT_PULSE_LEN_MIN, LEGO_START_BIT_PULSE_LEN_MAX, LEGO_START_BIT_PAUSE_LEN_MIN, LEGO_START_BIT_PAUSE_LEN_MAX, 0, &lego_param },
+#endif
+#if IRMP_SUPPORT_A1TVBOX_PROTOCOL == 1
+    { A1TVBOX_START_BIT_PULSE_LEN_MIN, A1TVBOX_START_BIT_PULSE_LEN_MAX, A1TVBOX_START_BIT_PAUSE_LEN_MIN, A1TVBOX_START_BIT_PAUSE_LEN_MAX, IRMP_START_BIT_SETUP_MANCHESTER, &a1tvbox_param },
+#endif
+#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+    { ORTEK_START_BIT_PULSE_LEN_MIN, ORTEK_START_BIT_PULSE_LEN_MAX, ORTEK_START_BIT_PAUSE_LEN_MIN, ORTEK_START_BIT_PAUSE_LEN_MAX, IRMP_START_BIT_SETUP_ORTEK, &ortek_param },
+#endif
+#if IRMP_SUPPORT_RCMM_PROTOCOL == 1
+    { RCMM32_START_BIT_PULSE_LEN_MIN, RCMM32_START_BIT_PULSE_LEN_MAX, RCMM32_START_BIT_PAUSE_LEN_MIN, RCMM32_START_BIT_PAUSE_LEN_MAX, 0, &rcmm_param },
+#endif
+};
 
-#elif defined(STELLARIS_ARM_CORTEX_M4)
-    // Enable the GPIO port
-    ROM_SysCtlPeripheralEnable(IRMP_PORT_PERIPH);
+#define IRMP_START_BITS                         (sizeof (irmp_start_bits) / sizeof (IRMP_START_BIT))
+#define IRMP_START_BIT_ENTRIES                  (IRMP_START_BITS + IRMP_DYNAMIC_PROTOCOLS)  // table and dynamic protocols
 
-    // Set as an input
-    ROM_GPIODirModeSet(IRMP_PORT_BASE, IRMP_PORT_PIN, GPIO_DIR_MODE_IN);
-    ROM_GPIOPadConfigSet(IRMP_PORT_BASE, IRMP_PORT_PIN, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+#if IRMP_DYNAMIC_PROTOCOLS > 0
+static IRMP_START_BIT                           irmp_dynamic_start_bits[IRMP_DYNAMIC_PROTOCOLS];    // entries IRMP_START_BITS ..., param_p 0: unused
+static IRMP_PARAMETER                           irmp_dynamic_params[IRMP_DYNAMIC_PROTOCOLS];
 
-#elif defined(__SDCC_stm8)                                              // STM8
-    IRMP_GPIO_STRUCT->DDR &= ~(1<<IRMP_BIT);                            // pin is input
-    IRMP_GPIO_STRUCT->CR1 |= (1<<IRMP_BIT);                             // activate pullup
+#define IRMP_START_BIT_ENTRY_GET(s, idx)        { if ((uint_fast8_t) (idx) < IRMP_START_BITS) memcpy_P (&(s), &irmp_start_bits[idx], sizeof (IRMP_START_BIT)); \
+                                                  else (s) = irmp_dynamic_start_bits[(idx) - IRMP_START_BITS]; }
+#else
+#define IRMP_START_BIT_ENTRY_GET(s, idx)        memcpy_P (&(s), &irmp_start_bits[idx], sizeof (IRMP_START_BIT))
+#endif
 
-#elif defined (TEENSY_ARM_CORTEX_M4)                                    // TEENSY
-    pinMode(IRMP_PIN, INPUT);
+#if IRMP_LEARNED_WINDOWS > 0
+static IRMP_QUALITY                             irmp_learned_quality[IRMP_LEARNED_WINDOWS];     // timing of learned frames, start_bit 0: unused
+static IRMP_START_BIT                           irmp_learned_start_bits[IRMP_LEARNED_WINDOWS];  // narrowed entries, flags | DYNAMIC
+static IRMP_PARAMETER                           irmp_learned_params[IRMP_LEARNED_WINDOWS];
+static uint8_t                                  irmp_start_bit_learned[IRMP_START_BITS];        // slot + 1 of entry n, 0: not learned
 
-#else                                                                   // AVR
-    IRMP_PORT &= ~(1<<IRMP_BIT);                                        // deactivate pullup
-    IRMP_DDR &= ~(1<<IRMP_BIT);                                         // set pin to input
+#define IRMP_START_BIT_GET(s, idx)              { if ((uint_fast8_t) (idx) < IRMP_START_BITS && irmp_start_bit_learned[idx]) \
+                                                      (s) = irmp_learned_start_bits[irmp_start_bit_learned[idx] - 1]; \
+                                                  else IRMP_START_BIT_ENTRY_GET (s, idx); }
+#else
+#define IRMP_START_BIT_GET(s, idx)              IRMP_START_BIT_ENTRY_GET (s, idx)
 #endif
 
-#if IRMP_LOGGING == 1
-    irmp_uart_init ();
+#if IRMP_DYNAMIC_PROTOCOLS > 0 || IRMP_LEARNED_WINDOWS > 0
+#define IRMP_START_BIT_PARAM_GET(p, s)          { if ((s).flags & IRMP_START_BIT_FLAG_DYNAMIC) (p) = *(s).param_p; \
+                                                  else memcpy_P (&(p), (s).param_p, sizeof (IRMP_PARAMETER)); }
+#else
+#define IRMP_START_BIT_PARAM_GET(p, s)          memcpy_P (&(p), (s).param_p, sizeof (IRMP_PARAMETER))
 #endif
-}
+
+static uint8_t                                  irmp_start_bit_order[IRMP_START_BIT_ENTRIES];   // table indexes, sorted by pulse_min
+
+#if IRMP_USE_PROTOCOL_MASK == 1 || IRMP_DYNAMIC_PROTOCOLS > 0
+static uint8_t                                  irmp_start_bit_count;                       // entries in irmp_start_bit_order
+#else
+#define irmp_start_bit_count                    IRMP_START_BITS
 #endif
+
+#if IRMP_USE_PROTOCOL_MASK == 1
+#define IRMP_MASK_IS_SET(m, n)                  ((m)[(n) >> 3] & (1 << ((n) & 0x07)))
+
+static uint8_t                                  irmp_protocol_disabled[(IRMP_N_PROTOCOLS + 8) / 8]; // bit n: protocol n disabled
+static uint8_t                                  irmp_start_bit_disabled[(IRMP_START_BIT_ENTRIES + 7) / 8];  // bit n: entry n disabled
+
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
- *  Get IRMP data
- *  @details  gets decoded IRMP data
- *  @param    pointer in order to store IRMP data
- *  @return    TRUE: successful, FALSE: failed
+ *  Protocols converted from the protocol of their start bit: (protocol, protocol of start bit), see irmp_ISR() and irmp_get_frame()
  *---------------------------------------------------------------------------------------------------------------------------------------------------
  */
-uint_fast8_t
-irmp_get_data (IRMP_DATA * irmp_data_p)
+static const PROGMEM uint8_t irmp_protocol_sources[][2] =
 {
-    uint_fast8_t   rtc = FALSE;
+    { IRMP_NEC_PROTOCOL,        IRMP_NEC42_PROTOCOL     },
+    { IRMP_NEC16_PROTOCOL,      IRMP_NEC42_PROTOCOL     },
+    { IRMP_NEC16_PROTOCOL,      IRMP_NEC_PROTOCOL       },
+    { IRMP_JVC_PROTOCOL,        IRMP_NEC42_PROTOCOL     },
+    { IRMP_JVC_PROTOCOL,        IRMP_NEC_PROTOCOL       },
+    { IRMP_LGAIR_PROTOCOL,      IRMP_NEC42_PROTOCOL     },
+    { IRMP_LGAIR_PROTOCOL,      IRMP_NEC_PROTOCOL       },
+    { IRMP_APPLE_PROTOCOL,      IRMP_NEC42_PROTOCOL     },
+    { IRMP_APPLE_PROTOCOL,      IRMP_NEC_PROTOCOL       },
+    { IRMP_SAMSUNG32_PROTOCOL,  IRMP_SAMSUNG_PROTOCOL   },
+    { IRMP_SAMSUNG48_PROTOCOL,  IRMP_SAMSUNG_PROTOCOL   },
+    { IRMP_TECHNICS_PROTOCOL,   IRMP_MATSUSHITA_PROTOCOL},
+    { IRMP_IR60_PROTOCOL,       IRMP_GRUNDIG_PROTOCOL   },
+    { IRMP_NOKIA_PROTOCOL,      IRMP_GRUNDIG_PROTOCOL   },
+    { IRMP_SIEMENS_PROTOCOL,    IRMP_RUWIDO_PROTOCOL    },
+    { IRMP_RCMM24_PROTOCOL,     IRMP_RCMM32_PROTOCOL    },
+    { IRMP_RCMM12_PROTOCOL,     IRMP_RCMM32_PROTOCOL    },
+    { IRMP_RC6A_PROTOCOL,       IRMP_RC6_PROTOCOL       },
+    { IRMP_FDC_PROTOCOL,        IRMP_RC5_PROTOCOL       },
+    { IRMP_RCCAR_PROTOCOL,      IRMP_RC5_PROTOCOL       },
+};
 
-    if (irmp_ir_detected)
+#define IRMP_PROTOCOL_SOURCES                   (sizeof (irmp_protocol_sources) / sizeof (irmp_protocol_sources[0]))
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Check start bit of protocol
+ *  @return   TRUE: protocol or a protocol converted from it is enabled, FALSE: start bit is not needed
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static uint_fast8_t
+irmp_start_bit_enabled (uint_fast8_t protocol)
+{
+    uint8_t         source[2];
+    uint_fast8_t    i;
+
+    if (! IRMP_MASK_IS_SET (irmp_protocol_disabled, protocol))
     {
-        switch (irmp_protocol)
+        return TRUE;
+    }
+
+    for (i = 0; i < IRMP_PROTOCOL_SOURCES; i++)
+    {
+        memcpy_P (source, irmp_protocol_sources[i], sizeof (source));
+
+        if (source[1] == protocol && ! IRMP_MASK_IS_SET (irmp_protocol_disabled, source[0]))
         {
-#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
-            case IRMP_SAMSUNG_PROTOCOL:
-                if ((irmp_command >> 8) == (~irmp_command & 0x00FF))
-                {
-                    irmp_command &= 0xff;
-                    irmp_command |= irmp_id << 8;
-                    rtc = TRUE;
-                }
-                break;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+#endif // IRMP_USE_PROTOCOL_MASK == 1
 
-#if IRMP_SUPPORT_SAMSUNG48_PROTOCOL == 1
-            case IRMP_SAMSUNG48_PROTOCOL:
-                irmp_command = (irmp_command & 0x00FF) | ((irmp_id & 0x00FF) << 8);
-                rtc = TRUE;
-                break;
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Sort start bit table index by minimum pulse length
+ *  @details  loaded dynamic protocols are sorted in after the table entries. With IRMP_USE_PROTOCOL_MASK, entries of disabled protocols
+ *            are left out of the index
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_start_bit_init (void)
+{
+    IRMP_START_BIT  a;
+    IRMP_START_BIT  b;
+    uint_fast8_t    n = 0;
+    uint_fast8_t    i;
+    uint_fast8_t    j;
+#if IRMP_USE_PROTOCOL_MASK == 1
+    IRMP_PARAMETER  param;
 #endif
+
+#if (IRMP_USE_PROTOCOL_MASK == 1 || IRMP_LEARNED_WINDOWS > 0) && defined (ANALYZE)
+    start_bit_table_masked = FALSE;
 #endif
 
-#if IRMP_SUPPORT_NEC_PROTOCOL == 1
-            case IRMP_NEC_PROTOCOL:
-                if ((irmp_command >> 8) == (~irmp_command & 0x00FF))
-                {
-                    irmp_command &= 0xff;
-                    rtc = TRUE;
-                }
-                else if (irmp_address == 0x87EE)
-                {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF ("Switching to APPLE protocol\n");
-#endif // ANALYZE
-                    irmp_protocol = IRMP_APPLE_PROTOCOL;
-                    irmp_address = (irmp_command & 0xFF00) >> 8;
-                    irmp_command &= 0x00FF;
-                    rtc = TRUE;
-                }
-                break;
+    for (i = 0; i < IRMP_START_BIT_ENTRIES; i++)                            // insertion sort, stable
+    {
+        IRMP_START_BIT_GET (a, i);
+
+#if IRMP_DYNAMIC_PROTOCOLS > 0
+        if (! a.param_p)                                                    // dynamic protocol not loaded
+        {
+            continue;
+        }
 #endif
-#if IRMP_SUPPORT_BOSE_PROTOCOL == 1
-            case IRMP_BOSE_PROTOCOL:
-                if ((irmp_command >> 8) == (~irmp_command & 0x00FF))
-                {
-                    irmp_command &= 0xff;
-                    rtc = TRUE;
-                }
-                break;
+
+#if IRMP_LEARNED_WINDOWS > 0 && defined (ANALYZE)
+        start_bit_table_masked |= (i < IRMP_START_BITS && irmp_start_bit_learned[i]);  // windows narrowed
 #endif
-#if IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1
-            case IRMP_SIEMENS_PROTOCOL:
-            case IRMP_RUWIDO_PROTOCOL:
-                if (((irmp_command >> 1) & 0x0001) == (~irmp_command & 0x0001))
-                {
-                    irmp_command >>= 1;
-                    rtc = TRUE;
-                }
-                break;
+
+#if IRMP_USE_PROTOCOL_MASK == 1
+        IRMP_START_BIT_PARAM_GET (param, a);
+
+        if (! irmp_start_bit_enabled (param.protocol))
+        {
+            irmp_start_bit_disabled[i >> 3] |= 1 << (i & 0x07);
+#ifdef ANALYZE
+            start_bit_table_masked |= (i < IRMP_START_BITS);
+#endif // ANALYZE
+            continue;
+        }
+        irmp_start_bit_disabled[i >> 3] &= ~(1 << (i & 0x07));
 #endif
-#if IRMP_SUPPORT_KATHREIN_PROTOCOL == 1
-            case IRMP_KATHREIN_PROTOCOL:
-                if (irmp_command != 0x0000)
-                {
-                    rtc = TRUE;
-                }
+
+        for (j = n; j > 0; j--)
+        {
+            IRMP_START_BIT_GET (b, irmp_start_bit_order[j - 1]);
+
+            if (b.pulse_min <= a.pulse_min)
+            {
                 break;
+            }
+            irmp_start_bit_order[j] = irmp_start_bit_order[j - 1];
+        }
+        irmp_start_bit_order[j] = i;
+        n++;
+    }
+
+#if IRMP_USE_PROTOCOL_MASK == 1 || IRMP_DYNAMIC_PROTOCOLS > 0
+    irmp_start_bit_count = n;
 #endif
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1
-            case IRMP_RC5_PROTOCOL:
-                irmp_address &= ~0x20;                              // clear toggle bit
-                rtc = TRUE;
-                break;
-#endif
-#if IRMP_SUPPORT_S100_PROTOCOL == 1
-            case IRMP_S100_PROTOCOL:
-                irmp_address &= ~0x20;                              // clear toggle bit
-                rtc = TRUE;
-                break;
-#endif
-#if IRMP_SUPPORT_IR60_PROTOCOL == 1
-            case IRMP_IR60_PROTOCOL:
-                if (irmp_command != 0x007d)                         // 0x007d (== 62<<1 + 1) is start instruction frame
-                {
-                    rtc = TRUE;
-                }
-                else
-                {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF("Info IR60: got start instruction frame\n");
-#endif // ANALYZE
-                }
-                break;
-#endif
-#if IRMP_SUPPORT_RCCAR_PROTOCOL == 1
-            case IRMP_RCCAR_PROTOCOL:
-                // frame in irmp_data:
-                // Bit 12 11 10 9  8  7  6  5  4  3  2  1  0
-                //     V  D7 D6 D5 D4 D3 D2 D1 D0 A1 A0 C1 C0   //         10 9  8  7  6  5  4  3  2  1  0
-                irmp_address = (irmp_command & 0x000C) >> 2;    // addr:   0  0  0  0  0  0  0  0  0  A1 A0
-                irmp_command = ((irmp_command & 0x1000) >> 2) | // V-Bit:  V  0  0  0  0  0  0  0  0  0  0
-                               ((irmp_command & 0x0003) << 8) | // C-Bits: 0  C1 C0 0  0  0  0  0  0  0  0
-                               ((irmp_command & 0x0FF0) >> 4);  // D-Bits:          D7 D6 D5 D4 D3 D2 D1 D0
-                rtc = TRUE;                                     // Summe:  V  C1 C0 D7 D6 D5 D4 D3 D2 D1 D0
-                break;
-#endif
-
-#if IRMP_SUPPORT_NETBOX_PROTOCOL == 1                           // squeeze code to 8 bit, upper bit indicates release-key
-            case IRMP_NETBOX_PROTOCOL:
-                if (irmp_command & 0x1000)                      // last bit set?
-                {
-                    if ((irmp_command & 0x1f) == 0x15)          // key pressed: 101 01 (LSB)
-                    {
-                        irmp_command >>= 5;
-                        irmp_command &= 0x7F;
-                        rtc = TRUE;
-                    }
-                    else if ((irmp_command & 0x1f) == 0x10)     // key released: 000 01 (LSB)
-                    {
-                        irmp_command >>= 5;
-                        irmp_command |= 0x80;
-                        rtc = TRUE;
-                    }
-                    else
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF("error NETBOX: bit6/7 must be 0/1\n");
-#endif // ANALYZE
-                    }
-                }
-                else
-                {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF("error NETBOX: last bit not set\n");
-#endif // ANALYZE
-                }
-                break;
-#endif
-#if IRMP_SUPPORT_LEGO_PROTOCOL == 1
-            case IRMP_LEGO_PROTOCOL:
-            {
-                uint_fast8_t crc = 0x0F ^ ((irmp_command & 0xF000) >> 12) ^ ((irmp_command & 0x0F00) >> 8) ^ ((irmp_command & 0x00F0) >> 4);
+}
 
-                if ((irmp_command & 0x000F) == crc)
-                {
-                    irmp_command >>= 4;
-                    rtc = TRUE;
-                }
-                else
-                {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF ("CRC error in LEGO protocol\n");
-#endif // ANALYZE
-                    // rtc = TRUE;                              // don't accept codes with CRC errors
-                }
-                break;
-            }
-#endif
+#if IRMP_USE_PROTOCOL_MASK == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Set enabled protocols
+ *  @details  shared by all contexts. Only start bits of the listed protocols, or of protocols converted into them, are looked up, frames of
+ *            other protocols are dropped. irmp_ISR() reads the start bit index, so call it with interrupts disabled
+ *  @param    protocols: list of protocols, unsupported ones (e.g. 0xFF from an erased EEPROM) are ignored
+ *  @param    n: length of list, 0 or no supported protocol in list: enable all protocols
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+void
+irmp_set_protocols (const uint8_t * protocols, uint_fast8_t n)
+{
+    uint_fast8_t    enabled = FALSE;
+    uint_fast8_t    i;
 
-            default:
-            {
-                rtc = TRUE;
-                break;
-            }
-        }
+    memset (irmp_protocol_disabled, 0xFF, sizeof (irmp_protocol_disabled));
 
-        if (rtc)
+    for (i = 0; i < n; i++)
+    {
+        if (protocols[i] > 0 && protocols[i] < IRMP_N_PROTOCOLS)
         {
-            irmp_data_p->protocol = irmp_protocol;
-            irmp_data_p->address = irmp_address;
-            irmp_data_p->command = irmp_command;
-            irmp_data_p->flags   = irmp_flags;
-            irmp_command = 0;
-            irmp_address = 0;
-            irmp_flags   = 0;
+            irmp_protocol_disabled[protocols[i] >> 3] &= ~(1 << (protocols[i] & 0x07));
+            enabled = TRUE;
         }
+    }
 
-        irmp_ir_detected = FALSE;
+    if (! enabled)
+    {
+        memset (irmp_protocol_disabled, 0x00, sizeof (irmp_protocol_disabled));
     }
 
-    return rtc;
+    irmp_start_bit_init ();
 }
+#endif // IRMP_USE_PROTOCOL_MASK == 1
 
-#if IRMP_USE_CALLBACK == 1
-void
-irmp_set_callback_ptr (void (*cb)(uint_fast8_t))
+#if IRMP_DYNAMIC_PROTOCOLS > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Load dynamic protocol
+ *  @details  shared by all contexts. Checks the descriptor, e.g. read from EEPROM, and sorts its start bit into the start bit index.
+ *            irmp_ISR() reads the start bit index, so call it with interrupts disabled
+ *  @param    idx: 0 ... IRMP_DYNAMIC_PROTOCOLS - 1, frames are returned as IRMP_DYNAMIC1_PROTOCOL + idx
+ *  @param    d: descriptor, generated with ./irmp -y (ANALYZE)
+ *  @return   TRUE: protocol loaded, FALSE: descriptor invalid, e.g. erased EEPROM or other F_INTERRUPTS, protocol unloaded
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+uint_fast8_t
+irmp_set_dynamic_protocol (uint_fast8_t idx, const IRMP_DYNAMIC_DESCRIPTOR * d)
 {
-    irmp_callback_ptr = cb;
-}
-#endif // IRMP_USE_CALLBACK == 1
+    IRMP_START_BIT *    start_bit_p;
+    IRMP_PARAMETER *    param_p;
+    uint_fast8_t        valid;
 
-// these statics must not be volatile, because they are only used by irmp_store_bit(), which is called by irmp_ISR()
-static uint_fast16_t irmp_tmp_address;                                      // ir address
-static uint_fast16_t irmp_tmp_command;                                      // ir command
+    if (idx >= IRMP_DYNAMIC_PROTOCOLS)
+    {
+        return FALSE;
+    }
 
-#if (IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)) || IRMP_SUPPORT_NEC42_PROTOCOL == 1
-static uint_fast16_t irmp_tmp_address2;                                     // ir address
-static uint_fast16_t irmp_tmp_command2;                                     // ir command
-#endif
+    valid = d->interrupts == (F_INTERRUPTS + 50) / 100 &&
+            d->start_pulse_len_min > 0 && d->start_pulse_len_min <= d->start_pulse_len_max &&
+            d->start_pause_len_min > 0 && d->start_pause_len_min <= d->start_pause_len_max &&
+            d->pulse_1_len_min <= d->pulse_1_len_max && d->pause_1_len_min <= d->pause_1_len_max &&
+            d->pulse_0_len_min <= d->pulse_0_len_max && d->pause_0_len_min <= d->pause_0_len_max &&
+            d->address_offset <= d->address_end && d->address_end - d->address_offset <= 16 && d->address_end <= d->complete_len &&
+            d->command_offset <= d->command_end && d->command_end - d->command_offset <= 16 && d->command_end <= d->complete_len &&
+            d->complete_len > 0 && d->stop_bit <= 1 && d->lsb_first <= 1;
 
-#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
-static uint_fast16_t irmp_lgair_address;                                    // ir address
-static uint_fast16_t irmp_lgair_command;                                    // ir command
-#endif
+    start_bit_p = irmp_dynamic_start_bits + idx;
+    param_p     = irmp_dynamic_params + idx;
+    memset (start_bit_p, 0, sizeof (IRMP_START_BIT));
 
-#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
-static uint_fast16_t irmp_tmp_id;                                           // ir id (only SAMSUNG)
-#endif
-#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
-static uint8_t      xor_check[6];                                           // check kaseikyo "parity" bits
-static uint_fast8_t genre2;                                                 // save genre2 bits here, later copied to MSB in flags
-#endif
+    if (valid)
+    {
+        param_p->protocol           = IRMP_DYNAMIC1_PROTOCOL + idx;
+        param_p->pulse_1_len_min    = d->pulse_1_len_min;
+        param_p->pulse_1_len_max    = d->pulse_1_len_max;
+        param_p->pause_1_len_min    = d->pause_1_len_min;
+        param_p->pause_1_len_max    = d->pause_1_len_max;
+        param_p->pulse_0_len_min    = d->pulse_0_len_min;
+        param_p->pulse_0_len_max    = d->pulse_0_len_max;
+        param_p->pause_0_len_min    = d->pause_0_len_min;
+        param_p->pause_0_len_max    = d->pause_0_len_max;
+        param_p->address_offset     = d->address_offset;
+        param_p->address_end        = d->address_end;
+        param_p->command_offset     = d->command_offset;
+        param_p->command_end        = d->command_end;
+        param_p->complete_len       = d->complete_len;
+        param_p->stop_bit           = d->stop_bit;
+        param_p->lsb_first          = d->lsb_first;
+        param_p->flags              = 0;                                    // pulse distance or pulse width only
+
+        start_bit_p->pulse_min      = d->start_pulse_len_min;
+        start_bit_p->pulse_max      = d->start_pulse_len_max;
+        start_bit_p->pause_min      = d->start_pause_len_min;
+        start_bit_p->pause_max      = d->start_pause_len_max;
+        start_bit_p->flags          = IRMP_START_BIT_FLAG_DYNAMIC;
+        start_bit_p->param_p        = param_p;
+    }
 
-#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
-static uint_fast8_t  parity;                                                // number of '1' of the first 14 bits, check if even.
-#endif
+    irmp_start_bit_init ();
+    return valid;
+}
+#endif // IRMP_DYNAMIC_PROTOCOLS > 0
+
+#if IRMP_LEARNED_WINDOWS > 0
+#define IRMP_LEARNED_WINDOW(min, max, lo, hi)   { if ((lo) > (int_fast16_t) (min)) (min) = (lo); if ((hi) < (int_fast16_t) (max)) (max) = (hi); }
 
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
- *  store bit
- *  @details  store bit in temp address or temp command
- *  @param    value to store: 0 or 1
+ *  Narrow data bit window
+ *  @details  keeps windows no length was measured in, e.g. pause 0 of SIRCS frames with one 0 bit, see irmp_quality_len()
+ *  @param    pointers to window limits, merged quality of the slots, window: IRMP_QUALITY_PULSE_1 ... IRMP_QUALITY_PAUSE_0
  *---------------------------------------------------------------------------------------------------------------------------------------------------
  */
-// verhindert, dass irmp_store_bit() inline compiliert wird:
-// static void irmp_store_bit (uint_fast8_t) __attribute__ ((noinline));
-
 static void
-irmp_store_bit (uint_fast8_t value)
+irmp_learned_data_window (uint_fast8_t * min_p, uint_fast8_t * max_p, const IRMP_QUALITY * m, uint_fast8_t window)
 {
-#if IRMP_SUPPORT_ACP24_PROTOCOL == 1
-    if (irmp_param.protocol == IRMP_ACP24_PROTOCOL)                                                 // squeeze 64 bits into 16 bits:
+    int_fast16_t    middle      = (*min_p + *max_p) / 2;
+    int_fast16_t    tolerance   = 1 + middle / 8;
+
+    if (m->window_min[window] <= m->window_max[window])
     {
-        if (value)
-        {
-            // ACP24-Frame:
-            //           1         2         3         4         5         6
-            // 0123456789012345678901234567890123456789012345678901234567890123456789
-            // N VVMMM    ? ???    t vmA x                 y                     TTTT
-            //
-            // irmp_data_p->command:
-            //
-            //         5432109876543210
-            //         NAVVvMMMmtxyTTTT
-
-            switch (irmp_bit)
-            {
-                case  0: irmp_tmp_command |= (1<<15); break;                                        // N
-                case  2: irmp_tmp_command |= (1<<13); break;                                        // V
-                case  3: irmp_tmp_command |= (1<<12); break;                                        // V
-                case  4: irmp_tmp_command |= (1<<10); break;                                        // M
-                case  5: irmp_tmp_command |= (1<< 9); break;                                        // M
-                case  6: irmp_tmp_command |= (1<< 8); break;                                        // M
-                case 20: irmp_tmp_command |= (1<< 6); break;                                        // t
-                case 22: irmp_tmp_command |= (1<<11); break;                                        // v
-                case 23: irmp_tmp_command |= (1<< 7); break;                                        // m
-                case 24: irmp_tmp_command |= (1<<14); break;                                        // A
-                case 26: irmp_tmp_command |= (1<< 5); break;                                        // x
-                case 44: irmp_tmp_command |= (1<< 4); break;                                        // y
-                case 66: irmp_tmp_command |= (1<< 3); break;                                        // T
-                case 67: irmp_tmp_command |= (1<< 2); break;                                        // T
-                case 68: irmp_tmp_command |= (1<< 1); break;                                        // T
-                case 69: irmp_tmp_command |= (1<< 0); break;                                        // T
-            }
-        }
+        IRMP_LEARNED_WINDOW (*min_p, *max_p, middle + m->window_min[window] - tolerance, middle + m->window_max[window] + tolerance);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Set learned windows
+ *  @details  shared by all contexts. Narrows the windows of the start bit table entry of a learned frame around the timing of its remote:
+ *            start bit pulse and pause, with pulse distance and pulse width protocols also each data bit window around its own lengths.
+ *            Slots of the same entry share windows covering all of them. The quality of a frame is measured against the windows it was
+ *            decoded with, so frames decoded with learned windows have no start bit. irmp_ISR() reads the start bit index, so call it with
+ *            interrupts disabled
+ *  @param    idx: 0 ... IRMP_LEARNED_WINDOWS - 1
+ *  @param    q: quality of the learned frame, see irmp_get_data_ex(), e.g. read from EEPROM, 0: clear slot
+ *  @return   TRUE: windows narrowed, FALSE: slot cleared, e.g. erased EEPROM, repetition frame or EEPROM of other firmware
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+uint_fast8_t
+irmp_set_learned_windows (uint_fast8_t idx, const IRMP_QUALITY * q)
+{
+    IRMP_START_BIT *    start_bit_p;
+    IRMP_PARAMETER *    param_p;
+    IRMP_QUALITY        m;
+    uint_fast8_t        start_pulse_max;
+    PAUSE_LEN           start_pause_max;
+    int_fast16_t        tolerance;
+    uint_fast8_t        valid = FALSE;
+    uint_fast8_t        i;
+    uint_fast8_t        j;
+    uint_fast8_t        w;
+
+    if (idx >= IRMP_LEARNED_WINDOWS)
+    {
+        return FALSE;
+    }
+
+    start_bit_p = irmp_learned_start_bits + idx;
+    param_p     = irmp_learned_params + idx;
+
+    if (q && q->start_bit > 0 && q->start_bit <= IRMP_START_BITS)
+    {
+        IRMP_START_BIT_ENTRY_GET (*start_bit_p, q->start_bit - 1);
+        memcpy_P (param_p, start_bit_p->param_p, sizeof (IRMP_PARAMETER));
+
+        valid = param_p->protocol == q->start_protocol &&
+                q->start_pulse >= start_bit_p->pulse_min && q->start_pulse <= start_bit_p->pulse_max &&
+                q->start_pause >= start_bit_p->pause_min && q->start_pause <= start_bit_p->pause_max;
+    }
+
+    if (valid)
+    {
+        irmp_learned_quality[idx] = *q;
     }
     else
-#endif // IRMP_SUPPORT_ACP24_PROTOCOL
+    {
+        irmp_learned_quality[idx].start_bit = 0;
+    }
 
-#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
-    if (irmp_param.protocol == IRMP_ORTEK_PROTOCOL)
+    memset (irmp_start_bit_learned, 0, sizeof (irmp_start_bit_learned));
+
+    for (i = 0; i < IRMP_LEARNED_WINDOWS; i++)
     {
-        if (irmp_bit < 14)
+        m = irmp_learned_quality[i];
+
+        if (! m.start_bit || irmp_start_bit_learned[m.start_bit - 1])      // unused or windows of entry already set
         {
-            if (value)
-            {
-                parity++;
-            }
+            continue;
         }
-        else if (irmp_bit == 14)
+
+        start_pulse_max = m.start_pulse;
+        start_pause_max = m.start_pause;
+
+        for (j = i + 1; j < IRMP_LEARNED_WINDOWS; j++)                      // ranges of all slots of the entry
         {
-            if (value)                                                                                      // value == 1: even parity
+            q = irmp_learned_quality + j;
+
+            if (q->start_bit != m.start_bit)
             {
-                if (parity & 0x01)
-                {
-                    parity = PARITY_CHECK_FAILED;
-                }
-                else
-                {
-                    parity = PARITY_CHECK_OK;
-                }
+                continue;
             }
-            else
+
+            if (m.start_pulse > q->start_pulse)
+            {
+                m.start_pulse = q->start_pulse;
+            }
+            if (start_pulse_max < q->start_pulse)
+            {
+                start_pulse_max = q->start_pulse;
+            }
+            if (m.start_pause > q->start_pause)
             {
-                if (parity & 0x01)                                                                          // value == 0: odd parity
+                m.start_pause = q->start_pause;
+            }
+            if (start_pause_max < q->start_pause)
+            {
+                start_pause_max = q->start_pause;
+            }
+            for (w = 0; w < IRMP_QUALITY_WINDOWS; w++)
+            {
+                if (m.window_min[w] > q->window_min[w])
                 {
-                    parity = PARITY_CHECK_OK;
+                    m.window_min[w] = q->window_min[w];
                 }
-                else
+                if (m.window_max[w] < q->window_max[w])
                 {
-                    parity = PARITY_CHECK_FAILED;
+                    m.window_max[w] = q->window_max[w];
                 }
             }
+            if (q->margin == 0xFF)                                          // no data bits, keep data windows
+            {
+                m.margin = 0xFF;
+            }
+        }
+
+        start_bit_p = irmp_learned_start_bits + i;
+        param_p     = irmp_learned_params + i;
+
+        IRMP_START_BIT_ENTRY_GET (*start_bit_p, m.start_bit - 1);
+        memcpy_P (param_p, start_bit_p->param_p, sizeof (IRMP_PARAMETER));
+
+        tolerance = 1 + start_pulse_max / 8 + IRMP_IDLE_DIVIDER;           // idle sampling: start pulse includes part of the idle period
+        IRMP_LEARNED_WINDOW (start_bit_p->pulse_min, start_bit_p->pulse_max, m.start_pulse - tolerance, start_pulse_max + tolerance);
+        tolerance = 1 + start_pause_max / 8;
+        IRMP_LEARNED_WINDOW (start_bit_p->pause_min, start_bit_p->pause_max, (int_fast16_t) m.start_pause - tolerance,
+                             (int_fast16_t) start_pause_max + tolerance);
+
+        if (m.margin != 0xFF && ! (param_p->flags & (IRMP_PARAM_FLAG_IS_MANCHESTER | IRMP_PARAM_FLAG_IS_SERIAL)))
+        {
+            irmp_learned_data_window (&param_p->pulse_1_len_min, &param_p->pulse_1_len_max, &m, IRMP_QUALITY_PULSE_1);
+            irmp_learned_data_window (&param_p->pause_1_len_min, &param_p->pause_1_len_max, &m, IRMP_QUALITY_PAUSE_1);
+            irmp_learned_data_window (&param_p->pulse_0_len_min, &param_p->pulse_0_len_max, &m, IRMP_QUALITY_PULSE_0);
+            irmp_learned_data_window (&param_p->pause_0_len_min, &param_p->pause_0_len_max, &m, IRMP_QUALITY_PAUSE_0);
         }
+
+        start_bit_p->flags     |= IRMP_START_BIT_FLAG_DYNAMIC;
+        start_bit_p->param_p    = param_p;
+        irmp_start_bit_learned[m.start_bit - 1] = i + 1;
     }
-    else
+
+    irmp_start_bit_init ();
+    return valid;
+}
+#endif // IRMP_LEARNED_WINDOWS > 0
+
+#if IRMP_CANDIDATES > 1
+
+#ifdef ANALYZE
+#define IRMP_CANDIDATES_LIMIT                   candidates_limit
+#else
+#define IRMP_CANDIDATES_LIMIT                   (IRMP_CANDIDATES - 1)
 #endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Collect candidates
+ *  @details  stores the parameters of other pulse distance protocols fitting the start bit, in the order of the start bit table.
+ *            Manchester and serial protocols cannot be checked bit by bit and are not collected.
+ *  @param    start bit pulse and pause length, parameters of the decoded protocol
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_start_bit_candidates (IRMP_CTX_PARAM_ uint_fast8_t pulse, PAUSE_LEN pause, const IRMP_PARAMETER * param_p)
+{
+    IRMP_START_BIT      s;
+    IRMP_CANDIDATE *    candidate_p;
+    uint_fast8_t        idx;
+    uint_fast8_t        i;
+
+#ifdef ANALYZE
+    if (candidates_forced)                                                  // benchmark: candidates which live as long as the frame
     {
-        ;
+        for (i = 0; i < candidates_forced; i++)
+        {
+            candidate_p = &irmp_candidate[i];
+            memcpy_P (&candidate_p->param, param_p, sizeof (IRMP_PARAMETER));
+            candidate_p->len = 0;
+            memset (candidate_p->bits, 0, sizeof (candidate_p->bits));
+        }
+        irmp_candidate_count = candidates_forced;
+        return;
     }
+#endif // ANALYZE
 
-#if IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
-    if (irmp_bit == 0 && irmp_param.protocol == IRMP_GRUNDIG_PROTOCOL)
+    for (idx = 0; idx < IRMP_START_BIT_ENTRIES && irmp_candidate_count < IRMP_CANDIDATES_LIMIT; idx++)
     {
-        first_bit = value;
-    }
-    else
+#if IRMP_USE_PROTOCOL_MASK == 1
+        if (IRMP_MASK_IS_SET (irmp_start_bit_disabled, idx))
+        {
+            continue;
+        }
 #endif
+        IRMP_START_BIT_GET (s, idx);
 
-    if (irmp_bit >= irmp_param.address_offset && irmp_bit < irmp_param.address_end)
-    {
-        if (irmp_param.lsb_first)
+        if ((s.flags & ~IRMP_START_BIT_FLAG_DYNAMIC) || s.param_p == param_p ||
+            pulse < s.pulse_min || pulse > s.pulse_max || pause < s.pause_min || pause > s.pause_max)
         {
-            irmp_tmp_address |= (((uint_fast16_t) (value)) << (irmp_bit - irmp_param.address_offset));   // CV wants cast
+            continue;
         }
-        else
+
+        candidate_p = &irmp_candidate[irmp_candidate_count];
+        IRMP_START_BIT_PARAM_GET (candidate_p->param, s);
+
+        if (candidate_p->param.flags & (IRMP_PARAM_FLAG_IS_MANCHESTER | IRMP_PARAM_FLAG_IS_SERIAL))
         {
-            irmp_tmp_address <<= 1;
-            irmp_tmp_address |= value;
+            continue;
         }
-    }
-    else if (irmp_bit >= irmp_param.command_offset && irmp_bit < irmp_param.command_end)
-    {
-        if (irmp_param.lsb_first)
+
+        for (i = 0; i < irmp_candidate_count && irmp_candidate[i].param.protocol != candidate_p->param.protocol; i++)
         {
-#if IRMP_SUPPORT_SAMSUNG48_PROTOCOL == 1
-            if (irmp_param.protocol == IRMP_SAMSUNG48_PROTOCOL && irmp_bit >= 32)
-            {
-                irmp_tmp_id |= (((uint_fast16_t) (value)) << (irmp_bit - 32));   // CV wants cast
-            }
-            else
-#endif
-            {
-                irmp_tmp_command |= (((uint_fast16_t) (value)) << (irmp_bit - irmp_param.command_offset));   // CV wants cast
-            }
+            ;
         }
-        else
+
+        if (i == irmp_candidate_count)                                      // not yet collected
         {
-            irmp_tmp_command <<= 1;
-            irmp_tmp_command |= value;
+            candidate_p->len = 0;
+            memset (candidate_p->bits, 0, sizeof (candidate_p->bits));
+            irmp_candidate_count++;
         }
     }
+}
+#endif // IRMP_CANDIDATES > 1
 
-#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
-    if (irmp_param.protocol == IRMP_NEC_PROTOCOL || irmp_param.protocol == IRMP_NEC42_PROTOCOL)
-    {
-        if (irmp_bit < 8)
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Look up start bit
+ *  @param    start bit pulse and pause length, pointer in order to store the start bit table entry
+ *  @return   TRUE: protocol found, FALSE: unknown start bit
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static uint_fast8_t
+irmp_start_bit_lookup (IRMP_CTX_PARAM_ uint_fast8_t pulse, PAUSE_LEN pause, IRMP_START_BIT * start_bit_p)
+{
+    IRMP_START_BIT  s;
+    uint_fast8_t    best = IRMP_START_BIT_ENTRIES;
+    uint_fast8_t    idx;
+    uint_fast8_t    i;
+
+    for (i = 0; i < irmp_start_bit_count; i++)
+    {
+        idx = irmp_start_bit_order[i];
+        IRMP_START_BIT_GET (s, idx);
+#ifdef ANALYZE
+        start_bit_table_checks++;
+#endif // ANALYZE
+
+        if (pulse < s.pulse_min)                                            // all following entries need longer pulses
         {
-            irmp_lgair_address <<= 1;                                                               // LGAIR uses MSB
-            irmp_lgair_address |= value;
+            break;
         }
-        else if (irmp_bit < 24)
+
+        if (idx < best && pulse <= s.pulse_max && pause >= s.pause_min && pause <= s.pause_max)
         {
-            irmp_lgair_command <<= 1;                                                               // LGAIR uses MSB
-            irmp_lgair_command |= value;
+#if IRMP_SUPPORT_JVC_PROTOCOL == 1
+            if ((s.flags & IRMP_START_BIT_FLAG_AFTER_JVC) && irmp_protocol != IRMP_JVC_PROTOCOL)
+            {
+                continue;
+            }
+#endif
+            best = idx;
+            *start_bit_p = s;
         }
     }
-    // NO else!
-#endif
 
-#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
-    if (irmp_param.protocol == IRMP_NEC42_PROTOCOL && irmp_bit >= 13 && irmp_bit < 26)
+#if IRMP_LEARNED_WINDOWS > 0
+    if (best < IRMP_START_BIT_ENTRIES)                                      // learned only if measured against the windows of the table
     {
-        irmp_tmp_address2 |= (((uint_fast16_t) (value)) << (irmp_bit - 13));                             // CV wants cast
+        irmp_tmp_quality.start_bit      = (best < IRMP_START_BITS && ! irmp_start_bit_learned[best]) ? best + 1 : 0;
+        irmp_tmp_quality.start_pulse    = pulse;
+        irmp_tmp_quality.start_pause    = pause;
     }
-    else
 #endif
 
-#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
-    if (irmp_param.protocol == IRMP_SAMSUNG_PROTOCOL && irmp_bit >= SAMSUNG_ID_OFFSET && irmp_bit < SAMSUNG_ID_OFFSET + SAMSUNG_ID_LEN)
+#if IRMP_CANDIDATES > 1
+    irmp_candidate_count = 0;
+
+    if (best < IRMP_START_BIT_ENTRIES)
     {
-        irmp_tmp_id |= (((uint_fast16_t) (value)) << (irmp_bit - SAMSUNG_ID_OFFSET));                    // store with LSB first
+        irmp_start_bit_candidates (IRMP_CTX_ARG_ pulse, pause, start_bit_p->param_p);
     }
-    else
 #endif
 
-#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
-    if (irmp_param.protocol == IRMP_KASEIKYO_PROTOCOL)
-    {
-        if (irmp_bit >= 20 && irmp_bit < 24)
-        {
-            irmp_tmp_command |= (((uint_fast16_t) (value)) << (irmp_bit - 8));       // store 4 system bits (genre 1) in upper nibble with LSB first
-        }
-        else if (irmp_bit >= 24 && irmp_bit < 28)
-        {
-            genre2 |= (((uint_fast8_t) (value)) << (irmp_bit - 20));                 // store 4 system bits (genre 2) in upper nibble with LSB first
-        }
+    return (best < IRMP_START_BIT_ENTRIES) ? TRUE : FALSE;
+}
 
-        if (irmp_bit < KASEIKYO_COMPLETE_DATA_LEN)
-        {
-            if (value)
-            {
-                xor_check[irmp_bit / 8] |= 1 << (irmp_bit % 8);
-            }
-            else
-            {
-                xor_check[irmp_bit / 8] &= ~(1 << (irmp_bit % 8));
-            }
-        }
-    }
-    else
-#endif
-    {
-        ;
-    }
+#endif // IRMP_USE_START_BIT_TABLE == 1
 
-    irmp_bit++;
+#if IRMP_USE_CONTEXT == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Initialize IRMP decoder context
+ *  @details  resets the decoder state of one IR receiver. Call irmp_init() once before.
+ *  @param    pointer to context
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+void
+irmp_init_ctx (IRMP_CONTEXT * ctx)
+{
+    memset (ctx, 0, sizeof (IRMP_CONTEXT));
+
+    last_irmp_address       = 0xFFFF;                                   // same initial values as irmp_context
+    last_irmp_command       = 0xFFFF;
+#if IRMP_SUPPORT_DENON_PROTOCOL == 1
+    irmp_denon_repetition_len = 0xFFFF;
+#endif
+#if IRMP_USE_EDGE_ISR == 1
+    irmp_last_input         = 1;
+#endif
 }
+#endif // IRMP_USE_CONTEXT == 1
+
+#if IRMP_CHANNEL_MASK != 0x00
+static IRMP_CONTEXT                             irmp_channel_context[IRMP_CHANNELS];        // context of each IR input, ordered by bit number
+static uint_fast16_t                            irmp_channel_last_call[IRMP_CHANNELS];      // irmp_channel_ticks at last call of irmp_ISR_edge_ctx()
+static uint_fast16_t                            irmp_channel_ticks;                         // ticks, counted by irmp_ISR_multi()
+static uint_fast16_t                            irmp_channel_timeout;                       // ticks until next input must be called
+static uint_fast8_t                             irmp_channel_timeout_bit;                   // port bit of input called at last timeout
+static uint_fast8_t                             irmp_channel_last_port;                     // port bits at last call of irmp_ISR_multi()
 
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
- *  store bit
- *  @details  store bit in temp address or temp command
- *  @param    value to store: 0 or 1
+ *  Initialize contexts of all IR inputs
  *---------------------------------------------------------------------------------------------------------------------------------------------------
  */
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
 static void
-irmp_store_bit2 (uint_fast8_t value)
+irmp_channel_init (void)
 {
-    uint_fast8_t irmp_bit2;
+    uint_fast8_t    i;
 
-    if (irmp_param.protocol)
+    for (i = 0; i < IRMP_CHANNELS; i++)
     {
-        irmp_bit2 = irmp_bit - 2;
-    }
-    else
-    {
-        irmp_bit2 = irmp_bit - 1;
+        irmp_init_ctx (irmp_channel_context + i);
+        irmp_channel_last_call[i] = 0;
     }
 
-    if (irmp_bit2 >= irmp_param2.address_offset && irmp_bit2 < irmp_param2.address_end)
-    {
-        irmp_tmp_address2 |= (((uint_fast16_t) (value)) << (irmp_bit2 - irmp_param2.address_offset));   // CV wants cast
-    }
-    else if (irmp_bit2 >= irmp_param2.command_offset && irmp_bit2 < irmp_param2.command_end)
-    {
-        irmp_tmp_command2 |= (((uint_fast16_t) (value)) << (irmp_bit2 - irmp_param2.command_offset));   // CV wants cast
-    }
+    irmp_channel_ticks          = 0;
+    irmp_channel_timeout        = IRMP_EDGE_TIMEOUT_LEN / IRMP_CHANNELS;
+    irmp_channel_timeout_bit    = 0x00;
+    irmp_channel_last_port      = IRMP_CHANNEL_MASK;                        // all inputs dark
 }
-#endif // IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
+#endif // IRMP_CHANNEL_MASK != 0x00
 
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
- *  ISR routine
- *  @details  ISR routine, called 10000 times per second
+ *  Initialize IRMP decoder
+ *  @details  Configures IRMP input pin
  *---------------------------------------------------------------------------------------------------------------------------------------------------
  */
-uint_fast8_t
-irmp_ISR (void)
+#ifndef ANALYZE
+void
+irmp_init (void)
 {
-    static uint_fast8_t     irmp_start_bit_detected;                                // flag: start bit detected
-    static uint_fast8_t     wait_for_space;                                         // flag: wait for data bit space
-    static uint_fast8_t     wait_for_start_space;                                   // flag: wait for start bit space
-    static uint_fast8_t     irmp_pulse_time;                                        // count bit time for pulse
-    static PAUSE_LEN        irmp_pause_time;                                        // count bit time for pause
-    static uint_fast16_t    last_irmp_address = 0xFFFF;                             // save last irmp address to recognize key repetition
-    static uint_fast16_t    last_irmp_command = 0xFFFF;                             // save last irmp command to recognize key repetition
-    static uint_fast16_t    key_repetition_len;                                     // SIRCS repeats frame 2-5 times with 45 ms pause
-    static uint_fast8_t     repetition_frame_number;
-#if IRMP_SUPPORT_DENON_PROTOCOL == 1
-    static uint_fast16_t    last_irmp_denon_command;                                // save last irmp command to recognize DENON frame repetition
-    static uint_fast16_t    denon_repetition_len = 0xFFFF;                          // denon repetition len of 2nd auto generated frame
+#if defined(PIC_CCS) || defined(PIC_C18)                                // PIC: do nothing
+#elif defined (ARM_STM32)                                               // STM32
+    GPIO_InitTypeDef     GPIO_InitStructure;
+
+    /* GPIOx clock enable */
+#  if defined (ARM_STM32L1XX)
+    RCC_AHBPeriphClockCmd(IRMP_PORT_RCC, ENABLE);
+#  elif defined (ARM_STM32F10X)
+    RCC_APB2PeriphClockCmd(IRMP_PORT_RCC, ENABLE);
+#  elif defined (ARM_STM32F4XX)
+    RCC_AHB1PeriphClockCmd(IRMP_PORT_RCC, ENABLE);
+#  endif
+
+    /* GPIO Configuration */
+    GPIO_InitStructure.GPIO_Pin = IRMP_BIT;
+#  if defined (ARM_STM32L1XX) || defined (ARM_STM32F4XX)
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_2MHz;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL;
+#  elif defined (ARM_STM32F10X)
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_2MHz;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
+#  endif
+    GPIO_Init(IRMP_PORT, &GPIO_InitStructure);
+
+#elif defined(STELLARIS_ARM_CORTEX_M4)
+    // Enable the GPIO port
+    ROM_SysCtlPeripheralEnable(IRMP_PORT_PERIPH);
+
+    // Set as an input
+    ROM_GPIODirModeSet(IRMP_PORT_BASE, IRMP_PORT_PIN, GPIO_DIR_MODE_IN);
+    ROM_GPIOPadConfigSet(IRMP_PORT_BASE, IRMP_PORT_PIN, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+
+#elif defined(__SDCC_stm8)                                              // STM8
+    IRMP_GPIO_STRUCT->DDR &= ~(1<<IRMP_BIT);                            // pin is input
+    IRMP_GPIO_STRUCT->CR1 |= (1<<IRMP_BIT);                             // activate pullup
+
+#elif defined (TEENSY_ARM_CORTEX_M4)                                    // TEENSY
+    pinMode(IRMP_PIN, INPUT);
+
+#else                                                                   // AVR
+#  if IRMP_CHANNEL_MASK != 0x00
+    IRMP_PORT &= ~IRMP_CHANNEL_MASK;                                    // deactivate pullups
+    IRMP_DDR &= ~IRMP_CHANNEL_MASK;                                     // set pins to input
+#  else
+    IRMP_PORT &= ~(1<<IRMP_BIT);                                        // deactivate pullup
+    IRMP_DDR &= ~(1<<IRMP_BIT);                                         // set pin to input
+#  endif
 #endif
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 || IRMP_SUPPORT_S100_PROTOCOL == 1
-    static uint_fast8_t     rc5_cmd_bit6;                                           // bit 6 of RC5 command is the inverted 2nd start bit
+
+#if IRMP_LOGGING == 1
+    irmp_uart_init ();
 #endif
-#if IRMP_SUPPORT_MANCHESTER == 1
-    static PAUSE_LEN        last_pause;                                             // last pause value
+
+#if IRMP_USE_START_BIT_TABLE == 1
+    irmp_start_bit_init ();
 #endif
-#if IRMP_SUPPORT_MANCHESTER == 1 || IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
-    static uint_fast8_t     last_value;                                             // last bit value
+
+#if IRMP_CHANNEL_MASK != 0x00
+    irmp_channel_init ();
+#endif
+}
 #endif
-    uint_fast8_t            irmp_input;                                             // input value
 
-#ifdef ANALYZE
-    time_counter++;
-#endif // ANALYZE
+#if IRMP_ADDRESS_FILTER_LEN > 0
+typedef struct
+{
+    uint8_t                             protocol;                                   // protocol, 0: unused
+    uint16_t                            address;                                    // address
+} IRMP_ADDRESS_FILTER;
 
-#if defined(__SDCC_stm8)
-    irmp_input = input(IRMP_GPIO_STRUCT->IDR)
-#else
-    irmp_input = input(IRMP_PIN);
-#endif
+static IRMP_ADDRESS_FILTER  irmp_address_filter_list[IRMP_ADDRESS_FILTER_LEN];      // accepted remotes, empty list: accept all
 
-#if IRMP_USE_CALLBACK == 1
-    if (irmp_callback_ptr)
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Set address filter
+ *  @details  only frames of a remote in the list are detected, the list is shared by all contexts.
+ *            irmp_ISR() reads it, so change it with interrupts disabled
+ *  @param    idx: 0 ... IRMP_ADDRESS_FILTER_LEN - 1
+ *  @param    protocol: protocol of remote, 0 clears the entry
+ *  @param    address: address of remote, as returned by irmp_get_data()
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+void
+irmp_set_address_filter (uint_fast8_t idx, uint_fast8_t protocol, uint_fast16_t address)
+{
+    if (idx < IRMP_ADDRESS_FILTER_LEN)
     {
-        static uint_fast8_t last_inverted_input;
+        irmp_address_filter_list[idx].protocol = protocol;
+        irmp_address_filter_list[idx].address  = address;
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Check address filter
+ *  @return   TRUE: remote is in list or list is empty, FALSE: foreign remote
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static uint_fast8_t
+irmp_address_filter_pass (uint_fast8_t protocol, uint_fast16_t address)
+{
+    uint_fast8_t    used = FALSE;
+    uint_fast8_t    i;
 
-        if (last_inverted_input != !irmp_input)
+    for (i = 0; i < IRMP_ADDRESS_FILTER_LEN; i++)
+    {
+        if (irmp_address_filter_list[i].protocol)
         {
-            (*irmp_callback_ptr) (! irmp_input);
-            last_inverted_input = !irmp_input;
+            if (irmp_address_filter_list[i].protocol == protocol && irmp_address_filter_list[i].address == address)
+            {
+                return TRUE;
+            }
+            used = TRUE;
         }
     }
-#endif // IRMP_USE_CALLBACK == 1
+    return ! used;
+}
+#endif // IRMP_ADDRESS_FILTER_LEN > 0
 
-    irmp_log(irmp_input);                                                       // log ir signal, if IRMP_LOGGING defined
+#if IRMP_FAST_NEC == 1
+static uint_fast8_t         irmp_nec42_expected = TRUE;                             // FALSE: finish NEC frames right after stop bit
 
-    if (! irmp_ir_detected)                                                     // ir code already detected?
-    {                                                                           // no...
-        if (! irmp_start_bit_detected)                                          // start bit detected?
-        {                                                                       // no...
-            if (! irmp_input)                                                   // receiving burst?
-            {                                                                   // yes...
-//              irmp_busy_flag = TRUE;
-#ifdef ANALYZE
-                if (! irmp_pulse_time)
-                {
-                    ANALYZE_PRINTF("%8.3fms [starting pulse]\n", (double) (time_counter * 1000) / F_INTERRUPTS);
-                }
-#endif // ANALYZE
-                irmp_pulse_time++;                                              // increment counter
-            }
-            else
-            {                                                                   // no...
-                if (irmp_pulse_time)                                            // it's dark....
-                {                                                               // set flags for counting the time of darkness...
-                    irmp_start_bit_detected = 1;
-                    wait_for_start_space    = 1;
-                    wait_for_space          = 0;
-                    irmp_tmp_command        = 0;
-                    irmp_tmp_address        = 0;
-#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
-                    genre2                  = 0;
-#endif
-#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
-                    irmp_tmp_id = 0;
-#endif
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Set NEC42 expectation
+ *  @details  shared by all contexts. TRUE: a NEC frame is finished when the pause after its stop bit is too long for a NEC42 data bit,
+ *            FALSE: at once after the stop bit, 33rd and further bits of NEC42 frames are lost then
+ *  @param    expected: TRUE if NEC42 remotes are used or unknown (default), else FALSE
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+void
+irmp_set_nec42_expected (uint_fast8_t expected)
+{
+    irmp_nec42_expected = expected;
+}
+#endif // IRMP_FAST_NEC == 1
 
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1) || IRMP_SUPPORT_NEC42_PROTOCOL == 1
-                    irmp_tmp_command2       = 0;
-                    irmp_tmp_address2       = 0;
-#endif
-#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
-                    irmp_lgair_command      = 0;
-                    irmp_lgair_address      = 0;
-#endif
-                    irmp_bit                = 0xff;
-                    irmp_pause_time         = 1;                                // 1st pause: set to 1, not to 0!
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 || IRMP_SUPPORT_S100_PROTOCOL == 1
-                    rc5_cmd_bit6            = 0;                                // fm 2010-03-07: bugfix: reset it after incomplete RC5 frame!
-#endif
-                }
-                else
-                {
-                    if (key_repetition_len < 0xFFFF)                            // avoid overflow of counter
-                    {
-                        key_repetition_len++;
+static uint_fast16_t        irmp_key_repetition_len = IRMP_KEY_REPETITION_LEN;      // key repetition window in ticks
 
-#if IRMP_SUPPORT_DENON_PROTOCOL == 1
-                        if (denon_repetition_len < 0xFFFF)                      // avoid overflow of counter
-                        {
-                            denon_repetition_len++;
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Set key repetition window
+ *  @details  shared by all contexts. A frame of the same key within len ticks after the frame before is flagged with IRMP_FLAG_REPETITION,
+ *            with IRMP_USE_KEY_RELEASE the key is released after len ticks without frame. irmp_ISR() reads it, so change it with
+ *            interrupts disabled
+ *  @param    len: window in ticks (1/F_INTERRUPTS sec), default is IRMP_KEY_REPETITION_LEN (150 ms)
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+void
+irmp_set_key_repetition_len (uint_fast16_t len)
+{
+    irmp_key_repetition_len = len;
+}
+
+#if IRMP_GLITCH_FILTER_LEN > 0
+static uint_fast8_t         irmp_glitch_filter_len = IRMP_GLITCH_FILTER_LEN;        // samples a level must last
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Set glitch filter
+ *  @details  shared by all contexts, irmp_ISR() reads it
+ *  @param    len: samples a new input level must last until the decoder sees it, 0 or 1: filter off
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+void
+irmp_set_glitch_filter (uint_fast8_t len)
+{
+    irmp_glitch_filter_len = len;
+}
+#endif // IRMP_GLITCH_FILTER_LEN > 0
 
-                            if (denon_repetition_len >= DENON_AUTO_REPETITION_PAUSE_LEN && last_irmp_denon_command != 0)
-                            {
 #ifdef ANALYZE
-                                ANALYZE_PRINTF ("%8.3fms warning: did not receive inverted command repetition\n",
-                                                (double) (time_counter * 1000) / F_INTERRUPTS);
-#endif // ANALYZE
-                                last_irmp_denon_command = 0;
-                                denon_repetition_len = 0xFFFF;
-                            }
-                        }
-#endif // IRMP_SUPPORT_DENON_PROTOCOL == 1
-                    }
-                }
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Print trace event as text of the analyzer
+ *  @details  host text formatter, called by irmp_trace(). Rebuilds the lines of ./irmp -v and the data bits of the normal output from
+ *            the entry alone, e.g. the data bit number and pulse of IRMP_TRACE_BIT_TIMING are taken from entry_p->bit and entry_p->pulse
+ *  @param    pointer to event
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_trace_text (const IRMP_TRACE_ENTRY * entry_p)
+{
+    static const char * const   error_variants[] = { "", " manchester", " Samsung", "a B&O", "b B&O", "c B&O", "d B&O" };   // error 3
+
+    switch (entry_p->event)
+    {
+        case IRMP_TRACE_PULSE:
+            ANALYZE_PRINTF ("%8.3fms [starting pulse]\n", (double) (time_counter * 1000) / F_INTERRUPTS);
+            break;
+
+        case IRMP_TRACE_START_BIT:
+            ANALYZE_PRINTF ("%8.3fms [start-bit: pulse = %2d, pause = %2d]\n", (double) (time_counter * 1000) / F_INTERRUPTS, entry_p->arg, entry_p->value);
+            break;
+
+        case IRMP_TRACE_BIT_TIMING:
+            ANALYZE_PRINTF ("%8.3fms [bit %2d: pulse = %3d, pause = %3d] ", (double) (time_counter * 1000) / F_INTERRUPTS, entry_p->bit, entry_p->pulse, entry_p->value);
+            break;
+
+        case IRMP_TRACE_BIT:
+            if (entry_p->arg)
+            {
+                ANALYZE_PUTCHAR (entry_p->arg);
             }
-        }
-        else
-        {
-            if (wait_for_start_space)                                           // we have received start bit...
-            {                                                                   // ...and are counting the time of darkness
-                if (irmp_input)                                                 // still dark?
-                {                                                               // yes
-                    irmp_pause_time++;                                          // increment counter
+            if (entry_p->value)
+            {
+                ANALYZE_NEWLINE ();
+            }
+            break;
 
-#if IRMP_SUPPORT_NIKON_PROTOCOL == 1
-                    if (((irmp_pulse_time < NIKON_START_BIT_PULSE_LEN_MIN || irmp_pulse_time > NIKON_START_BIT_PULSE_LEN_MAX) && irmp_pause_time > IRMP_TIMEOUT_LEN) ||
-                         irmp_pause_time > IRMP_TIMEOUT_NIKON_LEN)
+        case IRMP_TRACE_ERROR:
+            switch (entry_p->arg & 0x0F)
+            {
+                case 1:
+                    ANALYZE_PRINTF ("%8.3fms error 1: pause after start bit pulse %d too long: %d\n", (double) (time_counter * 1000) / F_INTERRUPTS, entry_p->pulse, entry_p->value);
+                    break;
+                case 2:
+                    ANALYZE_PRINTF ("error 2: pause %d after data bit %d too long\n", entry_p->value, entry_p->bit);
+                    break;
+                case 3:
+                    ANALYZE_PRINTF ("error 3%s: timing not correct: data bit %d,  pulse: %d, pause: %d\n", error_variants[entry_p->arg >> 4], entry_p->bit, entry_p->pulse, entry_p->value);
+                    break;
+                case 4:
+                    ANALYZE_PRINTF ("error 4: wrong XOR check for customer id: 0x%1x 0x%1x\n", entry_p->value >> 8, entry_p->value & 0xFF);
+                    break;
+                case 5:
+                    ANALYZE_PRINTF ("error 5: wrong XOR check for data bits: 0x%02x 0x%02x\n", entry_p->value >> 8, entry_p->value & 0xFF);
+                    break;
+                case 6:
+                    ANALYZE_PRINTF ("error 6: parity check failed\n");
+                    break;
+                case 8:
+                    ANALYZE_PRINTF ("error 8: TECHNICS frame error\n");
+                    break;
+            }
+
+            if ((entry_p->arg & 0x0F) <= 3 || (entry_p->arg & 0x0F) == 8)                 // frame aborted while receiving data bits
+            {
+                ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
+            }
+            break;
+    }
+}
+#endif // ANALYZE
+
+#if IRMP_TRACE_LEN > 0 || defined (ANALYZE)
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Put trace event into trace buffer
+ *  @details  called by irmp_ISR() only, see IRMP_TRACE(). If the buffer is full, the event is lost. The analyzer prints the event, too
+ *  @param    event, e.g. IRMP_TRACE_ERROR, and its values
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_trace (IRMP_CTX_PARAM_ uint_fast8_t event, uint_fast8_t arg, uint_fast16_t value)
+{
+    IRMP_TRACE_ENTRY    entry;
+
+#if IRMP_USE_TIMESTAMP == 1
+    entry.ticks = irmp_ticks;
 #else
-                    if (irmp_pause_time > IRMP_TIMEOUT_LEN)                     // timeout?
+    entry.ticks = 0;
 #endif
-                    {                                                           // yes...
-#if IRMP_SUPPORT_JVC_PROTOCOL == 1
-                        if (irmp_protocol == IRMP_JVC_PROTOCOL)                 // don't show eror if JVC protocol, irmp_pulse_time has been set below!
-                        {
-                            ;
-                        }
-                        else
-#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
-                        {
+    entry.event = event;
+    entry.arg   = arg;
+    entry.value = value;
+    entry.bit   = irmp_bit;
+    entry.pulse = irmp_pulse_time;
+
 #ifdef ANALYZE
-                            ANALYZE_PRINTF ("%8.3fms error 1: pause after start bit pulse %d too long: %d\n", (double) (time_counter * 1000) / F_INTERRUPTS, irmp_pulse_time, irmp_pause_time);
-                            ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
-#endif // ANALYZE
-                        }
+    irmp_trace_text (&entry);
+#endif
 
-                        irmp_start_bit_detected = 0;                            // reset flags, let's wait for another start bit
-                        irmp_pulse_time         = 0;
-                        irmp_pause_time         = 0;
-                    }
+#if IRMP_TRACE_LEN > 0
+#if IRMP_TRACE_DETAIL == 0
+    if (event < IRMP_TRACE_PULSE)                                                   // analyzer: no detail events in buffer
+#endif
+    {
+        if ((uint8_t) (irmp_trace_write - irmp_trace_read) < IRMP_TRACE_LEN)
+        {
+            irmp_trace_buf[irmp_trace_write & (IRMP_TRACE_LEN - 1)] = entry;
+            irmp_trace_write++;                                                     // publish event after it is stored
+        }
+    }
+#endif
+}
+#endif // IRMP_TRACE_LEN > 0 || defined (ANALYZE)
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Get IRMP data
+ *  @details  gets decoded IRMP data, irmp_get_data_ctx() gets it from context ctx
+ *            with IRMP_QUEUE_LEN, irmp_get_frame() gets the frame in irmp_ISR() and puts it into the queue, see irmp_queue_put()
+ *  @param    pointer in order to store IRMP data
+ *  @return    TRUE: successful, FALSE: failed
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#if IRMP_QUEUE_LEN > 0
+static uint_fast8_t
+irmp_get_frame (IRMP_CTX_PARAM_ IRMP_DATA * irmp_data_p)
+#elif IRMP_USE_CONTEXT == 1
+uint_fast8_t
+irmp_get_data_ctx (IRMP_CONTEXT * ctx, IRMP_DATA * irmp_data_p)
+#else
+uint_fast8_t
+irmp_get_data (IRMP_DATA * irmp_data_p)
+#endif
+{
+    uint_fast8_t   rtc = FALSE;
+
+    if (irmp_ir_detected)
+    {
+#if IRMP_USE_KEY_RELEASE == 1
+        if (irmp_flags & IRMP_FLAG_RELEASE)                         // key of a returned frame, already converted, see irmp_key_release()
+        {
+            rtc = TRUE;
+        }
+        else
+#endif
+        switch (irmp_protocol)
+        {
+#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+            case IRMP_SAMSUNG_PROTOCOL:
+                if ((irmp_command >> 8) == (~irmp_command & 0x00FF))
+                {
+                    irmp_command &= 0xff;
+                    irmp_command |= irmp_id << 8;
+                    rtc = TRUE;
                 }
-                else
-                {                                                               // receiving first data pulse!
-                    IRMP_PARAMETER * irmp_param_p;
-                    irmp_param_p = (IRMP_PARAMETER *) 0;
+                break;
 
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
-                    irmp_param2.protocol = 0;
+#if IRMP_SUPPORT_SAMSUNG48_PROTOCOL == 1
+            case IRMP_SAMSUNG48_PROTOCOL:
+                irmp_command = (irmp_command & 0x00FF) | ((irmp_id & 0x00FF) << 8);
+                rtc = TRUE;
+                break;
+#endif
 #endif
 
+#if IRMP_SUPPORT_NEC_PROTOCOL == 1
+            case IRMP_NEC_PROTOCOL:
+                if ((irmp_command >> 8) == (~irmp_command & 0x00FF))
+                {
+                    irmp_command &= 0xff;
+                    rtc = TRUE;
+                }
+                else if (irmp_address == 0x87EE)
+                {
 #ifdef ANALYZE
-                    ANALYZE_PRINTF ("%8.3fms [start-bit: pulse = %2d, pause = %2d]\n", (double) (time_counter * 1000) / F_INTERRUPTS, irmp_pulse_time, irmp_pause_time);
+                    ANALYZE_PRINTF ("Switching to APPLE protocol\n");
 #endif // ANALYZE
-
-#if IRMP_SUPPORT_SIRCS_PROTOCOL == 1
-                    if (irmp_pulse_time >= SIRCS_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= SIRCS_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= SIRCS_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= SIRCS_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's SIRCS
+                    irmp_protocol = IRMP_APPLE_PROTOCOL;
+                    irmp_address = (irmp_command & 0xFF00) >> 8;
+                    irmp_command &= 0x00FF;
+                    rtc = TRUE;
+                }
+                break;
+#endif
+#if IRMP_SUPPORT_BOSE_PROTOCOL == 1
+            case IRMP_BOSE_PROTOCOL:
+                if ((irmp_command >> 8) == (~irmp_command & 0x00FF))
+                {
+                    irmp_command &= 0xff;
+                    rtc = TRUE;
+                }
+                break;
+#endif
+#if IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1
+            case IRMP_SIEMENS_PROTOCOL:
+            case IRMP_RUWIDO_PROTOCOL:
+                if (((irmp_command >> 1) & 0x0001) == (~irmp_command & 0x0001))
+                {
+                    irmp_command >>= 1;
+                    rtc = TRUE;
+                }
+                break;
+#endif
+#if IRMP_SUPPORT_KATHREIN_PROTOCOL == 1
+            case IRMP_KATHREIN_PROTOCOL:
+                if (irmp_command != 0x0000)
+                {
+                    rtc = TRUE;
+                }
+                break;
+#endif
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1
+            case IRMP_RC5_PROTOCOL:
+                irmp_address &= ~0x20;                              // clear toggle bit
+                rtc = TRUE;
+                break;
+#endif
+#if IRMP_SUPPORT_S100_PROTOCOL == 1
+            case IRMP_S100_PROTOCOL:
+                irmp_address &= ~0x20;                              // clear toggle bit
+                rtc = TRUE;
+                break;
+#endif
+#if IRMP_SUPPORT_IR60_PROTOCOL == 1
+            case IRMP_IR60_PROTOCOL:
+                if (irmp_command != 0x007d)                         // 0x007d (== 62<<1 + 1) is start instruction frame
+                {
+                    rtc = TRUE;
+                }
+                else
+                {
 #ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = SIRCS, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        SIRCS_START_BIT_PULSE_LEN_MIN, SIRCS_START_BIT_PULSE_LEN_MAX,
-                                        SIRCS_START_BIT_PAUSE_LEN_MIN, SIRCS_START_BIT_PAUSE_LEN_MAX);
+                    ANALYZE_PRINTF("Info IR60: got start instruction frame\n");
 #endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &sircs_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_SIRCS_PROTOCOL == 1
+                }
+                break;
+#endif
+#if IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+            case IRMP_RCCAR_PROTOCOL:                           // address and command already reshuffled by rccar_remap[]
+                rtc = TRUE;
+                break;
+#endif
 
-#if IRMP_SUPPORT_JVC_PROTOCOL == 1
-                    if (irmp_protocol == IRMP_JVC_PROTOCOL &&                                                       // last protocol was JVC, awaiting repeat frame
-                        irmp_pulse_time >= JVC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= JVC_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= JVC_REPEAT_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= JVC_REPEAT_START_BIT_PAUSE_LEN_MAX)
+#if IRMP_SUPPORT_NETBOX_PROTOCOL == 1                           // squeeze code to 8 bit, upper bit indicates release-key
+            case IRMP_NETBOX_PROTOCOL:
+                if (irmp_command & 0x1000)                      // last bit set?
+                {
+                    if ((irmp_command & 0x1f) == 0x15)          // key pressed: 101 01 (LSB)
                     {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = NEC or JVC (type 1) repeat frame, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        JVC_START_BIT_PULSE_LEN_MIN, JVC_START_BIT_PULSE_LEN_MAX,
-                                        JVC_REPEAT_START_BIT_PAUSE_LEN_MIN, JVC_REPEAT_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &nec_param;
+                        irmp_command >>= 5;
+                        irmp_command &= 0x7F;
+                        rtc = TRUE;
+                    }
+                    else if ((irmp_command & 0x1f) == 0x10)     // key released: 000 01 (LSB)
+                    {
+                        irmp_command >>= 5;
+                        irmp_command |= 0x80;
+                        rtc = TRUE;
                     }
                     else
-#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
-
-#if IRMP_SUPPORT_NEC_PROTOCOL == 1
-                    if (irmp_pulse_time >= NEC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= NEC_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= NEC_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NEC_START_BIT_PAUSE_LEN_MAX)
                     {
-#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = NEC42, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX,
-                                        NEC_START_BIT_PAUSE_LEN_MIN, NEC_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &nec42_param;
-#else
 #ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = NEC, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX,
-                                        NEC_START_BIT_PAUSE_LEN_MIN, NEC_START_BIT_PAUSE_LEN_MAX);
+                        ANALYZE_PRINTF("error NETBOX: bit6/7 must be 0/1\n");
 #endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &nec_param;
-#endif
                     }
-                    else if (irmp_pulse_time >= NEC_START_BIT_PULSE_LEN_MIN        && irmp_pulse_time <= NEC_START_BIT_PULSE_LEN_MAX &&
-                             irmp_pause_time >= NEC_REPEAT_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NEC_REPEAT_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's NEC
-#if IRMP_SUPPORT_JVC_PROTOCOL == 1
-                        if (irmp_protocol == IRMP_JVC_PROTOCOL)                 // last protocol was JVC, awaiting repeat frame
-                        {                                                       // some jvc remote controls use nec repetition frame for jvc repetition frame
+                }
+                else
+                {
 #ifdef ANALYZE
-                            ANALYZE_PRINTF ("protocol = JVC repeat frame type 2, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                            NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX,
-                                            NEC_REPEAT_START_BIT_PAUSE_LEN_MIN, NEC_REPEAT_START_BIT_PAUSE_LEN_MAX);
+                    ANALYZE_PRINTF("error NETBOX: last bit not set\n");
 #endif // ANALYZE
-                            irmp_param_p = (IRMP_PARAMETER *) &nec_param;
-                        }
-                        else
-#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("protocol = NEC (repetition frame), start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                            NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX,
-                                            NEC_REPEAT_START_BIT_PAUSE_LEN_MIN, NEC_REPEAT_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-
-                            irmp_param_p = (IRMP_PARAMETER *) &nec_rep_param;
-                        }
-                    }
-                    else
+                }
+                break;
+#endif
+#if IRMP_SUPPORT_LEGO_PROTOCOL == 1
+            case IRMP_LEGO_PROTOCOL:
+            {
+                uint_fast8_t crc = 0x0F ^ ((irmp_command & 0xF000) >> 12) ^ ((irmp_command & 0x0F00) >> 8) ^ ((irmp_command & 0x00F0) >> 4);
 
-#if IRMP_SUPPORT_JVC_PROTOCOL == 1
-                    if (irmp_protocol == IRMP_JVC_PROTOCOL &&                   // last protocol was JVC, awaiting repeat frame
-                        irmp_pulse_time >= NEC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= NEC_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= NEC_0_PAUSE_LEN_MIN         && irmp_pause_time <= NEC_0_PAUSE_LEN_MAX)
-                    {                                                           // it's JVC repetition type 3
+                if ((irmp_command & 0x000F) == crc)
+                {
+                    irmp_command >>= 4;
+                    rtc = TRUE;
+                }
+                else
+                {
 #ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = JVC repeat frame type 3, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX,
-                                        NEC_0_PAUSE_LEN_MIN, NEC_0_PAUSE_LEN_MAX);
+                    ANALYZE_PRINTF ("CRC error in LEGO protocol\n");
 #endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &nec_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
+                    // rtc = TRUE;                              // don't accept codes with CRC errors
+                }
+                break;
+            }
+#endif
 
-#endif // IRMP_SUPPORT_NEC_PROTOCOL == 1
+            default:
+            {
+                rtc = TRUE;
+                break;
+            }
+        }
 
-#if IRMP_SUPPORT_TELEFUNKEN_PROTOCOL == 1
-                    if (irmp_pulse_time >= TELEFUNKEN_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= TELEFUNKEN_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= TELEFUNKEN_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= TELEFUNKEN_START_BIT_PAUSE_LEN_MAX)
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = TELEFUNKEN, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        TELEFUNKEN_START_BIT_PULSE_LEN_MIN, TELEFUNKEN_START_BIT_PULSE_LEN_MAX,
-                                        TELEFUNKEN_START_BIT_PAUSE_LEN_MIN, TELEFUNKEN_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &telefunken_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_TELEFUNKEN_PROTOCOL == 1
+        if (! rtc)
+        {
+            IRMP_COUNT (check);
+        }
 
-#if IRMP_SUPPORT_ROOMBA_PROTOCOL == 1
-                    if (irmp_pulse_time >= ROOMBA_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= ROOMBA_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= ROOMBA_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= ROOMBA_START_BIT_PAUSE_LEN_MAX)
-                    {
+#if IRMP_USE_PROTOCOL_MASK == 1
+        if (rtc && IRMP_MASK_IS_SET (irmp_protocol_disabled, irmp_protocol))
+        {
 #ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = ROOMBA, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        ROOMBA_START_BIT_PULSE_LEN_MIN, ROOMBA_START_BIT_PULSE_LEN_MAX,
-                                        ROOMBA_START_BIT_PAUSE_LEN_MIN, ROOMBA_START_BIT_PAUSE_LEN_MAX);
+            ANALYZE_PRINTF ("protocol mask: frame of disabled protocol ignored, protocol = %d\n", irmp_protocol);
 #endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &roomba_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_ROOMBA_PROTOCOL == 1
+            IRMP_COUNT (disabled);
+            irmp_flags  = 0;
+            rtc         = FALSE;
+        }
+#endif
 
-#if IRMP_SUPPORT_ACP24_PROTOCOL == 1
-                    if (irmp_pulse_time >= ACP24_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= ACP24_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= ACP24_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= ACP24_START_BIT_PAUSE_LEN_MAX)
-                    {
+#if IRMP_ADDRESS_FILTER_LEN > 0
+        if (rtc && ! irmp_address_filter_pass (irmp_protocol, irmp_address))
+        {
 #ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = ACP24, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        ACP24_START_BIT_PULSE_LEN_MIN, ACP24_START_BIT_PULSE_LEN_MAX,
-                                        ACP24_START_BIT_PAUSE_LEN_MIN, ACP24_START_BIT_PAUSE_LEN_MAX);
+            ANALYZE_PRINTF ("address filter: frame of foreign remote ignored, protocol = %d, address = 0x%04x\n", irmp_protocol, (unsigned int) irmp_address);
 #endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &acp24_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_ROOMBA_PROTOCOL == 1
+            irmp_flags  = 0;
+            rtc         = FALSE;
+        }
+#endif
 
-#if IRMP_SUPPORT_PENTAX_PROTOCOL == 1
-                    if (irmp_pulse_time >= PENTAX_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= PENTAX_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= PENTAX_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= PENTAX_START_BIT_PAUSE_LEN_MAX)
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = PENTAX, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        PENTAX_START_BIT_PULSE_LEN_MIN, PENTAX_START_BIT_PULSE_LEN_MAX,
-                                        PENTAX_START_BIT_PAUSE_LEN_MIN, PENTAX_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &pentax_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_PENTAX_PROTOCOL == 1
+        if (rtc)
+        {
+            IRMP_COUNT (frames);
+#if IRMP_USE_KEY_RELEASE == 1
+            if (irmp_flags & IRMP_FLAG_RELEASE)
+            {
+                irmp_key_protocol = 0;                              // wait for next key
+            }
+            else if ((irmp_flags & (IRMP_FLAG_REPETITION | IRMP_FLAG_AUTO_REPETITION)) && irmp_key_protocol == irmp_protocol &&
+                     irmp_key_address == irmp_address && irmp_key_command == irmp_command)
+            {                                                       // same key still held down
+                if ((irmp_flags & IRMP_FLAG_REPETITION) && irmp_key_hold < 0xFF)
+                {
+                    irmp_key_hold++;
+                }
+            }
+            else
+            {                                                       // key pressed
+                irmp_key_protocol   = irmp_protocol;
+                irmp_key_address    = irmp_address;
+                irmp_key_command    = irmp_command;
+                irmp_key_hold       = 0;
+            }
+#endif
+            irmp_data_p->protocol = irmp_protocol;
+            irmp_data_p->address = irmp_address;
+            irmp_data_p->command = irmp_command;
+            irmp_data_p->flags   = irmp_flags;
+            irmp_command = 0;
+            irmp_address = 0;
+            irmp_flags   = 0;
+        }
 
-#if IRMP_SUPPORT_NIKON_PROTOCOL == 1
-                    if (irmp_pulse_time >= NIKON_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= NIKON_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= NIKON_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NIKON_START_BIT_PAUSE_LEN_MAX)
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = NIKON, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        NIKON_START_BIT_PULSE_LEN_MIN, NIKON_START_BIT_PULSE_LEN_MAX,
-                                        NIKON_START_BIT_PAUSE_LEN_MIN, NIKON_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &nikon_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_NIKON_PROTOCOL == 1
+        irmp_ir_detected = FALSE;
+    }
 
-#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
-                    if (irmp_pulse_time >= SAMSUNG_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= SAMSUNG_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= SAMSUNG_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= SAMSUNG_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's SAMSUNG
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = SAMSUNG, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        SAMSUNG_START_BIT_PULSE_LEN_MIN, SAMSUNG_START_BIT_PULSE_LEN_MAX,
-                                        SAMSUNG_START_BIT_PAUSE_LEN_MIN, SAMSUNG_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &samsung_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+    return rtc;
+}
 
-#if IRMP_SUPPORT_MATSUSHITA_PROTOCOL == 1
-                    if (irmp_pulse_time >= MATSUSHITA_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= MATSUSHITA_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= MATSUSHITA_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= MATSUSHITA_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's MATSUSHITA
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = MATSUSHITA, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        MATSUSHITA_START_BIT_PULSE_LEN_MIN, MATSUSHITA_START_BIT_PULSE_LEN_MAX,
-                                        MATSUSHITA_START_BIT_PAUSE_LEN_MIN, MATSUSHITA_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &matsushita_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_MATSUSHITA_PROTOCOL == 1
+#if IRMP_QUEUE_LEN > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Put detected frame into queue
+ *  @details  called by irmp_ISR(), so the decoder can go on while the frame waits for irmp_get_data().
+ *            The queue has one writer (irmp_ISR) and one reader (irmp_get_data), each of them changes its own index only.
+ *            If the queue is full, the frame is lost and counted in irmp_queue_overflows.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_queue_put (IRMP_CTX_PARAM)
+{
+    IRMP_DATA   irmp_data;
 
-#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
-                    if (irmp_pulse_time >= KASEIKYO_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= KASEIKYO_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= KASEIKYO_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= KASEIKYO_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's KASEIKYO
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = KASEIKYO, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        KASEIKYO_START_BIT_PULSE_LEN_MIN, KASEIKYO_START_BIT_PULSE_LEN_MAX,
-                                        KASEIKYO_START_BIT_PAUSE_LEN_MIN, KASEIKYO_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &kaseikyo_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+    if (irmp_get_frame (IRMP_CTX_ARG_ &irmp_data))
+    {
+        if ((uint8_t) (irmp_queue_write - irmp_queue_read) < IRMP_QUEUE_LEN)
+        {
+            irmp_queue[irmp_queue_write & (IRMP_QUEUE_LEN - 1)] = irmp_data;
+#if IRMP_USE_TIMESTAMP == 1
+            irmp_queue_ticks[irmp_queue_write & (IRMP_QUEUE_LEN - 1)] = irmp_frame_ticks;
+#endif
+#if IRMP_USE_RAW_FRAME == 1
+            irmp_queue_raw[irmp_queue_write & (IRMP_QUEUE_LEN - 1)]     = irmp_tmp_raw;
+            irmp_queue_raw_len[irmp_queue_write & (IRMP_QUEUE_LEN - 1)] = irmp_tmp_raw_len;
+#endif
+#if IRMP_USE_KEY_RELEASE == 1
+            irmp_queue_hold[irmp_queue_write & (IRMP_QUEUE_LEN - 1)]    = irmp_key_hold;
+#endif
+#if IRMP_USE_QUALITY == 1
+            irmp_queue_quality[irmp_queue_write & (IRMP_QUEUE_LEN - 1)] = irmp_tmp_quality;
+#endif
+            irmp_queue_write++;                                                     // publish frame after it is stored
+        }
+        else if (irmp_queue_overflows < 0xFFFF)
+        {
+            irmp_queue_overflows++;
+            IRMP_COUNT (dropped);
+            IRMP_TRACE (IRMP_TRACE_DROPPED, irmp_data.protocol, 0);
+        }
+    }
+}
 
-#if IRMP_SUPPORT_PANASONIC_PROTOCOL == 1
-                    if (irmp_pulse_time >= PANASONIC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= PANASONIC_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= PANASONIC_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= PANASONIC_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's PANASONIC
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = PANASONIC, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        PANASONIC_START_BIT_PULSE_LEN_MIN, PANASONIC_START_BIT_PULSE_LEN_MAX,
-                                        PANASONIC_START_BIT_PAUSE_LEN_MIN, PANASONIC_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &panasonic_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_PANASONIC_PROTOCOL == 1
+#if IRMP_USE_CONTEXT == 1
+uint_fast8_t
+irmp_get_data_ctx (IRMP_CONTEXT * ctx, IRMP_DATA * irmp_data_p)
+#else
+uint_fast8_t
+irmp_get_data (IRMP_DATA * irmp_data_p)
+#endif
+{
+    if (irmp_queue_read != irmp_queue_write)
+    {
+        *irmp_data_p = irmp_queue[irmp_queue_read & (IRMP_QUEUE_LEN - 1)];
+        irmp_queue_read++;                                                          // release entry after it is copied
+        return TRUE;
+    }
+    return FALSE;
+}
 
-#if IRMP_SUPPORT_RADIO1_PROTOCOL == 1
-                    if (irmp_pulse_time >= RADIO1_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RADIO1_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= RADIO1_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RADIO1_START_BIT_PAUSE_LEN_MAX)
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = RADIO1, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        RADIO1_START_BIT_PULSE_LEN_MIN, RADIO1_START_BIT_PULSE_LEN_MAX,
-                                        RADIO1_START_BIT_PAUSE_LEN_MIN, RADIO1_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &radio1_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_RRADIO1_PROTOCOL == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Get number of frames lost because the queue was full
+ *  @details  irmp_get_queue_overflows_ctx() for context ctx
+ *  @return   number of lost frames, saturates at 0xFFFF
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#if IRMP_USE_CONTEXT == 1
+uint_fast16_t
+irmp_get_queue_overflows_ctx (IRMP_CONTEXT * ctx)
+#else
+uint_fast16_t
+irmp_get_queue_overflows (void)
+#endif
+{
+    uint_fast16_t   overflows;
 
-#if IRMP_SUPPORT_RECS80_PROTOCOL == 1
-                    if (irmp_pulse_time >= RECS80_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RECS80_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= RECS80_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RECS80_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's RECS80
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = RECS80, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        RECS80_START_BIT_PULSE_LEN_MIN, RECS80_START_BIT_PULSE_LEN_MAX,
-                                        RECS80_START_BIT_PAUSE_LEN_MIN, RECS80_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &recs80_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_RECS80_PROTOCOL == 1
+    do
+    {
+        overflows = irmp_queue_overflows;                                           // 16 bit read may be interrupted by irmp_ISR()
+    } while (overflows != irmp_queue_overflows);
 
-#if IRMP_SUPPORT_S100_PROTOCOL == 1
-                    if (((irmp_pulse_time >= S100_START_BIT_LEN_MIN     && irmp_pulse_time <= S100_START_BIT_LEN_MAX) ||
-                         (irmp_pulse_time >= 2 * S100_START_BIT_LEN_MIN && irmp_pulse_time <= 2 * S100_START_BIT_LEN_MAX)) &&
-                        ((irmp_pause_time >= S100_START_BIT_LEN_MIN     && irmp_pause_time <= S100_START_BIT_LEN_MAX) ||
-                         (irmp_pause_time >= 2 * S100_START_BIT_LEN_MIN && irmp_pause_time <= 2 * S100_START_BIT_LEN_MAX)))
-                    {                                                           // it's S100
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = S100, start bit timings: pulse: %3d - %3d, pause: %3d - %3d or pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        S100_START_BIT_LEN_MIN, S100_START_BIT_LEN_MAX,
-                                        2 * S100_START_BIT_LEN_MIN, 2 * S100_START_BIT_LEN_MAX,
-                                        S100_START_BIT_LEN_MIN, S100_START_BIT_LEN_MAX,
-                                        2 * S100_START_BIT_LEN_MIN, 2 * S100_START_BIT_LEN_MAX);
-#endif // ANALYZE
+    return overflows;
+}
 
-                        irmp_param_p = (IRMP_PARAMETER *) &s100_param;
-                        last_pause = irmp_pause_time;
+#if IRMP_USE_CONTEXT == 1
+uint_fast16_t
+irmp_get_queue_overflows (void)
+{
+    return irmp_get_queue_overflows_ctx (&irmp_context);
+}
+#endif // IRMP_USE_CONTEXT == 1
+#endif // IRMP_QUEUE_LEN > 0
 
-                        if ((irmp_pulse_time > S100_START_BIT_LEN_MAX && irmp_pulse_time <= 2 * S100_START_BIT_LEN_MAX) ||
-                            (irmp_pause_time > S100_START_BIT_LEN_MAX && irmp_pause_time <= 2 * S100_START_BIT_LEN_MAX))
-                        {
-                          last_value  = 0;
-                          rc5_cmd_bit6 = 1<<6;
-                        }
-                        else
-                        {
-                          last_value  = 1;
-                        }
-                    }
-                    else
-#endif // IRMP_SUPPORT_S100_PROTOCOL == 1
+#if IRMP_TRACE_LEN > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Get trace event
+ *  @details  gets the oldest event of the trace buffer, irmp_get_trace_ctx() of context ctx
+ *  @param    pointer in order to store the event
+ *  @return   TRUE: successful, FALSE: no event
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#if IRMP_USE_CONTEXT == 1
+uint_fast8_t
+irmp_get_trace_ctx (IRMP_CONTEXT * ctx, IRMP_TRACE_ENTRY * entry_p)
+#else
+uint_fast8_t
+irmp_get_trace (IRMP_TRACE_ENTRY * entry_p)
+#endif
+{
+    if (irmp_trace_read != irmp_trace_write)
+    {
+        *entry_p = irmp_trace_buf[irmp_trace_read & (IRMP_TRACE_LEN - 1)];
+        irmp_trace_read++;                                                          // release entry after it is copied
+        return TRUE;
+    }
+    return FALSE;
+}
 
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1
-                    if (((irmp_pulse_time >= RC5_START_BIT_LEN_MIN     && irmp_pulse_time <= RC5_START_BIT_LEN_MAX) ||
-                         (irmp_pulse_time >= 2 * RC5_START_BIT_LEN_MIN && irmp_pulse_time <= 2 * RC5_START_BIT_LEN_MAX)) &&
-                        ((irmp_pause_time >= RC5_START_BIT_LEN_MIN     && irmp_pause_time <= RC5_START_BIT_LEN_MAX) ||
-                         (irmp_pause_time >= 2 * RC5_START_BIT_LEN_MIN && irmp_pause_time <= 2 * RC5_START_BIT_LEN_MAX)))
-                    {                                                           // it's RC5
-#if IRMP_SUPPORT_FDC_PROTOCOL == 1
-                        if (irmp_pulse_time >= FDC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= FDC_START_BIT_PULSE_LEN_MAX &&
-                            irmp_pause_time >= FDC_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= FDC_START_BIT_PAUSE_LEN_MAX)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("protocol = RC5 or FDC\n");
-                            ANALYZE_PRINTF ("FDC start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                            FDC_START_BIT_PULSE_LEN_MIN, FDC_START_BIT_PULSE_LEN_MAX,
-                                            FDC_START_BIT_PAUSE_LEN_MIN, FDC_START_BIT_PAUSE_LEN_MAX);
-                            ANALYZE_PRINTF ("RC5 start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX,
-                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX);
-#endif // ANALYZE
-                            memcpy_P (&irmp_param2, &fdc_param, sizeof (IRMP_PARAMETER));
-                        }
-                        else
-#endif // IRMP_SUPPORT_FDC_PROTOCOL == 1
+#if IRMP_USE_CONTEXT == 1
+uint_fast8_t
+irmp_get_trace (IRMP_TRACE_ENTRY * entry_p)
+{
+    return irmp_get_trace_ctx (&irmp_context, entry_p);
+}
+#endif // IRMP_USE_CONTEXT == 1
+#endif // IRMP_TRACE_LEN > 0
 
-#if IRMP_SUPPORT_RCCAR_PROTOCOL == 1
-                        if (irmp_pulse_time >= RCCAR_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RCCAR_START_BIT_PULSE_LEN_MAX &&
-                            irmp_pause_time >= RCCAR_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_START_BIT_PAUSE_LEN_MAX)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("protocol = RC5 or RCCAR\n");
-                            ANALYZE_PRINTF ("RCCAR start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                            RCCAR_START_BIT_PULSE_LEN_MIN, RCCAR_START_BIT_PULSE_LEN_MAX,
-                                            RCCAR_START_BIT_PAUSE_LEN_MIN, RCCAR_START_BIT_PAUSE_LEN_MAX);
-                            ANALYZE_PRINTF ("RC5 start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX,
-                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX);
-#endif // ANALYZE
-                            memcpy_P (&irmp_param2, &rccar_param, sizeof (IRMP_PARAMETER));
-                        }
-                        else
-#endif // IRMP_SUPPORT_RCCAR_PROTOCOL == 1
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("protocol = RC5, start bit timings: pulse: %3d - %3d, pause: %3d - %3d or pulse: %3d - %3d, pause: %3d - %3d\n",
-                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX,
-                                            2 * RC5_START_BIT_LEN_MIN, 2 * RC5_START_BIT_LEN_MAX,
-                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX,
-                                            2 * RC5_START_BIT_LEN_MIN, 2 * RC5_START_BIT_LEN_MAX);
-#endif // ANALYZE
-                        }
+#if IRMP_USE_COUNTERS == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Get decode counters
+ *  @details  copies frame and decode error counters, irmp_get_counters_ctx() of context ctx. The counters are never reset, compare
+ *            two copies to get the counts of a period
+ *  @param    pointer in order to store the counters
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#if IRMP_USE_CONTEXT == 1
+void
+irmp_get_counters_ctx (IRMP_CONTEXT * ctx, IRMP_COUNTERS * irmp_counters_p)
+#else
+void
+irmp_get_counters (IRMP_COUNTERS * irmp_counters_p)
+#endif
+{
+    IRMP_COUNTERS   check;
 
-                        irmp_param_p = (IRMP_PARAMETER *) &rc5_param;
-                        last_pause = irmp_pause_time;
+    do
+    {
+        *irmp_counters_p    = irmp_counters;                                        // 16 bit reads may be interrupted by irmp_ISR()
+        check               = irmp_counters;
+    } while (memcmp (irmp_counters_p, &check, sizeof (IRMP_COUNTERS)));
+}
 
-                        if ((irmp_pulse_time > RC5_START_BIT_LEN_MAX && irmp_pulse_time <= 2 * RC5_START_BIT_LEN_MAX) ||
-                            (irmp_pause_time > RC5_START_BIT_LEN_MAX && irmp_pause_time <= 2 * RC5_START_BIT_LEN_MAX))
-                        {
-                          last_value  = 0;
-                          rc5_cmd_bit6 = 1<<6;
-                        }
-                        else
-                        {
-                          last_value  = 1;
-                        }
-                    }
-                    else
-#endif // IRMP_SUPPORT_RC5_PROTOCOL == 1
+#if IRMP_USE_CONTEXT == 1
+void
+irmp_get_counters (IRMP_COUNTERS * irmp_counters_p)
+{
+    irmp_get_counters_ctx (&irmp_context, irmp_counters_p);
+}
+#endif // IRMP_USE_CONTEXT == 1
+#endif // IRMP_USE_COUNTERS == 1
 
-#if IRMP_SUPPORT_DENON_PROTOCOL == 1
-                    if ( (irmp_pulse_time >= DENON_PULSE_LEN_MIN && irmp_pulse_time <= DENON_PULSE_LEN_MAX) &&
-                        ((irmp_pause_time >= DENON_1_PAUSE_LEN_MIN && irmp_pause_time <= DENON_1_PAUSE_LEN_MAX) ||
-                         (irmp_pause_time >= DENON_0_PAUSE_LEN_MIN && irmp_pause_time <= DENON_0_PAUSE_LEN_MAX)))
-                    {                                                           // it's DENON
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = DENON, start bit timings: pulse: %3d - %3d, pause: %3d - %3d or %3d - %3d\n",
-                                        DENON_PULSE_LEN_MIN, DENON_PULSE_LEN_MAX,
-                                        DENON_1_PAUSE_LEN_MIN, DENON_1_PAUSE_LEN_MAX,
-                                        DENON_0_PAUSE_LEN_MIN, DENON_0_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &denon_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_DENON_PROTOCOL == 1
+#if IRMP_USE_TIMESTAMP == 1 || IRMP_USE_RAW_FRAME == 1 || IRMP_USE_KEY_RELEASE == 1 || IRMP_USE_QUALITY == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Get IRMP data with timestamp, raw frame, hold counter and signal quality
+ *  @details  gets decoded IRMP data, irmp_get_ticks() at the end of the frame, the received bits, the number of repetition frames of
+ *            the key so far and the timing of the data bits, irmp_get_data_ex_ctx() gets it from context ctx
+ *  @param    pointer in order to store IRMP data, timestamp, raw frame, hold counter and signal quality
+ *  @return    TRUE: successful, FALSE: failed
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#if IRMP_USE_CONTEXT == 1
+uint_fast8_t
+irmp_get_data_ex_ctx (IRMP_CONTEXT * ctx, IRMP_DATA_EX * irmp_data_ex_p)
+#else
+uint_fast8_t
+irmp_get_data_ex (IRMP_DATA_EX * irmp_data_ex_p)
+#endif
+{
+#if IRMP_USE_KEY_RELEASE == 1 && IRMP_QUEUE_LEN == 0
+    uint_fast8_t    rtc;
 
-#if IRMP_SUPPORT_THOMSON_PROTOCOL == 1
-                    if ( (irmp_pulse_time >= THOMSON_PULSE_LEN_MIN && irmp_pulse_time <= THOMSON_PULSE_LEN_MAX) &&
-                        ((irmp_pause_time >= THOMSON_1_PAUSE_LEN_MIN && irmp_pause_time <= THOMSON_1_PAUSE_LEN_MAX) ||
-                         (irmp_pause_time >= THOMSON_0_PAUSE_LEN_MIN && irmp_pause_time <= THOMSON_0_PAUSE_LEN_MAX)))
-                    {                                                           // it's THOMSON
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = THOMSON, start bit timings: pulse: %3d - %3d, pause: %3d - %3d or %3d - %3d\n",
-                                        THOMSON_PULSE_LEN_MIN, THOMSON_PULSE_LEN_MAX,
-                                        THOMSON_1_PAUSE_LEN_MIN, THOMSON_1_PAUSE_LEN_MAX,
-                                        THOMSON_0_PAUSE_LEN_MIN, THOMSON_0_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &thomson_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_THOMSON_PROTOCOL == 1
+#endif
+#if IRMP_QUEUE_LEN > 0                                                              // entry stays until irmp_get_data() releases it
+    if (irmp_queue_read != irmp_queue_write)                                        // queue not empty
+    {
+#  if IRMP_USE_TIMESTAMP == 1
+        irmp_data_ex_p->ticks   = irmp_queue_ticks[irmp_queue_read & (IRMP_QUEUE_LEN - 1)];
+#  endif
+#  if IRMP_USE_RAW_FRAME == 1
+        irmp_data_ex_p->raw     = irmp_queue_raw[irmp_queue_read & (IRMP_QUEUE_LEN - 1)];
+        irmp_data_ex_p->raw_len = irmp_queue_raw_len[irmp_queue_read & (IRMP_QUEUE_LEN - 1)];
+#  endif
+#  if IRMP_USE_KEY_RELEASE == 1
+        irmp_data_ex_p->hold    = irmp_queue_hold[irmp_queue_read & (IRMP_QUEUE_LEN - 1)];
+#  endif
+#  if IRMP_USE_QUALITY == 1
+        irmp_data_ex_p->quality = irmp_queue_quality[irmp_queue_read & (IRMP_QUEUE_LEN - 1)];
+#  endif
+    }
+#else
+    if (irmp_ir_detected)                                                           // irmp_ISR() waits until irmp_get_data() got the frame
+    {
+#  if IRMP_USE_TIMESTAMP == 1
+        irmp_data_ex_p->ticks   = irmp_frame_ticks;
+#  endif
+#  if IRMP_USE_RAW_FRAME == 1
+        irmp_data_ex_p->raw     = irmp_tmp_raw;
+        irmp_data_ex_p->raw_len = irmp_tmp_raw_len;
+#  endif
+#  if IRMP_USE_QUALITY == 1
+        irmp_data_ex_p->quality = irmp_tmp_quality;
+#  endif
+    }
+#endif
 
-#if IRMP_SUPPORT_BOSE_PROTOCOL == 1
-                    if (irmp_pulse_time >= BOSE_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= BOSE_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= BOSE_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= BOSE_START_BIT_PAUSE_LEN_MAX)
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = BOSE, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        BOSE_START_BIT_PULSE_LEN_MIN, BOSE_START_BIT_PULSE_LEN_MAX,
-                                        BOSE_START_BIT_PAUSE_LEN_MIN, BOSE_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &bose_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_BOSE_PROTOCOL == 1
+#if IRMP_USE_KEY_RELEASE == 1 && IRMP_QUEUE_LEN == 0
+#  if IRMP_USE_CONTEXT == 1
+    rtc = irmp_get_data_ctx (ctx, &irmp_data_ex_p->data);
+#  else
+    rtc = irmp_get_data (&irmp_data_ex_p->data);
+#  endif
+    irmp_data_ex_p->hold = irmp_key_hold;                                          // counted by irmp_get_data()
+    return rtc;
+#elif IRMP_USE_CONTEXT == 1
+    return irmp_get_data_ctx (ctx, &irmp_data_ex_p->data);
+#else
+    return irmp_get_data (&irmp_data_ex_p->data);
+#endif
+}
 
-#if IRMP_SUPPORT_RC6_PROTOCOL == 1
-                    if (irmp_pulse_time >= RC6_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RC6_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= RC6_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RC6_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's RC6
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = RC6, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        RC6_START_BIT_PULSE_LEN_MIN, RC6_START_BIT_PULSE_LEN_MAX,
-                                        RC6_START_BIT_PAUSE_LEN_MIN, RC6_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &rc6_param;
-                        last_pause = 0;
-                        last_value = 1;
-                    }
-                    else
-#endif // IRMP_SUPPORT_RC6_PROTOCOL == 1
+#if IRMP_USE_CONTEXT == 1
+uint_fast8_t
+irmp_get_data_ex (IRMP_DATA_EX * irmp_data_ex_p)
+{
+    return irmp_get_data_ex_ctx (&irmp_context, irmp_data_ex_p);
+}
+#endif // IRMP_USE_CONTEXT == 1
+#endif // IRMP_USE_TIMESTAMP == 1 || IRMP_USE_RAW_FRAME == 1 || IRMP_USE_KEY_RELEASE == 1 || IRMP_USE_QUALITY == 1
 
-#if IRMP_SUPPORT_RECS80EXT_PROTOCOL == 1
-                    if (irmp_pulse_time >= RECS80EXT_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RECS80EXT_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= RECS80EXT_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RECS80EXT_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's RECS80EXT
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = RECS80EXT, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        RECS80EXT_START_BIT_PULSE_LEN_MIN, RECS80EXT_START_BIT_PULSE_LEN_MAX,
-                                        RECS80EXT_START_BIT_PAUSE_LEN_MIN, RECS80EXT_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &recs80ext_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_RECS80EXT_PROTOCOL == 1
+#if IRMP_USE_TIMESTAMP == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Get tick counter
+ *  @details  ticks (1/F_INTERRUPTS sec) counted by irmp_ISR(), irmp_get_ticks_ctx() of context ctx.
+ *            With IRMP_USE_EDGE_ISR, the counter advances on each call of irmp_ISR_edge() only.
+ *  @return   tick counter, wraps around after 2^32 ticks
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#if IRMP_USE_CONTEXT == 1
+uint32_t
+irmp_get_ticks_ctx (IRMP_CONTEXT * ctx)
+#else
+uint32_t
+irmp_get_ticks (void)
+#endif
+{
+    uint32_t    ticks;
 
-#if IRMP_SUPPORT_NUBERT_PROTOCOL == 1
-                    if (irmp_pulse_time >= NUBERT_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= NUBERT_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= NUBERT_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NUBERT_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's NUBERT
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = NUBERT, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        NUBERT_START_BIT_PULSE_LEN_MIN, NUBERT_START_BIT_PULSE_LEN_MAX,
-                                        NUBERT_START_BIT_PAUSE_LEN_MIN, NUBERT_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &nubert_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_NUBERT_PROTOCOL == 1
+    do
+    {
+        ticks = irmp_ticks;                                                         // 32 bit read may be interrupted by irmp_ISR()
+    } while (ticks != irmp_ticks);
 
-#if IRMP_SUPPORT_FAN_PROTOCOL == 1
-                    if (irmp_pulse_time >= FAN_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= FAN_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= FAN_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= FAN_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's FAN
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = FAN, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        FAN_START_BIT_PULSE_LEN_MIN, FAN_START_BIT_PULSE_LEN_MAX,
-                                        FAN_START_BIT_PAUSE_LEN_MIN, FAN_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &fan_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_FAN_PROTOCOL == 1
+    return ticks;
+}
 
-#if IRMP_SUPPORT_SPEAKER_PROTOCOL == 1
-                    if (irmp_pulse_time >= SPEAKER_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= SPEAKER_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= SPEAKER_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= SPEAKER_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's SPEAKER
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = SPEAKER, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        SPEAKER_START_BIT_PULSE_LEN_MIN, SPEAKER_START_BIT_PULSE_LEN_MAX,
-                                        SPEAKER_START_BIT_PAUSE_LEN_MIN, SPEAKER_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &speaker_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_SPEAKER_PROTOCOL == 1
-
-#if IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
-                    if (irmp_pulse_time >= BANG_OLUFSEN_START_BIT1_PULSE_LEN_MIN && irmp_pulse_time <= BANG_OLUFSEN_START_BIT1_PULSE_LEN_MAX &&
-                        irmp_pause_time >= BANG_OLUFSEN_START_BIT1_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_START_BIT1_PAUSE_LEN_MAX)
-                    {                                                           // it's BANG_OLUFSEN
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = BANG_OLUFSEN\n");
-                        ANALYZE_PRINTF ("start bit 1 timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        BANG_OLUFSEN_START_BIT1_PULSE_LEN_MIN, BANG_OLUFSEN_START_BIT1_PULSE_LEN_MAX,
-                                        BANG_OLUFSEN_START_BIT1_PAUSE_LEN_MIN, BANG_OLUFSEN_START_BIT1_PAUSE_LEN_MAX);
-                        ANALYZE_PRINTF ("start bit 2 timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        BANG_OLUFSEN_START_BIT2_PULSE_LEN_MIN, BANG_OLUFSEN_START_BIT2_PULSE_LEN_MAX,
-                                        BANG_OLUFSEN_START_BIT2_PAUSE_LEN_MIN, BANG_OLUFSEN_START_BIT2_PAUSE_LEN_MAX);
-                        ANALYZE_PRINTF ("start bit 3 timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        BANG_OLUFSEN_START_BIT3_PULSE_LEN_MIN, BANG_OLUFSEN_START_BIT3_PULSE_LEN_MAX,
-                                        BANG_OLUFSEN_START_BIT3_PAUSE_LEN_MIN, BANG_OLUFSEN_START_BIT3_PAUSE_LEN_MAX);
-                        ANALYZE_PRINTF ("start bit 4 timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        BANG_OLUFSEN_START_BIT4_PULSE_LEN_MIN, BANG_OLUFSEN_START_BIT4_PULSE_LEN_MAX,
-                                        BANG_OLUFSEN_START_BIT4_PAUSE_LEN_MIN, BANG_OLUFSEN_START_BIT4_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &bang_olufsen_param;
-                        last_value = 0;
-                    }
-                    else
-#endif // IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
-
-#if IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
-                    if (irmp_pulse_time >= GRUNDIG_NOKIA_IR60_START_BIT_LEN_MIN && irmp_pulse_time <= GRUNDIG_NOKIA_IR60_START_BIT_LEN_MAX &&
-                        irmp_pause_time >= GRUNDIG_NOKIA_IR60_PRE_PAUSE_LEN_MIN && irmp_pause_time <= GRUNDIG_NOKIA_IR60_PRE_PAUSE_LEN_MAX)
-                    {                                                           // it's GRUNDIG
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = GRUNDIG, pre bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        GRUNDIG_NOKIA_IR60_START_BIT_LEN_MIN, GRUNDIG_NOKIA_IR60_START_BIT_LEN_MAX,
-                                        GRUNDIG_NOKIA_IR60_PRE_PAUSE_LEN_MIN, GRUNDIG_NOKIA_IR60_PRE_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &grundig_param;
-                        last_pause = irmp_pause_time;
-                        last_value  = 1;
-                    }
-                    else
-#endif // IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
-
-#if IRMP_SUPPORT_MERLIN_PROTOCOL == 1 // check MERLIN before RUWIDO!
-                    if (irmp_pulse_time >= MERLIN_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= MERLIN_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= MERLIN_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= MERLIN_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's MERLIN
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = MERLIN, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        MERLIN_START_BIT_PULSE_LEN_MIN, MERLIN_START_BIT_PULSE_LEN_MAX,
-                                        MERLIN_START_BIT_PAUSE_LEN_MIN, MERLIN_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &merlin_param;
-                        last_pause = 0;
-                        last_value = 1;
-                    }
-                    else
-#endif // IRMP_SUPPORT_MERLIN_PROTOCOL == 1
+#if IRMP_USE_CONTEXT == 1
+uint32_t
+irmp_get_ticks (void)
+{
+    return irmp_get_ticks_ctx (&irmp_context);
+}
+#endif // IRMP_USE_CONTEXT == 1
+#endif // IRMP_USE_TIMESTAMP == 1
 
-#if IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1
-                    if (((irmp_pulse_time >= SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX) ||
-                         (irmp_pulse_time >= 2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= 2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX)) &&
-                        ((irmp_pause_time >= SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX) ||
-                         (irmp_pause_time >= 2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= 2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX)))
-                    {                                                           // it's RUWIDO or SIEMENS
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = RUWIDO, start bit timings: pulse: %3d - %3d or %3d - %3d, pause: %3d - %3d or %3d - %3d\n",
-                                        SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN,   SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX,
-                                        2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN, 2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX,
-                                        SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN,   SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX,
-                                        2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN, 2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &ruwido_param;
-                        last_pause = irmp_pause_time;
-                        last_value  = 1;
-                    }
-                    else
-#endif // IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1
+#if IRMP_USE_CONTEXT == 1
+uint_fast8_t
+irmp_get_data (IRMP_DATA * irmp_data_p)
+{
+    return irmp_get_data_ctx (&irmp_context, irmp_data_p);
+}
+#endif // IRMP_USE_CONTEXT == 1
 
-#if IRMP_SUPPORT_FDC_PROTOCOL == 1
-                    if (irmp_pulse_time >= FDC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= FDC_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= FDC_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= FDC_START_BIT_PAUSE_LEN_MAX)
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = FDC, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        FDC_START_BIT_PULSE_LEN_MIN, FDC_START_BIT_PULSE_LEN_MAX,
-                                        FDC_START_BIT_PAUSE_LEN_MIN, FDC_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &fdc_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_FDC_PROTOCOL == 1
+#if IRMP_USE_CALLBACK == 1
+void
+irmp_set_callback_ptr (void (*cb)(uint_fast8_t))
+{
+    irmp_callback_ptr = cb;
+}
+#endif // IRMP_USE_CALLBACK == 1
 
-#if IRMP_SUPPORT_RCCAR_PROTOCOL == 1
-                    if (irmp_pulse_time >= RCCAR_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RCCAR_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= RCCAR_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_START_BIT_PAUSE_LEN_MAX)
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = RCCAR, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        RCCAR_START_BIT_PULSE_LEN_MIN, RCCAR_START_BIT_PULSE_LEN_MAX,
-                                        RCCAR_START_BIT_PAUSE_LEN_MIN, RCCAR_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &rccar_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+#if IRMP_USE_RAW_FRAME == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Get bit field of raw frame
+ *  @details  bits offset ... end - 1 of the received bits, as far as received. Like irmp_store_bit(), LSB first fields keep their
+ *            first, MSB first fields their last bits if the field is longer than uint_fast16_t.
+ *  @param    offset and end of field, flag: LSB first
+ *  @return   value of field
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static uint_fast16_t
+irmp_raw_field (IRMP_CTX_PARAM_ uint_fast8_t offset, uint_fast8_t end, uint_fast8_t lsb_first)
+{
+    uint64_t        bits;
+    uint_fast16_t   field = 0;
+    uint_fast8_t    i;
 
-#if IRMP_SUPPORT_KATHREIN_PROTOCOL == 1
-                    if (irmp_pulse_time >= KATHREIN_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= KATHREIN_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= KATHREIN_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= KATHREIN_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's KATHREIN
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = KATHREIN, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        KATHREIN_START_BIT_PULSE_LEN_MIN, KATHREIN_START_BIT_PULSE_LEN_MAX,
-                                        KATHREIN_START_BIT_PAUSE_LEN_MIN, KATHREIN_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &kathrein_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_KATHREIN_PROTOCOL == 1
+    if (end > irmp_tmp_raw_len)
+    {
+        end = irmp_tmp_raw_len;
+    }
 
-#if IRMP_SUPPORT_NETBOX_PROTOCOL == 1
-                    if (irmp_pulse_time >= NETBOX_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= NETBOX_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= NETBOX_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NETBOX_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's NETBOX
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = NETBOX, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        NETBOX_START_BIT_PULSE_LEN_MIN, NETBOX_START_BIT_PULSE_LEN_MAX,
-                                        NETBOX_START_BIT_PAUSE_LEN_MIN, NETBOX_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &netbox_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_NETBOX_PROTOCOL == 1
+    if (offset >= end)
+    {
+        return 0;
+    }
 
-#if IRMP_SUPPORT_LEGO_PROTOCOL == 1
-                    if (irmp_pulse_time >= LEGO_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= LEGO_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= LEGO_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= LEGO_START_BIT_PAUSE_LEN_MAX)
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = LEGO, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        LEGO_START_BIT_PULSE_LEN_MIN, LEGO_START_BIT_PULSE_LEN_MAX,
-                                        LEGO_START_BIT_PAUSE_LEN_MIN, LEGO_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &lego_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_LEGO_PROTOCOL == 1
+    bits = irmp_tmp_raw >> (irmp_tmp_raw_len - end);                        // last bit of field is bit 0 now
 
-#if IRMP_SUPPORT_A1TVBOX_PROTOCOL == 1
-                    if (irmp_pulse_time >= A1TVBOX_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= A1TVBOX_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= A1TVBOX_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= A1TVBOX_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's A1TVBOX
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = A1TVBOX, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        A1TVBOX_START_BIT_PULSE_LEN_MIN, A1TVBOX_START_BIT_PULSE_LEN_MAX,
-                                        A1TVBOX_START_BIT_PAUSE_LEN_MIN, A1TVBOX_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &a1tvbox_param;
-                        last_pause = 0;
-                        last_value = 1;
-                    }
-                    else
-#endif // IRMP_SUPPORT_A1TVBOX_PROTOCOL == 1
+    if (lsb_first)
+    {
+        for (i = offset; i < end; i++)                                      // last bit of field is MSB of value
+        {
+            field = (field << 1) | ((uint_fast16_t) bits & 1);
+            bits >>= 1;
+        }
+        return field;
+    }
 
-#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
-                    if (irmp_pulse_time >= ORTEK_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= ORTEK_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= ORTEK_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= ORTEK_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's ORTEK (Hama)
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = ORTEK, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        ORTEK_START_BIT_PULSE_LEN_MIN, ORTEK_START_BIT_PULSE_LEN_MAX,
-                                        ORTEK_START_BIT_PAUSE_LEN_MIN, ORTEK_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &ortek_param;
-                        last_pause  = 0;
-                        last_value  = 1;
-                        parity      = 0;
-                    }
-                    else
-#endif // IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+    if (end - offset < 64)
+    {
+        bits &= ((uint64_t) 1 << (end - offset)) - 1;
+    }
+    return (uint_fast16_t) bits;
+}
 
-#if IRMP_SUPPORT_RCMM_PROTOCOL == 1
-                    if (irmp_pulse_time >= RCMM32_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RCMM32_START_BIT_PULSE_LEN_MAX &&
-                        irmp_pause_time >= RCMM32_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RCMM32_START_BIT_PAUSE_LEN_MAX)
-                    {                                                           // it's RCMM
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = RCMM, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
-                                        RCMM32_START_BIT_PULSE_LEN_MIN, RCMM32_START_BIT_PULSE_LEN_MAX,
-                                        RCMM32_START_BIT_PAUSE_LEN_MIN, RCMM32_START_BIT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                        irmp_param_p = (IRMP_PARAMETER *) &rcmm_param;
-                    }
-                    else
-#endif // IRMP_SUPPORT_RCMM_PROTOCOL == 1
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("protocol = UNKNOWN\n");
-#endif // ANALYZE
-                        irmp_start_bit_detected = 0;                            // wait for another start bit...
-                    }
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Extract address and command from raw frame
+ *  @details  protocols with IRMP_PARAM_FLAG_RAW_FIELDS only shift their bits into irmp_tmp_raw, see irmp_store_bit(). Their fields are
+ *            extracted here before they are read: at frame end, or earlier by early match and address filter. Following bits are
+ *            stored one by one again.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_raw_extract (IRMP_CTX_PARAM)
+{
+    uint_fast8_t    command_end = irmp_param.command_end;
 
-                    if (irmp_start_bit_detected)
-                    {
-                        memcpy_P (&irmp_param, irmp_param_p, sizeof (IRMP_PARAMETER));
+    if (irmp_param.address_offset > irmp_param.command_offset && irmp_param.address_offset < command_end)
+    {
+        command_end = irmp_param.address_offset;                            // irmp_store_bit(): address before command
+    }
 
-                        if (! (irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER))
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("pulse_1: %3d - %3d\n", irmp_param.pulse_1_len_min, irmp_param.pulse_1_len_max);
-                            ANALYZE_PRINTF ("pause_1: %3d - %3d\n", irmp_param.pause_1_len_min, irmp_param.pause_1_len_max);
-#endif // ANALYZE
-                        }
-                        else
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("pulse: %3d - %3d or %3d - %3d\n", irmp_param.pulse_1_len_min, irmp_param.pulse_1_len_max,
-                                            2 * irmp_param.pulse_1_len_min, 2 * irmp_param.pulse_1_len_max);
-                            ANALYZE_PRINTF ("pause: %3d - %3d or %3d - %3d\n", irmp_param.pause_1_len_min, irmp_param.pause_1_len_max,
-                                            2 * irmp_param.pause_1_len_min, 2 * irmp_param.pause_1_len_max);
-#endif // ANALYZE
-                        }
+    irmp_tmp_address |= irmp_raw_field (IRMP_CTX_ARG_ irmp_param.address_offset, irmp_param.address_end, irmp_param.lsb_first);
+    irmp_tmp_command |= irmp_raw_field (IRMP_CTX_ARG_ irmp_param.command_offset, command_end, irmp_param.lsb_first);
 
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
-                        if (irmp_param2.protocol)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("pulse_0: %3d - %3d\n", irmp_param2.pulse_0_len_min, irmp_param2.pulse_0_len_max);
-                            ANALYZE_PRINTF ("pause_0: %3d - %3d\n", irmp_param2.pause_0_len_min, irmp_param2.pause_0_len_max);
-                            ANALYZE_PRINTF ("pulse_1: %3d - %3d\n", irmp_param2.pulse_1_len_min, irmp_param2.pulse_1_len_max);
-                            ANALYZE_PRINTF ("pause_1: %3d - %3d\n", irmp_param2.pause_1_len_min, irmp_param2.pause_1_len_max);
-#endif // ANALYZE
-                        }
+#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_NEC_PROTOCOL || irmp_param.protocol == IRMP_NEC42_PROTOCOL)
+    {
+        irmp_lgair_address |= irmp_raw_field (IRMP_CTX_ARG_ 0, 8, FALSE);   // LGAIR uses MSB
+        irmp_lgair_command |= irmp_raw_field (IRMP_CTX_ARG_ 8, 24, FALSE);
+    }
+#endif
+#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_NEC42_PROTOCOL)
+    {
+        irmp_tmp_address2 |= irmp_raw_field (IRMP_CTX_ARG_ 13, 26, TRUE);
+    }
 #endif
 
+    irmp_raw_pending = FALSE;
+}
+#endif // IRMP_USE_RAW_FRAME == 1
 
-#if IRMP_SUPPORT_RC6_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_RC6_PROTOCOL)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("pulse_toggle: %3d - %3d\n", RC6_TOGGLE_BIT_LEN_MIN, RC6_TOGGLE_BIT_LEN_MAX);
-#endif // ANALYZE
-                        }
+#if IRMP_EARLY_MATCH_LEN > 0
+static IRMP_DATA    irmp_early_match_list[IRMP_EARLY_MATCH_LEN];                // learned keys, protocol 0: unused
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Register learned key for early match
+ *  @details  the list is shared by all contexts. irmp_ISR() reads it, so change it with interrupts disabled
+ *  @param    idx: 0 ... IRMP_EARLY_MATCH_LEN - 1
+ *  @param    irmp_data_p: learned key, only protocol, address and command are compared. protocol 0 clears the entry
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+void
+irmp_set_early_match (uint_fast8_t idx, IRMP_DATA * irmp_data_p)
+{
+    if (idx < IRMP_EARLY_MATCH_LEN)
+    {
+        irmp_early_match_list[idx] = *irmp_data_p;
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Early match
+ *  @details  called after every stored bit. If address and command of the frame are complete and belong to a learned key, the frame is
+ *            detected now. The rest of the frame is decoded as usual, but not detected again, see irmp_early_protocol.
+ *            NEC is received as NEC42 until its stop bit, so bit 24 of a NEC42 frame is checked for NEC, too.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_early_match (IRMP_CTX_PARAM)
+{
+    uint_fast8_t    protocol;
+    uint_fast16_t   address;
+    uint_fast16_t   command;
+    uint_fast8_t    i;
+
+#if IRMP_USE_RAW_FRAME == 1
+    if (irmp_raw_pending && (irmp_bit == 24 || irmp_bit == NEC42_COMMAND_OFFSET + NEC42_COMMAND_LEN))  // fields are read below
+    {
+        irmp_raw_extract (IRMP_CTX_ARG);
+    }
 #endif
 
-                        if (! (irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER))
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("pulse_0: %3d - %3d\n", irmp_param.pulse_0_len_min, irmp_param.pulse_0_len_max);
-                            ANALYZE_PRINTF ("pause_0: %3d - %3d\n", irmp_param.pause_0_len_min, irmp_param.pause_0_len_max);
-#endif // ANALYZE
-                        }
-                        else
-                        {
+#if IRMP_SUPPORT_NEC_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_NEC_PROTOCOL && irmp_bit == 24)                 // 16 address bits + 8 command bits, 8 inverted command bits follow
+    {
+        protocol = IRMP_NEC_PROTOCOL;
+        address  = irmp_tmp_address;
+        command  = irmp_tmp_command & 0x00FF;
+    }
+    else
+#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_NEC42_PROTOCOL && irmp_bit == 24)               // may be NEC, see conversion at NEC stop bit
+    {
+        protocol = IRMP_NEC_PROTOCOL;
+        address  = irmp_tmp_address | ((irmp_tmp_address2 & 0x0007) << 13);
+        command  = (irmp_tmp_address2 >> 3) & 0x00FF;
+    }
+    else
+#endif // IRMP_SUPPORT_NEC42_PROTOCOL == 1
+#endif // IRMP_SUPPORT_NEC_PROTOCOL == 1
+#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_NEC42_PROTOCOL && irmp_bit == NEC42_COMMAND_OFFSET + NEC42_COMMAND_LEN)   // 8 inverted command bits follow
+    {
+        protocol = IRMP_NEC42_PROTOCOL;
+        address  = irmp_tmp_address;
+        command  = irmp_tmp_command;
+    }
+    else
+#endif // IRMP_SUPPORT_NEC42_PROTOCOL == 1
+    {
+        return;
+    }
+
+    for (i = 0; i < IRMP_EARLY_MATCH_LEN; i++)
+    {
+        if (irmp_early_match_list[i].protocol == protocol && irmp_early_match_list[i].address == address && irmp_early_match_list[i].command == command)
+        {
+#if IRMP_SUPPORT_NEC_PROTOCOL == 1
+            if (protocol == IRMP_NEC_PROTOCOL)
+            {
+                command |= (~command & 0x00FF) << 8;                                // irmp_get_data() checks the inverted command
+            }
+#endif
 #ifdef ANALYZE
-                            ANALYZE_PRINTF ("pulse: %3d - %3d or %3d - %3d\n", irmp_param.pulse_0_len_min, irmp_param.pulse_0_len_max,
-                                            2 * irmp_param.pulse_0_len_min, 2 * irmp_param.pulse_0_len_max);
-                            ANALYZE_PRINTF ("pause: %3d - %3d or %3d - %3d\n", irmp_param.pause_0_len_min, irmp_param.pause_0_len_max,
-                                            2 * irmp_param.pause_0_len_min, 2 * irmp_param.pause_0_len_max);
+            ANALYZE_PRINTF ("%8.3fms early match: learned key %d\n", (double) (time_counter * 1000) / F_INTERRUPTS, i);
 #endif // ANALYZE
-                        }
+            if (last_irmp_command == command && last_irmp_address == address && irmp_repetition_ticks < irmp_key_repetition_len)
+            {
+                irmp_flags |= IRMP_FLAG_REPETITION;
+            }
 
-#ifdef ANALYZE
-#if IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_BANG_OLUFSEN_PROTOCOL)
-                        {
-                            ANALYZE_PRINTF ("pulse_r: %3d - %3d\n", irmp_param.pulse_0_len_min, irmp_param.pulse_0_len_max);
-                            ANALYZE_PRINTF ("pause_r: %3d - %3d\n", BANG_OLUFSEN_R_PAUSE_LEN_MIN, BANG_OLUFSEN_R_PAUSE_LEN_MAX);
-                        }
+            irmp_protocol       = protocol;
+            irmp_address        = address;
+            irmp_command        = command;
+            irmp_early_protocol = protocol;
+            irmp_ir_detected    = TRUE;                                             // irmp_ISR_sample() puts it into the queue
+#if IRMP_USE_TIMESTAMP == 1
+            irmp_frame_ticks    = irmp_ticks;
 #endif
+            break;
+        }
+    }
+}
+#endif // IRMP_EARLY_MATCH_LEN > 0
 
-                        ANALYZE_PRINTF ("command_offset: %2d\n", irmp_param.command_offset);
-                        ANALYZE_PRINTF ("command_len:    %3d\n", irmp_param.command_end - irmp_param.command_offset);
-                        ANALYZE_PRINTF ("complete_len:   %3d\n", irmp_param.complete_len);
-                        ANALYZE_PRINTF ("stop_bit:       %3d\n", irmp_param.stop_bit);
-#endif // ANALYZE
-                    }
+#if IRMP_ADDRESS_FILTER_LEN > 0 && (IRMP_SUPPORT_NEC_PROTOCOL == 1 || IRMP_SUPPORT_NEC42_PROTOCOL == 1)
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Address filter for NEC
+ *  @details  called after every stored bit. After 16 bits the NEC address is complete: a frame of a foreign remote is dropped here
+ *            instead of being decoded up to its end. A NEC frame may still turn into NEC42, JVC, LGAIR or APPLE, so nothing is dropped
+ *            if one of those is in the list. Other protocols are checked by irmp_get_data() at frame end.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_address_filter_nec (IRMP_CTX_PARAM)
+{
+    uint_fast16_t   address;
+    uint_fast8_t    protocol;
+    uint_fast8_t    used = FALSE;
+    uint_fast8_t    i;
 
-                    irmp_bit = 0;
+    if (irmp_bit != NEC_ADDRESS_LEN)
+    {
+        return;
+    }
 
-#if IRMP_SUPPORT_MANCHESTER == 1
-                    if ((irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER) &&
-                         irmp_param.protocol != IRMP_RUWIDO_PROTOCOL && // Manchester, but not RUWIDO
-                         irmp_param.protocol != IRMP_RC6_PROTOCOL)      // Manchester, but not RC6
-                    {
-                        if (irmp_pause_time > irmp_param.pulse_1_len_max && irmp_pause_time <= 2 * irmp_param.pulse_1_len_max)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("%8.3fms [bit %2d: pulse = %3d, pause = %3d] ", (double) (time_counter * 1000) / F_INTERRUPTS, irmp_bit, irmp_pulse_time, irmp_pause_time);
-                            ANALYZE_PUTCHAR ((irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? '0' : '1');
-                            ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                            irmp_store_bit ((irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? 0 : 1);
-                        }
-                        else if (! last_value)  // && irmp_pause_time >= irmp_param.pause_1_len_min && irmp_pause_time <= irmp_param.pause_1_len_max)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("%8.3fms [bit %2d: pulse = %3d, pause = %3d] ", (double) (time_counter * 1000) / F_INTERRUPTS, irmp_bit, irmp_pulse_time, irmp_pause_time);
-                            ANALYZE_PUTCHAR ((irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? '1' : '0');
-                            ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                            irmp_store_bit ((irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? 1 : 0);
-                        }
-                    }
-                    else
-#endif // IRMP_SUPPORT_MANCHESTER == 1
+#if IRMP_USE_RAW_FRAME == 1
+    if (irmp_raw_pending)
+    {
+        irmp_raw_extract (IRMP_CTX_ARG);
+    }
+#endif
 
-#if IRMP_SUPPORT_SERIAL == 1
-                    if (irmp_param.flags & IRMP_PARAM_FLAG_IS_SERIAL)
-                    {
-                        ; // do nothing
-                    }
-                    else
-#endif // IRMP_SUPPORT_SERIAL == 1
+#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_NEC42_PROTOCOL)                                 // NEC is received as NEC42 until its stop bit
+    {
+        address = irmp_tmp_address | ((irmp_tmp_address2 & 0x0007) << 13);
+    }
+    else
+#endif
+    if (irmp_param.protocol == IRMP_NEC_PROTOCOL)
+    {
+        address = irmp_tmp_address;
+    }
+    else
+    {
+        return;
+    }
 
+    for (i = 0; i < IRMP_ADDRESS_FILTER_LEN; i++)
+    {
+        protocol = irmp_address_filter_list[i].protocol;
 
-#if IRMP_SUPPORT_DENON_PROTOCOL == 1
-                    if (irmp_param.protocol == IRMP_DENON_PROTOCOL)
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("%8.3fms [bit %2d: pulse = %3d, pause = %3d] ", (double) (time_counter * 1000) / F_INTERRUPTS, irmp_bit, irmp_pulse_time, irmp_pause_time);
-#endif // ANALYZE
+        if (protocol == IRMP_NEC_PROTOCOL)
+        {
+            if (irmp_address_filter_list[i].address == address)
+            {
+                return;
+            }
+        }
+        else if (protocol == IRMP_NEC42_PROTOCOL || protocol == IRMP_JVC_PROTOCOL || protocol == IRMP_LGAIR_PROTOCOL || protocol == IRMP_APPLE_PROTOCOL)
+        {
+            return;                                                                 // decide at frame end
+        }
 
-                        if (irmp_pause_time >= DENON_1_PAUSE_LEN_MIN && irmp_pause_time <= DENON_1_PAUSE_LEN_MAX)
-                        {                                                       // pause timings correct for "1"?
-#ifdef ANALYZE
-                            ANALYZE_PUTCHAR ('1');                                  // yes, store 1
-                            ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                            irmp_store_bit (1);
-                        }
-                        else // if (irmp_pause_time >= DENON_0_PAUSE_LEN_MIN && irmp_pause_time <= DENON_0_PAUSE_LEN_MAX)
-                        {                                                       // pause timings correct for "0"?
-#ifdef ANALYZE
-                            ANALYZE_PUTCHAR ('0');                                  // yes, store 0
-                            ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                            irmp_store_bit (0);
-                        }
-                    }
-                    else
-#endif // IRMP_SUPPORT_DENON_PROTOCOL == 1
-#if IRMP_SUPPORT_THOMSON_PROTOCOL == 1
-                    if (irmp_param.protocol == IRMP_THOMSON_PROTOCOL)
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("%8.3fms [bit %2d: pulse = %3d, pause = %3d] ", (double) (time_counter * 1000) / F_INTERRUPTS, irmp_bit, irmp_pulse_time, irmp_pause_time);
-#endif // ANALYZE
+        if (protocol)
+        {
+            used = TRUE;
+        }
+    }
 
-                        if (irmp_pause_time >= THOMSON_1_PAUSE_LEN_MIN && irmp_pause_time <= THOMSON_1_PAUSE_LEN_MAX)
-                        {                                                       // pause timings correct for "1"?
-#ifdef ANALYZE
-                          ANALYZE_PUTCHAR ('1');                                  // yes, store 1
-                          ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                          irmp_store_bit (1);
-                        }
-                        else // if (irmp_pause_time >= THOMSON_0_PAUSE_LEN_MIN && irmp_pause_time <= THOMSON_0_PAUSE_LEN_MAX)
-                        {                                                       // pause timings correct for "0"?
+    if (used)
+    {
 #ifdef ANALYZE
-                          ANALYZE_PUTCHAR ('0');                                  // yes, store 0
-                          ANALYZE_NEWLINE ();
+        ANALYZE_PRINTF ("%8.3fms address filter: NEC frame of foreign remote dropped, address = 0x%04x\n", (double) (time_counter * 1000) / F_INTERRUPTS, (unsigned int) address);
 #endif // ANALYZE
-                          irmp_store_bit (0);
-                        }
-                    }
-                    else
-#endif // IRMP_SUPPORT_THOMSON_PROTOCOL == 1
-                    {
-                        ;                                                       // else do nothing
-                    }
+        irmp_start_bit_detected = 0;                                                // reset flags and wait for next start bit
+        irmp_pause_time         = 0;
+        irmp_repetition_ticks   = 0xFFFF;                                           // following repetition frames are foreign, too
+#if IRMP_CANDIDATES > 1
+        irmp_candidate_count    = 0;
+#endif
+    }
+}
+#endif // IRMP_ADDRESS_FILTER_LEN > 0 && (IRMP_SUPPORT_NEC_PROTOCOL == 1 || IRMP_SUPPORT_NEC42_PROTOCOL == 1)
 
-                    irmp_pulse_time = 1;                                        // set counter to 1, not 0
-                    irmp_pause_time = 0;
-                    wait_for_start_space = 0;
-                }
-            }
-            else if (wait_for_space)                                            // the data section....
-            {                                                                   // counting the time of darkness....
-                uint_fast8_t got_light = FALSE;
+#if IRMP_EARLY_ABORT == 1
+#define IRMP_CHECK_FAILED_NEC                   0x01                            // inverted command of NEC did not fit
+#define IRMP_CHECK_FAILED_NEC42                 0x02                            // inverted address or command of NEC42 did not fit
 
-                if (irmp_input)                                                 // still dark?
-                {                                                               // yes...
-                    if (irmp_bit == irmp_param.complete_len && irmp_param.stop_bit == 1)
-                    {
-                        if (
-#if IRMP_SUPPORT_MANCHESTER == 1
-                            (irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER) ||
-#endif
-#if IRMP_SUPPORT_SERIAL == 1
-                            (irmp_param.flags & IRMP_PARAM_FLAG_IS_SERIAL) ||
+#if IRMP_USE_RAW_FRAME == 1                                                     // bit received 'distance' bits ago
+#  define IRMP_CHECK_REF(distance, field)       ((uint_fast8_t) (irmp_tmp_raw >> (distance)) & 1)
+#else
+#  define IRMP_CHECK_REF(distance, field)       ((uint_fast8_t) (field) & 1)
 #endif
-                            (irmp_pulse_time >= irmp_param.pulse_0_len_min && irmp_pulse_time <= irmp_param.pulse_0_len_max))
-                        {
-#ifdef ANALYZE
-                            if (! (irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER))
-                            {
-                                ANALYZE_PRINTF ("stop bit detected\n");
-                            }
-#endif // ANALYZE
-                            irmp_param.stop_bit = 0;
-                        }
-                        else
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("error: stop bit timing wrong, irmp_bit = %d, irmp_pulse_time = %d, pulse_0_len_min = %d, pulse_0_len_max = %d\n",
-                                            irmp_bit, irmp_pulse_time, irmp_param.pulse_0_len_min, irmp_param.pulse_0_len_max);
-#endif // ANALYZE
-                            irmp_start_bit_detected = 0;                        // wait for another start bit...
-                            irmp_pulse_time         = 0;
-                            irmp_pause_time         = 0;
-                        }
-                    }
-                    else
-                    {
-                        irmp_pause_time++;                                                          // increment counter
 
-#if IRMP_SUPPORT_SIRCS_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_SIRCS_PROTOCOL &&                           // Sony has a variable number of bits:
-                            irmp_pause_time > SIRCS_PAUSE_LEN_MAX &&                                // minimum is 12
-                            irmp_bit >= 12 - 1)                                                     // pause too long?
-                        {                                                                           // yes, break and close this frame
-                            irmp_param.complete_len = irmp_bit + 1;                                 // set new complete length
-                            got_light = TRUE;                                                       // this is a lie, but helps (generates stop bit)
-                            irmp_tmp_address |= (irmp_bit - SIRCS_MINIMUM_DATA_LEN + 1) << 8;       // new: store number of additional bits in upper byte of address!
-                            irmp_param.command_end = irmp_param.command_offset + irmp_bit + 1;      // correct command length
-                            irmp_pause_time = SIRCS_PAUSE_LEN_MAX - 1;                              // correct pause length
-                        }
-                        else
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Check inverted and XOR bits
+ *  @details  called with every stored bit before irmp_bit is incremented. A frame is dropped at the first bit which does not fit,
+ *            irmp_get_data() and the end of irmp_ISR() would reject it anyway. NEC is received as NEC42 until its stop bit, so such a
+ *            frame is dropped after 32 bits if it fits neither NEC nor NEC42, only with IRMP_EARLY_ABORT_NEC42. A NEC frame which fails
+ *            may still be APPLE or LGAIR.
+ *  @param    value of stored bit
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_check_bit (IRMP_CTX_PARAM_ uint_fast8_t value)
+{
+    uint_fast8_t    drop = FALSE;
+
+#if IRMP_SUPPORT_NEC_PROTOCOL == 1 || (IRMP_SUPPORT_NEC42_PROTOCOL == 1 && IRMP_EARLY_ABORT_NEC42 == 1)
+    if (irmp_bit == 0)
+    {
+        irmp_check_failed = 0;
+    }
 #endif
-#if IRMP_SUPPORT_FAN_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_FAN_PROTOCOL &&                             // FAN has no stop bit.
-                            irmp_bit >= FAN_COMPLETE_DATA_LEN - 1)                                  // last bit in frame
-                        {                                                                           // yes, break and close this frame
-                            if (irmp_pulse_time <= FAN_0_PULSE_LEN_MAX && irmp_pause_time >= FAN_0_PAUSE_LEN_MIN)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Generating virtual stop bit\n");
-#endif // ANALYZE
-                                got_light = TRUE;                                                   // this is a lie, but helps (generates stop bit)
-                            }
-                            else if (irmp_pulse_time >= FAN_1_PULSE_LEN_MIN && irmp_pause_time >= FAN_1_PAUSE_LEN_MIN)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Generating virtual stop bit\n");
-#endif // ANALYZE
-                                got_light = TRUE;                                                   // this is a lie, but helps (generates stop bit)
-                            }
-                        }
-                        else
-#endif
-#if IRMP_SUPPORT_SERIAL == 1
-                        // NETBOX generates no stop bit, here is the timeout condition:
-                        if ((irmp_param.flags & IRMP_PARAM_FLAG_IS_SERIAL) && irmp_param.protocol == IRMP_NETBOX_PROTOCOL &&
-                            irmp_pause_time >= NETBOX_PULSE_LEN * (NETBOX_COMPLETE_DATA_LEN - irmp_bit))
-                        {
-                            got_light = TRUE;                                                       // this is a lie, but helps (generates stop bit)
-                        }
-                        else
-#endif
-#if IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_GRUNDIG_PROTOCOL && !irmp_param.stop_bit)
-                        {
-                            if (irmp_pause_time > IR60_TIMEOUT_LEN && (irmp_bit == 5 || irmp_bit == 6))
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to IR60 protocol\n");
-#endif // ANALYZE
-                                got_light = TRUE;                                       // this is a lie, but generates a stop bit ;-)
-                                irmp_param.stop_bit = TRUE;                             // set flag
 
-                                irmp_param.protocol         = IRMP_IR60_PROTOCOL;       // change protocol
-                                irmp_param.complete_len     = IR60_COMPLETE_DATA_LEN;   // correct complete len
-                                irmp_param.address_offset   = IR60_ADDRESS_OFFSET;
-                                irmp_param.address_end      = IR60_ADDRESS_OFFSET + IR60_ADDRESS_LEN;
-                                irmp_param.command_offset   = IR60_COMMAND_OFFSET;
-                                irmp_param.command_end      = IR60_COMMAND_OFFSET + IR60_COMMAND_LEN;
+#if IRMP_SUPPORT_NEC42_PROTOCOL == 1 && IRMP_EARLY_ABORT_NEC42 == 1             // without it, NEC42 frames are not checked at all
+    if (irmp_param.protocol == IRMP_NEC42_PROTOCOL)
+    {
+        if (irmp_bit >= 13 && irmp_bit < 26)                                        // NEC42: 13 inverted address bits
+        {
+            if (value == IRMP_CHECK_REF (13, irmp_tmp_address >> (irmp_bit - 13)))
+            {
+                irmp_check_failed |= IRMP_CHECK_FAILED_NEC42;
+            }
+        }
+        else if (irmp_bit >= 34 && irmp_bit < 42)                                   // NEC42: 8 inverted command bits
+        {
+            if (value == IRMP_CHECK_REF (8, irmp_tmp_command >> (irmp_bit - 34)))
+            {
+                irmp_check_failed |= IRMP_CHECK_FAILED_NEC42;
+            }
+        }
 
-                                irmp_tmp_command <<= 1;
-                                irmp_tmp_command |= first_bit;
-                            }
-                            else if (irmp_pause_time >= 2 * irmp_param.pause_1_len_max && irmp_bit >= GRUNDIG_COMPLETE_DATA_LEN - 2)
-                            {                                                           // special manchester decoder
-                                irmp_param.complete_len = GRUNDIG_COMPLETE_DATA_LEN;    // correct complete len
-                                got_light = TRUE;                                       // this is a lie, but generates a stop bit ;-)
-                                irmp_param.stop_bit = TRUE;                             // set flag
-                            }
-                            else if (irmp_bit >= GRUNDIG_COMPLETE_DATA_LEN)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to NOKIA protocol, irmp_bit = %d\n", irmp_bit);
-#endif // ANALYZE
-                                irmp_param.protocol         = IRMP_NOKIA_PROTOCOL;      // change protocol
-                                irmp_param.address_offset   = NOKIA_ADDRESS_OFFSET;
-                                irmp_param.address_end      = NOKIA_ADDRESS_OFFSET + NOKIA_ADDRESS_LEN;
-                                irmp_param.command_offset   = NOKIA_COMMAND_OFFSET;
-                                irmp_param.command_end      = NOKIA_COMMAND_OFFSET + NOKIA_COMMAND_LEN;
+#if IRMP_SUPPORT_NEC_PROTOCOL == 1
+        if (irmp_bit >= 24 && irmp_bit < 32)                                        // NEC: 8 inverted command bits, command is in irmp_tmp_address2
+        {
+            if (value == IRMP_CHECK_REF (8, irmp_tmp_address2 >> (irmp_bit - 21)))
+            {
+                irmp_check_failed |= IRMP_CHECK_FAILED_NEC;
+            }
+        }
 
-                                if (irmp_tmp_command & 0x300)
-                                {
-                                    irmp_tmp_address = (irmp_tmp_command >> 8);
-                                    irmp_tmp_command &= 0xFF;
-                                }
-                            }
-                        }
-                        else
+        if (irmp_bit == 31 && (irmp_check_failed & IRMP_CHECK_FAILED_NEC))
+        {
+#if IRMP_USE_RAW_FRAME == 1
+            if (irmp_raw_pending)
+            {
+                irmp_raw_extract (IRMP_CTX_ARG);
+            }
 #endif
-#if IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_RUWIDO_PROTOCOL && !irmp_param.stop_bit)
-                        {
-                            if (irmp_pause_time >= 2 * irmp_param.pause_1_len_max && irmp_bit >= RUWIDO_COMPLETE_DATA_LEN - 2)
-                            {                                                           // special manchester decoder
-                                irmp_param.complete_len = RUWIDO_COMPLETE_DATA_LEN;     // correct complete len
-                                got_light = TRUE;                                       // this is a lie, but generates a stop bit ;-)
-                                irmp_param.stop_bit = TRUE;                             // set flag
-                            }
-                            else if (irmp_bit >= RUWIDO_COMPLETE_DATA_LEN)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to SIEMENS protocol\n");
-#endif // ANALYZE
-                                irmp_param.protocol         = IRMP_SIEMENS_PROTOCOL;    // change protocol
-                                irmp_param.address_offset   = SIEMENS_ADDRESS_OFFSET;
-                                irmp_param.address_end      = SIEMENS_ADDRESS_OFFSET + SIEMENS_ADDRESS_LEN;
-                                irmp_param.command_offset   = SIEMENS_COMMAND_OFFSET;
-                                irmp_param.command_end      = SIEMENS_COMMAND_OFFSET + SIEMENS_COMMAND_LEN;
+            if ((irmp_tmp_address | ((irmp_tmp_address2 & 0x0007) << 13)) == 0x87EE)   // APPLE has no inverted command
+            {
+                irmp_check_failed &= ~IRMP_CHECK_FAILED_NEC;
+            }
+        }
 
-                                //                   76543210
-                                // RUWIDO:  AAAAAAAAACCCCCCCp
-                                // SIEMENS: AAAAAAAAAAACCCCCCCCCCp
-                                irmp_tmp_address <<= 2;
-                                irmp_tmp_address |= (irmp_tmp_command >> 6);
-                                irmp_tmp_command &= 0x003F;
-//                              irmp_tmp_command <<= 4;
-                                irmp_tmp_command |= last_value;
-                            }
-                        }
-                        else
+        if ((irmp_check_failed & IRMP_CHECK_FAILED_NEC42) && (irmp_bit >= 32 || (irmp_bit == 31 && (irmp_check_failed & IRMP_CHECK_FAILED_NEC))))
+#else
+        if ((irmp_check_failed & IRMP_CHECK_FAILED_NEC42) && irmp_bit >= 31)
 #endif
-#if IRMP_SUPPORT_ROOMBA_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_ROOMBA_PROTOCOL &&                          // Roomba has no stop bit
-                            irmp_bit >= ROOMBA_COMPLETE_DATA_LEN - 1)                               // it's the last data bit...
-                        {                                                                           // break and close this frame
-                            if (irmp_pulse_time >= ROOMBA_1_PULSE_LEN_MIN && irmp_pulse_time <= ROOMBA_1_PULSE_LEN_MAX)
-                            {
-                                irmp_pause_time = ROOMBA_1_PAUSE_LEN_EXACT;
-                            }
-                            else if (irmp_pulse_time >= ROOMBA_0_PULSE_LEN_MIN && irmp_pulse_time <= ROOMBA_0_PULSE_LEN_MAX)
-                            {
-                                irmp_pause_time = ROOMBA_0_PAUSE_LEN;
-                            }
+        {
+            drop = TRUE;
+        }
+    }
+    else
+#endif // IRMP_SUPPORT_NEC42_PROTOCOL == 1 && IRMP_EARLY_ABORT_NEC42 == 1
+#if IRMP_SUPPORT_NEC_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_NEC_PROTOCOL)
+    {
+        if (irmp_bit >= 24 && irmp_bit < 32)                                        // 8 inverted command bits
+        {
+            if (value == IRMP_CHECK_REF (8, irmp_tmp_command >> (irmp_bit - 24)))
+            {
+                irmp_check_failed |= IRMP_CHECK_FAILED_NEC;
+            }
+        }
 
-                            got_light = TRUE;                                                       // this is a lie, but helps (generates stop bit)
-                        }
-                        else
+        if (irmp_bit == 31 && (irmp_check_failed & IRMP_CHECK_FAILED_NEC))          // not before: 28 bits of LGAIR fail, too
+        {
+#if IRMP_USE_RAW_FRAME == 1
+            if (irmp_raw_pending)
+            {
+                irmp_raw_extract (IRMP_CTX_ARG);
+            }
 #endif
-#if IRMP_SUPPORT_MANCHESTER == 1
-                        if ((irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER) &&
-                            irmp_pause_time >= 2 * irmp_param.pause_1_len_max && irmp_bit >= irmp_param.complete_len - 2 && !irmp_param.stop_bit)
-                        {                                                       // special manchester decoder
-                            got_light = TRUE;                                   // this is a lie, but generates a stop bit ;-)
-                            irmp_param.stop_bit = TRUE;                         // set flag
-                        }
-                        else
-#endif // IRMP_SUPPORT_MANCHESTER == 1
-                        if (irmp_pause_time > IRMP_TIMEOUT_LEN)                 // timeout?
-                        {                                                       // yes...
-                            if (irmp_bit == irmp_param.complete_len - 1 && irmp_param.stop_bit == 0)
-                            {
-                                irmp_bit++;
-                            }
-#if IRMP_SUPPORT_JVC_PROTOCOL == 1
-                            else if (irmp_param.protocol == IRMP_NEC_PROTOCOL && (irmp_bit == 16 || irmp_bit == 17))      // it was a JVC stop bit
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to JVC protocol, irmp_bit = %d\n", irmp_bit);
-#endif // ANALYZE
-                                irmp_param.stop_bit     = TRUE;                                     // set flag
-                                irmp_param.protocol     = IRMP_JVC_PROTOCOL;                        // switch protocol
-                                irmp_param.complete_len = irmp_bit;                                 // patch length: 16 or 17
-                                irmp_tmp_command        = (irmp_tmp_address >> 4);                  // set command: upper 12 bits are command bits
-                                irmp_tmp_address        = irmp_tmp_address & 0x000F;                // lower 4 bits are address bits
-                                irmp_start_bit_detected = 1;                                        // tricky: don't wait for another start bit...
-                            }
-#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
-#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
-                            else if (irmp_param.protocol == IRMP_NEC_PROTOCOL && (irmp_bit == 28 || irmp_bit == 29))      // it was a LGAIR stop bit
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to LGAIR protocol, irmp_bit = %d\n", irmp_bit);
-#endif // ANALYZE
-                                irmp_param.stop_bit     = TRUE;                                     // set flag
-                                irmp_param.protocol     = IRMP_LGAIR_PROTOCOL;                      // switch protocol
-                                irmp_param.complete_len = irmp_bit;                                 // patch length: 16 or 17
-                                irmp_tmp_command        = irmp_lgair_command;                       // set command: upper 8 bits are command bits
-                                irmp_tmp_address        = irmp_lgair_address;                       // lower 4 bits are address bits
-                                irmp_start_bit_detected = 1;                                        // tricky: don't wait for another start bit...
-                            }
-#endif // IRMP_SUPPORT_LGAIR_PROTOCOL == 1
+            if (irmp_tmp_address != 0x87EE)                                         // APPLE has no inverted command
+            {
+                drop = TRUE;
+            }
+        }
+    }
+    else
+#endif // IRMP_SUPPORT_NEC_PROTOCOL == 1
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_KASEIKYO_PROTOCOL)
+    {
+        if (irmp_bit == 19)                                                         // XOR nibble of customer id complete
+        {
+            uint_fast8_t xor_value = (irmp_xor_check[0] & 0x0F) ^ ((irmp_xor_check[0] & 0xF0) >> 4) ^ (irmp_xor_check[1] & 0x0F) ^ ((irmp_xor_check[1] & 0xF0) >> 4);
 
-#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
-#if IRMP_SUPPORT_NEC_PROTOCOL == 1
-                            else if (irmp_param.protocol == IRMP_NEC42_PROTOCOL && irmp_bit == 32)      // it was a NEC stop bit
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to NEC protocol\n");
-#endif // ANALYZE
-                                irmp_param.stop_bit     = TRUE;                                     // set flag
-                                irmp_param.protocol     = IRMP_NEC_PROTOCOL;                        // switch protocol
-                                irmp_param.complete_len = irmp_bit;                                 // patch length: 16 or 17
+            if (xor_value != (irmp_xor_check[2] & 0x0F))
+            {
+                drop = TRUE;
+            }
+        }
+        else if (irmp_bit >= 40 && irmp_bit < 48)                                   // XOR byte of data bits
+        {
+            if (value != (((irmp_xor_check[2] ^ irmp_xor_check[3] ^ irmp_xor_check[4]) >> (irmp_bit - 40)) & 0x01))
+            {
+                drop = TRUE;
+            }
+        }
+    }
+    else
+#endif // IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+    {
+        ;
+    }
 
-                                //        0123456789ABC0123456789ABC0123456701234567
-                                // NEC42: AAAAAAAAAAAAAaaaaaaaaaaaaaCCCCCCCCcccccccc
-                                // NEC:   AAAAAAAAaaaaaaaaCCCCCCCCcccccccc
-                                irmp_tmp_address        |= (irmp_tmp_address2 & 0x0007) << 13;      // fm 2012-02-13: 12 -> 13
-                                irmp_tmp_command        = (irmp_tmp_address2 >> 3) | (irmp_tmp_command << 10);
-                            }
-#endif // IRMP_SUPPORT_NEC_PROTOCOL == 1
-#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
-                            else if (irmp_param.protocol == IRMP_NEC42_PROTOCOL && irmp_bit == 28)      // it was a NEC stop bit
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to LGAIR protocol\n");
-#endif // ANALYZE
-                                irmp_param.stop_bit     = TRUE;                                     // set flag
-                                irmp_param.protocol     = IRMP_LGAIR_PROTOCOL;                      // switch protocol
-                                irmp_param.complete_len = irmp_bit;                                 // patch length: 16 or 17
-                                irmp_tmp_address        = irmp_lgair_address;
-                                irmp_tmp_command        = irmp_lgair_command;
-                            }
-#endif // IRMP_SUPPORT_LGAIR_PROTOCOL == 1
-#if IRMP_SUPPORT_JVC_PROTOCOL == 1
-                            else if (irmp_param.protocol == IRMP_NEC42_PROTOCOL && (irmp_bit == 16 || irmp_bit == 17))  // it was a JVC stop bit
-                            {
+    if (drop)
+    {
 #ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to JVC protocol, irmp_bit = %d\n", irmp_bit);
+        ANALYZE_PRINTF ("%8.3fms early abort: %s frame dropped, check of data bit %d failed\n", (double) (time_counter * 1000) / F_INTERRUPTS,
+                        irmp_protocol_names[irmp_param.protocol], irmp_bit);
 #endif // ANALYZE
-                                irmp_param.stop_bit     = TRUE;                                     // set flag
-                                irmp_param.protocol     = IRMP_JVC_PROTOCOL;                        // switch protocol
-                                irmp_param.complete_len = irmp_bit;                                 // patch length: 16 or 17
+        irmp_start_bit_detected = 0;                                                // reset flags and wait for next start bit
+        irmp_pause_time         = 0;
+#if IRMP_CANDIDATES > 1
+        irmp_candidate_count    = 0;
+#endif
+    }
+}
+#endif // IRMP_EARLY_ABORT == 1
 
-                                //        0123456789ABC0123456789ABC0123456701234567
-                                // NEC42: AAAAAAAAAAAAAaaaaaaaaaaaaaCCCCCCCCcccccccc
-                                // JVC:   AAAACCCCCCCCCCCC
-                                irmp_tmp_command        = (irmp_tmp_address >> 4) | (irmp_tmp_address2 << 9);   // set command: upper 12 bits are command bits
-                                irmp_tmp_address        = irmp_tmp_address & 0x000F;                            // lower 4 bits are address bits
-                            }
-#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
-#endif // IRMP_SUPPORT_NEC42_PROTOCOL == 1
+#if IRMP_SUPPORT_BIT_REMAP == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  bit remap tables
+ *  @details  protocols with IRMP_PARAM_FLAG_BIT_REMAP spread their bits over address, command and irmp_genre2 in a special order.
+ *            One byte per data bit: upper nibble is the destination, lower nibble the bit position within the destination.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#define IRMP_REMAP_SKIP                         0x00                            // bit is not stored
+#define IRMP_REMAP_ADDRESS                      0x10                            // store bit in irmp_tmp_address
+#define IRMP_REMAP_COMMAND                      0x20                            // store bit in irmp_tmp_command
+#define IRMP_REMAP_GENRE2                       0x30                            // store bit in irmp_genre2 (KASEIKYO)
+#define IRMP_REMAP_DEST_MASK                    0xF0
+#define IRMP_REMAP_BIT_MASK                     0x0F
+
+#define R__                                     IRMP_REMAP_SKIP
+#define RA(b)                                   (IRMP_REMAP_ADDRESS | (b))
+#define RC(b)                                   (IRMP_REMAP_COMMAND | (b))
+#define RG(b)                                   (IRMP_REMAP_GENRE2  | (b))
 
-#if IRMP_SUPPORT_SAMSUNG48_PROTOCOL == 1
-                            else if (irmp_param.protocol == IRMP_SAMSUNG48_PROTOCOL && irmp_bit == 32)          // it was a SAMSUNG32 stop bit
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to SAMSUNG32 protocol\n");
-#endif // ANALYZE
-                                irmp_param.protocol         = IRMP_SAMSUNG32_PROTOCOL;
-                                irmp_param.command_offset   = SAMSUNG32_COMMAND_OFFSET;
-                                irmp_param.command_end      = SAMSUNG32_COMMAND_OFFSET + SAMSUNG32_COMMAND_LEN;
-                                irmp_param.complete_len     = SAMSUNG32_COMPLETE_DATA_LEN;
-                            }
-#endif // IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+// KASEIKYO-Frame: 16 manufacturer bits, 4 parity bits, 4 genre1 bits, 4 genre2 bits, 12 command bits, 8 parity bits, all LSB first
+// genre1 goes into the upper nibble of the command, genre2 into the upper nibble of the flags, see irmp_ISR()
+static const PROGMEM uint8_t kaseikyo_remap[KASEIKYO_COMPLETE_DATA_LEN] =
+{
+    RA(0),  RA(1),  RA(2),  RA(3),  RA(4),  RA(5),  RA(6),  RA(7),                                  // bit  0 -  7
+    RA(8),  RA(9),  RA(10), RA(11), RA(12), RA(13), RA(14), RA(15),                                 // bit  8 - 15
+    R__,    R__,    R__,    R__,    RC(12), RC(13), RC(14), RC(15),                                 // bit 16 - 23
+    RG(4),  RG(5),  RG(6),  RG(7),  RC(0),  RC(1),  RC(2),  RC(3),                                  // bit 24 - 31
+    RC(4),  RC(5),  RC(6),  RC(7),  RC(8),  RC(9),  RC(10), RC(11),                                 // bit 32 - 39
+    R__,    R__,    R__,    R__,    R__,    R__,    R__,    R__                                     // bit 40 - 47
+};
+#endif // IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
 
-#if IRMP_SUPPORT_RCMM_PROTOCOL == 1
-                            else if (irmp_param.protocol == IRMP_RCMM32_PROTOCOL && (irmp_bit == 12 || irmp_bit == 24))  // it was a RCMM stop bit
-                            {
-                                if (irmp_bit == 12)
-                                {
-                                    irmp_tmp_command = (irmp_tmp_address & 0xFF);                   // set command: lower 8 bits are command bits
-                                    irmp_tmp_address >>= 8;                                         // upper 4 bits are address bits
+#if IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+// RCCAR-Frame (LSB first):
+// Bit 12 11 10 9  8  7  6  5  4  3  2  1  0
+//     V  D7 D6 D5 D4 D3 D2 D1 D0 A1 A0 C1 C0
+//
+// irmp_data_p->address: A1 A0
+// irmp_data_p->command: V C1 C0 D7 D6 D5 D4 D3 D2 D1 D0
+static const PROGMEM uint8_t rccar_remap[RCCAR_COMPLETE_DATA_LEN] =
+{
+    RC(8),  RC(9),  RA(0),  RA(1),  RC(0),  RC(1),  RC(2),  RC(3),                                  // bit  0 -  7
+    RC(4),  RC(5),  RC(6),  RC(7),  RC(10)                                                          // bit  8 - 12
+};
+#endif // IRMP_SUPPORT_RCCAR_PROTOCOL == 1
 
-#ifdef ANALYZE
-                                    ANALYZE_PRINTF ("Switching to RCMM12 protocol, irmp_bit = %d\n", irmp_bit);
-#endif // ANALYZE
-                                    irmp_param.protocol     = IRMP_RCMM12_PROTOCOL;                 // switch protocol
-                                }
-                                else // if ((irmp_bit == 24)
-                                {
-#ifdef ANALYZE
-                                    ANALYZE_PRINTF ("Switching to RCMM24 protocol, irmp_bit = %d\n", irmp_bit);
-#endif // ANALYZE
-                                    irmp_param.protocol     = IRMP_RCMM24_PROTOCOL;                 // switch protocol
-                                }
-                                irmp_param.stop_bit     = TRUE;                                     // set flag
-                                irmp_param.complete_len = irmp_bit;                                 // patch length
-                            }
-#endif // IRMP_SUPPORT_RCMM_PROTOCOL == 1
+#if IRMP_SUPPORT_ACP24_PROTOCOL == 1
+// ACP24-Frame, squeeze 70 bits into 16 bits:
+//           1         2         3         4         5         6
+// 0123456789012345678901234567890123456789012345678901234567890123456789
+// N VVMMM    ? ???    t vmA x                 y                     TTTT
+//
+// irmp_data_p->command:
+//
+//         5432109876543210
+//         NAVVvMMMmtxyTTTT
+static const PROGMEM uint8_t acp24_remap[ACP24_COMPLETE_DATA_LEN] =
+{
+    RC(15), R__,    RC(13), RC(12), RC(10), RC(9),  RC(8),  R__,    R__,    R__,                    // bit  0 -  9
+    R__,    R__,    R__,    R__,    R__,    R__,    R__,    R__,    R__,    R__,                    // bit 10 - 19
+    RC(6),  R__,    RC(11), RC(7),  RC(14), R__,    RC(5),  R__,    R__,    R__,                    // bit 20 - 29
+    R__,    R__,    R__,    R__,    R__,    R__,    R__,    R__,    R__,    R__,                    // bit 30 - 39
+    R__,    R__,    R__,    R__,    RC(4),  R__,    R__,    R__,    R__,    R__,                    // bit 40 - 49
+    R__,    R__,    R__,    R__,    R__,    R__,    R__,    R__,    R__,    R__,                    // bit 50 - 59
+    R__,    R__,    R__,    R__,    R__,    R__,    RC(3),  RC(2),  RC(1),  RC(0)                   // bit 60 - 69
+};
+#endif // IRMP_SUPPORT_ACP24_PROTOCOL == 1
 
-#if IRMP_SUPPORT_TECHNICS_PROTOCOL == 1
-                            else if (irmp_param.protocol == IRMP_MATSUSHITA_PROTOCOL && irmp_bit == 22)  // it was a TECHNICS stop bit
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to TECHNICS protocol, irmp_bit = %d\n", irmp_bit);
-#endif // ANALYZE
-                                // Situation:
-                                // The first 12 bits have been stored in irmp_tmp_command (LSB first)
-                                // The following 10 bits have been stored in irmp_tmp_address (LSB first)
-                                // The code of TECHNICS is:
-                                //   cccccccccccCCCCCCCCCCC (11 times c and 11 times C)
-                                //   ccccccccccccaaaaaaaaaa
-                                // where C is inverted value of c
+#undef R__
+#undef RA
+#undef RC
+#undef RG
 
-                                irmp_tmp_address <<= 1;
-                                if (irmp_tmp_command & (1<<11))
-                                {
-                                    irmp_tmp_address |= 1;
-                                    irmp_tmp_command &= ~(1<<11);
-                                }
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  get remap table entry
+ *  @details  one table lookup instead of range checks and shifts for every bit
+ *  @param    protocol, bit number
+ *  @return   IRMP_REMAP_xxx | bit position, IRMP_REMAP_SKIP if bit is not stored
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static uint_fast8_t
+irmp_bit_remap (uint_fast8_t protocol, uint_fast8_t bit)
+{
+    const uint8_t * remap_p;
+    uint_fast8_t    len;
+    uint8_t         remap;
 
-                                if (irmp_tmp_command == ((~irmp_tmp_address) & 0x07FF))
-                                {
-                                    irmp_tmp_address = 0;
+    switch (protocol)
+    {
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+        case IRMP_KASEIKYO_PROTOCOL:    remap_p = kaseikyo_remap;   len = KASEIKYO_COMPLETE_DATA_LEN;   break;
+#endif
+#if IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+        case IRMP_RCCAR_PROTOCOL:       remap_p = rccar_remap;      len = RCCAR_COMPLETE_DATA_LEN;      break;
+#endif
+#if IRMP_SUPPORT_ACP24_PROTOCOL == 1
+        case IRMP_ACP24_PROTOCOL:       remap_p = acp24_remap;      len = ACP24_COMPLETE_DATA_LEN;      break;
+#endif
+        default:                        return IRMP_REMAP_SKIP;
+    }
 
-                                    irmp_param.protocol     = IRMP_TECHNICS_PROTOCOL;                   // switch protocol
-                                    irmp_param.complete_len = irmp_bit;                                 // patch length
-                                }
-                                else
-                                {
-#ifdef ANALYZE
-                                    ANALYZE_PRINTF ("error 8: TECHNICS frame error\n");
-                                    ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
-#endif // ANALYZE
-                                    irmp_start_bit_detected = 0;                    // wait for another start bit...
-                                    irmp_pulse_time         = 0;
-                                    irmp_pause_time         = 0;
-                                }
-                            }
-#endif // IRMP_SUPPORT_TECHNICS_PROTOCOL == 1
-                            else
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("error 2: pause %d after data bit %d too long\n", irmp_pause_time, irmp_bit);
-                                ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
-#endif // ANALYZE
-                                irmp_start_bit_detected = 0;                    // wait for another start bit...
-                                irmp_pulse_time         = 0;
-                                irmp_pause_time         = 0;
-                            }
-                        }
-                    }
+    if (bit >= len)
+    {
+        return IRMP_REMAP_SKIP;
+    }
+
+    memcpy_P (&remap, remap_p + bit, sizeof (remap));
+    return remap;
+}
+#endif // IRMP_SUPPORT_BIT_REMAP == 1
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  store bit
+ *  @details  store bit in temp address or temp command
+ *  @param    value to store: 0 or 1
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+// verhindert, dass irmp_store_bit() inline compiliert wird:
+// static void irmp_store_bit (uint_fast8_t) __attribute__ ((noinline));
+
+static void
+irmp_store_bit_fields (IRMP_CTX_PARAM_ uint_fast8_t value)
+{
+#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_ORTEK_PROTOCOL)
+    {
+        if (irmp_bit < 14)
+        {
+            if (value)
+            {
+                irmp_parity++;
+            }
+        }
+        else if (irmp_bit == 14)
+        {
+            if (value)                                                                                      // value == 1: even parity
+            {
+                if (irmp_parity & 0x01)
+                {
+                    irmp_parity = PARITY_CHECK_FAILED;
                 }
                 else
-                {                                                               // got light now!
-                    got_light = TRUE;
+                {
+                    irmp_parity = PARITY_CHECK_OK;
                 }
-
-                if (got_light)
+            }
+            else
+            {
+                if (irmp_parity & 0x01)                                                                     // value == 0: odd parity
                 {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF ("%8.3fms [bit %2d: pulse = %3d, pause = %3d] ", (double) (time_counter * 1000) / F_INTERRUPTS, irmp_bit, irmp_pulse_time, irmp_pause_time);
-#endif // ANALYZE
-
-#if IRMP_SUPPORT_MANCHESTER == 1
-                    if ((irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER))                                     // Manchester
-                    {
-#if 1
-                        if (irmp_pulse_time > irmp_param.pulse_1_len_max /* && irmp_pulse_time <= 2 * irmp_param.pulse_1_len_max */)
-#else // better, but some IR-RCs use asymmetric timings :-/
-                        if (irmp_pulse_time > irmp_param.pulse_1_len_max && irmp_pulse_time <= 2 * irmp_param.pulse_1_len_max &&
-                            irmp_pause_time <= 2 * irmp_param.pause_1_len_max)
+                    irmp_parity = PARITY_CHECK_OK;
+                }
+                else
+                {
+                    irmp_parity = PARITY_CHECK_FAILED;
+                }
+            }
+        }
+    }
+    else
 #endif
-                        {
-#if IRMP_SUPPORT_RC6_PROTOCOL == 1
-                            if (irmp_param.protocol == IRMP_RC6_PROTOCOL && irmp_bit == 4 && irmp_pulse_time > RC6_TOGGLE_BIT_LEN_MIN)         // RC6 toggle bit
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PUTCHAR ('T');
-#endif // ANALYZE
-                                if (irmp_param.complete_len == RC6_COMPLETE_DATA_LEN_LONG)                      // RC6 mode 6A
-                                {
-                                    irmp_store_bit (1);
-                                    last_value = 1;
-                                }
-                                else                                                                            // RC6 mode 0
-                                {
-                                    irmp_store_bit (0);
-                                    last_value = 0;
-                                }
-#ifdef ANALYZE
-                                ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                            }
-                            else
-#endif // IRMP_SUPPORT_RC6_PROTOCOL == 1
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PUTCHAR ((irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? '0' : '1');
-#endif // ANALYZE
-                                irmp_store_bit ((irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? 0  :  1 );
+    {
+        ;
+    }
 
-#if IRMP_SUPPORT_RC6_PROTOCOL == 1
-                                if (irmp_param.protocol == IRMP_RC6_PROTOCOL && irmp_bit == 4 && irmp_pulse_time > RC6_TOGGLE_BIT_LEN_MIN)      // RC6 toggle bit
-                                {
-#ifdef ANALYZE
-                                    ANALYZE_PUTCHAR ('T');
-#endif // ANALYZE
-                                    irmp_store_bit (1);
+#if IRMP_SUPPORT_BIT_REMAP == 1
+    if (irmp_param.flags & IRMP_PARAM_FLAG_BIT_REMAP)
+    {
+        if (value)
+        {
+            uint_fast8_t    remap = irmp_bit_remap (irmp_param.protocol, irmp_bit);
+            uint_fast16_t   mask  = (uint_fast16_t) 1 << (remap & IRMP_REMAP_BIT_MASK);
 
-                                    if (irmp_pause_time > 2 * irmp_param.pause_1_len_max)
-                                    {
-                                        last_value = 0;
-                                    }
-                                    else
-                                    {
-                                        last_value = 1;
-                                    }
-#ifdef ANALYZE
-                                    ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                                }
-                                else
-#endif // IRMP_SUPPORT_RC6_PROTOCOL == 1
-                                {
-#ifdef ANALYZE
-                                    ANALYZE_PUTCHAR ((irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? '1' : '0');
-#endif // ANALYZE
-                                    irmp_store_bit ((irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? 1 :   0 );
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
-                                    if (! irmp_param2.protocol)
+            switch (remap & IRMP_REMAP_DEST_MASK)
+            {
+                case IRMP_REMAP_ADDRESS:    irmp_tmp_address |= mask;               break;
+                case IRMP_REMAP_COMMAND:    irmp_tmp_command |= mask;               break;
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+                case IRMP_REMAP_GENRE2:     irmp_genre2 |= (uint_fast8_t) mask;     break;
 #endif
-                                    {
-#ifdef ANALYZE
-                                        ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                                    }
-                                    last_value = (irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? 1 : 0;
-                                }
-                            }
-                        }
-                        else if (irmp_pulse_time >= irmp_param.pulse_1_len_min && irmp_pulse_time <= irmp_param.pulse_1_len_max
-                                 /* && irmp_pause_time <= 2 * irmp_param.pause_1_len_max */)
-                        {
-                            uint_fast8_t manchester_value;
-
-                            if (last_pause > irmp_param.pause_1_len_max && last_pause <= 2 * irmp_param.pause_1_len_max)
-                            {
-                                manchester_value = last_value ? 0 : 1;
-                                last_value  = manchester_value;
-                            }
-                            else
-                            {
-                                manchester_value = last_value;
-                            }
-
-#ifdef ANALYZE
-                            ANALYZE_PUTCHAR (manchester_value + '0');
-#endif // ANALYZE
+            }
+        }
+    }
+    else
+#endif // IRMP_SUPPORT_BIT_REMAP == 1
 
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
-                            if (! irmp_param2.protocol)
+#if IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
+    if (irmp_bit == 0 && irmp_param.protocol == IRMP_GRUNDIG_PROTOCOL)
+    {
+        irmp_first_bit = value;
+    }
+    else
 #endif
-                            {
-#ifdef ANALYZE
-                                ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                            }
-
-#if IRMP_SUPPORT_RC6_PROTOCOL == 1
-                            if (irmp_param.protocol == IRMP_RC6_PROTOCOL && irmp_bit == 1 && manchester_value == 1)     // RC6 mode != 0 ???
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to RC6A protocol\n");
-#endif // ANALYZE
-                                irmp_param.complete_len = RC6_COMPLETE_DATA_LEN_LONG;
-                                irmp_param.address_offset = 5;
-                                irmp_param.address_end = irmp_param.address_offset + 15;
-                                irmp_param.command_offset = irmp_param.address_end + 1;                                 // skip 1 system bit, changes like a toggle bit
-                                irmp_param.command_end = irmp_param.command_offset + 16 - 1;
-                                irmp_tmp_address = 0;
-                            }
-#endif // IRMP_SUPPORT_RC6_PROTOCOL == 1
 
-                            irmp_store_bit (manchester_value);
-                        }
-                        else
-                        {
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && IRMP_SUPPORT_FDC_PROTOCOL == 1
-                            if (irmp_param2.protocol == IRMP_FDC_PROTOCOL &&
-                                irmp_pulse_time >= FDC_PULSE_LEN_MIN && irmp_pulse_time <= FDC_PULSE_LEN_MAX &&
-                                ((irmp_pause_time >= FDC_1_PAUSE_LEN_MIN && irmp_pause_time <= FDC_1_PAUSE_LEN_MAX) ||
-                                 (irmp_pause_time >= FDC_0_PAUSE_LEN_MIN && irmp_pause_time <= FDC_0_PAUSE_LEN_MAX)))
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PUTCHAR ('?');
-#endif // ANALYZE
-                                irmp_param.protocol = 0;                // switch to FDC, see below
-                            }
-                            else
-#endif // IRMP_SUPPORT_FDC_PROTOCOL == 1
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && IRMP_SUPPORT_RCCAR_PROTOCOL == 1
-                            if (irmp_param2.protocol == IRMP_RCCAR_PROTOCOL &&
-                                irmp_pulse_time >= RCCAR_PULSE_LEN_MIN && irmp_pulse_time <= RCCAR_PULSE_LEN_MAX &&
-                                ((irmp_pause_time >= RCCAR_1_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_1_PAUSE_LEN_MAX) ||
-                                 (irmp_pause_time >= RCCAR_0_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_0_PAUSE_LEN_MAX)))
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PUTCHAR ('?');
-#endif // ANALYZE
-                                irmp_param.protocol = 0;                // switch to RCCAR, see below
-                            }
-                            else
+    if (irmp_bit >= irmp_param.address_offset && irmp_bit < irmp_param.address_end)
+    {
+        if (irmp_param.lsb_first)
+        {
+            irmp_tmp_address |= (((uint_fast16_t) (value)) << (irmp_bit - irmp_param.address_offset));   // CV wants cast
+        }
+        else
+        {
+            irmp_tmp_address <<= 1;
+            irmp_tmp_address |= value;
+        }
+    }
+    else if (irmp_bit >= irmp_param.command_offset && irmp_bit < irmp_param.command_end)
+    {
+        if (irmp_param.lsb_first)
+        {
+#if IRMP_SUPPORT_SAMSUNG48_PROTOCOL == 1
+            if (irmp_param.protocol == IRMP_SAMSUNG48_PROTOCOL && irmp_bit >= 32)
+            {
+                irmp_tmp_id |= (((uint_fast16_t) (value)) << (irmp_bit - 32));   // CV wants cast
+            }
+            else
+#endif
+            {
+                irmp_tmp_command |= (((uint_fast16_t) (value)) << (irmp_bit - irmp_param.command_offset));   // CV wants cast
+            }
+        }
+        else
+        {
+            irmp_tmp_command <<= 1;
+            irmp_tmp_command |= value;
+        }
+    }
+
+#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_NEC_PROTOCOL || irmp_param.protocol == IRMP_NEC42_PROTOCOL)
+    {
+        if (irmp_bit < 8)
+        {
+            irmp_lgair_address <<= 1;                                                               // LGAIR uses MSB
+            irmp_lgair_address |= value;
+        }
+        else if (irmp_bit < 24)
+        {
+            irmp_lgair_command <<= 1;                                                               // LGAIR uses MSB
+            irmp_lgair_command |= value;
+        }
+    }
+    // NO else!
+#endif
+
+#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_NEC42_PROTOCOL && irmp_bit >= 13 && irmp_bit < 26)
+    {
+        irmp_tmp_address2 |= (((uint_fast16_t) (value)) << (irmp_bit - 13));                             // CV wants cast
+    }
+    else
+#endif
+
+#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_SAMSUNG_PROTOCOL && irmp_bit >= SAMSUNG_ID_OFFSET && irmp_bit < SAMSUNG_ID_OFFSET + SAMSUNG_ID_LEN)
+    {
+        irmp_tmp_id |= (((uint_fast16_t) (value)) << (irmp_bit - SAMSUNG_ID_OFFSET));                    // store with LSB first
+    }
+    else
+#endif
+
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+    if (irmp_param.protocol == IRMP_KASEIKYO_PROTOCOL)                                               // genre bits are stored via kaseikyo_remap[]
+    {
+        if (irmp_bit < KASEIKYO_COMPLETE_DATA_LEN)
+        {
+            if (value)
+            {
+                irmp_xor_check[irmp_bit / 8] |= 1 << (irmp_bit % 8);
+            }
+            else
+            {
+                irmp_xor_check[irmp_bit / 8] &= ~(1 << (irmp_bit % 8));
+            }
+        }
+    }
+    else
+#endif
+    {
+        ;
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  store bit
+ *  @details  store bit with irmp_store_bit_fields(), with IRMP_USE_RAW_FRAME in irmp_tmp_raw, too
+ *  @param    value to store: 0 or 1
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_store_bit (IRMP_CTX_PARAM_ uint_fast8_t value)
+{
+#if IRMP_USE_RAW_FRAME == 1
+    irmp_tmp_raw = (irmp_tmp_raw << 1) | value;
+    irmp_tmp_raw_len++;
+
+    if (! irmp_raw_pending)                                                                         // else extracted at frame end
+#endif
+    {
+        irmp_store_bit_fields (IRMP_CTX_ARG_ value);
+    }
+
+#if IRMP_EARLY_ABORT == 1
+    irmp_check_bit (IRMP_CTX_ARG_ value);
+#endif
+
+    irmp_bit++;
+
+#if IRMP_ADDRESS_FILTER_LEN > 0 && (IRMP_SUPPORT_NEC_PROTOCOL == 1 || IRMP_SUPPORT_NEC42_PROTOCOL == 1)
+    irmp_address_filter_nec (IRMP_CTX_ARG);
+#endif
+#if IRMP_EARLY_MATCH_LEN > 0
+    irmp_early_match (IRMP_CTX_ARG);
+#endif
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  store bit
+ *  @details  store bit in temp address or temp command
+ *  @param    value to store: 0 or 1
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
+static void
+irmp_store_bit2 (IRMP_CTX_PARAM_ uint_fast8_t value)
+{
+    uint_fast8_t irmp_bit2;
+
+    if (irmp_param.protocol)
+    {
+        irmp_bit2 = irmp_bit - 2;
+    }
+    else
+    {
+        irmp_bit2 = irmp_bit - 1;
+    }
+
+#if IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+    if (irmp_param2.flags & IRMP_PARAM_FLAG_BIT_REMAP)
+    {
+        if (value)
+        {
+            uint_fast8_t    remap = irmp_bit_remap (irmp_param2.protocol, irmp_bit2);
+            uint_fast16_t   mask  = (uint_fast16_t) 1 << (remap & IRMP_REMAP_BIT_MASK);
+
+            if ((remap & IRMP_REMAP_DEST_MASK) == IRMP_REMAP_ADDRESS)
+            {
+                irmp_tmp_address2 |= mask;
+            }
+            else if ((remap & IRMP_REMAP_DEST_MASK) == IRMP_REMAP_COMMAND)
+            {
+                irmp_tmp_command2 |= mask;
+            }
+        }
+    }
+    else
 #endif // IRMP_SUPPORT_RCCAR_PROTOCOL == 1
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PUTCHAR ('?');
-                                ANALYZE_NEWLINE ();
-                                ANALYZE_PRINTF ("error 3 manchester: timing not correct: data bit %d,  pulse: %d, pause: %d\n", irmp_bit, irmp_pulse_time, irmp_pause_time);
-                                ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
-#endif // ANALYZE
-                                irmp_start_bit_detected = 0;                            // reset flags and wait for next start bit
-                                irmp_pause_time         = 0;
-                            }
-                        }
+    if (irmp_bit2 >= irmp_param2.address_offset && irmp_bit2 < irmp_param2.address_end)
+    {
+        irmp_tmp_address2 |= (((uint_fast16_t) (value)) << (irmp_bit2 - irmp_param2.address_offset));   // CV wants cast
+    }
+    else if (irmp_bit2 >= irmp_param2.command_offset && irmp_bit2 < irmp_param2.command_end)
+    {
+        irmp_tmp_command2 |= (((uint_fast16_t) (value)) << (irmp_bit2 - irmp_param2.command_offset));   // CV wants cast
+    }
+}
+#endif // IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
 
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && IRMP_SUPPORT_FDC_PROTOCOL == 1
-                        if (irmp_param2.protocol == IRMP_FDC_PROTOCOL && irmp_pulse_time >= FDC_PULSE_LEN_MIN && irmp_pulse_time <= FDC_PULSE_LEN_MAX)
-                        {
-                            if (irmp_pause_time >= FDC_1_PAUSE_LEN_MIN && irmp_pause_time <= FDC_1_PAUSE_LEN_MAX)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("   1 (FDC)\n");
-#endif // ANALYZE
-                                irmp_store_bit2 (1);
-                            }
-                            else if (irmp_pause_time >= FDC_0_PAUSE_LEN_MIN && irmp_pause_time <= FDC_0_PAUSE_LEN_MAX)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("   0 (FDC)\n");
-#endif // ANALYZE
-                                irmp_store_bit2 (0);
-                            }
+#if IRMP_CANDIDATES > 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Check data bit against candidates
+ *  @details  called with every data bit of the decoded protocol. Every candidate classifies the bit with its own timings and stores it.
+ *            A candidate is dropped if the bit fits neither its 1 nor its 0 or if it gets more bits than its frame length.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_candidate_bit (IRMP_CTX_PARAM)
+{
+    IRMP_CANDIDATE *    candidate_p;
+    uint_fast8_t        live = 0;
+    uint_fast8_t        i;
 
-                            if (! irmp_param.protocol)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to FDC protocol\n");
-#endif // ANALYZE
-                                memcpy (&irmp_param, &irmp_param2, sizeof (IRMP_PARAMETER));
-                                irmp_param2.protocol = 0;
-                                irmp_tmp_address = irmp_tmp_address2;
-                                irmp_tmp_command = irmp_tmp_command2;
-                            }
-                        }
-#endif // IRMP_SUPPORT_FDC_PROTOCOL == 1
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && IRMP_SUPPORT_RCCAR_PROTOCOL == 1
-                        if (irmp_param2.protocol == IRMP_RCCAR_PROTOCOL && irmp_pulse_time >= RCCAR_PULSE_LEN_MIN && irmp_pulse_time <= RCCAR_PULSE_LEN_MAX)
-                        {
-                            if (irmp_pause_time >= RCCAR_1_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_1_PAUSE_LEN_MAX)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("   1 (RCCAR)\n");
-#endif // ANALYZE
-                                irmp_store_bit2 (1);
-                            }
-                            else if (irmp_pause_time >= RCCAR_0_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_0_PAUSE_LEN_MAX)
-                            {
+    for (i = 0; i < irmp_candidate_count; i++)
+    {
+        candidate_p = &irmp_candidate[i];
+
+        if (candidate_p->len >= candidate_p->param.complete_len || candidate_p->len >= IRMP_CANDIDATE_BITS)
+        {
+            continue;
+        }
+
+        if (irmp_pulse_time >= candidate_p->param.pulse_1_len_min && irmp_pulse_time <= candidate_p->param.pulse_1_len_max &&
+            irmp_pause_time >= candidate_p->param.pause_1_len_min && irmp_pause_time <= candidate_p->param.pause_1_len_max)
+        {
+            candidate_p->bits[candidate_p->len / 8] |= 1 << (candidate_p->len % 8);
+        }
+        else if (! (irmp_pulse_time >= candidate_p->param.pulse_0_len_min && irmp_pulse_time <= candidate_p->param.pulse_0_len_max &&
+                    irmp_pause_time >= candidate_p->param.pause_0_len_min && irmp_pause_time <= candidate_p->param.pause_0_len_max))
+        {
 #ifdef ANALYZE
-                                ANALYZE_PRINTF ("   0 (RCCAR)\n");
+            ANALYZE_PRINTF ("%8.3fms candidate %s dropped: bit %d,  pulse: %d, pause: %d\n", (double) (time_counter * 1000) / F_INTERRUPTS,
+                            irmp_protocol_names[candidate_p->param.protocol], candidate_p->len, irmp_pulse_time, irmp_pause_time);
 #endif // ANALYZE
-                                irmp_store_bit2 (0);
-                            }
+            continue;
+        }
+
+        candidate_p->len++;
+
+        if (live != i)
+        {
+            memcpy (&irmp_candidate[live], candidate_p, sizeof (IRMP_CANDIDATE));
+        }
+        live++;
+    }
+
+    irmp_candidate_count = live;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Switch to 1st candidate
+ *  @details  called if the decoded protocol got a wrong data bit. The 1st candidate becomes the decoded protocol: its bits are stored
+ *            again with irmp_store_bit(), then the frame continues with the next pulse.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_candidate_switch (IRMP_CTX_PARAM)
+{
+    IRMP_CANDIDATE *    candidate_p = &irmp_candidate[0];
+    uint_fast8_t        i;
 
-                            if (! irmp_param.protocol)
-                            {
 #ifdef ANALYZE
-                                ANALYZE_PRINTF ("Switching to RCCAR protocol\n");
+    ANALYZE_PRINTF ("%8.3fms switching to candidate %s after %d bits\n", (double) (time_counter * 1000) / F_INTERRUPTS,
+                    irmp_protocol_names[candidate_p->param.protocol], candidate_p->len);
+    candidates_switches++;
 #endif // ANALYZE
-                                memcpy (&irmp_param, &irmp_param2, sizeof (IRMP_PARAMETER));
-                                irmp_param2.protocol = 0;
-                                irmp_tmp_address = irmp_tmp_address2;
-                                irmp_tmp_command = irmp_tmp_command2;
-                            }
-                        }
-#endif // IRMP_SUPPORT_RCCAR_PROTOCOL == 1
 
-                        last_pause      = irmp_pause_time;
-                        wait_for_space  = 0;
-                    }
-                    else
-#endif // IRMP_SUPPORT_MANCHESTER == 1
+    memcpy (&irmp_param, &candidate_p->param, sizeof (IRMP_PARAMETER));
+#if IRMP_LEARNED_WINDOWS > 0
+    irmp_tmp_quality.start_bit = 0;                                         // timing is not the one of the start bit table entry
+#endif
+
+    irmp_tmp_command        = 0;                                            // same as at start of frame
+    irmp_tmp_address        = 0;
+#if IRMP_USE_RAW_FRAME == 1
+    irmp_tmp_raw            = 0;
+    irmp_tmp_raw_len        = 0;
+    irmp_raw_pending        = (irmp_param.flags & IRMP_PARAM_FLAG_RAW_FIELDS) ? TRUE : FALSE;
+#endif
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+    irmp_genre2             = 0;
+#endif
+#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+    irmp_tmp_id             = 0;
+#endif
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1) || IRMP_SUPPORT_NEC42_PROTOCOL == 1
+    irmp_tmp_command2       = 0;
+    irmp_tmp_address2       = 0;
+#endif
+#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
+    irmp_lgair_command      = 0;
+    irmp_lgair_address      = 0;
+#endif
+    irmp_bit                = 0;
+    irmp_start_bit_detected = 1;
+    irmp_wait_for_space     = 0;
+
+    for (i = 0; i < candidate_p->len && irmp_start_bit_detected; i++)      // irmp_store_bit() may drop the frame, see address filter
+    {
+#ifdef ANALYZE
+        ANALYZE_ONLY_NORMAL_PUTCHAR ('0' + ((candidate_p->bits[i / 8] >> (i % 8)) & 1));
+#endif // ANALYZE
+        irmp_store_bit (IRMP_CTX_ARG_ (candidate_p->bits[i / 8] >> (i % 8)) & 1);
+    }
+
+    if (irmp_candidate_count)                                               // 0: frame dropped, all candidates reset
+    {
+        irmp_candidate_count--;
+        memmove (&irmp_candidate[0], &irmp_candidate[1], irmp_candidate_count * sizeof (IRMP_CANDIDATE));
+    }
+}
+#endif // IRMP_CANDIDATES > 1
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  auto repetition table
+ *  @details  some remotes send every frame several times. frame 0 is the 1st frame of a command, frame n is the n-th frame of the same
+ *            command, each within window ticks after the frame before. Frames 1 ... frames are auto repetitions, with
+ *            IRMP_AUTO_REPETITION_ODD every odd frame. Auto repetitions are skipped, with IRMP_AUTO_REPETITION_RETURN they are returned
+ *            with IRMP_FLAG_AUTO_REPETITION. The last entry (protocol 0) holds the window of all other protocols.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#define IRMP_AUTO_REPETITION_ODD                0x01                            // every odd frame is an auto repetition
+#define IRMP_AUTO_REPETITION_RETURN             0x02                            // return auto repetition with IRMP_FLAG_AUTO_REPETITION
+
+typedef struct
+{
+    uint8_t                             protocol;                               // protocol, 0: end of table
+    uint8_t                             frames;                                 // frames 1 ... frames are auto repetitions
+    uint8_t                             flags;                                  // IRMP_AUTO_REPETITION_xxx
+    uint16_t                            window;                                 // max. ticks between end of frame and end of repetition
+} IRMP_AUTO_REPETITION;
+
+static const PROGMEM IRMP_AUTO_REPETITION irmp_auto_repetition_list[] =
+{
+#if IRMP_SUPPORT_SIRCS_PROTOCOL == 1
+#  if IRMP_SIRCS_LOW_LATENCY == 1
+    { IRMP_SIRCS_PROTOCOL,      2,  IRMP_AUTO_REPETITION_RETURN,    AUTO_FRAME_REPETITION_LEN },    // SIRCS: 2nd and 3rd frame
+#  else
+    { IRMP_SIRCS_PROTOCOL,      2,  0,                              AUTO_FRAME_REPETITION_LEN },    // SIRCS: 2nd and 3rd frame
+#  endif
+#endif
+#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+    { IRMP_ORTEK_PROTOCOL,      1,  0,                              AUTO_FRAME_REPETITION_LEN },    // ORTEK: 2nd frame
+#endif
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+    { IRMP_KASEIKYO_PROTOCOL,   1,  0,                              AUTO_FRAME_REPETITION_LEN },    // KASEIKYO: 2nd frame
+#endif
+#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+    { IRMP_SAMSUNG32_PROTOCOL,  0,  IRMP_AUTO_REPETITION_ODD,       AUTO_FRAME_REPETITION_LEN },    // SAMSUNG32: every 2nd frame
+    { IRMP_SAMSUNG48_PROTOCOL,  0,  IRMP_AUTO_REPETITION_ODD,       AUTO_FRAME_REPETITION_LEN },    // SAMSUNG48: every 2nd frame
+#endif
+#if IRMP_SUPPORT_NUBERT_PROTOCOL == 1
+    { IRMP_NUBERT_PROTOCOL,     0,  IRMP_AUTO_REPETITION_ODD,       AUTO_FRAME_REPETITION_LEN },    // NUBERT: every 2nd frame
+#endif
+#if IRMP_SUPPORT_SPEAKER_PROTOCOL == 1
+    { IRMP_SPEAKER_PROTOCOL,    0,  IRMP_AUTO_REPETITION_ODD,       AUTO_FRAME_REPETITION_LEN },    // SPEAKER: every 2nd frame
+#endif
+    { 0,                        0,  0,                              AUTO_FRAME_REPETITION_LEN }     // all other protocols
+};
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Auto repetition
+ *  @details  called at frame end: counts the frames of the same command and checks the frame number against irmp_auto_repetition_list[]
+ *  @return   TRUE: skip frame, FALSE: detect frame, auto repetitions are flagged with IRMP_FLAG_AUTO_REPETITION
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static uint_fast8_t
+irmp_auto_repetition (IRMP_CTX_PARAM)
+{
+    const IRMP_AUTO_REPETITION *    list_p = irmp_auto_repetition_list;
+    IRMP_AUTO_REPETITION            entry;
+
+    do
+    {
+        memcpy_P (&entry, list_p++, sizeof (IRMP_AUTO_REPETITION));
+    } while (entry.protocol && entry.protocol != irmp_param.protocol);
+
+    if (last_irmp_command == irmp_tmp_command && irmp_repetition_ticks < entry.window)
+    {
+        irmp_repetition_frame_number++;
+    }
+    else
+    {
+        irmp_repetition_frame_number = 0;
+    }
+
+    if (entry.protocol && irmp_repetition_frame_number &&
+        ((entry.flags & IRMP_AUTO_REPETITION_ODD) ? (irmp_repetition_frame_number & 0x01) : irmp_repetition_frame_number <= entry.frames))
+    {
+#ifdef ANALYZE
+        ANALYZE_PRINTF ("code %s: %s auto repetition frame #%d, counter = %d, auto repetition len = %d\n",
+                        (entry.flags & IRMP_AUTO_REPETITION_RETURN) ? "flagged" : "skipped", irmp_protocol_names[entry.protocol],
+                        irmp_repetition_frame_number + 1, (int) irmp_repetition_ticks, (int) entry.window);
+#endif // ANALYZE
+        if (entry.flags & IRMP_AUTO_REPETITION_RETURN)
+        {
+            irmp_flags |= IRMP_FLAG_AUTO_REPETITION;
+            return FALSE;
+        }
+        return TRUE;
+    }
+    return FALSE;
+}
+
+#if IRMP_GLITCH_FILTER_LEN > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Glitch filter
+ *  @details  the filtered level follows the input after irmp_glitch_filter_len samples of the new level, shorter levels are masked
+ *  @param    irmp_input: sampled input, 0 = pulse (light)
+ *  @return   filtered input, 0 = pulse (light), 1 = pause (dark)
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static uint_fast8_t
+irmp_glitch_filter (IRMP_CTX_PARAM_ uint_fast8_t irmp_input)
+{
+    if ((! irmp_input) == irmp_filter_light)                                // same level
+    {
+        irmp_filter_count = 0;
+    }
+    else if (++irmp_filter_count >= irmp_glitch_filter_len)                 // new level lasted long enough
+    {
+        irmp_filter_light = ! irmp_filter_light;
+        irmp_filter_count = 0;
+    }
+    return ! irmp_filter_light;
+}
+#endif // IRMP_GLITCH_FILTER_LEN > 0
+
+#if IRMP_USE_KEY_RELEASE == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Key release
+ *  @details  called while waiting for a start bit. If the key returned last is not repeated within irmp_key_repetition_len, the key is
+ *            detected again with IRMP_FLAG_RELEASE. irmp_get_data() does not convert it again and clears irmp_key_protocol.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_key_release (IRMP_CTX_PARAM)
+{
+    if (irmp_key_protocol && irmp_repetition_ticks >= irmp_key_repetition_len && ! irmp_ir_detected)
+    {
+#ifdef ANALYZE
+        ANALYZE_PRINTF ("%8.3fms key released after %d repetition frames\n", (double) (time_counter * 1000) / F_INTERRUPTS, irmp_key_hold);
+#endif // ANALYZE
+        irmp_protocol       = irmp_key_protocol;
+        irmp_address        = irmp_key_address;
+        irmp_command        = irmp_key_command;
+        irmp_flags          = IRMP_FLAG_RELEASE;
+        irmp_ir_detected    = TRUE;
+#if IRMP_USE_TIMESTAMP == 1
+        irmp_frame_ticks    = irmp_ticks;
+#endif
+    }
+}
+#endif // IRMP_USE_KEY_RELEASE == 1
+
+#if IRMP_USE_QUALITY == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Measure one pulse or pause length
+ *  @details  updates the deviation range of the length from the middle of its window, with learned windows also the range of the window
+ *            itself, and the margin of the frame
+ *  @param    length and window limits in ticks, pointers to min. and max. deviation, window: IRMP_QUALITY_PULSE_1 ... IRMP_QUALITY_PAUSE_0
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_quality_len (IRMP_CTX_PARAM_ uint_fast16_t len, uint_fast8_t min, uint_fast8_t max, int8_t * deviation_min_p, int8_t * deviation_max_p,
+                  uint_fast8_t window)
+{
+    int_fast16_t    deviation   = (int_fast16_t) (2 * len - min - max) / 2;       // window is symmetric to the nominal length
+    uint_fast8_t    margin      = (len - min < max - len) ? len - min : max - len;
+
+    if (deviation < *deviation_min_p)
+    {
+        *deviation_min_p = deviation;
+    }
+
+    if (deviation > *deviation_max_p)
+    {
+        *deviation_max_p = deviation;
+    }
+
+#if IRMP_LEARNED_WINDOWS > 0
+    if (deviation < irmp_tmp_quality.window_min[window])
+    {
+        irmp_tmp_quality.window_min[window] = deviation;
+    }
+
+    if (deviation > irmp_tmp_quality.window_max[window])
+    {
+        irmp_tmp_quality.window_max[window] = deviation;
+    }
+#else
+    (void) window;
+#endif
+
+    if (margin < irmp_tmp_quality.margin)
+    {
+        irmp_tmp_quality.margin = margin;
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Measure pulse and pause of a data bit
+ *  @details  called before irmp_store_bit() with lengths inside the windows of value
+ *  @param    value of the bit, FALSE if the pause was not ended by a pulse and is not measured
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_quality_bit (IRMP_CTX_PARAM_ uint_fast8_t value, uint_fast8_t pause_valid)
+{
+    if (value)
+    {
+        irmp_quality_len (IRMP_CTX_ARG_ irmp_pulse_time, irmp_param.pulse_1_len_min, irmp_param.pulse_1_len_max,
+                          &irmp_tmp_quality.pulse_min, &irmp_tmp_quality.pulse_max, IRMP_QUALITY_PULSE_1);
+
+        if (pause_valid)
+        {
+            irmp_quality_len (IRMP_CTX_ARG_ irmp_pause_time, irmp_param.pause_1_len_min, irmp_param.pause_1_len_max,
+                              &irmp_tmp_quality.pause_min, &irmp_tmp_quality.pause_max, IRMP_QUALITY_PAUSE_1);
+        }
+    }
+    else
+    {
+        irmp_quality_len (IRMP_CTX_ARG_ irmp_pulse_time, irmp_param.pulse_0_len_min, irmp_param.pulse_0_len_max,
+                          &irmp_tmp_quality.pulse_min, &irmp_tmp_quality.pulse_max, IRMP_QUALITY_PULSE_0);
+
+        if (pause_valid)
+        {
+            irmp_quality_len (IRMP_CTX_ARG_ irmp_pause_time, irmp_param.pause_0_len_min, irmp_param.pause_0_len_max,
+                              &irmp_tmp_quality.pause_min, &irmp_tmp_quality.pause_max, IRMP_QUALITY_PAUSE_0);
+        }
+    }
+}
+#endif // IRMP_USE_QUALITY == 1
+
+#if IRMP_USE_HASH == 1
+#define IRMP_HASH_OFFSET                        2166136261UL                // FNV-1a, 32 bit
+#define IRMP_HASH_PRIME                         16777619UL
+#define IRMP_HASH_MIN_LEN                       16                          // min. pulses and pauses of a hashed burst, NEC repetition: 3
+#define IRMP_HASH_LEN_MAX                       0x0FFF                      // lengths are limited, so 5 * len fits into 16 bits
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  End of burst
+ *  @details  called IRMP_TIMEOUT_LEN after the last pulse of a burst. If no frame was decoded, the hash is returned as IRMP_HASH_PROTOCOL
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_hash_frame (IRMP_CTX_PARAM)
+{
+    if (! irmp_hash_decoded && ! irmp_ir_detected && irmp_hash_count >= IRMP_HASH_MIN_LEN
+#if IRMP_USE_PROTOCOL_MASK == 1
+        && ! IRMP_MASK_IS_SET (irmp_protocol_disabled, IRMP_HASH_PROTOCOL)     // else repetition state of other protocols would change
+#endif
+       )
+    {
+#ifdef ANALYZE
+        ANALYZE_PRINTF ("%8.3fms no protocol decoded, hash of %d pulses and pauses: 0x%08lx\n",
+                        (double) (time_counter * 1000) / F_INTERRUPTS, irmp_hash_count, (unsigned long) irmp_hash);
+#endif // ANALYZE
+        irmp_protocol   = IRMP_HASH_PROTOCOL;
+        irmp_address    = irmp_hash >> 16;
+        irmp_command    = irmp_hash & 0xFFFF;
+        irmp_flags      = 0;
+
+        if (last_irmp_address == irmp_address && last_irmp_command == irmp_command && irmp_repetition_ticks < irmp_key_repetition_len)
+        {
+            irmp_flags |= IRMP_FLAG_REPETITION;
+        }
+
+        last_irmp_address   = irmp_address;
+        last_irmp_command   = irmp_command;
+        irmp_repetition_ticks = 0;
+#if IRMP_USE_TIMESTAMP == 1
+        irmp_frame_ticks    = irmp_ticks;
+#endif
+#if IRMP_USE_RAW_FRAME == 1
+        irmp_tmp_raw        = 0;                                            // no data bits
+        irmp_tmp_raw_len    = 0;
+        irmp_raw_pending    = FALSE;
+#endif
+#if IRMP_USE_QUALITY == 1
+        irmp_tmp_quality.pulse_min  = irmp_tmp_quality.pause_min = 127;
+        irmp_tmp_quality.pulse_max  = irmp_tmp_quality.pause_max = -128;
+        irmp_tmp_quality.margin     = 0xFF;
+#if IRMP_LEARNED_WINDOWS > 0
+        irmp_tmp_quality.start_bit  = 0;
+        memset (irmp_tmp_quality.window_min, 127, IRMP_QUALITY_WINDOWS);
+        memset (irmp_tmp_quality.window_max, -128, IRMP_QUALITY_WINDOWS);
+#endif
+#endif
+        IRMP_TRACE (IRMP_TRACE_FRAME, IRMP_HASH_PROTOCOL, irmp_hash_count);
+        irmp_ir_detected    = TRUE;
+    }
+
+    irmp_hash_count     = 0;
+    irmp_hash_decoded   = FALSE;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Hash pulses and pauses
+ *  @details  called with the filtered input after the decoder. At the end of every pulse and pause of a burst its length is compared with
+ *            the last one of the same level: 0 = shorter, 1 = about equal (within 20 percent), 2 = longer. The results are hashed, so
+ *            the hash does not depend on the timing of the remote, only on the order of short and long pulses and pauses. The start
+ *            pulse is not hashed, its length is not exact with idle sampling, and the 1st pause and the 1st data pulse only set the
+ *            length compared with.
+ *  @param    irmp_input: input level, 0 = pulse (light), else pause (dark)
+ *  @param    ticks: number of samples of this level
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_hash_sample (IRMP_CTX_PARAM_ uint_fast8_t irmp_input, uint_fast16_t ticks)
+{
+    uint_fast8_t    light = ! irmp_input;
+    uint_fast16_t   ref;
+    uint_fast8_t    value;
+
+    if (irmp_ir_detected)
+    {
+        irmp_hash_decoded = TRUE;
+    }
+
+    if (light != irmp_hash_light)                                           // end of pulse or pause
+    {
+        if (! irmp_hash_count)
+        {
+            if (irmp_hash_light)                                            // end of start pulse
+            {
+                irmp_hash           = IRMP_HASH_OFFSET;
+                irmp_hash_last[0]   = 0;
+                irmp_hash_last[1]   = 0;
+                irmp_hash_count     = 1;
+            }
+        }
+        else
+        {
+            ref = irmp_hash_last[! irmp_hash_light];
+
+            if (ref)
+            {
+                if (5 * irmp_hash_len < 4 * ref)
+                {
+                    value = 0;
+                }
+                else if (4 * irmp_hash_len > 5 * ref)
+                {
+                    value = 2;
+                }
+                else
+                {
+                    value = 1;
+                }
+
+                irmp_hash = (irmp_hash ^ value) * IRMP_HASH_PRIME;
+            }
+
+            irmp_hash_last[! irmp_hash_light] = irmp_hash_len;
+
+            if (irmp_hash_count < 0xFF)
+            {
+                irmp_hash_count++;
+            }
+        }
+
+        irmp_hash_light = light;
+        irmp_hash_len   = 0;
+    }
+
+    if (ticks < (uint_fast16_t) (IRMP_HASH_LEN_MAX - irmp_hash_len))
+    {
+        irmp_hash_len += ticks;
+    }
+    else
+    {
+        irmp_hash_len = IRMP_HASH_LEN_MAX;
+    }
+
+    if (irmp_hash_count && ! light && irmp_hash_len > IRMP_TIMEOUT_LEN && ! irmp_start_bit_detected)
+    {
+        irmp_hash_frame (IRMP_CTX_ARG);
+    }
+}
+#endif // IRMP_USE_HASH == 1
+
+#if IRMP_USE_EDGE_ISR == 1 || IRMP_IDLE_DIVIDER > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Skip dark samples while waiting for a start bit
+ *  @details  only the repetition counters are running, so they are advanced in one step instead of calling irmp_ISR_sample() per sample
+ *  @param    ticks: number of samples to skip
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+irmp_skip_idle (IRMP_CTX_PARAM_ uint_fast16_t ticks)
+{
+    if (irmp_repetition_ticks < 0xFFFF - ticks)
+    {
+        irmp_repetition_ticks += ticks;
+    }
+    else
+    {
+        irmp_repetition_ticks = 0xFFFF;
+    }
+
+#if IRMP_SUPPORT_DENON_PROTOCOL == 1
+    if (irmp_denon_repetition_len < 0xFFFF - ticks)
+    {
+        irmp_denon_repetition_len += ticks;
+    }
+    else
+    {
+        irmp_denon_repetition_len = 0xFFFF;
+    }
+
+    if (irmp_denon_repetition_len >= DENON_AUTO_REPETITION_PAUSE_LEN && last_irmp_denon_command != 0)
+    {
+        last_irmp_denon_command = 0;
+        irmp_denon_repetition_len = 0xFFFF;
+    }
+#endif // IRMP_SUPPORT_DENON_PROTOCOL == 1
+
+#ifdef ANALYZE
+    time_counter += ticks;
+#endif // ANALYZE
+#if IRMP_USE_TIMESTAMP == 1
+    irmp_ticks += ticks;
+#endif
+#if IRMP_GLITCH_FILTER_LEN > 0
+    irmp_filter_count = 0;                                                          // skipped samples are dark, too
+#endif
+#if IRMP_USE_KEY_RELEASE == 1
+    irmp_key_release (IRMP_CTX_ARG);
+#endif
+#if IRMP_USE_HASH == 1
+    irmp_hash_sample (IRMP_CTX_ARG_ 1, ticks);
+#endif
+#if (IRMP_USE_KEY_RELEASE == 1 || IRMP_USE_HASH == 1) && IRMP_QUEUE_LEN > 0
+    if (irmp_ir_detected)
+    {
+        irmp_queue_put (IRMP_CTX_ARG);
+    }
+#endif
+}
+#endif // IRMP_USE_EDGE_ISR == 1 || IRMP_IDLE_DIVIDER > 0
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  ISR routine
+ *  @details  ISR routine, called 10000 times per second
+ *            with IRMP_USE_EDGE_ISR or IRMP_USE_CONTEXT, irmp_ISR_sample() processes one sample, irmp_ISR() reads the pin and calls it
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#if IRMP_ISR_SAMPLE == 1
+static uint_fast8_t
+irmp_ISR_sample (IRMP_CTX_PARAM_ uint_fast8_t irmp_input)
+#else
+uint_fast8_t
+irmp_ISR (void)
+#endif
+{
+#if IRMP_ISR_SAMPLE == 0
+    uint_fast8_t            irmp_input;                                             // input value
+#endif
 
-#if IRMP_SUPPORT_SERIAL == 1
-                    if (irmp_param.flags & IRMP_PARAM_FLAG_IS_SERIAL)
-                    {
-                        while (irmp_bit < irmp_param.complete_len && irmp_pulse_time > irmp_param.pulse_1_len_max)
-                        {
 #ifdef ANALYZE
-                            ANALYZE_PUTCHAR ('1');
+    time_counter++;
+#if IRMP_USE_EDGE_ISR == 1
+    isr_samples++;
+#endif
 #endif // ANALYZE
-                            irmp_store_bit (1);
 
-                            if (irmp_pulse_time >= irmp_param.pulse_1_len_min)
-                            {
-                                irmp_pulse_time -= irmp_param.pulse_1_len_min;
-                            }
-                            else
-                            {
-                                irmp_pulse_time = 0;
-                            }
-                        }
+#if IRMP_USE_TIMESTAMP == 1
+    irmp_ticks++;
+#endif
+
+#if IRMP_ISR_SAMPLE == 0
+#if defined(__SDCC_stm8)
+    irmp_input = input(IRMP_GPIO_STRUCT->IDR)
+#else
+    irmp_input = input(IRMP_PIN);
+#endif
+#endif // IRMP_ISR_SAMPLE == 0
+
+#if IRMP_USE_CALLBACK == 1
+    if (irmp_callback_ptr)
+    {
+        if (irmp_last_inverted_input != !irmp_input)
+        {
+            (*irmp_callback_ptr) (! irmp_input);
+            irmp_last_inverted_input = !irmp_input;
+        }
+    }
+#endif // IRMP_USE_CALLBACK == 1
+
+    irmp_log(irmp_input);                                                       // log ir signal, if IRMP_LOGGING defined
+
+#if IRMP_GLITCH_FILTER_LEN > 0
+    irmp_input = irmp_glitch_filter (IRMP_CTX_ARG_ irmp_input);                 // mask glitches before pulse and pause are counted
+#endif
+
+    if (! irmp_ir_detected)                                                     // ir code already detected?
+    {                                                                           // no...
+        if (! irmp_start_bit_detected)                                          // start bit detected?
+        {                                                                       // no...
+            if (! irmp_input)                                                   // receiving burst?
+            {                                                                   // yes...
+//              irmp_busy_flag = TRUE;
+                if (! irmp_pulse_time)
+                {
+                    IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_PULSE, 0, 0);
+                }
+                irmp_pulse_time++;                                              // increment counter
+            }
+            else
+            {                                                                   // no...
+                if (irmp_pulse_time)                                            // it's dark....
+                {                                                               // set flags for counting the time of darkness...
+                    irmp_start_bit_detected = 1;
+                    irmp_wait_for_start_space = 1;
+                    irmp_wait_for_space     = 0;
+                    irmp_tmp_command        = 0;
+                    irmp_tmp_address        = 0;
+#if IRMP_USE_RAW_FRAME == 1
+                    irmp_tmp_raw            = 0;
+                    irmp_tmp_raw_len        = 0;
+#endif
+#if IRMP_USE_QUALITY == 1
+                    irmp_tmp_quality.pulse_min  = irmp_tmp_quality.pause_min = 127;
+                    irmp_tmp_quality.pulse_max  = irmp_tmp_quality.pause_max = -128;
+                    irmp_tmp_quality.margin     = 0xFF;
+#if IRMP_LEARNED_WINDOWS > 0
+                    irmp_tmp_quality.start_bit  = 0;
+                    memset (irmp_tmp_quality.window_min, 127, IRMP_QUALITY_WINDOWS);
+                    memset (irmp_tmp_quality.window_max, -128, IRMP_QUALITY_WINDOWS);
+#endif
+#endif
+#if IRMP_EARLY_MATCH_LEN > 0
+                    irmp_early_protocol     = 0;
+#endif
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+                    irmp_genre2             = 0;
+#endif
+#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+                    irmp_tmp_id = 0;
+#endif
+
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1) || IRMP_SUPPORT_NEC42_PROTOCOL == 1
+                    irmp_tmp_command2       = 0;
+                    irmp_tmp_address2       = 0;
+#endif
+#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
+                    irmp_lgair_command      = 0;
+                    irmp_lgair_address      = 0;
+#endif
+                    irmp_bit                = 0xff;
+                    irmp_pause_time         = 1;                                // 1st pause: set to 1, not to 0!
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 || IRMP_SUPPORT_S100_PROTOCOL == 1
+                    irmp_rc5_cmd_bit6       = 0;                                // fm 2010-03-07: bugfix: reset it after incomplete RC5 frame!
+#endif
+                }
+                else
+                {
+                    if (irmp_repetition_ticks < 0xFFFF)                         // avoid overflow of counter
+                    {
+                        irmp_repetition_ticks++;
+
+#if IRMP_SUPPORT_DENON_PROTOCOL == 1
+                        if (irmp_denon_repetition_len < 0xFFFF)                 // avoid overflow of counter
+                        {
+                            irmp_denon_repetition_len++;
+
+                            if (irmp_denon_repetition_len >= DENON_AUTO_REPETITION_PAUSE_LEN && last_irmp_denon_command != 0)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("%8.3fms warning: did not receive inverted command repetition\n",
+                                                (double) (time_counter * 1000) / F_INTERRUPTS);
+#endif // ANALYZE
+                                last_irmp_denon_command = 0;
+                                irmp_denon_repetition_len = 0xFFFF;
+                            }
+                        }
+#endif // IRMP_SUPPORT_DENON_PROTOCOL == 1
+                    }
+#if IRMP_USE_KEY_RELEASE == 1
+                    irmp_key_release (IRMP_CTX_ARG);
+#endif
+                }
+            }
+        }
+        else
+        {
+            if (irmp_wait_for_start_space)                                      // we have received start bit...
+            {                                                                   // ...and are counting the time of darkness
+                if (irmp_input)                                                 // still dark?
+                {                                                               // yes
+                    irmp_pause_time++;                                          // increment counter
+
+#if IRMP_SUPPORT_NIKON_PROTOCOL == 1
+                    if (((irmp_pulse_time < NIKON_START_BIT_PULSE_LEN_MIN || irmp_pulse_time > NIKON_START_BIT_PULSE_LEN_MAX) && irmp_pause_time > IRMP_TIMEOUT_LEN) ||
+                         irmp_pause_time > IRMP_TIMEOUT_NIKON_LEN)
+#else
+                    if (irmp_pause_time > IRMP_TIMEOUT_LEN)                     // timeout?
+#endif
+                    {                                                           // yes...
+#if IRMP_SUPPORT_JVC_PROTOCOL == 1
+                        if (irmp_protocol == IRMP_JVC_PROTOCOL)                 // don't show eror if JVC protocol, irmp_pulse_time has been set below!
+                        {
+                            ;
+                        }
+                        else
+#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
+                        {
+                            IRMP_ERROR (start_pause, 1, irmp_pause_time);
+                        }
+
+                        irmp_start_bit_detected = 0;                            // reset flags, let's wait for another start bit
+                        irmp_pulse_time         = 0;
+                        irmp_pause_time         = 0;
+                    }
+                }
+                else
+                {                                                               // receiving first data pulse!
+                    IRMP_PARAMETER * irmp_param_p;
+                    irmp_param_p = (IRMP_PARAMETER *) 0;
+#if IRMP_DYNAMIC_PROTOCOLS > 0 || IRMP_LEARNED_WINDOWS > 0
+                    uint_fast8_t irmp_param_dynamic = FALSE;
+#endif
+
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
+                    irmp_param2.protocol = 0;
+#endif
+
+                    IRMP_TRACE (IRMP_TRACE_START_BIT, irmp_pulse_time, irmp_pause_time);
+
+#if IRMP_USE_START_BIT_TABLE == 0 || defined (ANALYZE)                          // analyzer: check table against classification below
+#if IRMP_SUPPORT_SIRCS_PROTOCOL == 1
+                    if (irmp_pulse_time >= SIRCS_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= SIRCS_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= SIRCS_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= SIRCS_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's SIRCS
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = SIRCS, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        SIRCS_START_BIT_PULSE_LEN_MIN, SIRCS_START_BIT_PULSE_LEN_MAX,
+                                        SIRCS_START_BIT_PAUSE_LEN_MIN, SIRCS_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &sircs_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_SIRCS_PROTOCOL == 1
+
+#if IRMP_SUPPORT_JVC_PROTOCOL == 1
+                    if (irmp_protocol == IRMP_JVC_PROTOCOL &&                                                       // last protocol was JVC, awaiting repeat frame
+                        irmp_pulse_time >= JVC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= JVC_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= JVC_REPEAT_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= JVC_REPEAT_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = NEC or JVC (type 1) repeat frame, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        JVC_START_BIT_PULSE_LEN_MIN, JVC_START_BIT_PULSE_LEN_MAX,
+                                        JVC_REPEAT_START_BIT_PAUSE_LEN_MIN, JVC_REPEAT_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &nec_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
+
+#if IRMP_SUPPORT_NEC_PROTOCOL == 1
+                    if (irmp_pulse_time >= NEC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= NEC_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= NEC_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NEC_START_BIT_PAUSE_LEN_MAX)
+                    {
+#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = NEC42, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX,
+                                        NEC_START_BIT_PAUSE_LEN_MIN, NEC_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &nec42_param;
+#else
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = NEC, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX,
+                                        NEC_START_BIT_PAUSE_LEN_MIN, NEC_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &nec_param;
+#endif
+                    }
+                    else if (irmp_pulse_time >= NEC_START_BIT_PULSE_LEN_MIN        && irmp_pulse_time <= NEC_START_BIT_PULSE_LEN_MAX &&
+                             irmp_pause_time >= NEC_REPEAT_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NEC_REPEAT_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's NEC
+#if IRMP_SUPPORT_JVC_PROTOCOL == 1
+                        if (irmp_protocol == IRMP_JVC_PROTOCOL)                 // last protocol was JVC, awaiting repeat frame
+                        {                                                       // some jvc remote controls use nec repetition frame for jvc repetition frame
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("protocol = JVC repeat frame type 2, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                            NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX,
+                                            NEC_REPEAT_START_BIT_PAUSE_LEN_MIN, NEC_REPEAT_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                            irmp_param_p = (IRMP_PARAMETER *) &nec_param;
+                        }
+                        else
+#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("protocol = NEC (repetition frame), start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                            NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX,
+                                            NEC_REPEAT_START_BIT_PAUSE_LEN_MIN, NEC_REPEAT_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+
+                            irmp_param_p = (IRMP_PARAMETER *) &nec_rep_param;
+                        }
+                    }
+                    else
+
+#if IRMP_SUPPORT_JVC_PROTOCOL == 1
+                    if (irmp_protocol == IRMP_JVC_PROTOCOL &&                   // last protocol was JVC, awaiting repeat frame
+                        irmp_pulse_time >= NEC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= NEC_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= NEC_0_PAUSE_LEN_MIN         && irmp_pause_time <= NEC_0_PAUSE_LEN_MAX)
+                    {                                                           // it's JVC repetition type 3
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = JVC repeat frame type 3, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        NEC_START_BIT_PULSE_LEN_MIN, NEC_START_BIT_PULSE_LEN_MAX,
+                                        NEC_0_PAUSE_LEN_MIN, NEC_0_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &nec_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
+
+#endif // IRMP_SUPPORT_NEC_PROTOCOL == 1
+
+#if IRMP_SUPPORT_TELEFUNKEN_PROTOCOL == 1
+                    if (irmp_pulse_time >= TELEFUNKEN_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= TELEFUNKEN_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= TELEFUNKEN_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= TELEFUNKEN_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = TELEFUNKEN, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        TELEFUNKEN_START_BIT_PULSE_LEN_MIN, TELEFUNKEN_START_BIT_PULSE_LEN_MAX,
+                                        TELEFUNKEN_START_BIT_PAUSE_LEN_MIN, TELEFUNKEN_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &telefunken_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_TELEFUNKEN_PROTOCOL == 1
+
+#if IRMP_SUPPORT_ROOMBA_PROTOCOL == 1
+                    if (irmp_pulse_time >= ROOMBA_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= ROOMBA_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= ROOMBA_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= ROOMBA_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = ROOMBA, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        ROOMBA_START_BIT_PULSE_LEN_MIN, ROOMBA_START_BIT_PULSE_LEN_MAX,
+                                        ROOMBA_START_BIT_PAUSE_LEN_MIN, ROOMBA_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &roomba_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_ROOMBA_PROTOCOL == 1
+
+#if IRMP_SUPPORT_ACP24_PROTOCOL == 1
+                    if (irmp_pulse_time >= ACP24_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= ACP24_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= ACP24_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= ACP24_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = ACP24, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        ACP24_START_BIT_PULSE_LEN_MIN, ACP24_START_BIT_PULSE_LEN_MAX,
+                                        ACP24_START_BIT_PAUSE_LEN_MIN, ACP24_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &acp24_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_ROOMBA_PROTOCOL == 1
+
+#if IRMP_SUPPORT_PENTAX_PROTOCOL == 1
+                    if (irmp_pulse_time >= PENTAX_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= PENTAX_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= PENTAX_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= PENTAX_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = PENTAX, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        PENTAX_START_BIT_PULSE_LEN_MIN, PENTAX_START_BIT_PULSE_LEN_MAX,
+                                        PENTAX_START_BIT_PAUSE_LEN_MIN, PENTAX_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &pentax_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_PENTAX_PROTOCOL == 1
+
+#if IRMP_SUPPORT_NIKON_PROTOCOL == 1
+                    if (irmp_pulse_time >= NIKON_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= NIKON_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= NIKON_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NIKON_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = NIKON, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        NIKON_START_BIT_PULSE_LEN_MIN, NIKON_START_BIT_PULSE_LEN_MAX,
+                                        NIKON_START_BIT_PAUSE_LEN_MIN, NIKON_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &nikon_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_NIKON_PROTOCOL == 1
+
+#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+                    if (irmp_pulse_time >= SAMSUNG_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= SAMSUNG_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= SAMSUNG_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= SAMSUNG_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's SAMSUNG
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = SAMSUNG, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        SAMSUNG_START_BIT_PULSE_LEN_MIN, SAMSUNG_START_BIT_PULSE_LEN_MAX,
+                                        SAMSUNG_START_BIT_PAUSE_LEN_MIN, SAMSUNG_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &samsung_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+
+#if IRMP_SUPPORT_MATSUSHITA_PROTOCOL == 1
+                    if (irmp_pulse_time >= MATSUSHITA_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= MATSUSHITA_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= MATSUSHITA_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= MATSUSHITA_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's MATSUSHITA
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = MATSUSHITA, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        MATSUSHITA_START_BIT_PULSE_LEN_MIN, MATSUSHITA_START_BIT_PULSE_LEN_MAX,
+                                        MATSUSHITA_START_BIT_PAUSE_LEN_MIN, MATSUSHITA_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &matsushita_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_MATSUSHITA_PROTOCOL == 1
+
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+                    if (irmp_pulse_time >= KASEIKYO_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= KASEIKYO_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= KASEIKYO_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= KASEIKYO_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's KASEIKYO
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = KASEIKYO, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        KASEIKYO_START_BIT_PULSE_LEN_MIN, KASEIKYO_START_BIT_PULSE_LEN_MAX,
+                                        KASEIKYO_START_BIT_PAUSE_LEN_MIN, KASEIKYO_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &kaseikyo_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+
+#if IRMP_SUPPORT_PANASONIC_PROTOCOL == 1
+                    if (irmp_pulse_time >= PANASONIC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= PANASONIC_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= PANASONIC_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= PANASONIC_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's PANASONIC
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = PANASONIC, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        PANASONIC_START_BIT_PULSE_LEN_MIN, PANASONIC_START_BIT_PULSE_LEN_MAX,
+                                        PANASONIC_START_BIT_PAUSE_LEN_MIN, PANASONIC_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &panasonic_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_PANASONIC_PROTOCOL == 1
+
+#if IRMP_SUPPORT_RADIO1_PROTOCOL == 1
+                    if (irmp_pulse_time >= RADIO1_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RADIO1_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= RADIO1_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RADIO1_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = RADIO1, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        RADIO1_START_BIT_PULSE_LEN_MIN, RADIO1_START_BIT_PULSE_LEN_MAX,
+                                        RADIO1_START_BIT_PAUSE_LEN_MIN, RADIO1_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &radio1_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_RRADIO1_PROTOCOL == 1
+
+#if IRMP_SUPPORT_RECS80_PROTOCOL == 1
+                    if (irmp_pulse_time >= RECS80_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RECS80_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= RECS80_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RECS80_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's RECS80
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = RECS80, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        RECS80_START_BIT_PULSE_LEN_MIN, RECS80_START_BIT_PULSE_LEN_MAX,
+                                        RECS80_START_BIT_PAUSE_LEN_MIN, RECS80_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &recs80_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_RECS80_PROTOCOL == 1
+
+#if IRMP_SUPPORT_S100_PROTOCOL == 1
+                    if (((irmp_pulse_time >= S100_START_BIT_LEN_MIN     && irmp_pulse_time <= S100_START_BIT_LEN_MAX) ||
+                         (irmp_pulse_time >= 2 * S100_START_BIT_LEN_MIN && irmp_pulse_time <= 2 * S100_START_BIT_LEN_MAX)) &&
+                        ((irmp_pause_time >= S100_START_BIT_LEN_MIN     && irmp_pause_time <= S100_START_BIT_LEN_MAX) ||
+                         (irmp_pause_time >= 2 * S100_START_BIT_LEN_MIN && irmp_pause_time <= 2 * S100_START_BIT_LEN_MAX)))
+                    {                                                           // it's S100
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = S100, start bit timings: pulse: %3d - %3d, pause: %3d - %3d or pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        S100_START_BIT_LEN_MIN, S100_START_BIT_LEN_MAX,
+                                        2 * S100_START_BIT_LEN_MIN, 2 * S100_START_BIT_LEN_MAX,
+                                        S100_START_BIT_LEN_MIN, S100_START_BIT_LEN_MAX,
+                                        2 * S100_START_BIT_LEN_MIN, 2 * S100_START_BIT_LEN_MAX);
+#endif // ANALYZE
+
+                        irmp_param_p = (IRMP_PARAMETER *) &s100_param;
+                        irmp_last_pause = irmp_pause_time;
+
+                        if ((irmp_pulse_time > S100_START_BIT_LEN_MAX && irmp_pulse_time <= 2 * S100_START_BIT_LEN_MAX) ||
+                            (irmp_pause_time > S100_START_BIT_LEN_MAX && irmp_pause_time <= 2 * S100_START_BIT_LEN_MAX))
+                        {
+                          irmp_last_value = 0;
+                          irmp_rc5_cmd_bit6 = 1<<6;
+                        }
+                        else
+                        {
+                          irmp_last_value = 1;
+                        }
+                    }
+                    else
+#endif // IRMP_SUPPORT_S100_PROTOCOL == 1
+
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1
+                    if (((irmp_pulse_time >= RC5_START_BIT_LEN_MIN     && irmp_pulse_time <= RC5_START_BIT_LEN_MAX) ||
+                         (irmp_pulse_time >= 2 * RC5_START_BIT_LEN_MIN && irmp_pulse_time <= 2 * RC5_START_BIT_LEN_MAX)) &&
+                        ((irmp_pause_time >= RC5_START_BIT_LEN_MIN     && irmp_pause_time <= RC5_START_BIT_LEN_MAX) ||
+                         (irmp_pause_time >= 2 * RC5_START_BIT_LEN_MIN && irmp_pause_time <= 2 * RC5_START_BIT_LEN_MAX)))
+                    {                                                           // it's RC5
+#if IRMP_SUPPORT_FDC_PROTOCOL == 1
+                        if (irmp_pulse_time >= FDC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= FDC_START_BIT_PULSE_LEN_MAX &&
+                            irmp_pause_time >= FDC_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= FDC_START_BIT_PAUSE_LEN_MAX)
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("protocol = RC5 or FDC\n");
+                            ANALYZE_PRINTF ("FDC start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                            FDC_START_BIT_PULSE_LEN_MIN, FDC_START_BIT_PULSE_LEN_MAX,
+                                            FDC_START_BIT_PAUSE_LEN_MIN, FDC_START_BIT_PAUSE_LEN_MAX);
+                            ANALYZE_PRINTF ("RC5 start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX,
+                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX);
+#endif // ANALYZE
+                            memcpy_P (&irmp_param2, &fdc_param, sizeof (IRMP_PARAMETER));
+                        }
+                        else
+#endif // IRMP_SUPPORT_FDC_PROTOCOL == 1
+
+#if IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+                        if (irmp_pulse_time >= RCCAR_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RCCAR_START_BIT_PULSE_LEN_MAX &&
+                            irmp_pause_time >= RCCAR_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_START_BIT_PAUSE_LEN_MAX)
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("protocol = RC5 or RCCAR\n");
+                            ANALYZE_PRINTF ("RCCAR start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                            RCCAR_START_BIT_PULSE_LEN_MIN, RCCAR_START_BIT_PULSE_LEN_MAX,
+                                            RCCAR_START_BIT_PAUSE_LEN_MIN, RCCAR_START_BIT_PAUSE_LEN_MAX);
+                            ANALYZE_PRINTF ("RC5 start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX,
+                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX);
+#endif // ANALYZE
+                            memcpy_P (&irmp_param2, &rccar_param, sizeof (IRMP_PARAMETER));
+                        }
+                        else
+#endif // IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("protocol = RC5, start bit timings: pulse: %3d - %3d, pause: %3d - %3d or pulse: %3d - %3d, pause: %3d - %3d\n",
+                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX,
+                                            2 * RC5_START_BIT_LEN_MIN, 2 * RC5_START_BIT_LEN_MAX,
+                                            RC5_START_BIT_LEN_MIN, RC5_START_BIT_LEN_MAX,
+                                            2 * RC5_START_BIT_LEN_MIN, 2 * RC5_START_BIT_LEN_MAX);
+#endif // ANALYZE
+                        }
+
+                        irmp_param_p = (IRMP_PARAMETER *) &rc5_param;
+                        irmp_last_pause = irmp_pause_time;
+
+                        if ((irmp_pulse_time > RC5_START_BIT_LEN_MAX && irmp_pulse_time <= 2 * RC5_START_BIT_LEN_MAX) ||
+                            (irmp_pause_time > RC5_START_BIT_LEN_MAX && irmp_pause_time <= 2 * RC5_START_BIT_LEN_MAX))
+                        {
+                          irmp_last_value = 0;
+                          irmp_rc5_cmd_bit6 = 1<<6;
+                        }
+                        else
+                        {
+                          irmp_last_value = 1;
+                        }
+                    }
+                    else
+#endif // IRMP_SUPPORT_RC5_PROTOCOL == 1
+
+#if IRMP_SUPPORT_DENON_PROTOCOL == 1
+                    if ( (irmp_pulse_time >= DENON_PULSE_LEN_MIN && irmp_pulse_time <= DENON_PULSE_LEN_MAX) &&
+                        ((irmp_pause_time >= DENON_1_PAUSE_LEN_MIN && irmp_pause_time <= DENON_1_PAUSE_LEN_MAX) ||
+                         (irmp_pause_time >= DENON_0_PAUSE_LEN_MIN && irmp_pause_time <= DENON_0_PAUSE_LEN_MAX)))
+                    {                                                           // it's DENON
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = DENON, start bit timings: pulse: %3d - %3d, pause: %3d - %3d or %3d - %3d\n",
+                                        DENON_PULSE_LEN_MIN, DENON_PULSE_LEN_MAX,
+                                        DENON_1_PAUSE_LEN_MIN, DENON_1_PAUSE_LEN_MAX,
+                                        DENON_0_PAUSE_LEN_MIN, DENON_0_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &denon_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_DENON_PROTOCOL == 1
+
+#if IRMP_SUPPORT_THOMSON_PROTOCOL == 1
+                    if ( (irmp_pulse_time >= THOMSON_PULSE_LEN_MIN && irmp_pulse_time <= THOMSON_PULSE_LEN_MAX) &&
+                        ((irmp_pause_time >= THOMSON_1_PAUSE_LEN_MIN && irmp_pause_time <= THOMSON_1_PAUSE_LEN_MAX) ||
+                         (irmp_pause_time >= THOMSON_0_PAUSE_LEN_MIN && irmp_pause_time <= THOMSON_0_PAUSE_LEN_MAX)))
+                    {                                                           // it's THOMSON
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = THOMSON, start bit timings: pulse: %3d - %3d, pause: %3d - %3d or %3d - %3d\n",
+                                        THOMSON_PULSE_LEN_MIN, THOMSON_PULSE_LEN_MAX,
+                                        THOMSON_1_PAUSE_LEN_MIN, THOMSON_1_PAUSE_LEN_MAX,
+                                        THOMSON_0_PAUSE_LEN_MIN, THOMSON_0_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &thomson_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_THOMSON_PROTOCOL == 1
+
+#if IRMP_SUPPORT_BOSE_PROTOCOL == 1
+                    if (irmp_pulse_time >= BOSE_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= BOSE_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= BOSE_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= BOSE_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = BOSE, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        BOSE_START_BIT_PULSE_LEN_MIN, BOSE_START_BIT_PULSE_LEN_MAX,
+                                        BOSE_START_BIT_PAUSE_LEN_MIN, BOSE_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &bose_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_BOSE_PROTOCOL == 1
+
+#if IRMP_SUPPORT_RC6_PROTOCOL == 1
+                    if (irmp_pulse_time >= RC6_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RC6_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= RC6_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RC6_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's RC6
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = RC6, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        RC6_START_BIT_PULSE_LEN_MIN, RC6_START_BIT_PULSE_LEN_MAX,
+                                        RC6_START_BIT_PAUSE_LEN_MIN, RC6_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &rc6_param;
+                        irmp_last_pause = 0;
+                        irmp_last_value = 1;
+                    }
+                    else
+#endif // IRMP_SUPPORT_RC6_PROTOCOL == 1
+
+#if IRMP_SUPPORT_RECS80EXT_PROTOCOL == 1
+                    if (irmp_pulse_time >= RECS80EXT_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RECS80EXT_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= RECS80EXT_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RECS80EXT_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's RECS80EXT
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = RECS80EXT, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        RECS80EXT_START_BIT_PULSE_LEN_MIN, RECS80EXT_START_BIT_PULSE_LEN_MAX,
+                                        RECS80EXT_START_BIT_PAUSE_LEN_MIN, RECS80EXT_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &recs80ext_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_RECS80EXT_PROTOCOL == 1
+
+#if IRMP_SUPPORT_NUBERT_PROTOCOL == 1
+                    if (irmp_pulse_time >= NUBERT_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= NUBERT_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= NUBERT_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NUBERT_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's NUBERT
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = NUBERT, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        NUBERT_START_BIT_PULSE_LEN_MIN, NUBERT_START_BIT_PULSE_LEN_MAX,
+                                        NUBERT_START_BIT_PAUSE_LEN_MIN, NUBERT_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &nubert_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_NUBERT_PROTOCOL == 1
+
+#if IRMP_SUPPORT_FAN_PROTOCOL == 1
+                    if (irmp_pulse_time >= FAN_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= FAN_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= FAN_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= FAN_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's FAN
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = FAN, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        FAN_START_BIT_PULSE_LEN_MIN, FAN_START_BIT_PULSE_LEN_MAX,
+                                        FAN_START_BIT_PAUSE_LEN_MIN, FAN_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &fan_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_FAN_PROTOCOL == 1
+
+#if IRMP_SUPPORT_SPEAKER_PROTOCOL == 1
+                    if (irmp_pulse_time >= SPEAKER_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= SPEAKER_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= SPEAKER_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= SPEAKER_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's SPEAKER
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = SPEAKER, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        SPEAKER_START_BIT_PULSE_LEN_MIN, SPEAKER_START_BIT_PULSE_LEN_MAX,
+                                        SPEAKER_START_BIT_PAUSE_LEN_MIN, SPEAKER_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &speaker_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_SPEAKER_PROTOCOL == 1
+
+#if IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
+                    if (irmp_pulse_time >= BANG_OLUFSEN_START_BIT1_PULSE_LEN_MIN && irmp_pulse_time <= BANG_OLUFSEN_START_BIT1_PULSE_LEN_MAX &&
+                        irmp_pause_time >= BANG_OLUFSEN_START_BIT1_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_START_BIT1_PAUSE_LEN_MAX)
+                    {                                                           // it's BANG_OLUFSEN
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = BANG_OLUFSEN\n");
+                        ANALYZE_PRINTF ("start bit 1 timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        BANG_OLUFSEN_START_BIT1_PULSE_LEN_MIN, BANG_OLUFSEN_START_BIT1_PULSE_LEN_MAX,
+                                        BANG_OLUFSEN_START_BIT1_PAUSE_LEN_MIN, BANG_OLUFSEN_START_BIT1_PAUSE_LEN_MAX);
+                        ANALYZE_PRINTF ("start bit 2 timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        BANG_OLUFSEN_START_BIT2_PULSE_LEN_MIN, BANG_OLUFSEN_START_BIT2_PULSE_LEN_MAX,
+                                        BANG_OLUFSEN_START_BIT2_PAUSE_LEN_MIN, BANG_OLUFSEN_START_BIT2_PAUSE_LEN_MAX);
+                        ANALYZE_PRINTF ("start bit 3 timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        BANG_OLUFSEN_START_BIT3_PULSE_LEN_MIN, BANG_OLUFSEN_START_BIT3_PULSE_LEN_MAX,
+                                        BANG_OLUFSEN_START_BIT3_PAUSE_LEN_MIN, BANG_OLUFSEN_START_BIT3_PAUSE_LEN_MAX);
+                        ANALYZE_PRINTF ("start bit 4 timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        BANG_OLUFSEN_START_BIT4_PULSE_LEN_MIN, BANG_OLUFSEN_START_BIT4_PULSE_LEN_MAX,
+                                        BANG_OLUFSEN_START_BIT4_PAUSE_LEN_MIN, BANG_OLUFSEN_START_BIT4_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &bang_olufsen_param;
+                        irmp_last_value = 0;
+                    }
+                    else
+#endif // IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
+
+#if IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
+                    if (irmp_pulse_time >= GRUNDIG_NOKIA_IR60_START_BIT_LEN_MIN && irmp_pulse_time <= GRUNDIG_NOKIA_IR60_START_BIT_LEN_MAX &&
+                        irmp_pause_time >= GRUNDIG_NOKIA_IR60_PRE_PAUSE_LEN_MIN && irmp_pause_time <= GRUNDIG_NOKIA_IR60_PRE_PAUSE_LEN_MAX)
+                    {                                                           // it's GRUNDIG
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = GRUNDIG, pre bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        GRUNDIG_NOKIA_IR60_START_BIT_LEN_MIN, GRUNDIG_NOKIA_IR60_START_BIT_LEN_MAX,
+                                        GRUNDIG_NOKIA_IR60_PRE_PAUSE_LEN_MIN, GRUNDIG_NOKIA_IR60_PRE_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &grundig_param;
+                        irmp_last_pause = irmp_pause_time;
+                        irmp_last_value = 1;
+                    }
+                    else
+#endif // IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
+
+#if IRMP_SUPPORT_MERLIN_PROTOCOL == 1 // check MERLIN before RUWIDO!
+                    if (irmp_pulse_time >= MERLIN_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= MERLIN_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= MERLIN_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= MERLIN_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's MERLIN
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = MERLIN, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        MERLIN_START_BIT_PULSE_LEN_MIN, MERLIN_START_BIT_PULSE_LEN_MAX,
+                                        MERLIN_START_BIT_PAUSE_LEN_MIN, MERLIN_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &merlin_param;
+                        irmp_last_pause = 0;
+                        irmp_last_value = 1;
+                    }
+                    else
+#endif // IRMP_SUPPORT_MERLIN_PROTOCOL == 1
+
+#if IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1
+                    if (((irmp_pulse_time >= SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX) ||
+                         (irmp_pulse_time >= 2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= 2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX)) &&
+                        ((irmp_pause_time >= SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX) ||
+                         (irmp_pause_time >= 2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= 2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX)))
+                    {                                                           // it's RUWIDO or SIEMENS
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = RUWIDO, start bit timings: pulse: %3d - %3d or %3d - %3d, pause: %3d - %3d or %3d - %3d\n",
+                                        SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN,   SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX,
+                                        2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MIN, 2 * SIEMENS_OR_RUWIDO_START_BIT_PULSE_LEN_MAX,
+                                        SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN,   SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX,
+                                        2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MIN, 2 * SIEMENS_OR_RUWIDO_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &ruwido_param;
+                        irmp_last_pause = irmp_pause_time;
+                        irmp_last_value = 1;
+                    }
+                    else
+#endif // IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1
+
+#if IRMP_SUPPORT_FDC_PROTOCOL == 1
+                    if (irmp_pulse_time >= FDC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= FDC_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= FDC_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= FDC_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = FDC, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        FDC_START_BIT_PULSE_LEN_MIN, FDC_START_BIT_PULSE_LEN_MAX,
+                                        FDC_START_BIT_PAUSE_LEN_MIN, FDC_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &fdc_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_FDC_PROTOCOL == 1
+
+#if IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+                    if (irmp_pulse_time >= RCCAR_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RCCAR_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= RCCAR_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = RCCAR, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        RCCAR_START_BIT_PULSE_LEN_MIN, RCCAR_START_BIT_PULSE_LEN_MAX,
+                                        RCCAR_START_BIT_PAUSE_LEN_MIN, RCCAR_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &rccar_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+
+#if IRMP_SUPPORT_KATHREIN_PROTOCOL == 1
+                    if (irmp_pulse_time >= KATHREIN_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= KATHREIN_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= KATHREIN_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= KATHREIN_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's KATHREIN
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = KATHREIN, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        KATHREIN_START_BIT_PULSE_LEN_MIN, KATHREIN_START_BIT_PULSE_LEN_MAX,
+                                        KATHREIN_START_BIT_PAUSE_LEN_MIN, KATHREIN_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &kathrein_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_KATHREIN_PROTOCOL == 1
+
+#if IRMP_SUPPORT_NETBOX_PROTOCOL == 1
+                    if (irmp_pulse_time >= NETBOX_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= NETBOX_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= NETBOX_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NETBOX_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's NETBOX
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = NETBOX, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        NETBOX_START_BIT_PULSE_LEN_MIN, NETBOX_START_BIT_PULSE_LEN_MAX,
+                                        NETBOX_START_BIT_PAUSE_LEN_MIN, NETBOX_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &netbox_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_NETBOX_PROTOCOL == 1
+
+#if IRMP_SUPPORT_LEGO_PROTOCOL == 1
+                    if (irmp_pulse_time >= LEGO_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= LEGO_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= LEGO_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= LEGO_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = LEGO, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        LEGO_START_BIT_PULSE_LEN_MIN, LEGO_START_BIT_PULSE_LEN_MAX,
+                                        LEGO_START_BIT_PAUSE_LEN_MIN, LEGO_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &lego_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_LEGO_PROTOCOL == 1
+
+#if IRMP_SUPPORT_A1TVBOX_PROTOCOL == 1
+                    if (irmp_pulse_time >= A1TVBOX_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= A1TVBOX_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= A1TVBOX_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= A1TVBOX_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's A1TVBOX
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = A1TVBOX, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        A1TVBOX_START_BIT_PULSE_LEN_MIN, A1TVBOX_START_BIT_PULSE_LEN_MAX,
+                                        A1TVBOX_START_BIT_PAUSE_LEN_MIN, A1TVBOX_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &a1tvbox_param;
+                        irmp_last_pause = 0;
+                        irmp_last_value = 1;
+                    }
+                    else
+#endif // IRMP_SUPPORT_A1TVBOX_PROTOCOL == 1
+
+#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+                    if (irmp_pulse_time >= ORTEK_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= ORTEK_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= ORTEK_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= ORTEK_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's ORTEK (Hama)
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = ORTEK, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        ORTEK_START_BIT_PULSE_LEN_MIN, ORTEK_START_BIT_PULSE_LEN_MAX,
+                                        ORTEK_START_BIT_PAUSE_LEN_MIN, ORTEK_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &ortek_param;
+                        irmp_last_pause = 0;
+                        irmp_last_value = 1;
+                        irmp_parity     = 0;
+                    }
+                    else
+#endif // IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+
+#if IRMP_SUPPORT_RCMM_PROTOCOL == 1
+                    if (irmp_pulse_time >= RCMM32_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RCMM32_START_BIT_PULSE_LEN_MAX &&
+                        irmp_pause_time >= RCMM32_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RCMM32_START_BIT_PAUSE_LEN_MAX)
+                    {                                                           // it's RCMM
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = RCMM, start bit timings: pulse: %3d - %3d, pause: %3d - %3d\n",
+                                        RCMM32_START_BIT_PULSE_LEN_MIN, RCMM32_START_BIT_PULSE_LEN_MAX,
+                                        RCMM32_START_BIT_PAUSE_LEN_MIN, RCMM32_START_BIT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                        irmp_param_p = (IRMP_PARAMETER *) &rcmm_param;
+                    }
+                    else
+#endif // IRMP_SUPPORT_RCMM_PROTOCOL == 1
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("protocol = UNKNOWN\n");
+#endif // ANALYZE
+                        irmp_start_bit_detected = 0;                            // wait for another start bit...
+                    }
+#endif // IRMP_USE_START_BIT_TABLE == 0 || defined (ANALYZE)
+
+#if IRMP_USE_START_BIT_TABLE == 1
+                    {
+                        IRMP_START_BIT  start_bit;
+
+                        if (irmp_start_bit_lookup (IRMP_CTX_ARG_ irmp_pulse_time, irmp_pause_time, &start_bit))
+                        {
+#ifdef ANALYZE
+                            if (start_bit.param_p != irmp_param_p && ! start_bit_table_masked && ! (start_bit.flags & IRMP_START_BIT_FLAG_DYNAMIC))
+                            {
+                                printf ("error: start bit table: pulse = %d, pause = %d: protocol = %d, classification: %d\n", irmp_pulse_time, irmp_pause_time,
+                                        ((IRMP_PARAMETER *) start_bit.param_p)->protocol, irmp_param_p ? irmp_param_p->protocol : 0);
+                                start_bit_table_errors++;
+                            }
+                            start_bit_table_found++;
+#endif // ANALYZE
+                            irmp_param_p = (IRMP_PARAMETER *) start_bit.param_p;
+                            irmp_start_bit_detected = 1;
+#if IRMP_DYNAMIC_PROTOCOLS > 0 || IRMP_LEARNED_WINDOWS > 0
+                            irmp_param_dynamic = start_bit.flags & IRMP_START_BIT_FLAG_DYNAMIC;
+#endif
+
+                            switch (start_bit.flags & IRMP_START_BIT_SETUP_MASK)
+                            {
+#if IRMP_SUPPORT_MANCHESTER == 1
+                                case IRMP_START_BIT_SETUP_MANCHESTER:
+                                    irmp_last_pause = 0;
+                                    irmp_last_value = 1;
+                                    break;
+                                case IRMP_START_BIT_SETUP_LAST_PAUSE:
+                                    irmp_last_pause = irmp_pause_time;
+                                    irmp_last_value = 1;
+                                    break;
+#endif // IRMP_SUPPORT_MANCHESTER == 1
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1
+                                case IRMP_START_BIT_SETUP_RC5:
+#if IRMP_SUPPORT_FDC_PROTOCOL == 1
+                                    if (irmp_pulse_time >= FDC_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= FDC_START_BIT_PULSE_LEN_MAX &&
+                                        irmp_pause_time >= FDC_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= FDC_START_BIT_PAUSE_LEN_MAX)
+                                    {
+                                        memcpy_P (&irmp_param2, &fdc_param, sizeof (IRMP_PARAMETER));
+                                    }
+                                    else
+#endif // IRMP_SUPPORT_FDC_PROTOCOL == 1
+#if IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+                                    if (irmp_pulse_time >= RCCAR_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= RCCAR_START_BIT_PULSE_LEN_MAX &&
+                                        irmp_pause_time >= RCCAR_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_START_BIT_PAUSE_LEN_MAX)
+                                    {
+                                        memcpy_P (&irmp_param2, &rccar_param, sizeof (IRMP_PARAMETER));
+                                    }
+                                    else
+#endif // IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+                                    {
+                                    }
+
+                                    irmp_last_pause = irmp_pause_time;
+
+                                    if ((irmp_pulse_time > RC5_START_BIT_LEN_MAX && irmp_pulse_time <= 2 * RC5_START_BIT_LEN_MAX) ||
+                                        (irmp_pause_time > RC5_START_BIT_LEN_MAX && irmp_pause_time <= 2 * RC5_START_BIT_LEN_MAX))
+                                    {
+                                        irmp_last_value = 0;
+                                        irmp_rc5_cmd_bit6 = 1<<6;
+                                    }
+                                    else
+                                    {
+                                        irmp_last_value = 1;
+                                    }
+                                    break;
+#endif // IRMP_SUPPORT_RC5_PROTOCOL == 1
+#if IRMP_SUPPORT_S100_PROTOCOL == 1
+                                case IRMP_START_BIT_SETUP_S100:
+                                    irmp_last_pause = irmp_pause_time;
+
+                                    if ((irmp_pulse_time > S100_START_BIT_LEN_MAX && irmp_pulse_time <= 2 * S100_START_BIT_LEN_MAX) ||
+                                        (irmp_pause_time > S100_START_BIT_LEN_MAX && irmp_pause_time <= 2 * S100_START_BIT_LEN_MAX))
+                                    {
+                                        irmp_last_value = 0;
+                                        irmp_rc5_cmd_bit6 = 1<<6;
+                                    }
+                                    else
+                                    {
+                                        irmp_last_value = 1;
+                                    }
+                                    break;
+#endif // IRMP_SUPPORT_S100_PROTOCOL == 1
+#if IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
+                                case IRMP_START_BIT_SETUP_BANG_OLUFSEN:
+                                    irmp_last_value = 0;
+                                    break;
+#endif // IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
+#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+                                case IRMP_START_BIT_SETUP_ORTEK:
+                                    irmp_last_pause = 0;
+                                    irmp_last_value = 1;
+                                    irmp_parity     = 0;
+                                    break;
+#endif // IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+                                default:
+                                    break;
+                            }
+                        }
+                        else
+                        {
+#ifdef ANALYZE
+                            if (irmp_param_p && ! start_bit_table_masked)
+                            {
+                                printf ("error: start bit table: pulse = %d, pause = %d: protocol = 0, classification: %d\n", irmp_pulse_time, irmp_pause_time,
+                                        irmp_param_p->protocol);
+                                start_bit_table_errors++;
+                            }
+#endif // ANALYZE
+                            irmp_param_p = (IRMP_PARAMETER *) 0;
+                            irmp_start_bit_detected = 0;                        // wait for another start bit...
+                        }
+#ifdef ANALYZE
+                        start_bit_table_lookups++;
+#endif // ANALYZE
+                    }
+#endif // IRMP_USE_START_BIT_TABLE == 1
+
+                    if (irmp_start_bit_detected)
+                    {
+#if IRMP_DYNAMIC_PROTOCOLS > 0 || IRMP_LEARNED_WINDOWS > 0
+                        if (irmp_param_dynamic)
+                        {
+                            irmp_param = *irmp_param_p;                         // parameters in RAM, see irmp_set_dynamic_protocol()
+                        }
+                        else
+#endif
+                        memcpy_P (&irmp_param, irmp_param_p, sizeof (IRMP_PARAMETER));
+                        IRMP_TRACE (IRMP_TRACE_PROTOCOL, irmp_param.protocol, 0);
+#if IRMP_LEARNED_WINDOWS > 0
+                        irmp_tmp_quality.start_protocol = irmp_param.protocol;
+#endif
+#if IRMP_USE_RAW_FRAME == 1
+                        irmp_raw_pending = (irmp_param.flags & IRMP_PARAM_FLAG_RAW_FIELDS) ? TRUE : FALSE;
+#endif
+
+                        if (! (irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER))
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("pulse_1: %3d - %3d\n", irmp_param.pulse_1_len_min, irmp_param.pulse_1_len_max);
+                            ANALYZE_PRINTF ("pause_1: %3d - %3d\n", irmp_param.pause_1_len_min, irmp_param.pause_1_len_max);
+#endif // ANALYZE
+                        }
+                        else
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("pulse: %3d - %3d or %3d - %3d\n", irmp_param.pulse_1_len_min, irmp_param.pulse_1_len_max,
+                                            2 * irmp_param.pulse_1_len_min, 2 * irmp_param.pulse_1_len_max);
+                            ANALYZE_PRINTF ("pause: %3d - %3d or %3d - %3d\n", irmp_param.pause_1_len_min, irmp_param.pause_1_len_max,
+                                            2 * irmp_param.pause_1_len_min, 2 * irmp_param.pause_1_len_max);
+#endif // ANALYZE
+                        }
+
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
+                        if (irmp_param2.protocol)
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("pulse_0: %3d - %3d\n", irmp_param2.pulse_0_len_min, irmp_param2.pulse_0_len_max);
+                            ANALYZE_PRINTF ("pause_0: %3d - %3d\n", irmp_param2.pause_0_len_min, irmp_param2.pause_0_len_max);
+                            ANALYZE_PRINTF ("pulse_1: %3d - %3d\n", irmp_param2.pulse_1_len_min, irmp_param2.pulse_1_len_max);
+                            ANALYZE_PRINTF ("pause_1: %3d - %3d\n", irmp_param2.pause_1_len_min, irmp_param2.pause_1_len_max);
+#endif // ANALYZE
+                        }
+#endif
+
+
+#if IRMP_SUPPORT_RC6_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_RC6_PROTOCOL)
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("pulse_toggle: %3d - %3d\n", RC6_TOGGLE_BIT_LEN_MIN, RC6_TOGGLE_BIT_LEN_MAX);
+#endif // ANALYZE
+                        }
+#endif
+
+                        if (! (irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER))
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("pulse_0: %3d - %3d\n", irmp_param.pulse_0_len_min, irmp_param.pulse_0_len_max);
+                            ANALYZE_PRINTF ("pause_0: %3d - %3d\n", irmp_param.pause_0_len_min, irmp_param.pause_0_len_max);
+#endif // ANALYZE
+                        }
+                        else
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("pulse: %3d - %3d or %3d - %3d\n", irmp_param.pulse_0_len_min, irmp_param.pulse_0_len_max,
+                                            2 * irmp_param.pulse_0_len_min, 2 * irmp_param.pulse_0_len_max);
+                            ANALYZE_PRINTF ("pause: %3d - %3d or %3d - %3d\n", irmp_param.pause_0_len_min, irmp_param.pause_0_len_max,
+                                            2 * irmp_param.pause_0_len_min, 2 * irmp_param.pause_0_len_max);
+#endif // ANALYZE
+                        }
+
+#ifdef ANALYZE
+#if IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_BANG_OLUFSEN_PROTOCOL)
+                        {
+                            ANALYZE_PRINTF ("pulse_r: %3d - %3d\n", irmp_param.pulse_0_len_min, irmp_param.pulse_0_len_max);
+                            ANALYZE_PRINTF ("pause_r: %3d - %3d\n", BANG_OLUFSEN_R_PAUSE_LEN_MIN, BANG_OLUFSEN_R_PAUSE_LEN_MAX);
+                        }
+#endif
+
+                        ANALYZE_PRINTF ("command_offset: %2d\n", irmp_param.command_offset);
+                        ANALYZE_PRINTF ("command_len:    %3d\n", irmp_param.command_end - irmp_param.command_offset);
+                        ANALYZE_PRINTF ("complete_len:   %3d\n", irmp_param.complete_len);
+                        ANALYZE_PRINTF ("stop_bit:       %3d\n", irmp_param.stop_bit);
+#endif // ANALYZE
+                    }
+
+                    irmp_bit = 0;
+
+#if IRMP_SUPPORT_MANCHESTER == 1
+                    if ((irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER) &&
+                         irmp_param.protocol != IRMP_RUWIDO_PROTOCOL && // Manchester, but not RUWIDO
+                         irmp_param.protocol != IRMP_RC6_PROTOCOL)      // Manchester, but not RC6
+                    {
+                        if (irmp_pause_time > irmp_param.pulse_1_len_max && irmp_pause_time <= 2 * irmp_param.pulse_1_len_max)
+                        {
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT_TIMING, 0, irmp_pause_time);
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, (irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? '0' : '1', 1);
+                            irmp_store_bit (IRMP_CTX_ARG_ (irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? 0 : 1);
+                        }
+                        else if (! irmp_last_value) // && irmp_pause_time >= irmp_param.pause_1_len_min && irmp_pause_time <= irmp_param.pause_1_len_max)
+                        {
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT_TIMING, 0, irmp_pause_time);
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, (irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? '1' : '0', 1);
+                            irmp_store_bit (IRMP_CTX_ARG_ (irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? 1 : 0);
+                        }
+                    }
+                    else
+#endif // IRMP_SUPPORT_MANCHESTER == 1
+
+#if IRMP_SUPPORT_SERIAL == 1
+                    if (irmp_param.flags & IRMP_PARAM_FLAG_IS_SERIAL)
+                    {
+                        ; // do nothing
+                    }
+                    else
+#endif // IRMP_SUPPORT_SERIAL == 1
+
+
+#if IRMP_SUPPORT_DENON_PROTOCOL == 1
+                    if (irmp_param.protocol == IRMP_DENON_PROTOCOL)
+                    {
+                        IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT_TIMING, 0, irmp_pause_time);
+
+                        if (irmp_pause_time >= DENON_1_PAUSE_LEN_MIN && irmp_pause_time <= DENON_1_PAUSE_LEN_MAX)
+                        {                                                       // pause timings correct for "1"?
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '1', 1);       // yes, store 1
+                            irmp_store_bit (IRMP_CTX_ARG_ 1);
+                        }
+                        else // if (irmp_pause_time >= DENON_0_PAUSE_LEN_MIN && irmp_pause_time <= DENON_0_PAUSE_LEN_MAX)
+                        {                                                       // pause timings correct for "0"?
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '0', 1);       // yes, store 0
+                            irmp_store_bit (IRMP_CTX_ARG_ 0);
+                        }
+                    }
+                    else
+#endif // IRMP_SUPPORT_DENON_PROTOCOL == 1
+#if IRMP_SUPPORT_THOMSON_PROTOCOL == 1
+                    if (irmp_param.protocol == IRMP_THOMSON_PROTOCOL)
+                    {
+                        IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT_TIMING, 0, irmp_pause_time);
+
+                        if (irmp_pause_time >= THOMSON_1_PAUSE_LEN_MIN && irmp_pause_time <= THOMSON_1_PAUSE_LEN_MAX)
+                        {                                                       // pause timings correct for "1"?
+                          IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '1', 1);         // yes, store 1
+                          irmp_store_bit (IRMP_CTX_ARG_ 1);
+                        }
+                        else // if (irmp_pause_time >= THOMSON_0_PAUSE_LEN_MIN && irmp_pause_time <= THOMSON_0_PAUSE_LEN_MAX)
+                        {                                                       // pause timings correct for "0"?
+                          IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '0', 1);         // yes, store 0
+                          irmp_store_bit (IRMP_CTX_ARG_ 0);
+                        }
+                    }
+                    else
+#endif // IRMP_SUPPORT_THOMSON_PROTOCOL == 1
+                    {
+                        ;                                                       // else do nothing
+                    }
+
+                    irmp_pulse_time = 1;                                        // set counter to 1, not 0
+                    irmp_pause_time = 0;
+                    irmp_wait_for_start_space = 0;
+                }
+            }
+            else if (irmp_wait_for_space)                                       // the data section....
+            {                                                                   // counting the time of darkness....
+                uint_fast8_t got_light = FALSE;
+
+                if (irmp_input)                                                 // still dark?
+                {                                                               // yes...
+                    if (irmp_bit == irmp_param.complete_len && irmp_param.stop_bit == 1)
+                    {
+                        if (
+#if IRMP_SUPPORT_MANCHESTER == 1
+                            (irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER) ||
+#endif
+#if IRMP_SUPPORT_SERIAL == 1
+                            (irmp_param.flags & IRMP_PARAM_FLAG_IS_SERIAL) ||
+#endif
+                            (irmp_pulse_time >= irmp_param.pulse_0_len_min && irmp_pulse_time <= irmp_param.pulse_0_len_max))
+                        {
+#ifdef ANALYZE
+                            if (! (irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER))
+                            {
+                                ANALYZE_PRINTF ("stop bit detected\n");
+                            }
+#endif // ANALYZE
+                            irmp_param.stop_bit = 0;
+                        }
+                        else
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("error: stop bit timing wrong, irmp_bit = %d, irmp_pulse_time = %d, pulse_0_len_min = %d, pulse_0_len_max = %d\n",
+                                            irmp_bit, irmp_pulse_time, irmp_param.pulse_0_len_min, irmp_param.pulse_0_len_max);
+#endif // ANALYZE
+                            irmp_start_bit_detected = 0;                        // wait for another start bit...
+                            irmp_pulse_time         = 0;
+                            irmp_pause_time         = 0;
+                        }
+                    }
+                    else
+                    {
+                        irmp_pause_time++;                                                          // increment counter
+
+#if IRMP_SUPPORT_SIRCS_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_SIRCS_PROTOCOL &&                           // Sony has a variable number of bits:
+                            irmp_pause_time > SIRCS_PAUSE_LEN_MAX &&                                // minimum is 12
+                            irmp_bit >= 12 - 1)                                                     // pause too long?
+                        {                                                                           // yes, break and close this frame
+                            irmp_param.complete_len = irmp_bit + 1;                                 // set new complete length
+                            got_light = TRUE;                                                       // this is a lie, but helps (generates stop bit)
+                            irmp_tmp_address |= (irmp_bit - SIRCS_MINIMUM_DATA_LEN + 1) << 8;       // new: store number of additional bits in upper byte of address!
+                            irmp_param.command_end = irmp_param.command_offset + irmp_bit + 1;      // correct command length
+                            irmp_pause_time = SIRCS_PAUSE_LEN_MAX - 1;                              // correct pause length
+                        }
+                        else
+#endif
+#if IRMP_SUPPORT_FAN_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_FAN_PROTOCOL &&                             // FAN has no stop bit.
+                            irmp_bit >= FAN_COMPLETE_DATA_LEN - 1)                                  // last bit in frame
+                        {                                                                           // yes, break and close this frame
+                            if (irmp_pulse_time <= FAN_0_PULSE_LEN_MAX && irmp_pause_time >= FAN_0_PAUSE_LEN_MIN)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Generating virtual stop bit\n");
+#endif // ANALYZE
+                                got_light = TRUE;                                                   // this is a lie, but helps (generates stop bit)
+                            }
+                            else if (irmp_pulse_time >= FAN_1_PULSE_LEN_MIN && irmp_pause_time >= FAN_1_PAUSE_LEN_MIN)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Generating virtual stop bit\n");
+#endif // ANALYZE
+                                got_light = TRUE;                                                   // this is a lie, but helps (generates stop bit)
+                            }
+                        }
+                        else
+#endif
+#if IRMP_SUPPORT_SERIAL == 1
+                        // NETBOX generates no stop bit, here is the timeout condition:
+                        if ((irmp_param.flags & IRMP_PARAM_FLAG_IS_SERIAL) && irmp_param.protocol == IRMP_NETBOX_PROTOCOL &&
+                            irmp_pause_time >= NETBOX_PULSE_LEN * (NETBOX_COMPLETE_DATA_LEN - irmp_bit))
+                        {
+                            got_light = TRUE;                                                       // this is a lie, but helps (generates stop bit)
+                        }
+                        else
+#endif
+#if IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_GRUNDIG_PROTOCOL && !irmp_param.stop_bit)
+                        {
+                            if (irmp_pause_time > IR60_TIMEOUT_LEN && (irmp_bit == 5 || irmp_bit == 6))
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to IR60 protocol\n");
+#endif // ANALYZE
+                                got_light = TRUE;                                       // this is a lie, but generates a stop bit ;-)
+                                irmp_param.stop_bit = TRUE;                             // set flag
+
+                                irmp_param.protocol         = IRMP_IR60_PROTOCOL;       // change protocol
+                                irmp_param.complete_len     = IR60_COMPLETE_DATA_LEN;   // correct complete len
+                                irmp_param.address_offset   = IR60_ADDRESS_OFFSET;
+                                irmp_param.address_end      = IR60_ADDRESS_OFFSET + IR60_ADDRESS_LEN;
+                                irmp_param.command_offset   = IR60_COMMAND_OFFSET;
+                                irmp_param.command_end      = IR60_COMMAND_OFFSET + IR60_COMMAND_LEN;
+
+                                irmp_tmp_command <<= 1;
+                                irmp_tmp_command |= irmp_first_bit;
+                            }
+                            else if (irmp_pause_time >= 2 * irmp_param.pause_1_len_max && irmp_bit >= GRUNDIG_COMPLETE_DATA_LEN - 2)
+                            {                                                           // special manchester decoder
+                                irmp_param.complete_len = GRUNDIG_COMPLETE_DATA_LEN;    // correct complete len
+                                got_light = TRUE;                                       // this is a lie, but generates a stop bit ;-)
+                                irmp_param.stop_bit = TRUE;                             // set flag
+                            }
+                            else if (irmp_bit >= GRUNDIG_COMPLETE_DATA_LEN)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to NOKIA protocol, irmp_bit = %d\n", irmp_bit);
+#endif // ANALYZE
+                                irmp_param.protocol         = IRMP_NOKIA_PROTOCOL;      // change protocol
+                                irmp_param.address_offset   = NOKIA_ADDRESS_OFFSET;
+                                irmp_param.address_end      = NOKIA_ADDRESS_OFFSET + NOKIA_ADDRESS_LEN;
+                                irmp_param.command_offset   = NOKIA_COMMAND_OFFSET;
+                                irmp_param.command_end      = NOKIA_COMMAND_OFFSET + NOKIA_COMMAND_LEN;
+
+                                if (irmp_tmp_command & 0x300)
+                                {
+                                    irmp_tmp_address = (irmp_tmp_command >> 8);
+                                    irmp_tmp_command &= 0xFF;
+                                }
+                            }
+                        }
+                        else
+#endif
+#if IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_RUWIDO_PROTOCOL && !irmp_param.stop_bit)
+                        {
+                            if (irmp_pause_time >= 2 * irmp_param.pause_1_len_max && irmp_bit >= RUWIDO_COMPLETE_DATA_LEN - 2)
+                            {                                                           // special manchester decoder
+                                irmp_param.complete_len = RUWIDO_COMPLETE_DATA_LEN;     // correct complete len
+                                got_light = TRUE;                                       // this is a lie, but generates a stop bit ;-)
+                                irmp_param.stop_bit = TRUE;                             // set flag
+                            }
+                            else if (irmp_bit >= RUWIDO_COMPLETE_DATA_LEN)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to SIEMENS protocol\n");
+#endif // ANALYZE
+                                irmp_param.protocol         = IRMP_SIEMENS_PROTOCOL;    // change protocol
+                                irmp_param.address_offset   = SIEMENS_ADDRESS_OFFSET;
+                                irmp_param.address_end      = SIEMENS_ADDRESS_OFFSET + SIEMENS_ADDRESS_LEN;
+                                irmp_param.command_offset   = SIEMENS_COMMAND_OFFSET;
+                                irmp_param.command_end      = SIEMENS_COMMAND_OFFSET + SIEMENS_COMMAND_LEN;
+
+                                //                   76543210
+                                // RUWIDO:  AAAAAAAAACCCCCCCp
+                                // SIEMENS: AAAAAAAAAAACCCCCCCCCCp
+                                irmp_tmp_address <<= 2;
+                                irmp_tmp_address |= (irmp_tmp_command >> 6);
+                                irmp_tmp_command &= 0x003F;
+//                              irmp_tmp_command <<= 4;
+                                irmp_tmp_command |= irmp_last_value;
+                            }
+                        }
+                        else
+#endif
+#if IRMP_SUPPORT_ROOMBA_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_ROOMBA_PROTOCOL &&                          // Roomba has no stop bit
+                            irmp_bit >= ROOMBA_COMPLETE_DATA_LEN - 1)                               // it's the last data bit...
+                        {                                                                           // break and close this frame
+                            if (irmp_pulse_time >= ROOMBA_1_PULSE_LEN_MIN && irmp_pulse_time <= ROOMBA_1_PULSE_LEN_MAX)
+                            {
+                                irmp_pause_time = ROOMBA_1_PAUSE_LEN_EXACT;
+                            }
+                            else if (irmp_pulse_time >= ROOMBA_0_PULSE_LEN_MIN && irmp_pulse_time <= ROOMBA_0_PULSE_LEN_MAX)
+                            {
+                                irmp_pause_time = ROOMBA_0_PAUSE_LEN;
+                            }
+
+                            got_light = TRUE;                                                       // this is a lie, but helps (generates stop bit)
+                        }
+                        else
+#endif
+#if IRMP_SUPPORT_MANCHESTER == 1
+                        if ((irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER) &&
+                            irmp_pause_time >= 2 * irmp_param.pause_1_len_max && irmp_bit >= irmp_param.complete_len - 2 && !irmp_param.stop_bit)
+                        {                                                       // special manchester decoder
+                            got_light = TRUE;                                   // this is a lie, but generates a stop bit ;-)
+                            irmp_param.stop_bit = TRUE;                         // set flag
+                        }
+                        else
+#endif // IRMP_SUPPORT_MANCHESTER == 1
+                        if (irmp_pause_time > IRMP_TIMEOUT_LEN                  // timeout?
+#if IRMP_FAST_NEC == 1 && IRMP_SUPPORT_NEC_PROTOCOL == 1 && IRMP_SUPPORT_NEC42_PROTOCOL == 1
+                            || (irmp_param.protocol == IRMP_NEC42_PROTOCOL && irmp_bit == 32 &&                 // or NEC stop bit and no 33rd bit
+                                (irmp_pause_time > irmp_param.pause_1_len_max || ! irmp_nec42_expected))
+#endif
+                           )
+                        {                                                       // yes...
+#if IRMP_USE_RAW_FRAME == 1
+                            if (irmp_raw_pending)                               // protocol switches below read the fields
+                            {
+                                irmp_raw_extract (IRMP_CTX_ARG);
+                            }
+#endif
+                            if (irmp_bit == irmp_param.complete_len - 1 && irmp_param.stop_bit == 0)
+                            {
+                                irmp_bit++;
+                            }
+#if IRMP_SUPPORT_JVC_PROTOCOL == 1
+                            else if (irmp_param.protocol == IRMP_NEC_PROTOCOL && (irmp_bit == 16 || irmp_bit == 17))      // it was a JVC stop bit
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to JVC protocol, irmp_bit = %d\n", irmp_bit);
+#endif // ANALYZE
+                                irmp_param.stop_bit     = TRUE;                                     // set flag
+                                irmp_param.protocol     = IRMP_JVC_PROTOCOL;                        // switch protocol
+                                irmp_param.complete_len = irmp_bit;                                 // patch length: 16 or 17
+                                irmp_tmp_command        = (irmp_tmp_address >> 4);                  // set command: upper 12 bits are command bits
+                                irmp_tmp_address        = irmp_tmp_address & 0x000F;                // lower 4 bits are address bits
+                                irmp_start_bit_detected = 1;                                        // tricky: don't wait for another start bit...
+                            }
+#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
+#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
+                            else if (irmp_param.protocol == IRMP_NEC_PROTOCOL && (irmp_bit == 28 || irmp_bit == 29))      // it was a LGAIR stop bit
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to LGAIR protocol, irmp_bit = %d\n", irmp_bit);
+#endif // ANALYZE
+                                irmp_param.stop_bit     = TRUE;                                     // set flag
+                                irmp_param.protocol     = IRMP_LGAIR_PROTOCOL;                      // switch protocol
+                                irmp_param.complete_len = irmp_bit;                                 // patch length: 16 or 17
+                                irmp_tmp_command        = irmp_lgair_command;                       // set command: upper 8 bits are command bits
+                                irmp_tmp_address        = irmp_lgair_address;                       // lower 4 bits are address bits
+                                irmp_start_bit_detected = 1;                                        // tricky: don't wait for another start bit...
+                            }
+#endif // IRMP_SUPPORT_LGAIR_PROTOCOL == 1
+
+#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
+#if IRMP_SUPPORT_NEC_PROTOCOL == 1
+                            else if (irmp_param.protocol == IRMP_NEC42_PROTOCOL && irmp_bit == 32)      // it was a NEC stop bit
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to NEC protocol\n");
+#endif // ANALYZE
+                                irmp_param.stop_bit     = TRUE;                                     // set flag
+                                irmp_param.protocol     = IRMP_NEC_PROTOCOL;                        // switch protocol
+                                irmp_param.complete_len = irmp_bit;                                 // patch length: 16 or 17
+
+                                //        0123456789ABC0123456789ABC0123456701234567
+                                // NEC42: AAAAAAAAAAAAAaaaaaaaaaaaaaCCCCCCCCcccccccc
+                                // NEC:   AAAAAAAAaaaaaaaaCCCCCCCCcccccccc
+                                irmp_tmp_address        |= (irmp_tmp_address2 & 0x0007) << 13;      // fm 2012-02-13: 12 -> 13
+                                irmp_tmp_command        = (irmp_tmp_address2 >> 3) | (irmp_tmp_command << 10);
+                            }
+#endif // IRMP_SUPPORT_NEC_PROTOCOL == 1
+#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
+                            else if (irmp_param.protocol == IRMP_NEC42_PROTOCOL && irmp_bit == 28)      // it was a NEC stop bit
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to LGAIR protocol\n");
+#endif // ANALYZE
+                                irmp_param.stop_bit     = TRUE;                                     // set flag
+                                irmp_param.protocol     = IRMP_LGAIR_PROTOCOL;                      // switch protocol
+                                irmp_param.complete_len = irmp_bit;                                 // patch length: 16 or 17
+                                irmp_tmp_address        = irmp_lgair_address;
+                                irmp_tmp_command        = irmp_lgair_command;
+                            }
+#endif // IRMP_SUPPORT_LGAIR_PROTOCOL == 1
+#if IRMP_SUPPORT_JVC_PROTOCOL == 1
+                            else if (irmp_param.protocol == IRMP_NEC42_PROTOCOL && (irmp_bit == 16 || irmp_bit == 17))  // it was a JVC stop bit
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to JVC protocol, irmp_bit = %d\n", irmp_bit);
+#endif // ANALYZE
+                                irmp_param.stop_bit     = TRUE;                                     // set flag
+                                irmp_param.protocol     = IRMP_JVC_PROTOCOL;                        // switch protocol
+                                irmp_param.complete_len = irmp_bit;                                 // patch length: 16 or 17
+
+                                //        0123456789ABC0123456789ABC0123456701234567
+                                // NEC42: AAAAAAAAAAAAAaaaaaaaaaaaaaCCCCCCCCcccccccc
+                                // JVC:   AAAACCCCCCCCCCCC
+                                irmp_tmp_command        = (irmp_tmp_address >> 4) | (irmp_tmp_address2 << 9);   // set command: upper 12 bits are command bits
+                                irmp_tmp_address        = irmp_tmp_address & 0x000F;                            // lower 4 bits are address bits
+                            }
+#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
+#endif // IRMP_SUPPORT_NEC42_PROTOCOL == 1
+
+#if IRMP_SUPPORT_SAMSUNG48_PROTOCOL == 1
+                            else if (irmp_param.protocol == IRMP_SAMSUNG48_PROTOCOL && irmp_bit == 32)          // it was a SAMSUNG32 stop bit
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to SAMSUNG32 protocol\n");
+#endif // ANALYZE
+                                irmp_param.protocol         = IRMP_SAMSUNG32_PROTOCOL;
+                                irmp_param.command_offset   = SAMSUNG32_COMMAND_OFFSET;
+                                irmp_param.command_end      = SAMSUNG32_COMMAND_OFFSET + SAMSUNG32_COMMAND_LEN;
+                                irmp_param.complete_len     = SAMSUNG32_COMPLETE_DATA_LEN;
+                            }
+#endif // IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+
+#if IRMP_SUPPORT_RCMM_PROTOCOL == 1
+                            else if (irmp_param.protocol == IRMP_RCMM32_PROTOCOL && (irmp_bit == 12 || irmp_bit == 24))  // it was a RCMM stop bit
+                            {
+                                if (irmp_bit == 12)
+                                {
+                                    irmp_tmp_command = (irmp_tmp_address & 0xFF);                   // set command: lower 8 bits are command bits
+                                    irmp_tmp_address >>= 8;                                         // upper 4 bits are address bits
+
+#ifdef ANALYZE
+                                    ANALYZE_PRINTF ("Switching to RCMM12 protocol, irmp_bit = %d\n", irmp_bit);
+#endif // ANALYZE
+                                    irmp_param.protocol     = IRMP_RCMM12_PROTOCOL;                 // switch protocol
+                                }
+                                else // if ((irmp_bit == 24)
+                                {
+#ifdef ANALYZE
+                                    ANALYZE_PRINTF ("Switching to RCMM24 protocol, irmp_bit = %d\n", irmp_bit);
+#endif // ANALYZE
+                                    irmp_param.protocol     = IRMP_RCMM24_PROTOCOL;                 // switch protocol
+                                }
+                                irmp_param.stop_bit     = TRUE;                                     // set flag
+                                irmp_param.complete_len = irmp_bit;                                 // patch length
+                            }
+#endif // IRMP_SUPPORT_RCMM_PROTOCOL == 1
+
+#if IRMP_SUPPORT_TECHNICS_PROTOCOL == 1
+                            else if (irmp_param.protocol == IRMP_MATSUSHITA_PROTOCOL && irmp_bit == 22)  // it was a TECHNICS stop bit
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to TECHNICS protocol, irmp_bit = %d\n", irmp_bit);
+#endif // ANALYZE
+                                // Situation:
+                                // The first 12 bits have been stored in irmp_tmp_command (LSB first)
+                                // The following 10 bits have been stored in irmp_tmp_address (LSB first)
+                                // The code of TECHNICS is:
+                                //   cccccccccccCCCCCCCCCCC (11 times c and 11 times C)
+                                //   ccccccccccccaaaaaaaaaa
+                                // where C is inverted value of c
+
+                                irmp_tmp_address <<= 1;
+                                if (irmp_tmp_command & (1<<11))
+                                {
+                                    irmp_tmp_address |= 1;
+                                    irmp_tmp_command &= ~(1<<11);
+                                }
+
+                                if (irmp_tmp_command == ((~irmp_tmp_address) & 0x07FF))
+                                {
+                                    irmp_tmp_address = 0;
+
+                                    irmp_param.protocol     = IRMP_TECHNICS_PROTOCOL;                   // switch protocol
+                                    irmp_param.complete_len = irmp_bit;                                 // patch length
+                                }
+                                else
+                                {
+                                    IRMP_ERROR (technics, 8, irmp_pause_time);
+                                    irmp_start_bit_detected = 0;                    // wait for another start bit...
+                                    irmp_pulse_time         = 0;
+                                    irmp_pause_time         = 0;
+                                }
+                            }
+#endif // IRMP_SUPPORT_TECHNICS_PROTOCOL == 1
+                            else
+                            {
+                                IRMP_ERROR (data_pause, 2, irmp_pause_time);
+                                irmp_start_bit_detected = 0;                    // wait for another start bit...
+                                irmp_pulse_time         = 0;
+                                irmp_pause_time         = 0;
+                            }
+                        }
+                    }
+                }
+                else
+                {                                                               // got light now!
+                    got_light = TRUE;
+                }
+
+                if (got_light)
+                {
+#if IRMP_CANDIDATES > 1
+                    if (irmp_candidate_count)
+                    {
+                        irmp_candidate_bit (IRMP_CTX_ARG);
+                    }
+#endif
+
+                    IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT_TIMING, 0, irmp_pause_time);
+
+#if IRMP_SUPPORT_MANCHESTER == 1
+                    if ((irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER))                                     // Manchester
+                    {
+#if 1
+                        if (irmp_pulse_time > irmp_param.pulse_1_len_max /* && irmp_pulse_time <= 2 * irmp_param.pulse_1_len_max */)
+#else // better, but some IR-RCs use asymmetric timings :-/
+                        if (irmp_pulse_time > irmp_param.pulse_1_len_max && irmp_pulse_time <= 2 * irmp_param.pulse_1_len_max &&
+                            irmp_pause_time <= 2 * irmp_param.pause_1_len_max)
+#endif
+                        {
+#if IRMP_SUPPORT_RC6_PROTOCOL == 1
+                            if (irmp_param.protocol == IRMP_RC6_PROTOCOL && irmp_bit == 4 && irmp_pulse_time > RC6_TOGGLE_BIT_LEN_MIN)         // RC6 toggle bit
+                            {
+                                IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, 'T', 0);
+                                if (irmp_param.complete_len == RC6_COMPLETE_DATA_LEN_LONG)                      // RC6 mode 6A
+                                {
+                                    irmp_store_bit (IRMP_CTX_ARG_ 1);
+                                    irmp_last_value = 1;
+                                }
+                                else                                                                            // RC6 mode 0
+                                {
+                                    irmp_store_bit (IRMP_CTX_ARG_ 0);
+                                    irmp_last_value = 0;
+                                }
+                                IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, 0, 1);
+                            }
+                            else
+#endif // IRMP_SUPPORT_RC6_PROTOCOL == 1
+                            {
+                                IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, (irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? '0' : '1', 0);
+                                irmp_store_bit (IRMP_CTX_ARG_ (irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? 0  :  1 );
+
+#if IRMP_SUPPORT_RC6_PROTOCOL == 1
+                                if (irmp_param.protocol == IRMP_RC6_PROTOCOL && irmp_bit == 4 && irmp_pulse_time > RC6_TOGGLE_BIT_LEN_MIN)      // RC6 toggle bit
+                                {
+                                    IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, 'T', 0);
+                                    irmp_store_bit (IRMP_CTX_ARG_ 1);
+
+                                    if (irmp_pause_time > 2 * irmp_param.pause_1_len_max)
+                                    {
+                                        irmp_last_value = 0;
+                                    }
+                                    else
+                                    {
+                                        irmp_last_value = 1;
+                                    }
+                                    IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, 0, 1);
+                                }
+                                else
+#endif // IRMP_SUPPORT_RC6_PROTOCOL == 1
+                                {
+                                    IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, (irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? '1' : '0', 0);
+                                    irmp_store_bit (IRMP_CTX_ARG_ (irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? 1 :   0 );
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
+                                    if (! irmp_param2.protocol)
+#endif
+                                    {
+                                        IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, 0, 1);
+                                    }
+                                    irmp_last_value = (irmp_param.flags & IRMP_PARAM_FLAG_1ST_PULSE_IS_1) ? 1 : 0;
+                                }
+                            }
+                        }
+                        else if (irmp_pulse_time >= irmp_param.pulse_1_len_min && irmp_pulse_time <= irmp_param.pulse_1_len_max
+                                 /* && irmp_pause_time <= 2 * irmp_param.pause_1_len_max */)
+                        {
+                            uint_fast8_t manchester_value;
+
+                            if (irmp_last_pause > irmp_param.pause_1_len_max && irmp_last_pause <= 2 * irmp_param.pause_1_len_max)
+                            {
+                                manchester_value = irmp_last_value ? 0 : 1;
+                                irmp_last_value = manchester_value;
+                            }
+                            else
+                            {
+                                manchester_value = irmp_last_value;
+                            }
+
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, manchester_value + '0', 0);
+
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
+                            if (! irmp_param2.protocol)
+#endif
+                            {
+                                IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, 0, 1);
+                            }
+
+#if IRMP_SUPPORT_RC6_PROTOCOL == 1
+                            if (irmp_param.protocol == IRMP_RC6_PROTOCOL && irmp_bit == 1 && manchester_value == 1)     // RC6 mode != 0 ???
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to RC6A protocol\n");
+#endif // ANALYZE
+                                irmp_param.complete_len = RC6_COMPLETE_DATA_LEN_LONG;
+                                irmp_param.address_offset = 5;
+                                irmp_param.address_end = irmp_param.address_offset + 15;
+                                irmp_param.command_offset = irmp_param.address_end + 1;                                 // skip 1 system bit, changes like a toggle bit
+                                irmp_param.command_end = irmp_param.command_offset + 16 - 1;
+                                irmp_tmp_address = 0;
+                            }
+#endif // IRMP_SUPPORT_RC6_PROTOCOL == 1
+
+                            irmp_store_bit (IRMP_CTX_ARG_ manchester_value);
+                        }
+                        else
+                        {
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && IRMP_SUPPORT_FDC_PROTOCOL == 1
+                            if (irmp_param2.protocol == IRMP_FDC_PROTOCOL &&
+                                irmp_pulse_time >= FDC_PULSE_LEN_MIN && irmp_pulse_time <= FDC_PULSE_LEN_MAX &&
+                                ((irmp_pause_time >= FDC_1_PAUSE_LEN_MIN && irmp_pause_time <= FDC_1_PAUSE_LEN_MAX) ||
+                                 (irmp_pause_time >= FDC_0_PAUSE_LEN_MIN && irmp_pause_time <= FDC_0_PAUSE_LEN_MAX)))
+                            {
+                                IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '?', 0);
+                                irmp_param.protocol = 0;                // switch to FDC, see below
+                            }
+                            else
+#endif // IRMP_SUPPORT_FDC_PROTOCOL == 1
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+                            if (irmp_param2.protocol == IRMP_RCCAR_PROTOCOL &&
+                                irmp_pulse_time >= RCCAR_PULSE_LEN_MIN && irmp_pulse_time <= RCCAR_PULSE_LEN_MAX &&
+                                ((irmp_pause_time >= RCCAR_1_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_1_PAUSE_LEN_MAX) ||
+                                 (irmp_pause_time >= RCCAR_0_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_0_PAUSE_LEN_MAX)))
+                            {
+                                IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '?', 0);
+                                irmp_param.protocol = 0;                // switch to RCCAR, see below
+                            }
+                            else
+#endif // IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+                            {
+                                IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '?', 1);
+                                IRMP_ERROR (timing, IRMP_TRACE_ERROR_MANCHESTER | 3, irmp_pause_time);
+                                irmp_start_bit_detected = 0;                            // reset flags and wait for next start bit
+                                irmp_pause_time         = 0;
+                            }
+                        }
+
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && IRMP_SUPPORT_FDC_PROTOCOL == 1
+                        if (irmp_param2.protocol == IRMP_FDC_PROTOCOL && irmp_pulse_time >= FDC_PULSE_LEN_MIN && irmp_pulse_time <= FDC_PULSE_LEN_MAX)
+                        {
+                            if (irmp_pause_time >= FDC_1_PAUSE_LEN_MIN && irmp_pause_time <= FDC_1_PAUSE_LEN_MAX)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("   1 (FDC)\n");
+#endif // ANALYZE
+                                irmp_store_bit2 (IRMP_CTX_ARG_ 1);
+                            }
+                            else if (irmp_pause_time >= FDC_0_PAUSE_LEN_MIN && irmp_pause_time <= FDC_0_PAUSE_LEN_MAX)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("   0 (FDC)\n");
+#endif // ANALYZE
+                                irmp_store_bit2 (IRMP_CTX_ARG_ 0);
+                            }
+
+                            if (! irmp_param.protocol)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to FDC protocol\n");
+#endif // ANALYZE
+                                memcpy (&irmp_param, &irmp_param2, sizeof (IRMP_PARAMETER));
+                                irmp_param2.protocol = 0;
+                                irmp_tmp_address = irmp_tmp_address2;
+                                irmp_tmp_command = irmp_tmp_command2;
+                            }
+                        }
+#endif // IRMP_SUPPORT_FDC_PROTOCOL == 1
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+                        if (irmp_param2.protocol == IRMP_RCCAR_PROTOCOL && irmp_pulse_time >= RCCAR_PULSE_LEN_MIN && irmp_pulse_time <= RCCAR_PULSE_LEN_MAX)
+                        {
+                            if (irmp_pause_time >= RCCAR_1_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_1_PAUSE_LEN_MAX)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("   1 (RCCAR)\n");
+#endif // ANALYZE
+                                irmp_store_bit2 (IRMP_CTX_ARG_ 1);
+                            }
+                            else if (irmp_pause_time >= RCCAR_0_PAUSE_LEN_MIN && irmp_pause_time <= RCCAR_0_PAUSE_LEN_MAX)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("   0 (RCCAR)\n");
+#endif // ANALYZE
+                                irmp_store_bit2 (IRMP_CTX_ARG_ 0);
+                            }
+
+                            if (! irmp_param.protocol)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Switching to RCCAR protocol\n");
+#endif // ANALYZE
+                                memcpy (&irmp_param, &irmp_param2, sizeof (IRMP_PARAMETER));
+                                irmp_param2.protocol = 0;
+                                irmp_tmp_address = irmp_tmp_address2;
+                                irmp_tmp_command = irmp_tmp_command2;
+                            }
+                        }
+#endif // IRMP_SUPPORT_RCCAR_PROTOCOL == 1
+
+                        irmp_last_pause     = irmp_pause_time;
+                        irmp_wait_for_space = 0;
+                    }
+                    else
+#endif // IRMP_SUPPORT_MANCHESTER == 1
+
+#if IRMP_SUPPORT_SERIAL == 1
+                    if (irmp_param.flags & IRMP_PARAM_FLAG_IS_SERIAL)
+                    {
+                        while (irmp_bit < irmp_param.complete_len && irmp_pulse_time > irmp_param.pulse_1_len_max)
+                        {
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '1', 0);
+                            irmp_store_bit (IRMP_CTX_ARG_ 1);
+
+                            if (irmp_pulse_time >= irmp_param.pulse_1_len_min)
+                            {
+                                irmp_pulse_time -= irmp_param.pulse_1_len_min;
+                            }
+                            else
+                            {
+                                irmp_pulse_time = 0;
+                            }
+                        }
+
+                        while (irmp_bit < irmp_param.complete_len && irmp_pause_time > irmp_param.pause_1_len_max)
+                        {
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '0', 0);
+                            irmp_store_bit (IRMP_CTX_ARG_ 0);
+
+                            if (irmp_pause_time >= irmp_param.pause_1_len_min)
+                            {
+                                irmp_pause_time -= irmp_param.pause_1_len_min;
+                            }
+                            else
+                            {
+                                irmp_pause_time = 0;
+                            }
+                        }
+                        IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, 0, 1);
+                        irmp_wait_for_space = 0;
+                    }
+                    else
+#endif // IRMP_SUPPORT_SERIAL == 1
+
+#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+                    if (irmp_param.protocol == IRMP_SAMSUNG_PROTOCOL && irmp_bit == 16)       // Samsung: 16th bit
+                    {
+                        if (irmp_pulse_time >= SAMSUNG_PULSE_LEN_MIN && irmp_pulse_time <= SAMSUNG_PULSE_LEN_MAX &&
+                            irmp_pause_time >= SAMSUNG_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= SAMSUNG_START_BIT_PAUSE_LEN_MAX)
+                        {
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("SYNC\n");
+#endif // ANALYZE
+                            irmp_wait_for_space = 0;
+                            irmp_bit++;
+                        }
+                        else  if (irmp_pulse_time >= SAMSUNG_PULSE_LEN_MIN && irmp_pulse_time <= SAMSUNG_PULSE_LEN_MAX)
+                        {
+#if IRMP_SUPPORT_SAMSUNG48_PROTOCOL == 1
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("Switching to SAMSUNG48 protocol ");
+#endif // ANALYZE
+                            irmp_param.protocol         = IRMP_SAMSUNG48_PROTOCOL;
+                            irmp_param.command_offset   = SAMSUNG48_COMMAND_OFFSET;
+                            irmp_param.command_end      = SAMSUNG48_COMMAND_OFFSET + SAMSUNG48_COMMAND_LEN;
+                            irmp_param.complete_len     = SAMSUNG48_COMPLETE_DATA_LEN;
+#else
+#ifdef ANALYZE
+                            ANALYZE_PRINTF ("Switching to SAMSUNG32 protocol ");
+#endif // ANALYZE
+                            irmp_param.protocol         = IRMP_SAMSUNG32_PROTOCOL;
+                            irmp_param.command_offset   = SAMSUNG32_COMMAND_OFFSET;
+                            irmp_param.command_end      = SAMSUNG32_COMMAND_OFFSET + SAMSUNG32_COMMAND_LEN;
+                            irmp_param.complete_len     = SAMSUNG32_COMPLETE_DATA_LEN;
+#endif
+                            if (irmp_pause_time >= SAMSUNG_1_PAUSE_LEN_MIN && irmp_pause_time <= SAMSUNG_1_PAUSE_LEN_MAX)
+                            {
+                                IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '1', 1);
+                                irmp_store_bit (IRMP_CTX_ARG_ 1);
+                                irmp_wait_for_space = 0;
+                            }
+                            else
+                            {
+                                IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '0', 1);
+                                irmp_store_bit (IRMP_CTX_ARG_ 0);
+                                irmp_wait_for_space = 0;
+                            }
+                        }
+                        else
+                        {                                                           // timing incorrect!
+                            IRMP_ERROR (timing, IRMP_TRACE_ERROR_SAMSUNG | 3, irmp_pause_time);
+                            irmp_start_bit_detected = 0;                            // reset flags and wait for next start bit
+                            irmp_pause_time         = 0;
+                        }
+                    }
+                    else
+#endif // IRMP_SUPPORT_SAMSUNG_PROTOCOL
+
+#if IRMP_SUPPORT_NEC16_PROTOCOL
+#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
+                    if (irmp_param.protocol == IRMP_NEC42_PROTOCOL &&
+#else // IRMP_SUPPORT_NEC_PROTOCOL instead
+                    if (irmp_param.protocol == IRMP_NEC_PROTOCOL &&
+#endif // IRMP_SUPPORT_NEC42_PROTOCOL == 1
+                        irmp_bit == 8 && irmp_pause_time >= NEC_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NEC_START_BIT_PAUSE_LEN_MAX)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("Switching to NEC16 protocol\n");
+#endif // ANALYZE
+                        irmp_param.protocol         = IRMP_NEC16_PROTOCOL;
+                        irmp_param.address_offset   = NEC16_ADDRESS_OFFSET;
+                        irmp_param.address_end      = NEC16_ADDRESS_OFFSET + NEC16_ADDRESS_LEN;
+                        irmp_param.command_offset   = NEC16_COMMAND_OFFSET;
+                        irmp_param.command_end      = NEC16_COMMAND_OFFSET + NEC16_COMMAND_LEN;
+                        irmp_param.complete_len     = NEC16_COMPLETE_DATA_LEN;
+                        irmp_wait_for_space = 0;
+                    }
+                    else
+#endif // IRMP_SUPPORT_NEC16_PROTOCOL
+
+#if IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
+                    if (irmp_param.protocol == IRMP_BANG_OLUFSEN_PROTOCOL)
+                    {
+                        if (irmp_pulse_time >= BANG_OLUFSEN_PULSE_LEN_MIN && irmp_pulse_time <= BANG_OLUFSEN_PULSE_LEN_MAX)
+                        {
+                            if (irmp_bit == 1)                                      // Bang & Olufsen: 3rd bit
+                            {
+                                if (irmp_pause_time >= BANG_OLUFSEN_START_BIT3_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_START_BIT3_PAUSE_LEN_MAX)
+                                {
+#ifdef ANALYZE
+                                    ANALYZE_PRINTF ("3rd start bit\n");
+#endif // ANALYZE
+                                    irmp_wait_for_space = 0;
+                                    irmp_bit++;
+                                }
+                                else
+                                {                                                   // timing incorrect!
+                                    IRMP_ERROR (timing, IRMP_TRACE_ERROR_BANG_OLUFSEN (0) | 3, irmp_pause_time);
+                                    irmp_start_bit_detected = 0;                    // reset flags and wait for next start bit
+                                    irmp_pause_time         = 0;
+                                }
+                            }
+                            else if (irmp_bit == 19)                                // Bang & Olufsen: trailer bit
+                            {
+                                if (irmp_pause_time >= BANG_OLUFSEN_TRAILER_BIT_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_TRAILER_BIT_PAUSE_LEN_MAX)
+                                {
+#ifdef ANALYZE
+                                    ANALYZE_PRINTF ("trailer bit\n");
+#endif // ANALYZE
+                                    irmp_wait_for_space = 0;
+                                    irmp_bit++;
+                                }
+                                else
+                                {                                                   // timing incorrect!
+                                    IRMP_ERROR (timing, IRMP_TRACE_ERROR_BANG_OLUFSEN (1) | 3, irmp_pause_time);
+                                    irmp_start_bit_detected = 0;                    // reset flags and wait for next start bit
+                                    irmp_pause_time         = 0;
+                                }
+                            }
+                            else
+                            {
+                                if (irmp_pause_time >= BANG_OLUFSEN_1_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_1_PAUSE_LEN_MAX)
+                                {                                                   // pulse & pause timings correct for "1"?
+                                    IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '1', 1);
+                                    irmp_store_bit (IRMP_CTX_ARG_ 1);
+                                    irmp_last_value = 1;
+                                    irmp_wait_for_space = 0;
+                                }
+                                else if (irmp_pause_time >= BANG_OLUFSEN_0_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_0_PAUSE_LEN_MAX)
+                                {                                                   // pulse & pause timings correct for "0"?
+                                    IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '0', 1);
+                                    irmp_store_bit (IRMP_CTX_ARG_ 0);
+                                    irmp_last_value = 0;
+                                    irmp_wait_for_space = 0;
+                                }
+                                else if (irmp_pause_time >= BANG_OLUFSEN_R_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_R_PAUSE_LEN_MAX)
+                                {
+                                    IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, irmp_last_value + '0', 1);
+                                    irmp_store_bit (IRMP_CTX_ARG_ irmp_last_value);
+                                    irmp_wait_for_space = 0;
+                                }
+                                else
+                                {                                                   // timing incorrect!
+                                    IRMP_ERROR (timing, IRMP_TRACE_ERROR_BANG_OLUFSEN (2) | 3, irmp_pause_time);
+                                    irmp_start_bit_detected = 0;                    // reset flags and wait for next start bit
+                                    irmp_pause_time         = 0;
+                                }
+                            }
+                        }
+                        else
+                        {                                                           // timing incorrect!
+                            IRMP_ERROR (timing, IRMP_TRACE_ERROR_BANG_OLUFSEN (3) | 3, irmp_pause_time);
+                            irmp_start_bit_detected = 0;                            // reset flags and wait for next start bit
+                            irmp_pause_time         = 0;
+                        }
+                    }
+                    else
+#endif // IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL
+
+#if IRMP_SUPPORT_RCMM_PROTOCOL == 1
+                    if (irmp_param.protocol == IRMP_RCMM32_PROTOCOL)
+                    {
+                        if (irmp_pause_time >= RCMM32_BIT_00_PAUSE_LEN_MIN && irmp_pause_time <= RCMM32_BIT_00_PAUSE_LEN_MAX)
+                        {
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '0', 0);
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '0', 0);
+                            irmp_store_bit (IRMP_CTX_ARG_ 0);
+                            irmp_store_bit (IRMP_CTX_ARG_ 0);
+                        }
+                        else if (irmp_pause_time >= RCMM32_BIT_01_PAUSE_LEN_MIN && irmp_pause_time <= RCMM32_BIT_01_PAUSE_LEN_MAX)
+                        {
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '0', 0);
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '1', 0);
+                            irmp_store_bit (IRMP_CTX_ARG_ 0);
+                            irmp_store_bit (IRMP_CTX_ARG_ 1);
+                        }
+                        else if (irmp_pause_time >= RCMM32_BIT_10_PAUSE_LEN_MIN && irmp_pause_time <= RCMM32_BIT_10_PAUSE_LEN_MAX)
+                        {
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '1', 0);
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '0', 0);
+                            irmp_store_bit (IRMP_CTX_ARG_ 1);
+                            irmp_store_bit (IRMP_CTX_ARG_ 0);
+                        }
+                        else if (irmp_pause_time >= RCMM32_BIT_11_PAUSE_LEN_MIN && irmp_pause_time <= RCMM32_BIT_11_PAUSE_LEN_MAX)
+                        {
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '1', 0);
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '1', 0);
+                            irmp_store_bit (IRMP_CTX_ARG_ 1);
+                            irmp_store_bit (IRMP_CTX_ARG_ 1);
+                        }
+                        IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, 0, 1);
+                        irmp_wait_for_space = 0;
+                    }
+                    else
+#endif
+
+                    if (irmp_pulse_time >= irmp_param.pulse_1_len_min && irmp_pulse_time <= irmp_param.pulse_1_len_max &&
+                        irmp_pause_time >= irmp_param.pause_1_len_min && irmp_pause_time <= irmp_param.pause_1_len_max)
+                    {                                                               // pulse & pause timings correct for "1"?
+                        IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '1', 1);
+#if IRMP_USE_QUALITY == 1
+                        irmp_quality_bit (IRMP_CTX_ARG_ 1, ! irmp_input);           // pause is faked if still dark, e.g. SIRCS stop bit
+#endif
+                        irmp_store_bit (IRMP_CTX_ARG_ 1);
+                        irmp_wait_for_space = 0;
+                    }
+                    else if (irmp_pulse_time >= irmp_param.pulse_0_len_min && irmp_pulse_time <= irmp_param.pulse_0_len_max &&
+                             irmp_pause_time >= irmp_param.pause_0_len_min && irmp_pause_time <= irmp_param.pause_0_len_max)
+                    {                                                               // pulse & pause timings correct for "0"?
+                        IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, '0', 1);
+#if IRMP_USE_QUALITY == 1
+                        irmp_quality_bit (IRMP_CTX_ARG_ 0, ! irmp_input);
+#endif
+                        irmp_store_bit (IRMP_CTX_ARG_ 0);
+                        irmp_wait_for_space = 0;
+                    }
+                    else
+#if IRMP_SUPPORT_KATHREIN_PROTOCOL
+
+                    if (irmp_param.protocol == IRMP_KATHREIN_PROTOCOL &&
+                        irmp_pulse_time >= KATHREIN_1_PULSE_LEN_MIN && irmp_pulse_time <= KATHREIN_1_PULSE_LEN_MAX &&
+                        (((irmp_bit == 8 || irmp_bit == 6) &&
+                                irmp_pause_time >= KATHREIN_SYNC_BIT_PAUSE_LEN_MIN && irmp_pause_time <= KATHREIN_SYNC_BIT_PAUSE_LEN_MAX) ||
+                         (irmp_bit == 12 &&
+                                irmp_pause_time >= KATHREIN_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= KATHREIN_START_BIT_PAUSE_LEN_MAX)))
+
+                    {
+                        if (irmp_bit == 8)
+                        {
+                            irmp_bit++;
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, 'S', 1);
+                            irmp_tmp_command <<= 1;
+                        }
+                        else
+                        {
+                            IRMP_TRACE_DETAIL_EVENT (IRMP_TRACE_BIT, 'S', 1);
+                            irmp_store_bit (IRMP_CTX_ARG_ 1);
+                        }
+                        irmp_wait_for_space = 0;
+                    }
+                    else
+#endif // IRMP_SUPPORT_KATHREIN_PROTOCOL
+                    {                                                               // timing incorrect!
+                        IRMP_ERROR (timing, 3, irmp_pause_time);
+                        irmp_start_bit_detected = 0;                                // reset flags and wait for next start bit
+                        irmp_pause_time         = 0;
+                    }
+
+                    irmp_pulse_time = 1;                                            // set counter to 1, not 0
+
+#if IRMP_CANDIDATES > 1
+                    if (! irmp_start_bit_detected && irmp_candidate_count)          // wrong bit: try next protocol fitting the start bit
+                    {
+                        irmp_candidate_switch (IRMP_CTX_ARG);
+                    }
+#endif
+                }
+            }
+            else
+            {                                                                       // counting the pulse length ...
+                if (! irmp_input)                                                   // still light?
+                {                                                                   // yes...
+                    irmp_pulse_time++;                                              // increment counter
+                }
+                else
+                {                                                                   // now it's dark!
+                    irmp_wait_for_space = 1;                                        // let's count the time (see above)
+                    irmp_pause_time = 1;                                            // set pause counter to 1, not 0
+                }
+            }
+
+            if (irmp_start_bit_detected && irmp_bit == irmp_param.complete_len && irmp_param.stop_bit == 0)    // enough bits received?
+            {
+#if IRMP_USE_RAW_FRAME == 1
+                if (irmp_raw_pending)
+                {
+                    irmp_raw_extract (IRMP_CTX_ARG);
+                }
+#endif
+#if IRMP_USE_HASH == 1
+                irmp_hash_decoded = TRUE;                                           // frame of a known protocol, even if dropped below
+#endif
+
+                if (irmp_auto_repetition (IRMP_CTX_ARG))                           // auto repetition frame: skip it
+                {
+                    irmp_repetition_ticks = 0;
+                }
+                else
+                {
+#ifdef ANALYZE
+                    ANALYZE_PRINTF ("%8.3fms code detected, length = %d\n", (double) (time_counter * 1000) / F_INTERRUPTS, irmp_bit);
+#endif // ANALYZE
+                    irmp_ir_detected = TRUE;
+
+#if IRMP_SUPPORT_DENON_PROTOCOL == 1
+                    if (irmp_param.protocol == IRMP_DENON_PROTOCOL)
+                    {                                                               // check for repetition frame
+                        if ((~irmp_tmp_command & 0x3FF) == last_irmp_denon_command) // command bits must be inverted
+                        {
+                            irmp_tmp_command = last_irmp_denon_command;             // use command received before!
+                            last_irmp_denon_command = 0;
+
+                            irmp_protocol = irmp_param.protocol;                    // store protocol
+                            irmp_address = irmp_tmp_address;                        // store address
+                            irmp_command = irmp_tmp_command;                        // store command
+                        }
+                        else
+                        {
+                            if ((irmp_tmp_command & 0x01) == 0x00)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("%8.3fms info Denon: waiting for inverted command repetition\n", (double) (time_counter * 1000) / F_INTERRUPTS);
+#endif // ANALYZE
+                                last_irmp_denon_command = irmp_tmp_command;
+                                irmp_denon_repetition_len = 0;
+                                irmp_ir_detected = FALSE;
+                            }
+                            else
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("%8.3fms warning Denon: got unexpected inverted command, ignoring it\n", (double) (time_counter * 1000) / F_INTERRUPTS);
+#endif // ANALYZE
+                                last_irmp_denon_command = 0;
+                                irmp_ir_detected = FALSE;
+                            }
+                        }
+                    }
+                    else
+#endif // IRMP_SUPPORT_DENON_PROTOCOL
+
+#if IRMP_SUPPORT_GRUNDIG_PROTOCOL == 1
+                    if (irmp_param.protocol == IRMP_GRUNDIG_PROTOCOL && irmp_tmp_command == 0x01ff)
+                    {                                                               // Grundig start frame?
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("Detected GRUNDIG start frame, ignoring it\n");
+#endif // ANALYZE
+                        irmp_ir_detected = FALSE;
+                    }
+                    else
+#endif // IRMP_SUPPORT_GRUNDIG_PROTOCOL
+
+#if IRMP_SUPPORT_NOKIA_PROTOCOL == 1
+                    if (irmp_param.protocol == IRMP_NOKIA_PROTOCOL && irmp_tmp_address == 0x00ff && irmp_tmp_command == 0x00fe)
+                    {                                                               // Nokia start frame?
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("Detected NOKIA start frame, ignoring it\n");
+#endif // ANALYZE
+                        irmp_ir_detected = FALSE;
+                    }
+                    else
+#endif // IRMP_SUPPORT_NOKIA_PROTOCOL
+                    {
+#if IRMP_SUPPORT_NEC_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_NEC_PROTOCOL && irmp_bit == 0)  // repetition frame
+                        {
+                            if (irmp_repetition_ticks < NEC_FRAME_REPEAT_PAUSE_LEN_MAX)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Detected NEC repetition frame, key_repetition_len = %d\n", irmp_repetition_ticks);
+                                ANALYZE_ONLY_NORMAL_PRINTF("REPETETION FRAME                ");
+#endif // ANALYZE
+                                irmp_tmp_address = last_irmp_address;                   // address is last address
+                                irmp_tmp_command = last_irmp_command;                   // command is last command
+                                irmp_flags |= IRMP_FLAG_REPETITION;
+                                irmp_repetition_ticks = 0;
+                            }
+                            else
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("Detected NEC repetition frame, ignoring it: timeout occured, key_repetition_len = %d > %d\n",
+                                                irmp_repetition_ticks, NEC_FRAME_REPEAT_PAUSE_LEN_MAX);
+#endif // ANALYZE
+                                irmp_ir_detected = FALSE;
+                            }
+                        }
+#endif // IRMP_SUPPORT_NEC_PROTOCOL
+
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_KASEIKYO_PROTOCOL)
+                        {
+                            uint_fast8_t xor_value;
+
+                            xor_value = (irmp_xor_check[0] & 0x0F) ^ ((irmp_xor_check[0] & 0xF0) >> 4) ^ (irmp_xor_check[1] & 0x0F) ^ ((irmp_xor_check[1] & 0xF0) >> 4);
+
+                            if (xor_value != (irmp_xor_check[2] & 0x0F))
+                            {
+                                IRMP_ERROR (xor_address, 4, (xor_value << 8) | (irmp_xor_check[2] & 0x0F));
+                                irmp_ir_detected = FALSE;
+                            }
+
+                            xor_value = irmp_xor_check[2] ^ irmp_xor_check[3] ^ irmp_xor_check[4];
+
+                            if (xor_value != irmp_xor_check[5])
+                            {
+                                IRMP_ERROR (xor_data, 5, (xor_value << 8) | irmp_xor_check[5]);
+                                irmp_ir_detected = FALSE;
+                            }
+
+                            irmp_flags |= irmp_genre2;  // write the genre2 bits into MSB of the flag byte
+                        }
+#endif // IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+
+#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_ORTEK_PROTOCOL)
+                        {
+                            if (irmp_parity == PARITY_CHECK_FAILED)
+                            {
+                                IRMP_ERROR (ortek_parity, 6, 0);
+                                irmp_ir_detected = FALSE;
+                            }
+
+                            if ((irmp_tmp_address & 0x03) == 0x02)
+                            {
+#ifdef ANALYZE
+                                ANALYZE_PRINTF ("code skipped: ORTEK end of transmission frame (key release)\n");
+#endif // ANALYZE
+                                irmp_ir_detected = FALSE;
+                            }
+                            irmp_tmp_address >>= 2;
+                        }
+#endif // IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+
+#if IRMP_SUPPORT_RC6_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_RC6_PROTOCOL && irmp_param.complete_len == RC6_COMPLETE_DATA_LEN_LONG)     // RC6 mode = 6?
+                        {
+                            irmp_protocol = IRMP_RC6A_PROTOCOL;
+                        }
+                        else
+#endif // IRMP_SUPPORT_RC6_PROTOCOL == 1
+                        {
+                            irmp_protocol = irmp_param.protocol;
+                        }
+
+#if IRMP_SUPPORT_FDC_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_FDC_PROTOCOL)
+                        {
+                            if (irmp_tmp_command & 0x000F)                          // released key?
+                            {
+                                irmp_tmp_command = (irmp_tmp_command >> 4) | 0x80;  // yes, set bit 7
+                            }
+                            else
+                            {
+                                irmp_tmp_command >>= 4;                             // no, it's a pressed key
+                            }
+                            irmp_tmp_command |= (irmp_tmp_address << 2) & 0x0F00;   // 000000CCCCAAAAAA -> 0000CCCC00000000
+                            irmp_tmp_address &= 0x003F;
+                        }
+#endif
+
+                        irmp_address = irmp_tmp_address;                            // store address
+#if IRMP_SUPPORT_NEC_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_NEC_PROTOCOL)
+                        {
+                            last_irmp_address = irmp_tmp_address;                   // store as last address, too
+                        }
+#endif
+
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_RC5_PROTOCOL)
+                        {
+                            irmp_tmp_command |= irmp_rc5_cmd_bit6;                  // store bit 6
+                        }
+#endif
+#if IRMP_SUPPORT_S100_PROTOCOL == 1
+                        if (irmp_param.protocol == IRMP_S100_PROTOCOL)
+                        {
+                            irmp_tmp_command |= irmp_rc5_cmd_bit6;                  // store bit 6
+                        }
+#endif
+                        irmp_command = irmp_tmp_command;                            // store command
+
+#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+                        irmp_id = irmp_tmp_id;
+#endif
+                    }
+                }
+
+                if (irmp_ir_detected)
+                {
+                    IRMP_TRACE (IRMP_TRACE_FRAME, irmp_param.protocol, irmp_bit);
+
+                    if (last_irmp_command == irmp_tmp_command &&
+                        last_irmp_address == irmp_tmp_address &&
+                        irmp_repetition_ticks < irmp_key_repetition_len)
+                    {
+                        irmp_flags |= IRMP_FLAG_REPETITION;
+                    }
+
+                    last_irmp_address = irmp_tmp_address;                           // store as last address, too
+                    last_irmp_command = irmp_tmp_command;                           // store as last command, too
+
+                    irmp_repetition_ticks = 0;
+#if IRMP_USE_TIMESTAMP == 1
+                    irmp_frame_ticks = irmp_ticks;
+#endif
+#if IRMP_EARLY_MATCH_LEN > 0
+                    if (irmp_early_protocol == irmp_param.protocol)
+                    {
+#ifdef ANALYZE
+                        ANALYZE_PRINTF ("code already detected by early match\n");
+#endif // ANALYZE
+                        irmp_ir_detected    = FALSE;
+                        irmp_flags          = 0;
+                    }
+                    irmp_early_protocol = 0;
+#endif
+                }
+                else
+                {
+#ifdef ANALYZE
+                    ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
+#endif // ANALYZE
+                }
+
+                irmp_start_bit_detected = 0;                                        // and wait for next start bit
+                irmp_tmp_command        = 0;
+                irmp_pulse_time         = 0;
+                irmp_pause_time         = 0;
+
+#if IRMP_SUPPORT_JVC_PROTOCOL == 1
+                if (irmp_protocol == IRMP_JVC_PROTOCOL)                             // the stop bit of JVC frame is also start bit of next frame
+                {                                                                   // set pulse time here!
+                    irmp_pulse_time = ((uint_fast8_t)(F_INTERRUPTS * JVC_START_BIT_PULSE_TIME));
+                }
+#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
+            }
+        }
+    }
+
+#if IRMP_USE_HASH == 1
+    irmp_hash_sample (IRMP_CTX_ARG_ irmp_input, 1);
+#endif
+
+#if IRMP_QUEUE_LEN > 0
+    if (irmp_ir_detected)
+    {
+        irmp_queue_put (IRMP_CTX_ARG);
+    }
+#endif
+
+#if defined(STELLARIS_ARM_CORTEX_M4) && IRMP_ISR_SAMPLE == 0
+    // Clear the timer interrupt
+    TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+#endif
+
+    return (IRMP_FRAME_PENDING);
+}
+
+#if IRMP_ISR_SAMPLE == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  ISR routine for polling, see irmp_ISR_sample()
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+uint_fast8_t
+irmp_ISR (void)
+{
+    uint_fast8_t    irmp_input;
+    uint_fast8_t    rtc;
+
+#if defined(__SDCC_stm8)
+    irmp_input = input(IRMP_GPIO_STRUCT->IDR);
+#else
+    irmp_input = input(IRMP_PIN);
+#endif
+
+#if IRMP_USE_CONTEXT == 1
+    rtc = irmp_ISR_sample (&irmp_context, irmp_input);
+#else
+    rtc = irmp_ISR_sample (irmp_input);
+#endif
+
+#if defined(STELLARIS_ARM_CORTEX_M4)
+    // Clear the timer interrupt
+    TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+#endif
+
+    return (rtc);
+}
+#endif // IRMP_ISR_SAMPLE == 1
+
+#if IRMP_IDLE_DIVIDER > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  ISR routine for idle sampling
+ *  @details  call it F_INTERRUPTS / IRMP_IDLE_DIVIDER times per second after irmp_idle() returned TRUE. A dark sample skips
+ *            IRMP_IDLE_DIVIDER ticks. On a light sample the pulse is assumed to have started in the middle of the idle period:
+ *            the first half is skipped as dark, the second half is sampled as light.
+ *  @return   TRUE: switch back to full rate and call irmp_ISR(), FALSE: stay at idle rate
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+uint_fast8_t
+irmp_ISR_idle (void)
+{
+#if IRMP_USE_CONTEXT == 1
+    IRMP_CONTEXT *  ctx = &irmp_context;
+#endif
+    uint_fast8_t    irmp_input;
+    uint_fast8_t    i;
+
+#if defined(__SDCC_stm8)
+    irmp_input = input(IRMP_GPIO_STRUCT->IDR);
+#else
+    irmp_input = input(IRMP_PIN);
+#endif
+
+    if (irmp_input && ! irmp_ir_detected)                                           // still dark, nothing to fetch
+    {
+        irmp_skip_idle (IRMP_CTX_ARG_ IRMP_IDLE_DIVIDER);
+        return FALSE;
+    }
+
+    if (irmp_input)                                                                 // frame not fetched yet: sample the period
+    {
+        i = IRMP_IDLE_DIVIDER;
+    }
+    else
+    {
+        irmp_skip_idle (IRMP_CTX_ARG_ IRMP_IDLE_DIVIDER - IRMP_IDLE_DIVIDER / 2);
+        i = IRMP_IDLE_DIVIDER / 2;                                                  // start pulse
+    }
+
+    while (i--)
+    {
+        (void) irmp_ISR ();
+    }
+    return TRUE;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Check for idle decoder
+ *  @details  call it after irmp_ISR() to switch to idle sampling, see irmp_ISR_idle()
+ *  @return   TRUE: waiting for a start bit, IRMP_TIMEOUT_LEN ticks after the last frame, FALSE: frame in flight
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+uint_fast8_t
+irmp_idle (void)
+{
+#if IRMP_USE_CONTEXT == 1
+    IRMP_CONTEXT *  ctx = &irmp_context;
+#endif
+
+#if IRMP_USE_HASH == 1
+    if (irmp_hash_count)                                                            // burst not decoded, but not finished yet
+    {
+        return FALSE;
+    }
+#endif
+    return (! irmp_ir_detected && ! irmp_start_bit_detected && ! irmp_pulse_time && irmp_repetition_ticks >= IRMP_TIMEOUT_LEN);
+}
+#endif // IRMP_IDLE_DIVIDER > 0
+
+#if IRMP_USE_CONTEXT == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  ISR routine for several IR receivers
+ *  @details  call it F_INTERRUPTS times per second for every context, e.g. with the bits of one port read
+ *  @param    ctx: context of IR receiver, see irmp_init_ctx()
+ *  @param    irmp_input: current input level, 0 = pulse (light), else pause (dark)
+ *  @return   TRUE: IR frame detected, get it with irmp_get_data_ctx()
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+uint_fast8_t
+irmp_ISR_ctx (IRMP_CONTEXT * ctx, uint_fast8_t irmp_input)
+{
+    return irmp_ISR_sample (ctx, irmp_input);
+}
+#endif // IRMP_USE_CONTEXT == 1
+
+#if IRMP_USE_EDGE_ISR == 1
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Count the samples of a pulse or pause in one step
+ *  @details  while a pulse or pause lasts, irmp_ISR_sample() only increments irmp_pulse_time or irmp_pause_time until it exceeds a limit,
+ *            e.g. the timeout. These samples are counted in one step, the sample exceeding the limit is left to irmp_ISR_sample().
+ *  @param    ticks: number of samples with level irmp_last_input
+ *  @return   number of samples counted, 0: call irmp_ISR_sample() for the next sample
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static uint_fast16_t
+irmp_count_len (IRMP_CTX_PARAM_ uint_fast16_t ticks)
+{
+    uint_fast16_t   limit;
+
+#if IRMP_GLITCH_FILTER_LEN > 0
+    if ((! irmp_last_input) != irmp_filter_light)                                   // filter has not followed the input yet
+    {
+        return 0;
+    }
+#endif
+
+    if (irmp_start_bit_detected && irmp_bit == irmp_param.complete_len && irmp_param.stop_bit == 0)    // frame complete
+    {
+        return 0;
+    }
+
+    if (! irmp_last_input)                                                          // counting a pulse
+    {
+        if (! irmp_pulse_time || (irmp_start_bit_detected && (irmp_wait_for_start_space || irmp_wait_for_space))) // 1st sample of pulse
+        {
+            return 0;
+        }
+
+        limit = irmp_pulse_time < 0xFF ? 0xFF - irmp_pulse_time : 0;                // don't overflow an 8 bit counter
+    }
+    else                                                                            // counting a pause
+    {
+        if (! irmp_start_bit_detected || (! irmp_wait_for_start_space && ! irmp_wait_for_space)) // 1st sample of pause
+        {
+            return 0;
+        }
+
+        limit = IRMP_TIMEOUT_LEN;                                                   // timeout: irmp_pause_time > IRMP_TIMEOUT_LEN
+
+#if IRMP_SUPPORT_NIKON_PROTOCOL == 1
+        if (irmp_wait_for_start_space && irmp_pulse_time >= NIKON_START_BIT_PULSE_LEN_MIN && irmp_pulse_time <= NIKON_START_BIT_PULSE_LEN_MAX)
+        {
+            limit = IRMP_TIMEOUT_NIKON_LEN;
+        }
+#endif
+
+        if (irmp_wait_for_space)
+        {
+            if (irmp_bit == irmp_param.complete_len && irmp_param.stop_bit == 1)    // stop bit
+            {
+                return 0;
+            }
+
+#if IRMP_SUPPORT_SIRCS_PROTOCOL == 1
+            if (irmp_param.protocol == IRMP_SIRCS_PROTOCOL && irmp_bit >= 12 - 1)
+            {
+                limit = SIRCS_PAUSE_LEN_MAX;
+            }
+#endif
+#if IRMP_SUPPORT_MANCHESTER == 1
+            if ((irmp_param.flags & IRMP_PARAM_FLAG_IS_MANCHESTER) && irmp_bit >= irmp_param.complete_len - 2 && ! irmp_param.stop_bit)
+            {
+                limit = 2 * irmp_param.pause_1_len_max - 1;
+            }
+#endif
+#if IRMP_FAST_NEC == 1 && IRMP_SUPPORT_NEC_PROTOCOL == 1 && IRMP_SUPPORT_NEC42_PROTOCOL == 1
+            if (irmp_param.protocol == IRMP_NEC42_PROTOCOL && irmp_bit == 32)
+            {
+                limit = irmp_nec42_expected ? irmp_param.pause_1_len_max : 0;
+            }
+#endif
+#if IRMP_SUPPORT_FAN_PROTOCOL == 1
+            if (irmp_param.protocol == IRMP_FAN_PROTOCOL && irmp_bit >= FAN_COMPLETE_DATA_LEN - 1)
+            {
+                limit = 0;                                                          // last bit: pause checked by irmp_ISR_sample()
+            }
+#endif
+#if IRMP_SUPPORT_SERIAL == 1
+            if ((irmp_param.flags & IRMP_PARAM_FLAG_IS_SERIAL) && irmp_param.protocol == IRMP_NETBOX_PROTOCOL &&
+                (uint_fast16_t) (NETBOX_PULSE_LEN * (NETBOX_COMPLETE_DATA_LEN - irmp_bit)) <= limit)
+            {
+                limit = NETBOX_PULSE_LEN * (NETBOX_COMPLETE_DATA_LEN - irmp_bit) - 1;
+            }
+#endif
+#if IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
+            if (irmp_param.protocol == IRMP_GRUNDIG_PROTOCOL && ! irmp_param.stop_bit)   // no timeout, see irmp_ISR_sample()
+            {
+                if (irmp_bit >= GRUNDIG_COMPLETE_DATA_LEN)
+                {
+                    limit = 0;
+                }
+                else if (irmp_bit == 5 || irmp_bit == 6)
+                {
+                    limit = IR60_TIMEOUT_LEN;
+                }
+                else if (irmp_bit >= GRUNDIG_COMPLETE_DATA_LEN - 2)
+                {
+                    limit = 2 * irmp_param.pause_1_len_max - 1;
+                }
+                else
+                {
+                    limit = (PAUSE_LEN) ~0;
+                }
+            }
+#endif
+#if IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1
+            if (irmp_param.protocol == IRMP_RUWIDO_PROTOCOL && ! irmp_param.stop_bit)    // no timeout, see irmp_ISR_sample()
+            {
+                if (irmp_bit >= RUWIDO_COMPLETE_DATA_LEN)
+                {
+                    limit = 0;
+                }
+                else if (irmp_bit >= RUWIDO_COMPLETE_DATA_LEN - 2)
+                {
+                    limit = 2 * irmp_param.pause_1_len_max - 1;
+                }
+                else
+                {
+                    limit = (PAUSE_LEN) ~0;
+                }
+            }
+#endif
+#if IRMP_SUPPORT_ROOMBA_PROTOCOL == 1
+            if (irmp_param.protocol == IRMP_ROOMBA_PROTOCOL && irmp_bit >= ROOMBA_COMPLETE_DATA_LEN - 1)
+            {
+                limit = 0;
+            }
+#endif
+        }
+
+        limit = irmp_pause_time < limit ? limit - irmp_pause_time : 0;
+    }
+
+    if (ticks > limit)
+    {
+        ticks = limit;
+    }
+
+    if (ticks)
+    {
+        if (irmp_last_input)
+        {
+            irmp_pause_time += ticks;
+        }
+        else
+        {
+            irmp_pulse_time += ticks;
+        }
+
+#ifdef ANALYZE
+        time_counter += ticks;
+#endif // ANALYZE
+#if IRMP_USE_TIMESTAMP == 1
+        irmp_ticks += ticks;
+#endif
+#if IRMP_GLITCH_FILTER_LEN > 0
+        irmp_filter_count = 0;
+#endif
+#if IRMP_USE_HASH == 1
+        irmp_hash_sample (IRMP_CTX_ARG_ irmp_last_input, ticks);
+#endif
+    }
+    return ticks;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  ISR routine for edge driven input
+ *  @details  call it on every edge of the input (pin change interrupt) and at least every IRMP_EDGE_TIMEOUT_LEN ticks without an edge,
+ *            irmp_ISR_edge_ctx() for context ctx
+ *  @param    irmp_input: current input level, 0 = pulse (light), else pause (dark)
+ *  @param    ticks: ticks (1/F_INTERRUPTS sec) elapsed since the last call
+ *  @return   TRUE: IR frame detected
+ *
+ *  The elapsed ticks are decoded with the level valid before the call, so the decoder sees the same input as with irmp_ISR(). The first
+ *  sample of a new level is processed immediately, so a frame is completed on the edge of its stop bit. The pulse or pause is counted
+ *  in one step by irmp_count_len(), only the sample exceeding a limit (e.g. the timeout) is decoded by irmp_ISR_sample(). Pauses while
+ *  waiting for a start bit are skipped in one step, too. So a call decodes a few samples, not all elapsed ticks.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#if IRMP_USE_CONTEXT == 1
+uint_fast8_t
+irmp_ISR_edge_ctx (IRMP_CONTEXT * ctx, uint_fast8_t irmp_input, uint_fast16_t ticks)
+#else
+uint_fast8_t
+irmp_ISR_edge (uint_fast8_t irmp_input, uint_fast16_t ticks)
+#endif
+{
+    uint_fast16_t   n;
+
+    irmp_input = irmp_input ? 1 : 0;
+
+    if (ticks > irmp_ticks_ahead)
+    {
+        ticks -= irmp_ticks_ahead;
+    }
+    else
+    {
+        ticks = 0;
+    }
+
+    while (ticks)
+    {
+        if (irmp_ir_detected)                                                       // frame not fetched yet, irmp_ISR_sample() would ignore the rest
+        {
+#ifdef ANALYZE
+            time_counter += ticks;
+#endif // ANALYZE
+#if IRMP_USE_TIMESTAMP == 1
+            irmp_ticks += ticks;
+#endif
+#if IRMP_USE_HASH == 1
+            irmp_hash_sample (IRMP_CTX_ARG_ irmp_last_input, ticks);
+#endif
+            break;
+        }
+
+        if (! irmp_start_bit_detected && ! irmp_pulse_time && irmp_last_input)    // waiting for start bit, it's dark...
+        {                                                                           // only repetition counters are running, skip them
+            irmp_skip_idle (IRMP_CTX_ARG_ ticks);
+            break;
+        }
+
+        n = irmp_count_len (IRMP_CTX_ARG_ ticks);                                   // pulse or pause: count it in one step
+
+        if (n)
+        {
+            ticks -= n;
+        }
+        else
+        {
+            (void) irmp_ISR_sample (IRMP_CTX_ARG_ irmp_last_input);
+            ticks--;
+        }
+    }
+
+    if (irmp_input != irmp_last_input)                                              // edge: process 1st sample of new level now
+    {
+        irmp_last_input = irmp_input;
+        (void) irmp_ISR_sample (IRMP_CTX_ARG_ irmp_input);
+        irmp_ticks_ahead = 1;
+    }
+    else
+    {
+        irmp_ticks_ahead = 0;
+    }
+
+    return (IRMP_FRAME_PENDING);
+}
+
+#if IRMP_USE_CONTEXT == 1
+uint_fast8_t
+irmp_ISR_edge (uint_fast8_t irmp_input, uint_fast16_t ticks)
+{
+    return irmp_ISR_edge_ctx (&irmp_context, irmp_input, ticks);
+}
+#endif // IRMP_USE_CONTEXT == 1
+#endif // IRMP_USE_EDGE_ISR == 1
+
+#if IRMP_CHANNEL_MASK != 0x00
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  ISR routine for several IR inputs on one port
+ *  @details  call it F_INTERRUPTS times per second with the port bits, e.g. irmp_ISR_multi (PINB)
+ *  @param    port: input levels of port, bit of IR input 0 = pulse (light), else pause (dark)
+ *  @return   TRUE: IR frame detected on an input, get it with irmp_get_data_multi()
+ *
+ *  One XOR of the port with the last port value finds the inputs with an edge. Only these are decoded, by irmp_ISR_edge_ctx() of
+ *  their context, which counts the pulse or pause since the last call in one step. Every IRMP_EDGE_TIMEOUT_LEN / IRMP_CHANNELS ticks
+ *  the next input is called to detect timeouts, so each input is called at least every IRMP_EDGE_TIMEOUT_LEN ticks, but never all
+ *  inputs in the same tick. Without edges, a tick costs the same for any number of inputs.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+uint_fast8_t
+irmp_ISR_multi (uint_fast8_t port)
+{
+    uint_fast8_t    changed;
+    uint_fast8_t    bit;
+    uint_fast8_t    i;
+    uint_fast8_t    rtc = FALSE;
+
+    irmp_channel_ticks++;
+
+    port    &= IRMP_CHANNEL_MASK;
+    changed = port ^ irmp_channel_last_port;
+
+    if (--irmp_channel_timeout == 0)                                                // call one input after another to detect timeouts
+    {
+        irmp_channel_timeout = IRMP_EDGE_TIMEOUT_LEN / IRMP_CHANNELS;
+
+        do
+        {
+            irmp_channel_timeout_bit <<= 1;
+
+            if (! irmp_channel_timeout_bit)
+            {
+                irmp_channel_timeout_bit = 0x01;
+            }
+        } while (! (IRMP_CHANNEL_MASK & irmp_channel_timeout_bit));
+
+        changed |= irmp_channel_timeout_bit;
+    }
+
+    if (changed)
+    {
+        irmp_channel_last_port = port;
+
+        for (bit = 0x01, i = 0; i < IRMP_CHANNELS; bit <<= 1)
+        {
+            if (IRMP_CHANNEL_MASK & bit)
+            {
+                if (changed & bit)
+                {
+                    rtc |= irmp_ISR_edge_ctx (irmp_channel_context + i, port & bit, irmp_channel_ticks - irmp_channel_last_call[i]);
+                    irmp_channel_last_call[i] = irmp_channel_ticks;
+                }
+                i++;
+            }
+        }
+    }
+
+    return (rtc);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ *  Get IRMP data of several IR inputs
+ *  @details  gets decoded IRMP data of the next IR input with a frame
+ *  @param    pointer in order to store IRMP data
+ *  @return   0: no frame, else port bit of the IR input
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+uint_fast8_t
+irmp_get_data_multi (IRMP_DATA * irmp_data_p)
+{
+    uint_fast8_t    bit;
+    uint_fast8_t    i;
+
+    for (bit = 0x01, i = 0; i < IRMP_CHANNELS; bit <<= 1)
+    {
+        if (IRMP_CHANNEL_MASK & bit)
+        {
+            if (irmp_get_data_ctx (irmp_channel_context + i, irmp_data_p))
+            {
+                return (bit);
+            }
+            i++;
+        }
+    }
+    return (0);
+}
+#endif // IRMP_CHANNEL_MASK != 0x00
+
+#ifdef ANALYZE
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * main functions - for Unix/Linux + Windows only!
+ *
+ * AVR: see main.c!
+ *
+ * Compile it under linux with:
+ * cc irmp.c -o irmp
+ *
+ * The analyzer decodes with the options of irmpconfig.h, options for the reports below are enabled on the command line, e.g.:
+ * cc -DIRMP_USE_EDGE_ISR=1 -DIRMP_USE_CONTEXT=1 -DIRMP_CHANNEL_MASK=0xFF -DIRMP_USE_TIMESTAMP=1 -DIRMP_TRACE_LEN=16 -DIRMP_IDLE_DIVIDER=8 \
+ *    -DIRMP_USE_START_BIT_TABLE=1 -DIRMP_QUEUE_LEN=4 -DIRMP_EARLY_MATCH_LEN=2 -DIRMP_ADDRESS_FILTER_LEN=2 -DIRMP_GLITCH_FILTER_LEN=1 \
+ *    -DIRMP_USE_COUNTERS=1 -DIRMP_USE_PROTOCOL_MASK=1 -DIRMP_DYNAMIC_PROTOCOLS=2 -DIRMP_USE_HASH=1 -DIRMP_USE_QUALITY=1 -DIRMP_LEARNED_WINDOWS=2 \
+ *    irmp.c -o irmp
+ *
+ * usage: ./irmp [-v|-s|-x|-a|-l|-b|-m|-e|-f|-d|-g|-i|-n|-q|-w|-p|-u|-c|-t] < file
+ *        ./irmp -y [eeprom-address] < scanfile
+ *
+ * Synthetic scan files and the command lines of measured figures: see irmpscans.py
+ *
+ * options:
+ *   -v verbose
+ *   -s silent
+ *   -x silent, print events of the trace buffer (IRMP_TRACE_LEN)
+ *   -a analyze
+ *   -l list pulse/pauses
+ *   -b benchmark: interrupts and cpu time per frame, polling vs. edge driven input (IRMP_USE_EDGE_ISR)
+ *   -m decode MULTI_CONTEXTS lines at once with irmp_ISR_ctx() and irmp_ISR_multi(), compare with irmp_ISR() (IRMP_CHANNEL_MASK)
+ *   -e early match: latency of 1st frame per protocol with and without the frame registered as learned key (IRMP_EARLY_MATCH_LEN)
+ *   -f address filter: frames and cpu time per protocol with filter empty, set to own remote and set to foreign remote (IRMP_ADDRESS_FILTER_LEN)
+ *   -d latency of 1st frame per protocol from its 1st and its last pulse, frames and auto repetition frames per protocol
+ *   -g glitch filter: share of correctly decoded lines and cpu time per tick with injected glitches, filter off and on (IRMP_GLITCH_FILTER_LEN)
+ *   -i idle sampling: interrupts per line at full rate and with idle sampling, lines decoded differently (IRMP_IDLE_DIVIDER)
+ *   -n decode counters: frames, lost frames and decode errors per class (IRMP_USE_COUNTERS)
+ *   -q signal quality: deviation of pulses and pauses from the middle of their windows and margin to the window limits per protocol (IRMP_USE_QUALITY)
+ *   -w learned windows: frames of the learned remote, frames of other remotes and accepted start bits without and with learned windows (IRMP_LEARNED_WINDOWS)
+ *   -p protocol mask: start bit table entries compared per start bit and frames of other protocols with only one protocol enabled (IRMP_USE_PROTOCOL_MASK)
+ *   -u hash fallback: repeatability of the hashes of frames and of lines with the same key, collisions of different keys (IRMP_USE_HASH, IRMP_USE_PROTOCOL_MASK)
+ *   -y dynamic protocol: IRMP_DYNAMIC_DESCRIPTOR of the remote scanned in the file, as C initializer and Intel HEX at eeprom-address (IRMP_DYNAMIC_PROTOCOLS, IRMP_USE_PROTOCOL_MASK)
+ *   -c candidates: frames per protocol without and with candidates, cpu time per tick against number of live candidates (IRMP_CANDIDATES)
+ *   -t test start bit table against classification in irmp_ISR() (IRMP_USE_START_BIT_TABLE)
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+void
+print_spectrum (char * text, int * buf, int is_pulse)
+{
+    int     i;
+    int     j;
+    int     min;
+    int     max;
+    int     max_value = 0;
+    int     value;
+    int     sum = 0;
+    int     counter = 0;
+    double  average = 0;
+    double  tolerance;
+
+    puts ("-----------------------------------------------------------------------------");
+    printf ("%s:\n", text);
+
+    for (i = 0; i < 256; i++)
+    {
+        if (buf[i] > max_value)
+        {
+            max_value = buf[i];
+        }
+    }
+
+    for (i = 1; i < 200; i++)
+    {
+        if (buf[i] > 0)
+        {
+            printf ("%3d ", i);
+            value = (buf[i] * 60) / max_value;
+
+            for (j = 0; j < value; j++)
+            {
+                putchar ('o');
+            }
+            printf (" %d\n", buf[i]);
+
+            sum += i * buf[i];
+            counter += buf[i];
+        }
+        else
+        {
+            max = i - 1;
+
+            if (counter > 0)
+            {
+                average = (float) sum / (float) counter;
+
+                if (is_pulse)
+                {
+                    printf ("pulse ");
+                }
+                else
+                {
+                    printf ("pause ");
+                }
+
+                printf ("avg: %4.1f=%6.1f us, ", average, (1000000. * average) / (float) F_INTERRUPTS);
+                printf ("min: %2d=%6.1f us, ", min, (1000000. * min) / (float) F_INTERRUPTS);
+                printf ("max: %2d=%6.1f us, ", max, (1000000. * max) / (float) F_INTERRUPTS);
+
+                tolerance = (max - average);
+
+                if (average - min > tolerance)
+                {
+                    tolerance = average - min;
+                }
+
+                tolerance = tolerance * 100 / average;
+                printf ("tol: %4.1f%%\n", tolerance);
+            }
+
+            counter = 0;
+            sum = 0;
+            min = i + 1;
+        }
+    }
+}
+
+#define STATE_LEFT_SHIFT    0x01
+#define STATE_RIGHT_SHIFT   0x02
+#define STATE_LEFT_CTRL     0x04
+#define STATE_LEFT_ALT      0x08
+#define STATE_RIGHT_ALT     0x10
+
+#define KEY_ESCAPE          0x1B            // keycode = 0x006e
+#define KEY_MENUE           0x80            // keycode = 0x0070
+#define KEY_BACK            0x81            // keycode = 0x0071
+#define KEY_FORWARD         0x82            // keycode = 0x0072
+#define KEY_ADDRESS         0x83            // keycode = 0x0073
+#define KEY_WINDOW          0x84            // keycode = 0x0074
+#define KEY_1ST_PAGE        0x85            // keycode = 0x0075
+#define KEY_STOP            0x86            // keycode = 0x0076
+#define KEY_MAIL            0x87            // keycode = 0x0077
+#define KEY_FAVORITES       0x88            // keycode = 0x0078
+#define KEY_NEW_PAGE        0x89            // keycode = 0x0079
+#define KEY_SETUP           0x8A            // keycode = 0x007a
+#define KEY_FONT            0x8B            // keycode = 0x007b
+#define KEY_PRINT           0x8C            // keycode = 0x007c
+#define KEY_ON_OFF          0x8E            // keycode = 0x007c
+
+#define KEY_INSERT          0x90            // keycode = 0x004b
+#define KEY_DELETE          0x91            // keycode = 0x004c
+#define KEY_LEFT            0x92            // keycode = 0x004f
+#define KEY_HOME            0x93            // keycode = 0x0050
+#define KEY_END             0x94            // keycode = 0x0051
+#define KEY_UP              0x95            // keycode = 0x0053
+#define KEY_DOWN            0x96            // keycode = 0x0054
+#define KEY_PAGE_UP         0x97            // keycode = 0x0055
+#define KEY_PAGE_DOWN       0x98            // keycode = 0x0056
+#define KEY_RIGHT           0x99            // keycode = 0x0059
+#define KEY_MOUSE_1         0x9E            // keycode = 0x0400
+#define KEY_MOUSE_2         0x9F            // keycode = 0x0800
+
+static uint_fast8_t
+get_fdc_key (uint_fast16_t cmd)
+{
+    static uint8_t key_table[128] =
+    {
+     // 0    1    2    3    4    5    6    7    8    9    A    B    C    D    E    F
+        0,  '^', '1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '�', '�',  0,  '\b',
+       '\t','q', 'w', 'e', 'r', 't', 'z', 'u', 'i', 'o', 'p', '�', '+',  0,   0,  'a',
+       's', 'd', 'f', 'g', 'h', 'j', 'k', 'l', '�', '�', '#',  '\r', 0,  '<', 'y', 'x',
+       'c', 'v', 'b', 'n', 'm', ',', '.', '-',  0,   0,   0,   0,   0,  ' ',  0,   0,
+
+        0,  '�', '!', '"', '�', '$', '%', '&', '/', '(', ')', '=', '?', '`',  0,  '\b',
+       '\t','Q', 'W', 'E', 'R', 'T', 'Z', 'U', 'I', 'O', 'P', '�', '*',  0,   0,  'A',
+       'S', 'D', 'F', 'G', 'H', 'J', 'K', 'L', '�', '�', '\'','\r', 0,  '>', 'Y', 'X',
+       'C', 'V', 'B', 'N', 'M', ';', ':', '_',  0,   0,   0,   0,   0,  ' ',  0,   0
+    };
+    static uint_fast8_t state;
+
+    uint_fast8_t key = 0;
+
+    switch (cmd)
+    {
+        case 0x002C: state |=  STATE_LEFT_SHIFT;    break;              // pressed left shift
+        case 0x00AC: state &= ~STATE_LEFT_SHIFT;    break;              // released left shift
+        case 0x0039: state |=  STATE_RIGHT_SHIFT;   break;              // pressed right shift
+        case 0x00B9: state &= ~STATE_RIGHT_SHIFT;   break;              // released right shift
+        case 0x003A: state |=  STATE_LEFT_CTRL;     break;              // pressed left ctrl
+        case 0x00BA: state &= ~STATE_LEFT_CTRL;     break;              // released left ctrl
+        case 0x003C: state |=  STATE_LEFT_ALT;      break;              // pressed left alt
+        case 0x00BC: state &= ~STATE_LEFT_ALT;      break;              // released left alt
+        case 0x003E: state |=  STATE_RIGHT_ALT;     break;              // pressed left alt
+        case 0x00BE: state &= ~STATE_RIGHT_ALT;     break;              // released left alt
+
+        case 0x006e: key = KEY_ESCAPE;              break;
+        case 0x004b: key = KEY_INSERT;              break;
+        case 0x004c: key = KEY_DELETE;              break;
+        case 0x004f: key = KEY_LEFT;                break;
+        case 0x0050: key = KEY_HOME;                break;
+        case 0x0051: key = KEY_END;                 break;
+        case 0x0053: key = KEY_UP;                  break;
+        case 0x0054: key = KEY_DOWN;                break;
+        case 0x0055: key = KEY_PAGE_UP;             break;
+        case 0x0056: key = KEY_PAGE_DOWN;           break;
+        case 0x0059: key = KEY_RIGHT;               break;
+        case 0x0400: key = KEY_MOUSE_1;             break;
+        case 0x0800: key = KEY_MOUSE_2;             break;
+
+        default:
+        {
+            if (!(cmd & 0x80))                      // pressed key
+            {
+                if (cmd >= 0x70 && cmd <= 0x7F)     // function keys
+                {
+                    key = cmd + 0x10;               // 7x -> 8x
+                }
+                else if (cmd < 64)                  // key listed in key_table
+                {
+                    if (state & (STATE_LEFT_ALT | STATE_RIGHT_ALT))
+                    {
+                        switch (cmd)
+                        {
+                            case 0x0003: key = '�';     break;
+                            case 0x0008: key = '{';     break;
+                            case 0x0009: key = '[';     break;
+                            case 0x000A: key = ']';     break;
+                            case 0x000B: key = '}';     break;
+                            case 0x000C: key = '\\';    break;
+                            case 0x001C: key = '~';     break;
+                            case 0x002D: key = '|';     break;
+                            case 0x0034: key = 0xB5;    break; // Mu
+                        }
+                    }
+                    else if (state & (STATE_LEFT_CTRL))
+                    {
+                        if (key_table[cmd] >= 'a' && key_table[cmd] <= 'z')
+                        {
+                            key = key_table[cmd] - 'a' + 1;
+                        }
+                        else
+                        {
+                            key = key_table[cmd];
+                        }
+                    }
+                    else
+                    {
+                        int idx = cmd + ((state & (STATE_LEFT_SHIFT | STATE_RIGHT_SHIFT)) ? 64 : 0);
+
+                        if (key_table[idx])
+                        {
+                            key = key_table[idx];
+                        }
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    return (key);
+}
+
+static int         analyze = FALSE;
+static int         list = FALSE;
+static IRMP_DATA   irmp_data;
+static int         expected_protocol;
+static int         expected_address;
+static int         expected_command;
+static int         do_check_expected_values;
+#if IRMP_TRACE_LEN > 0
+static int         trace = FALSE;
+#endif
+static IRMP_CONTEXT irmp_context_initial;                                       // irmp_context at program start, see analyze_reset()
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * reset the decoder state to program start, with IRMP_USE_CONTEXT or without
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+analyze_reset (void)
+{
+    memcpy ((void *) &irmp_context, &irmp_context_initial, sizeof (IRMP_CONTEXT));
+}
+
+#if IRMP_TRACE_LEN > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * print events of trace buffer as text, see IRMP_TRACE_LEN
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+print_trace (void)
+{
+    IRMP_TRACE_ENTRY    e;
+
+    while (irmp_get_trace (&e))
+    {
+        uint16_t    age = (uint16_t) irmp_get_ticks () - e.ticks;                 // ticks since event
+
+        printf ("%8.3fms ", (double) ((time_counter - age) * 1000) / F_INTERRUPTS);
+
+        switch (e.event)
+        {
+            case IRMP_TRACE_START_BIT:  printf ("start bit: pulse = %d, pause = %d\n", e.arg, e.value);              break;
+            case IRMP_TRACE_PROTOCOL:   printf ("protocol = %s\n", irmp_protocol_names[e.arg]);                     break;
+            case IRMP_TRACE_ERROR:      printf ("error %d at data bit %d\n", e.arg & 0x0F, e.bit);                  break;
+            case IRMP_TRACE_FRAME:      printf ("frame %s, length = %d\n", irmp_protocol_names[e.arg], e.value);    break;
+            case IRMP_TRACE_DROPPED:    printf ("frame %s lost, queue full\n", irmp_protocol_names[e.arg]);         break;
+#if IRMP_TRACE_DETAIL == 1
+            case IRMP_TRACE_PULSE:      printf ("starting pulse\n");                                                break;
+            case IRMP_TRACE_BIT_TIMING: printf ("bit %d: pulse = %d, pause = %d\n", e.bit, e.pulse, e.value);       break;
+            case IRMP_TRACE_BIT:        printf ("bit %d: value %c\n", e.bit, e.arg ? e.arg : '-');                  break;
+#endif
+            default:                    printf ("unknown event %d\n", e.event);                                     break;
+        }
+    }
+}
+#endif // IRMP_TRACE_LEN > 0
+
+static void
+next_tick (void)
+{
+    if (! analyze && ! list)
+    {
+#if IRMP_USE_TIMESTAMP == 1 || IRMP_USE_RAW_FRAME == 1 || IRMP_USE_KEY_RELEASE == 1 || IRMP_USE_QUALITY == 1
+        IRMP_DATA_EX    irmp_data_ex;
+#endif
+
+        (void) irmp_ISR ();
+
+#if IRMP_TRACE_LEN > 0
+        if (trace)
+        {
+            print_trace ();
+        }
+#endif
+
+#if IRMP_USE_TIMESTAMP == 1 || IRMP_USE_RAW_FRAME == 1 || IRMP_USE_KEY_RELEASE == 1 || IRMP_USE_QUALITY == 1
+        if (irmp_get_data_ex (&irmp_data_ex))
+#else
+        if (irmp_get_data (&irmp_data))
+#endif
+        {
+            uint_fast8_t key;
+
+#if IRMP_USE_TIMESTAMP == 1 || IRMP_USE_RAW_FRAME == 1 || IRMP_USE_KEY_RELEASE == 1 || IRMP_USE_QUALITY == 1
+            irmp_data = irmp_data_ex.data;
+#endif
+
+            ANALYZE_ONLY_NORMAL_PUTCHAR (' ');
+
+            if (verbose)
+            {
+#if IRMP_USE_TIMESTAMP == 1
+                long    age = irmp_get_ticks () - irmp_data_ex.ticks;             // ticks since end of frame
+
+                printf ("%8.3fms ", (double) ((time_counter - age) * 1000) / F_INTERRUPTS);
+#else
+                printf ("%8.3fms ", (double) (time_counter * 1000) / F_INTERRUPTS);
+#endif
+#if IRMP_USE_KEY_RELEASE == 1
+                printf ("hold=%3d ", irmp_data_ex.hold);
+#endif
+            }
+
+            if (irmp_data.protocol == IRMP_ACP24_PROTOCOL)
+            {
+                uint16_t    temp = (irmp_data.command & 0x000F) + 15;
+
+                printf ("p=%2d (%s), a=0x%04x, c=0x%04x, f=0x%02x, temp=%d",
+                        irmp_data.protocol, irmp_protocol_names[irmp_data.protocol], irmp_data.address, irmp_data.command, irmp_data.flags, temp);
+            }
+            else if (irmp_data.protocol == IRMP_FDC_PROTOCOL && (key = get_fdc_key (irmp_data.command)) != 0)
+            {
+                if ((key >= 0x20 && key < 0x7F) || key >= 0xA0)
+                {
+                    printf ("p=%2d (%s), a=0x%04x, c=0x%04x, f=0x%02x, asc=0x%02x, key='%c'",
+                            irmp_data.protocol,  irmp_protocol_names[irmp_data.protocol], irmp_data.address, irmp_data.command, irmp_data.flags, key, key);
+                }
+                else if (key == '\r' || key == '\t' || key == KEY_ESCAPE || (key >= 0x80 && key <= 0x9F))                 // function keys
+                {
+                    char * p = (char *) NULL;
+
+                    switch (key)
+                    {
+                        case '\t'                : p = "TAB";           break;
+                        case '\r'                : p = "CR";            break;
+                        case KEY_ESCAPE          : p = "ESCAPE";        break;
+                        case KEY_MENUE           : p = "MENUE";         break;
+                        case KEY_BACK            : p = "BACK";          break;
+                        case KEY_FORWARD         : p = "FORWARD";       break;
+                        case KEY_ADDRESS         : p = "ADDRESS";       break;
+                        case KEY_WINDOW          : p = "WINDOW";        break;
+                        case KEY_1ST_PAGE        : p = "1ST_PAGE";      break;
+                        case KEY_STOP            : p = "STOP";          break;
+                        case KEY_MAIL            : p = "MAIL";          break;
+                        case KEY_FAVORITES       : p = "FAVORITES";     break;
+                        case KEY_NEW_PAGE        : p = "NEW_PAGE";      break;
+                        case KEY_SETUP           : p = "SETUP";         break;
+                        case KEY_FONT            : p = "FONT";          break;
+                        case KEY_PRINT           : p = "PRINT";         break;
+                        case KEY_ON_OFF          : p = "ON_OFF";        break;
+
+                        case KEY_INSERT          : p = "INSERT";        break;
+                        case KEY_DELETE          : p = "DELETE";        break;
+                        case KEY_LEFT            : p = "LEFT";          break;
+                        case KEY_HOME            : p = "HOME";          break;
+                        case KEY_END             : p = "END";           break;
+                        case KEY_UP              : p = "UP";            break;
+                        case KEY_DOWN            : p = "DOWN";          break;
+                        case KEY_PAGE_UP         : p = "PAGE_UP";       break;
+                        case KEY_PAGE_DOWN       : p = "PAGE_DOWN";     break;
+                        case KEY_RIGHT           : p = "RIGHT";         break;
+                        case KEY_MOUSE_1         : p = "KEY_MOUSE_1";   break;
+                        case KEY_MOUSE_2         : p = "KEY_MOUSE_2";   break;
+                        default                  : p = "<UNKNWON>";     break;
+                    }
+
+                    printf ("p=%2d (%s), a=0x%04x, c=0x%04x, f=0x%02x, asc=0x%02x, key=%s",
+                            irmp_data.protocol, irmp_protocol_names[irmp_data.protocol], irmp_data.address, irmp_data.command, irmp_data.flags, key, p);
+                }
+                else
+                {
+                    printf ("p=%2d (%s), a=0x%04x, c=0x%04x, f=0x%02x, asc=0x%02x",
+                            irmp_data.protocol,  irmp_protocol_names[irmp_data.protocol], irmp_data.address, irmp_data.command, irmp_data.flags, key);
+                }
+            }
+            else
+            {
+                printf ("p=%2d (%s), a=0x%04x, c=0x%04x, f=0x%02x",
+                        irmp_data.protocol, irmp_protocol_names[irmp_data.protocol], irmp_data.address, irmp_data.command, irmp_data.flags);
+            }
+
+            if (do_check_expected_values)
+            {
+                if (irmp_data.protocol != expected_protocol ||
+                    irmp_data.address  != expected_address  ||
+                    irmp_data.command  != expected_command)
+                {
+                    printf ("\nerror 7: expected values differ: p=%2d (%s), a=0x%04x, c=0x%04x\n",
+                            expected_protocol, irmp_protocol_names[expected_protocol], expected_address, expected_command);
+                }
+                else
+                {
+                    printf (" checked!\n");
+                }
+                do_check_expected_values = FALSE;                           // only check 1st frame in a line!
+            }
+            else
+            {
+                putchar ('\n');
+            }
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * benchmark: read scan file into memory and decode it BENCHMARK_LOOPS times in every mode
+ * samples/irq: max. number of samples decoded by irmp_ISR_sample() in one interrupt, the worst case cpu time of an interrupt
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#define BENCHMARK_LOOPS         100                                             // number of decoding loops per mode
+#if IRMP_USE_EDGE_ISR == 1
+#  define BENCHMARK_MODES       2                                               // 0: polling, 1: edge driven
+#else
+#  define BENCHMARK_MODES       1                                               // 0: polling
+#endif
+#define BENCHMARK_MAX_LINES     4096                                            // max. number of scan lines
+
+typedef struct
+{
+    uint8_t *       levels;                                                     // input level of each tick, 0 = pulse
+    int             len;                                                        // number of ticks
+    uint8_t *       edge_inputs;                                                // edge driven: input level of each interrupt
+    uint16_t *      edge_ticks;                                                 // edge driven: ticks since last interrupt
+    int             n_edges;                                                    // edge driven: number of interrupts
+} BENCHMARK_LINE;
+
+typedef struct
+{
+    long            lines;                                                      // number of lines, 1st frame of protocol
+    long            frames;                                                     // decoded frames
+    long            interrupts;                                                 // number of interrupts
+    long            max_samples;                                                // max. number of decoded samples per interrupt
+    clock_t         cpu;                                                        // cpu time
+} BENCHMARK_STAT;
+
+static BENCHMARK_LINE   benchmark_lines[BENCHMARK_MAX_LINES];
+static int              benchmark_n_lines;
+static long             benchmark_max_samples;                                  // max. number of decoded samples per interrupt of last line
+static BENCHMARK_STAT   benchmark_stat[BENCHMARK_MODES][IRMP_N_PROTOCOLS + 1];
+static const char *     benchmark_mode_names[] = { "polling", "edge" };
+
+#if IRMP_USE_EDGE_ISR == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * edge driven input: interrupt on every level change and after IRMP_EDGE_TIMEOUT_LEN ticks without level change
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+benchmark_edges (BENCHMARK_LINE * l)
+{
+    uint_fast8_t    level = 1;
+    int             last_pos = 0;
+    int             i;
+
+    l->edge_inputs  = malloc (l->len + 1);
+    l->edge_ticks   = malloc ((l->len + 1) * sizeof (uint16_t));
+
+    for (i = 0; i < l->len; i++)
+    {
+        if (l->levels[i] != level || (uint_fast16_t) (i - last_pos) >= IRMP_EDGE_TIMEOUT_LEN)
+        {
+            level = l->levels[i];
+            l->edge_inputs[l->n_edges]  = level;
+            l->edge_ticks[l->n_edges]   = i - last_pos;
+            l->n_edges++;
+            last_pos = i;
+        }
+    }
+
+    l->edge_inputs[l->n_edges]  = 1;                                            // remaining ticks, handled in idle time
+    l->edge_ticks[l->n_edges]   = l->len - last_pos;
+}
+#endif // IRMP_USE_EDGE_ISR == 1
+
+static void
+benchmark_read_lines (void)
+{
+    int     ch;
+    int     size = 0;
+
+    while ((ch = getchar ()) != EOF)
+    {
+        if (ch == '#')
+        {
+            while ((ch = getchar ()) != '\n' && ch != EOF)
+            {
+                ;
+            }
+        }
+        else if (ch == '0' || ch == '_' || ch == '1' || ch == '-' || ch == 0xaf)
+        {
+            BENCHMARK_LINE * l;
+
+            if (benchmark_n_lines == BENCHMARK_MAX_LINES)
+            {
+                fprintf (stderr, "too many lines\n");
+                exit (1);
+            }
+
+            l = benchmark_lines + benchmark_n_lines;
+
+            if (l->len == size)
+            {
+                size = size ? 2 * size : 1024;
+                l->levels = realloc (l->levels, size);
+            }
+
+            l->levels[l->len++] = (ch == '0' || ch == '_') ? 0 : 1;
+        }
+        else if (ch == '\n' && benchmark_lines[benchmark_n_lines].len > 0)
+        {
+#if IRMP_USE_EDGE_ISR == 1
+            benchmark_edges (benchmark_lines + benchmark_n_lines);
+#endif
+            benchmark_n_lines++;
+            size = 0;
+        }
+    }
+
+    if (benchmark_n_lines < BENCHMARK_MAX_LINES && benchmark_lines[benchmark_n_lines].len > 0)
+    {
+#if IRMP_USE_EDGE_ISR == 1
+        benchmark_edges (benchmark_lines + benchmark_n_lines);
+#endif
+        benchmark_n_lines++;
+    }
+}
+
+static void
+benchmark_frame (IRMP_DATA * d, int * frames, uint_fast8_t * protocol, unsigned long * checksum)
+{
+    if (! *frames)
+    {
+        *protocol = d->protocol;
+    }
+    (*frames)++;
+    *checksum = *checksum * 31 + ((unsigned long) d->protocol << 24) + ((unsigned long) d->flags << 20) + ((unsigned long) d->address << 8) + d->command;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * decode one line, followed by one second of darkness (neither counted as interrupts nor as cpu time)
+ * returns number of frames, interrupts, cpu time, protocol of 1st frame and a checksum of all decoded frames
+ * benchmark_max_samples: max. number of irmp_ISR_sample() calls in one interrupt
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static int
+benchmark_line (int mode, BENCHMARK_LINE * l, long * interrupts, clock_t * cpu, uint_fast8_t * protocol, unsigned long * checksum)
+{
+    IRMP_DATA       d;
+    int             frames = 0;
+    clock_t         start;
+    int             i;
+
+    *protocol   = 0;
+    *checksum   = 0;
+
+    start = clock ();
+
+    if (mode == 0)
+    {
+        for (i = 0; i < l->len; i++)
+        {
+            IRMP_PIN = l->levels[i] ? 0xff : 0x00;
+
+            if (irmp_ISR () && irmp_get_data (&d))
+            {
+                benchmark_frame (&d, &frames, protocol, checksum);
+            }
+        }
+        *interrupts = l->len;
+        benchmark_max_samples = 1;
+    }
+#if IRMP_USE_EDGE_ISR == 1
+    else
+    {
+        benchmark_max_samples = 0;
+
+        for (i = 0; i < l->n_edges; i++)
+        {
+            long samples = isr_samples;
+
+            if (irmp_ISR_edge (l->edge_inputs[i], l->edge_ticks[i]) && irmp_get_data (&d))
+            {
+                benchmark_frame (&d, &frames, protocol, checksum);
+            }
+
+            if (isr_samples - samples > benchmark_max_samples)
+            {
+                benchmark_max_samples = isr_samples - samples;
+            }
+        }
+        *interrupts = l->n_edges;
+    }
+#endif
+
+    *cpu = clock () - start;
+
+    IRMP_PIN = 0xff;
+
+    if (mode == 0)
+    {
+        for (i = 0; i < F_INTERRUPTS; i++)
+        {
+            if (irmp_ISR () && irmp_get_data (&d))
+            {
+                benchmark_frame (&d, &frames, protocol, checksum);
+            }
+        }
+    }
+#if IRMP_USE_EDGE_ISR == 1
+    else
+    {
+        for (i = 0; i < F_INTERRUPTS; i += IRMP_EDGE_TIMEOUT_LEN)
+        {
+            if (irmp_ISR_edge (1, i ? IRMP_EDGE_TIMEOUT_LEN : l->edge_ticks[l->n_edges]) && irmp_get_data (&d))
+            {
+                benchmark_frame (&d, &frames, protocol, checksum);
+            }
+        }
+    }
+#endif
+    return frames;
+}
+
+static int
+benchmark (void)
+{
+    static unsigned long    checksums[BENCHMARK_MODES][BENCHMARK_MAX_LINES];
+    int                     mode;
+    int                     loop;
+    int                     i;
+    int                     differ = 0;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+
+    for (mode = 0; mode < BENCHMARK_MODES; mode++)
+    {
+        for (loop = 0; loop < BENCHMARK_LOOPS; loop++)
+        {
+            for (i = 0; i < benchmark_n_lines; i++)
+            {
+                BENCHMARK_STAT *    s;
+                long                interrupts;
+                uint_fast8_t        protocol;
+                unsigned long       checksum;
+                clock_t             cpu;
+                int                 frames;
+
+                frames  = benchmark_line (mode, benchmark_lines + i, &interrupts, &cpu, &protocol, &checksum);
+                s       = &benchmark_stat[mode][protocol];
+                s->cpu += cpu;
+
+                if (loop == 0)
+                {
+                    s->lines++;
+                    s->frames       += frames;
+                    s->interrupts   += interrupts;
+                    checksums[mode][i] = checksum;
+
+                    if (s->max_samples < benchmark_max_samples)
+                    {
+                        s->max_samples = benchmark_max_samples;
+                    }
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        for (mode = 1; mode < BENCHMARK_MODES; mode++)
+        {
+            if (checksums[0][i] != checksums[mode][i])
+            {
+                printf ("line %d: decoded frames differ\n", i + 1);
+                differ++;
+            }
+        }
+    }
+
+    printf ("%d lines, %d loops, idle time between lines not counted\n", benchmark_n_lines, BENCHMARK_LOOPS);
+    printf ("%-12s %-8s %6s %6s %12s %12s %12s %12s\n", "protocol", "mode", "lines", "frames", "interrupts", "irqs/frame", "samples/irq", "ns/frame");
+
+    for (i = 0; i <= IRMP_N_PROTOCOLS; i++)
+    {
+        for (mode = 0; mode < BENCHMARK_MODES; mode++)
+        {
+            BENCHMARK_STAT * s = &benchmark_stat[mode][i];
+
+            if (s->lines)
+            {
+                printf ("%-12s %-8s %6ld %6ld %12ld %12.1f %12ld %12.0f\n", irmp_protocol_names[i], benchmark_mode_names[mode], s->lines, s->frames, s->interrupts,
+                        s->frames ? (double) s->interrupts / s->frames : 0.0, s->max_samples,
+                        s->frames ? (double) s->cpu * 1e9 / CLOCKS_PER_SEC / BENCHMARK_LOOPS / s->frames : 0.0);
+            }
+        }
+    }
+
+#if IRMP_USE_START_BIT_TABLE == 1
+    printf ("start bit table: %d start bits checked, %d errors\n", start_bit_table_lookups, start_bit_table_errors);
+    differ += start_bit_table_errors;
+#endif
+
+    return differ ? 1 : 0;
+}
+
+#if IRMP_CHANNEL_MASK != 0x00
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * multiple contexts: decode MULTI_CONTEXTS lines at once, line k is IR input k of a port
+ *   - one irmp_ISR_ctx() call per context and tick
+ *   - one irmp_ISR_multi() call per tick
+ * every line must give the same frames as decoded alone with irmp_ISR()
+ * samples/tick: max. number of samples decoded by irmp_ISR_sample() in one tick, the worst case cpu time of a tick
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#define MULTI_CONTEXTS          IRMP_CHANNELS                                   // number of contexts decoded at once
+#define MULTI_MODES             2                                               // 0: irmp_ISR_ctx(), 1: irmp_ISR_multi()
+
+static int
+multi_context (void)
+{
+    IRMP_CONTEXT        ctx[MULTI_CONTEXTS];
+    uint_fast8_t        channel_bits[MULTI_CONTEXTS];
+    unsigned long       checksums[MULTI_MODES][MULTI_CONTEXTS];
+    int                 frames[MULTI_MODES][MULTI_CONTEXTS];
+    clock_t             cpu[MULTI_MODES] = { 0, 0 };
+    long                max_samples[MULTI_MODES] = { 0, 0 };
+    long                samples;
+    uint8_t *           ports = (uint8_t *) NULL;
+    long                ticks = 0;
+    IRMP_DATA           d;
+    long                interrupts;
+    clock_t             start;
+    clock_t             line_cpu;
+    uint_fast8_t        protocol;
+    uint_fast8_t        bit;
+    unsigned long       checksum;
+    int                 first;
+    int                 n;
+    int                 len;
+    int                 mode;
+    int                 differ = 0;
+    int                 i;
+    int                 k;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    for (bit = 0x01, k = 0; k < MULTI_CONTEXTS; bit <<= 1)
+    {
+        if (IRMP_CHANNEL_MASK & bit)
+        {
+            channel_bits[k++] = bit;
+        }
+    }
+
+    benchmark_read_lines ();
+
+    for (first = 0; first < benchmark_n_lines; first += n)
+    {
+        n   = benchmark_n_lines - first < MULTI_CONTEXTS ? benchmark_n_lines - first : MULTI_CONTEXTS;
+        len = 0;
+
+        for (k = 0; k < n; k++)
+        {
+            if (len < benchmark_lines[first + k].len)
+            {
+                len = benchmark_lines[first + k].len;
+            }
+        }
+
+        len  += F_INTERRUPTS;                                                   // one second of darkness after the longest line
+        ports = realloc (ports, len);
+
+        for (i = 0; i < len; i++)
+        {
+            ports[i] = 0xFF;                                                    // unused inputs are dark
+
+            for (k = 0; k < n; k++)
+            {
+                BENCHMARK_LINE * l = benchmark_lines + first + k;
+
+                if (i < l->len && ! l->levels[i])
+                {
+                    ports[i] &= ~channel_bits[k];
+                }
+            }
+        }
+
+        for (k = 0; k < n; k++)
+        {
+            irmp_init_ctx (ctx + k);
+
+            for (mode = 0; mode < MULTI_MODES; mode++)
+            {
+                checksums[mode][k]  = 0;
+                frames[mode][k]     = 0;
+            }
+        }
+
+        irmp_channel_init ();
+
+        start = clock ();
+
+        for (i = 0; i < len; i++)
+        {
+            samples = isr_samples;
+
+            for (k = 0; k < n; k++)
+            {
+                if (irmp_ISR_ctx (ctx + k, ports[i] & channel_bits[k]) && irmp_get_data_ctx (ctx + k, &d))
+                {
+                    benchmark_frame (&d, frames[0] + k, &protocol, checksums[0] + k);
+                }
+            }
+
+            if (max_samples[0] < isr_samples - samples)
+            {
+                max_samples[0] = isr_samples - samples;
+            }
+        }
+
+        cpu[0] += clock () - start;
+        start   = clock ();
+
+        for (i = 0; i < len; i++)
+        {
+            samples = isr_samples;
+
+            if (irmp_ISR_multi (ports[i]))
+            {
+                while ((bit = irmp_get_data_multi (&d)) != 0)
+                {
+                    for (k = 0; channel_bits[k] != bit; k++)
+                    {
+                        ;
+                    }
+                    benchmark_frame (&d, frames[1] + k, &protocol, checksums[1] + k);
+                }
+            }
+
+            if (max_samples[1] < isr_samples - samples)
+            {
+                max_samples[1] = isr_samples - samples;
+            }
+        }
+
+        cpu[1] += clock () - start;
+        ticks  += len;
+
+        for (k = 0; k < n; k++)
+        {
+            analyze_reset ();                                                   // same initial state as ctx[k]
+            (void) benchmark_line (0, benchmark_lines + first + k, &interrupts, &line_cpu, &protocol, &checksum);
+
+            for (mode = 0; mode < MULTI_MODES; mode++)
+            {
+                if (checksum != checksums[mode][k])
+                {
+                    printf ("line %d: decoded frames differ: %s\n", first + k + 1, mode ? "irmp_ISR_multi" : "irmp_ISR_ctx");
+                    differ++;
+                }
+            }
+        }
+    }
+
+    free (ports);
+
+    printf ("%d lines, %d contexts, %d differences\n", benchmark_n_lines, MULTI_CONTEXTS, differ);
+    printf ("%-20s %12s %12s\n", "decoder", "ns/tick", "samples/tick");
+    printf ("%d x %-16s %12.1f %12ld\n", MULTI_CONTEXTS, "irmp_ISR_ctx", (double) cpu[0] * 1e9 / CLOCKS_PER_SEC / ticks, max_samples[0]);
+    printf ("%-20s %12.1f %12ld\n", "irmp_ISR_multi", (double) cpu[1] * 1e9 / CLOCKS_PER_SEC / ticks, max_samples[1]);
+    return differ ? 1 : 0;
+}
+#endif // IRMP_CHANNEL_MASK != 0x00
+
+#if IRMP_EARLY_MATCH_LEN > 0 || IRMP_ADDRESS_FILTER_LEN > 0 || IRMP_USE_PROTOCOL_MASK == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * decode one line from a fresh context, followed by one second of darkness
+ * returns tick of 1st frame (-1: no frame), the 1st frame and a checksum of all decoded frames
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static int
+first_frame_line (BENCHMARK_LINE * l, IRMP_DATA * first, unsigned long * checksum)
+{
+    IRMP_DATA       d;
+    uint_fast8_t    protocol;
+    int             frames = 0;
+    int             tick = -1;
+    int             i;
+
+    *checksum = 0;
+    analyze_reset ();
+
+    for (i = 0; i < l->len + F_INTERRUPTS; i++)                                 // line, followed by one second of darkness
+    {
+        IRMP_PIN = (i >= l->len || l->levels[i]) ? 0xff : 0x00;
+
+        if (irmp_ISR () && irmp_get_data (&d))
+        {
+            if (! frames)
+            {
+                *first  = d;
+                tick    = i;
+            }
+            benchmark_frame (&d, &frames, &protocol, checksum);
+        }
+    }
+    return tick;
+}
+#endif // IRMP_EARLY_MATCH_LEN > 0 || IRMP_ADDRESS_FILTER_LEN > 0 || IRMP_USE_PROTOCOL_MASK == 1
+
+#if IRMP_EARLY_MATCH_LEN > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * early match: decode every line twice, the 2nd time with its 1st frame registered as learned key
+ * reports the latency of the 1st frame (from its 1st pulse to irmp_get_data()) and the gain of early match per protocol
+ * every line must give the same frames in both runs
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct
+{
+    long            lines;                                                      // number of lines, 1st frame of protocol
+    long            early;                                                      // number of lines with early match
+    long            latency;                                                    // sum of latencies without early match in ticks
+    long            gain;                                                       // sum of gains in ticks
+} EARLY_MATCH_STAT;
+
+static int
+early_match_report (void)
+{
+    static EARLY_MATCH_STAT stat[IRMP_N_PROTOCOLS + 1];
+    static IRMP_DATA        none;
+    IRMP_DATA               first;
+    IRMP_DATA               early_first;
+    unsigned long           checksum;
+    unsigned long           early_checksum;
+    int                     tick;
+    int                     early_tick;
+    int                     start;
+    int                     differ = 0;
+    int                     i;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        BENCHMARK_LINE *    l = benchmark_lines + i;
+        EARLY_MATCH_STAT *  s;
+
+        irmp_set_early_match (0, &none);
+        tick = first_frame_line (l, &first, &checksum);
+
+        if (tick < 0)
+        {
+            continue;
+        }
+
+        irmp_set_early_match (0, &first);
+        early_tick = first_frame_line (l, &early_first, &early_checksum);
+
+        if (early_checksum != checksum)
+        {
+            printf ("line %d: decoded frames differ\n", i + 1);
+            differ++;
+            continue;
+        }
+
+        for (start = 0; start < l->len && l->levels[start]; start++)
+        {
+            ;
+        }
+
+        s = &stat[first.protocol];
+        s->lines++;
+        s->latency += tick - start;
+
+        if (early_tick < tick)
+        {
+            s->early++;
+            s->gain += tick - early_tick;
+        }
+    }
+
+    irmp_set_early_match (0, &none);
+
+    printf ("%d lines, %d differences, latency from 1st pulse to irmp_get_data()\n", benchmark_n_lines, differ);
+    printf ("%-12s %6s %6s %12s %12s %12s\n", "protocol", "lines", "early", "latency/ms", "early/ms", "gain/ms");
+
+    for (i = 0; i <= IRMP_N_PROTOCOLS; i++)
+    {
+        EARLY_MATCH_STAT * s = &stat[i];
+
+        if (s->lines)
+        {
+            printf ("%-12s %6ld %6ld %12.1f %12.1f %12.1f\n", irmp_protocol_names[i], s->lines, s->early,
+                    1000.0 * s->latency / F_INTERRUPTS / s->lines,
+                    1000.0 * (s->latency - s->gain) / F_INTERRUPTS / s->lines,
+                    1000.0 * s->gain / F_INTERRUPTS / s->lines);
+        }
+    }
+
+    return differ ? 1 : 0;
+}
+#endif // IRMP_EARLY_MATCH_LEN > 0
+
+#if IRMP_ADDRESS_FILTER_LEN > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * address filter: decode every line BENCHMARK_LOOPS times with
+ *   - empty filter
+ *   - filter set to the remote of the 1st frame: must give the same frames of this remote
+ *   - filter set to a foreign remote (address of 1st frame ^ 1): must give no frame
+ * reports frames and cpu time per protocol
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#define FILTER_MODES            3                                               // 0: empty, 1: own remote, 2: foreign remote
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * decode one line from a fresh context, followed by one second of darkness (not counted as cpu time)
+ * returns number of frames, cpu time and a checksum of the frames of remote
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static int
+address_filter_line (BENCHMARK_LINE * l, IRMP_DATA * remote, clock_t * cpu, unsigned long * checksum)
+{
+    IRMP_DATA       d;
+    uint_fast8_t    protocol;
+    int             frames = 0;
+    int             remote_frames = 0;
+    clock_t         start;
+    int             i;
+
+    *checksum   = 0;
+    *cpu        = 0;
+    analyze_reset ();
+
+    start = clock ();
+
+    for (i = 0; i < l->len + F_INTERRUPTS; i++)
+    {
+        if (i == l->len)
+        {
+            *cpu = clock () - start;
+        }
+
+        IRMP_PIN = (i >= l->len || l->levels[i]) ? 0xff : 0x00;
 
-                        while (irmp_bit < irmp_param.complete_len && irmp_pause_time > irmp_param.pause_1_len_max)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PUTCHAR ('0');
-#endif // ANALYZE
-                            irmp_store_bit (0);
+        if (irmp_ISR () && irmp_get_data (&d))
+        {
+            frames++;
 
-                            if (irmp_pause_time >= irmp_param.pause_1_len_min)
-                            {
-                                irmp_pause_time -= irmp_param.pause_1_len_min;
-                            }
-                            else
-                            {
-                                irmp_pause_time = 0;
-                            }
-                        }
-#ifdef ANALYZE
-                        ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                        wait_for_space = 0;
-                    }
-                    else
-#endif // IRMP_SUPPORT_SERIAL == 1
+            if (d.protocol == remote->protocol && d.address == remote->address)
+            {
+                benchmark_frame (&d, &remote_frames, &protocol, checksum);
+            }
+        }
+    }
+    return frames;
+}
 
-#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
-                    if (irmp_param.protocol == IRMP_SAMSUNG_PROTOCOL && irmp_bit == 16)       // Samsung: 16th bit
-                    {
-                        if (irmp_pulse_time >= SAMSUNG_PULSE_LEN_MIN && irmp_pulse_time <= SAMSUNG_PULSE_LEN_MAX &&
-                            irmp_pause_time >= SAMSUNG_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= SAMSUNG_START_BIT_PAUSE_LEN_MAX)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("SYNC\n");
-#endif // ANALYZE
-                            wait_for_space = 0;
-                            irmp_bit++;
-                        }
-                        else  if (irmp_pulse_time >= SAMSUNG_PULSE_LEN_MIN && irmp_pulse_time <= SAMSUNG_PULSE_LEN_MAX)
-                        {
-#if IRMP_SUPPORT_SAMSUNG48_PROTOCOL == 1
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("Switching to SAMSUNG48 protocol ");
-#endif // ANALYZE
-                            irmp_param.protocol         = IRMP_SAMSUNG48_PROTOCOL;
-                            irmp_param.command_offset   = SAMSUNG48_COMMAND_OFFSET;
-                            irmp_param.command_end      = SAMSUNG48_COMMAND_OFFSET + SAMSUNG48_COMMAND_LEN;
-                            irmp_param.complete_len     = SAMSUNG48_COMPLETE_DATA_LEN;
-#else
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("Switching to SAMSUNG32 protocol ");
-#endif // ANALYZE
-                            irmp_param.protocol         = IRMP_SAMSUNG32_PROTOCOL;
-                            irmp_param.command_offset   = SAMSUNG32_COMMAND_OFFSET;
-                            irmp_param.command_end      = SAMSUNG32_COMMAND_OFFSET + SAMSUNG32_COMMAND_LEN;
-                            irmp_param.complete_len     = SAMSUNG32_COMPLETE_DATA_LEN;
-#endif
-                            if (irmp_pause_time >= SAMSUNG_1_PAUSE_LEN_MIN && irmp_pause_time <= SAMSUNG_1_PAUSE_LEN_MAX)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PUTCHAR ('1');
-                                ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                                irmp_store_bit (1);
-                                wait_for_space = 0;
-                            }
-                            else
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PUTCHAR ('0');
-                                ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                                irmp_store_bit (0);
-                                wait_for_space = 0;
-                            }
-                        }
-                        else
-                        {                                                           // timing incorrect!
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("error 3 Samsung: timing not correct: data bit %d,  pulse: %d, pause: %d\n", irmp_bit, irmp_pulse_time, irmp_pause_time);
-                            ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
-#endif // ANALYZE
-                            irmp_start_bit_detected = 0;                            // reset flags and wait for next start bit
-                            irmp_pause_time         = 0;
-                        }
-                    }
-                    else
-#endif // IRMP_SUPPORT_SAMSUNG_PROTOCOL
+static int
+address_filter_report (void)
+{
+    static long         frames[FILTER_MODES][IRMP_N_PROTOCOLS + 1];
+    static clock_t      cpu[FILTER_MODES][IRMP_N_PROTOCOLS + 1];
+    static long         lines[IRMP_N_PROTOCOLS + 1];
+    static long         ticks[IRMP_N_PROTOCOLS + 1];
+    IRMP_DATA           first;
+    unsigned long       checksum;
+    unsigned long       own_checksum = 0;
+    clock_t             line_cpu;
+    int                 n = 0;
+    int                 mode;
+    int                 loop;
+    int                 differ = 0;
+    int                 i;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        BENCHMARK_LINE * l = benchmark_lines + i;
 
-#if IRMP_SUPPORT_NEC16_PROTOCOL
-#if IRMP_SUPPORT_NEC42_PROTOCOL == 1
-                    if (irmp_param.protocol == IRMP_NEC42_PROTOCOL &&
-#else // IRMP_SUPPORT_NEC_PROTOCOL instead
-                    if (irmp_param.protocol == IRMP_NEC_PROTOCOL &&
-#endif // IRMP_SUPPORT_NEC42_PROTOCOL == 1
-                        irmp_bit == 8 && irmp_pause_time >= NEC_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= NEC_START_BIT_PAUSE_LEN_MAX)
-                    {
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("Switching to NEC16 protocol\n");
-#endif // ANALYZE
-                        irmp_param.protocol         = IRMP_NEC16_PROTOCOL;
-                        irmp_param.address_offset   = NEC16_ADDRESS_OFFSET;
-                        irmp_param.address_end      = NEC16_ADDRESS_OFFSET + NEC16_ADDRESS_LEN;
-                        irmp_param.command_offset   = NEC16_COMMAND_OFFSET;
-                        irmp_param.command_end      = NEC16_COMMAND_OFFSET + NEC16_COMMAND_LEN;
-                        irmp_param.complete_len     = NEC16_COMPLETE_DATA_LEN;
-                        wait_for_space = 0;
-                    }
-                    else
-#endif // IRMP_SUPPORT_NEC16_PROTOCOL
+        irmp_set_address_filter (0, 0, 0);
 
-#if IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
-                    if (irmp_param.protocol == IRMP_BANG_OLUFSEN_PROTOCOL)
-                    {
-                        if (irmp_pulse_time >= BANG_OLUFSEN_PULSE_LEN_MIN && irmp_pulse_time <= BANG_OLUFSEN_PULSE_LEN_MAX)
-                        {
-                            if (irmp_bit == 1)                                      // Bang & Olufsen: 3rd bit
-                            {
-                                if (irmp_pause_time >= BANG_OLUFSEN_START_BIT3_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_START_BIT3_PAUSE_LEN_MAX)
-                                {
-#ifdef ANALYZE
-                                    ANALYZE_PRINTF ("3rd start bit\n");
-#endif // ANALYZE
-                                    wait_for_space = 0;
-                                    irmp_bit++;
-                                }
-                                else
-                                {                                                   // timing incorrect!
-#ifdef ANALYZE
-                                    ANALYZE_PRINTF ("error 3a B&O: timing not correct: data bit %d,  pulse: %d, pause: %d\n", irmp_bit, irmp_pulse_time, irmp_pause_time);
-                                    ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
-#endif // ANALYZE
-                                    irmp_start_bit_detected = 0;                    // reset flags and wait for next start bit
-                                    irmp_pause_time         = 0;
-                                }
-                            }
-                            else if (irmp_bit == 19)                                // Bang & Olufsen: trailer bit
-                            {
-                                if (irmp_pause_time >= BANG_OLUFSEN_TRAILER_BIT_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_TRAILER_BIT_PAUSE_LEN_MAX)
-                                {
-#ifdef ANALYZE
-                                    ANALYZE_PRINTF ("trailer bit\n");
-#endif // ANALYZE
-                                    wait_for_space = 0;
-                                    irmp_bit++;
-                                }
-                                else
-                                {                                                   // timing incorrect!
-#ifdef ANALYZE
-                                    ANALYZE_PRINTF ("error 3b B&O: timing not correct: data bit %d,  pulse: %d, pause: %d\n", irmp_bit, irmp_pulse_time, irmp_pause_time);
-                                    ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
-#endif // ANALYZE
-                                    irmp_start_bit_detected = 0;                    // reset flags and wait for next start bit
-                                    irmp_pause_time         = 0;
-                                }
-                            }
-                            else
-                            {
-                                if (irmp_pause_time >= BANG_OLUFSEN_1_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_1_PAUSE_LEN_MAX)
-                                {                                                   // pulse & pause timings correct for "1"?
-#ifdef ANALYZE
-                                    ANALYZE_PUTCHAR ('1');
-                                    ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                                    irmp_store_bit (1);
-                                    last_value = 1;
-                                    wait_for_space = 0;
-                                }
-                                else if (irmp_pause_time >= BANG_OLUFSEN_0_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_0_PAUSE_LEN_MAX)
-                                {                                                   // pulse & pause timings correct for "0"?
-#ifdef ANALYZE
-                                    ANALYZE_PUTCHAR ('0');
-                                    ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                                    irmp_store_bit (0);
-                                    last_value = 0;
-                                    wait_for_space = 0;
-                                }
-                                else if (irmp_pause_time >= BANG_OLUFSEN_R_PAUSE_LEN_MIN && irmp_pause_time <= BANG_OLUFSEN_R_PAUSE_LEN_MAX)
-                                {
-#ifdef ANALYZE
-                                    ANALYZE_PUTCHAR (last_value + '0');
-                                    ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                                    irmp_store_bit (last_value);
-                                    wait_for_space = 0;
-                                }
-                                else
-                                {                                                   // timing incorrect!
-#ifdef ANALYZE
-                                    ANALYZE_PRINTF ("error 3c B&O: timing not correct: data bit %d,  pulse: %d, pause: %d\n", irmp_bit, irmp_pulse_time, irmp_pause_time);
-                                    ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
-#endif // ANALYZE
-                                    irmp_start_bit_detected = 0;                    // reset flags and wait for next start bit
-                                    irmp_pause_time         = 0;
-                                }
-                            }
-                        }
-                        else
-                        {                                                           // timing incorrect!
-#ifdef ANALYZE
-                            ANALYZE_PRINTF ("error 3d B&O: timing not correct: data bit %d,  pulse: %d, pause: %d\n", irmp_bit, irmp_pulse_time, irmp_pause_time);
-                            ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
-#endif // ANALYZE
-                            irmp_start_bit_detected = 0;                            // reset flags and wait for next start bit
-                            irmp_pause_time         = 0;
-                        }
-                    }
-                    else
-#endif // IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL
+        if (first_frame_line (l, &first, &checksum) < 0)
+        {
+            continue;
+        }
 
-#if IRMP_SUPPORT_RCMM_PROTOCOL == 1
-                    if (irmp_param.protocol == IRMP_RCMM32_PROTOCOL)
-                    {
-                        if (irmp_pause_time >= RCMM32_BIT_00_PAUSE_LEN_MIN && irmp_pause_time <= RCMM32_BIT_00_PAUSE_LEN_MAX)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PUTCHAR ('0');
-                            ANALYZE_PUTCHAR ('0');
-#endif // ANALYZE
-                            irmp_store_bit (0);
-                            irmp_store_bit (0);
-                        }
-                        else if (irmp_pause_time >= RCMM32_BIT_01_PAUSE_LEN_MIN && irmp_pause_time <= RCMM32_BIT_01_PAUSE_LEN_MAX)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PUTCHAR ('0');
-                            ANALYZE_PUTCHAR ('1');
-#endif // ANALYZE
-                            irmp_store_bit (0);
-                            irmp_store_bit (1);
-                        }
-                        else if (irmp_pause_time >= RCMM32_BIT_10_PAUSE_LEN_MIN && irmp_pause_time <= RCMM32_BIT_10_PAUSE_LEN_MAX)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PUTCHAR ('1');
-                            ANALYZE_PUTCHAR ('0');
-#endif // ANALYZE
-                            irmp_store_bit (1);
-                            irmp_store_bit (0);
-                        }
-                        else if (irmp_pause_time >= RCMM32_BIT_11_PAUSE_LEN_MIN && irmp_pause_time <= RCMM32_BIT_11_PAUSE_LEN_MAX)
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PUTCHAR ('1');
-                            ANALYZE_PUTCHAR ('1');
-#endif // ANALYZE
-                            irmp_store_bit (1);
-                            irmp_store_bit (1);
-                        }
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("\n");
-#endif // ANALYZE
-                        wait_for_space = 0;
-                    }
-                    else
-#endif
+        lines[first.protocol]++;
+        ticks[first.protocol] += l->len;
 
-                    if (irmp_pulse_time >= irmp_param.pulse_1_len_min && irmp_pulse_time <= irmp_param.pulse_1_len_max &&
-                        irmp_pause_time >= irmp_param.pause_1_len_min && irmp_pause_time <= irmp_param.pause_1_len_max)
-                    {                                                               // pulse & pause timings correct for "1"?
-#ifdef ANALYZE
-                        ANALYZE_PUTCHAR ('1');
-                        ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                        irmp_store_bit (1);
-                        wait_for_space = 0;
-                    }
-                    else if (irmp_pulse_time >= irmp_param.pulse_0_len_min && irmp_pulse_time <= irmp_param.pulse_0_len_max &&
-                             irmp_pause_time >= irmp_param.pause_0_len_min && irmp_pause_time <= irmp_param.pause_0_len_max)
-                    {                                                               // pulse & pause timings correct for "0"?
-#ifdef ANALYZE
-                        ANALYZE_PUTCHAR ('0');
-                        ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                        irmp_store_bit (0);
-                        wait_for_space = 0;
-                    }
-                    else
-#if IRMP_SUPPORT_KATHREIN_PROTOCOL
+        for (mode = 0; mode < FILTER_MODES; mode++)
+        {
+            irmp_set_address_filter (0, mode ? first.protocol : 0, mode == 2 ? first.address ^ 1 : first.address);
 
-                    if (irmp_param.protocol == IRMP_KATHREIN_PROTOCOL &&
-                        irmp_pulse_time >= KATHREIN_1_PULSE_LEN_MIN && irmp_pulse_time <= KATHREIN_1_PULSE_LEN_MAX &&
-                        (((irmp_bit == 8 || irmp_bit == 6) &&
-                                irmp_pause_time >= KATHREIN_SYNC_BIT_PAUSE_LEN_MIN && irmp_pause_time <= KATHREIN_SYNC_BIT_PAUSE_LEN_MAX) ||
-                         (irmp_bit == 12 &&
-                                irmp_pause_time >= KATHREIN_START_BIT_PAUSE_LEN_MIN && irmp_pause_time <= KATHREIN_START_BIT_PAUSE_LEN_MAX)))
+            for (loop = 0; loop < BENCHMARK_LOOPS; loop++)
+            {
+                n = address_filter_line (l, &first, &line_cpu, &checksum);
+                cpu[mode][first.protocol] += line_cpu;
+            }
 
-                    {
-                        if (irmp_bit == 8)
-                        {
-                            irmp_bit++;
-#ifdef ANALYZE
-                            ANALYZE_PUTCHAR ('S');
-                            ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                            irmp_tmp_command <<= 1;
-                        }
-                        else
-                        {
-#ifdef ANALYZE
-                            ANALYZE_PUTCHAR ('S');
-                            ANALYZE_NEWLINE ();
-#endif // ANALYZE
-                            irmp_store_bit (1);
-                        }
-                        wait_for_space = 0;
-                    }
-                    else
-#endif // IRMP_SUPPORT_KATHREIN_PROTOCOL
-                    {                                                               // timing incorrect!
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("error 3: timing not correct: data bit %d,  pulse: %d, pause: %d\n", irmp_bit, irmp_pulse_time, irmp_pause_time);
-                        ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
-#endif // ANALYZE
-                        irmp_start_bit_detected = 0;                                // reset flags and wait for next start bit
-                        irmp_pause_time         = 0;
-                    }
+            frames[mode][first.protocol] += n;
 
-                    irmp_pulse_time = 1;                                            // set counter to 1, not 0
-                }
+            if (mode == 0)
+            {
+                own_checksum = checksum;
             }
-            else
-            {                                                                       // counting the pulse length ...
-                if (! irmp_input)                                                   // still light?
-                {                                                                   // yes...
-                    irmp_pulse_time++;                                              // increment counter
-                }
-                else
-                {                                                                   // now it's dark!
-                    wait_for_space  = 1;                                            // let's count the time (see above)
-                    irmp_pause_time = 1;                                            // set pause counter to 1, not 0
-                }
+            else if (mode == 1 ? checksum != own_checksum : n != 0)
+            {
+                printf ("line %d: %s remote: wrong frames\n", i + 1, mode == 1 ? "own" : "foreign");
+                differ++;
+            }
+        }
+    }
+
+    irmp_set_address_filter (0, 0, 0);
+
+    printf ("%d lines, %d loops, %d differences\n", benchmark_n_lines, BENCHMARK_LOOPS, differ);
+    printf ("%-12s %6s %8s %8s %8s %16s %16s %16s\n", "protocol", "lines", "frames", "own", "foreign", "ns/tick", "own ns/tick", "foreign ns/tick");
+
+    for (i = 0; i <= IRMP_N_PROTOCOLS; i++)
+    {
+        if (lines[i])
+        {
+            printf ("%-12s %6ld %8ld %8ld %8ld", irmp_protocol_names[i], lines[i], frames[0][i], frames[1][i], frames[2][i]);
+
+            for (mode = 0; mode < FILTER_MODES; mode++)
+            {
+                printf (" %16.1f", (double) cpu[mode][i] * 1e9 / CLOCKS_PER_SEC / BENCHMARK_LOOPS / ticks[i]);
             }
+            putchar ('\n');
+        }
+    }
 
-            if (irmp_start_bit_detected && irmp_bit == irmp_param.complete_len && irmp_param.stop_bit == 0)    // enough bits received?
+    return differ ? 1 : 0;
+}
+#endif // IRMP_ADDRESS_FILTER_LEN > 0
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * latency: decode every line, reports per protocol the latency of the 1st frame from its 1st pulse and from its last pulse to
+ * irmp_get_data() and the frames per line, auto repetition frames are counted separately (see IRMP_SIRCS_LOW_LATENCY).
+ * With IRMP_FAST_NEC, a 2nd table is decoded with irmp_set_nec42_expected (FALSE)
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct
+{
+    long            lines;                                                      // number of lines, 1st frame of protocol
+    long            frames;                                                     // decoded frames
+    long            auto_frames;                                                // decoded frames flagged as auto repetition
+    long            latency;                                                    // sum of latencies from 1st pulse in ticks
+    long            hold;                                                       // sum of latencies from last pulse in ticks
+    long            max_hold;                                                   // max. latency from last pulse in ticks
+} LATENCY_STAT;
+
+static void
+latency_table (const char * title)
+{
+    static LATENCY_STAT stat[IRMP_N_PROTOCOLS + 1];
+    IRMP_DATA           d;
+    IRMP_DATA           first;
+    int                 frames;
+    int                 auto_frames;
+    int                 tick;
+    int                 start;
+    int                 end;
+    int                 i;
+    int                 j;
+
+    memset (stat, 0, sizeof (stat));
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        BENCHMARK_LINE *    l = benchmark_lines + i;
+        LATENCY_STAT *      s;
+
+        frames      = 0;
+        auto_frames = 0;
+        tick        = -1;
+        analyze_reset ();
+
+        for (j = 0; j < l->len + F_INTERRUPTS; j++)                             // line, followed by one second of darkness
+        {
+            IRMP_PIN = (j >= l->len || l->levels[j]) ? 0xff : 0x00;
+
+            if (irmp_ISR () && irmp_get_data (&d))
             {
-                if (last_irmp_command == irmp_tmp_command && key_repetition_len < AUTO_FRAME_REPETITION_LEN)
+                if (! frames)
                 {
-                    repetition_frame_number++;
+                    first   = d;
+                    tick    = j;
                 }
-                else
+#ifdef IRMP_FLAG_AUTO_REPETITION
+                if (d.flags & IRMP_FLAG_AUTO_REPETITION)
                 {
-                    repetition_frame_number = 0;
+                    auto_frames++;
                 }
+#endif
+                frames++;
+            }
+        }
 
-#if IRMP_SUPPORT_SIRCS_PROTOCOL == 1
-                // if SIRCS protocol and the code will be repeated within 50 ms, we will ignore 2nd and 3rd repetition frame
-                if (irmp_param.protocol == IRMP_SIRCS_PROTOCOL && (repetition_frame_number == 1 || repetition_frame_number == 2))
-                {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF ("code skipped: SIRCS auto repetition frame #%d, counter = %d, auto repetition len = %d\n",
-                                    repetition_frame_number + 1, key_repetition_len, AUTO_FRAME_REPETITION_LEN);
-#endif // ANALYZE
-                    key_repetition_len = 0;
-                }
-                else
+        if (tick < 0)
+        {
+            continue;
+        }
+
+        for (start = 0; start < l->len && l->levels[start]; start++)
+        {
+            ;
+        }
+
+        for (end = tick < l->len ? tick : l->len - 1; end > 0 && l->levels[end]; end--)   // last pulse before 1st frame was detected
+        {
+            ;
+        }
+
+        s = &stat[first.protocol];
+        s->lines++;
+        s->frames       += frames;
+        s->auto_frames  += auto_frames;
+        s->latency      += tick - start;
+        s->hold         += tick - end;
+
+        if (s->max_hold < tick - end)
+        {
+            s->max_hold = tick - end;
+        }
+    }
+
+    printf ("%d lines, latency of 1st frame to irmp_get_data() from its 1st pulse and from its last pulse%s\n", benchmark_n_lines, title);
+    printf ("%-12s %6s %8s %8s %12s %12s %12s\n", "protocol", "lines", "frames", "auto", "latency/ms", "end/ms", "max end/ms");
+
+    for (i = 0; i <= IRMP_N_PROTOCOLS; i++)
+    {
+        LATENCY_STAT * s = &stat[i];
+
+        if (s->lines)
+        {
+            printf ("%-12s %6ld %8ld %8ld %12.1f %12.1f %12.1f\n", irmp_protocol_names[i], s->lines, s->frames, s->auto_frames,
+                    1000.0 * s->latency / F_INTERRUPTS / s->lines,
+                    1000.0 * s->hold / F_INTERRUPTS / s->lines,
+                    1000.0 * s->max_hold / F_INTERRUPTS);
+        }
+    }
+
+}
+
+static int
+latency_report (void)
+{
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+    latency_table ("");
+
+#if IRMP_FAST_NEC == 1
+    putchar ('\n');
+    irmp_set_nec42_expected (FALSE);
+    latency_table (", without NEC42 remotes");
+    irmp_set_nec42_expected (TRUE);
 #endif
 
-#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
-                // if ORTEK protocol and the code will be repeated within 50 ms, we will ignore 2nd repetition frame
-                if (irmp_param.protocol == IRMP_ORTEK_PROTOCOL && repetition_frame_number == 1)
+    return 0;
+}
+
+#if IRMP_GLITCH_FILTER_LEN > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * glitch filter: decode every line with glitches of 1 tick injected at GLITCH_RATES rates, without filter and with GLITCH_FILTERS - 1
+ * filter lengths. A line is decoded correctly if its frames are the frames of the line without glitches and without filter.
+ * Reports per rate and filter length the share of correctly decoded lines and the cpu time per tick
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#define GLITCH_RATES            4
+#define GLITCH_FILTERS          3
+#define GLITCH_LOOPS            10                                              // number of decoding loops per rate and filter
+
+static const int                glitch_rates[GLITCH_RATES]      = { 0, 2, 5, 10 };     // glitches per 1000 ticks
+static const int                glitch_filters[GLITCH_FILTERS]  = { 1, 2, 3 };         // filter length, 1: off
+
+static int
+glitch_report (void)
+{
+    static unsigned long    reference[BENCHMARK_MAX_LINES];
+    BENCHMARK_LINE          noisy;
+    uint8_t *               levels = (uint8_t *) NULL;
+    unsigned long           seed;
+    unsigned long           checksum;
+    long                    interrupts;
+    long                    ticks;
+    long                    correct;
+    clock_t                 cpu;
+    clock_t                 cpu_sum;
+    uint_fast8_t            protocol;
+    int                     rate;
+    int                     filter;
+    int                     loop;
+    int                     i;
+    int                     j;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+
+    irmp_set_glitch_filter (1);
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        (void) benchmark_line (0, benchmark_lines + i, &interrupts, &cpu, &protocol, reference + i);
+    }
+
+    printf ("%d lines, %d loops, glitches of 1 tick\n", benchmark_n_lines, GLITCH_LOOPS);
+    printf ("%13s %8s %8s %10s %12s\n", "glitches/1000", "filter", "correct", "correct/%", "ns/tick");
+
+    for (rate = 0; rate < GLITCH_RATES; rate++)
+    {
+        for (filter = 0; filter < GLITCH_FILTERS; filter++)
+        {
+            irmp_set_glitch_filter (glitch_filters[filter]);
+            seed    = 1;                                                        // same glitches for every filter length
+            correct = 0;
+            ticks   = 0;
+            cpu_sum = 0;
+
+            for (i = 0; i < benchmark_n_lines; i++)
+            {
+                noisy           = benchmark_lines[i];
+                levels          = realloc (levels, noisy.len);
+                noisy.levels    = levels;
+
+                for (j = 0; j < noisy.len; j++)
                 {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF ("code skipped: ORTEK auto repetition frame #%d, counter = %d, auto repetition len = %d\n",
-                                    repetition_frame_number + 1, key_repetition_len, AUTO_FRAME_REPETITION_LEN);
-#endif // ANALYZE
-                    key_repetition_len = 0;
+                    seed = seed * 1103515245 + 12345;
+                    levels[j] = benchmark_lines[i].levels[j];
+
+                    if ((seed >> 16) % 1000 < (unsigned long) glitch_rates[rate])
+                    {
+                        levels[j] = ! levels[j];
+                    }
                 }
-                else
-#endif
 
-#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
-                // if KASEIKYO protocol and the code will be repeated within 50 ms, we will ignore 2nd repetition frame
-                if (irmp_param.protocol == IRMP_KASEIKYO_PROTOCOL && repetition_frame_number == 1)
+                for (loop = 0; loop < GLITCH_LOOPS; loop++)
                 {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF ("code skipped: KASEIKYO auto repetition frame #%d, counter = %d, auto repetition len = %d\n",
-                                    repetition_frame_number + 1, key_repetition_len, AUTO_FRAME_REPETITION_LEN);
-#endif // ANALYZE
-                    key_repetition_len = 0;
+                    (void) benchmark_line (0, &noisy, &interrupts, &cpu, &protocol, &checksum);
+                    cpu_sum += cpu;
                 }
-                else
-#endif
 
-#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
-                // if SAMSUNG32 or SAMSUNG48 protocol and the code will be repeated within 50 ms, we will ignore every 2nd frame
-                if ((irmp_param.protocol == IRMP_SAMSUNG32_PROTOCOL || irmp_param.protocol == IRMP_SAMSUNG48_PROTOCOL) && (repetition_frame_number & 0x01))
+                ticks += noisy.len;
+
+                if (checksum == reference[i])
                 {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF ("code skipped: SAMSUNG32/SAMSUNG48 auto repetition frame #%d, counter = %d, auto repetition len = %d\n",
-                                    repetition_frame_number + 1, key_repetition_len, AUTO_FRAME_REPETITION_LEN);
-#endif // ANALYZE
-                    key_repetition_len = 0;
+                    correct++;
                 }
-                else
-#endif
+            }
+
+            printf ("%13d %8d %8ld %10.1f %12.1f\n", glitch_rates[rate], glitch_filters[filter], correct, 100.0 * correct / benchmark_n_lines,
+                    (double) cpu_sum * 1e9 / CLOCKS_PER_SEC / GLITCH_LOOPS / ticks);
+        }
+    }
+
+    irmp_set_glitch_filter (IRMP_GLITCH_FILTER_LEN);
+    free (levels);
+    return 0;
+}
+#endif // IRMP_GLITCH_FILTER_LEN > 0
+
+#if IRMP_IDLE_DIVIDER > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * idle sampling: decode every line, followed by one second of darkness, like the timer in main.c does with IRMP_IDLE_DIVIDER:
+ * irmp_ISR() at full rate until irmp_idle(), then irmp_ISR_idle() at idle rate until it returns TRUE.
+ * Reports interrupts per line against polling at full rate and lines decoded differently
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static long
+idle_line (BENCHMARK_LINE * l, uint_fast8_t * protocol, unsigned long * checksum)
+{
+    IRMP_DATA       d;
+    long            interrupts  = 0;
+    int             frames      = 0;
+    int             idle        = FALSE;
+    int             i           = 0;
+
+    *protocol   = 0;
+    *checksum   = 0;
+
+    while (i < l->len + F_INTERRUPTS)
+    {
+        if (idle)
+        {
+            i += IRMP_IDLE_DIVIDER;                                             // sample at end of idle period
+            IRMP_PIN    = (i > l->len || l->levels[i - 1]) ? 0xff : 0x00;
+            idle        = ! irmp_ISR_idle ();
+        }
+        else
+        {
+            IRMP_PIN    = (i >= l->len || l->levels[i]) ? 0xff : 0x00;
+            i++;
+            (void) irmp_ISR ();
+            idle        = irmp_idle ();
+        }
+
+        interrupts++;
+
+        if (irmp_get_data (&d))
+        {
+            benchmark_frame (&d, &frames, protocol, checksum);
+        }
+    }
+    return interrupts;
+}
+
+static int
+idle_report (void)
+{
+    static long         stat[IRMP_N_PROTOCOLS + 1][3];                         // lines, interrupts polling, interrupts idle sampling
+    unsigned long       reference;
+    unsigned long       checksum;
+    long                interrupts;
+    clock_t             cpu;
+    uint_fast8_t        protocol;
+    uint_fast8_t        idle_protocol;                                      // 1st frame with idle sampling, lines count for protocol
+    int                 differ = 0;
+    int                 i;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        BENCHMARK_LINE * l = benchmark_lines + i;
+
+        analyze_reset ();
+        (void) benchmark_line (0, l, &interrupts, &cpu, &protocol, &reference);
+
+        stat[protocol][0]++;
+        stat[protocol][1] += l->len + F_INTERRUPTS;
+
+        analyze_reset ();
+        stat[protocol][2] += idle_line (l, &idle_protocol, &checksum);
+
+        if (checksum != reference)
+        {
+            printf ("line %d: decoded frames differ with idle sampling, 1st frame %s\n", i + 1, irmp_protocol_names[protocol]);
+            differ++;
+        }
+    }
+
+    printf ("%d lines, %d decoded differently, interrupts per line incl. 1 s of darkness, idle rate = full rate / %d\n",
+            benchmark_n_lines, differ, IRMP_IDLE_DIVIDER);
+    printf ("%-12s %6s %12s %12s %10s\n", "protocol", "lines", "full rate", "idle rate", "saved/%");
+
+    for (i = 0; i <= IRMP_N_PROTOCOLS; i++)
+    {
+        if (stat[i][0])
+        {
+            printf ("%-12s %6ld %12.1f %12.1f %10.1f\n", irmp_protocol_names[i], stat[i][0],
+                    (double) stat[i][1] / stat[i][0], (double) stat[i][2] / stat[i][0], 100.0 - 100.0 * stat[i][2] / stat[i][1]);
+        }
+    }
+
+    return differ ? 1 : 0;
+}
+#endif // IRMP_IDLE_DIVIDER > 0
+
+#if IRMP_USE_COUNTERS == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * decode counters: decode every line, reports the counters of irmp_get_counters()
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static int
+counters_report (void)
+{
+    IRMP_COUNTERS   c;
+    unsigned long   checksum;
+    long            interrupts;
+    clock_t         cpu;
+    uint_fast8_t    protocol;
+    int             i;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        (void) benchmark_line (0, benchmark_lines + i, &interrupts, &cpu, &protocol, &checksum);
+    }
+
+    irmp_get_counters (&c);
+
+    printf ("%d lines\n", benchmark_n_lines);
+    printf ("%-40s %6u\n", "frames",                                  c.frames);
+    printf ("%-40s %6u\n", "frames lost, queue full",                 c.dropped);
+    printf ("%-40s %6u\n", "frames rejected by irmp_get_data()",      c.check);
+    printf ("%-40s %6u\n", "error 1: pause after start bit too long", c.start_pause);
+    printf ("%-40s %6u\n", "error 2: pause after data bit too long",  c.data_pause);
+    printf ("%-40s %6u\n", "error 3: timing of data bit not correct", c.timing);
+    printf ("%-40s %6u\n", "error 4: wrong XOR check of customer id", c.xor_address);
+    printf ("%-40s %6u\n", "error 5: wrong XOR check of data bits",   c.xor_data);
+    printf ("%-40s %6u\n", "error 6: parity check failed",            c.ortek_parity);
+    printf ("%-40s %6u\n", "error 8: TECHNICS frame error",           c.technics);
+    printf ("%-40s %6u\n", "frames of disabled protocols",            c.disabled);
+    return 0;
+}
+#endif // IRMP_USE_COUNTERS == 1
+
+#if IRMP_USE_PROTOCOL_MASK == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * protocol mask: decode all lines once with all protocols and once with only the protocol of a line's 1st frame enabled, for every
+ * protocol found. Reports the enabled start bit table entries, the entries compared per start bit and the frames of other protocols.
+ * Frames of the enabled protocol must not change, frames of others must not show up.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static void
+protocol_mask_line (BENCHMARK_LINE * l, uint_fast8_t protocol, long * own, long * foreign, unsigned long * checksum)
+{
+    IRMP_DATA       d;
+    uint_fast8_t    p;
+    int             frames = 0;
+    int             i;
+
+    analyze_reset ();
+
+    for (i = 0; i < l->len + F_INTERRUPTS; i++)                                 // line, followed by one second of darkness
+    {
+        IRMP_PIN = (i >= l->len || l->levels[i]) ? 0xff : 0x00;
+
+        if (irmp_ISR () && irmp_get_data (&d))
+        {
+            if (d.protocol == protocol)
+            {
+                benchmark_frame (&d, &frames, &p, checksum);
+            }
+            else
+            {
+                (*foreign)++;
+            }
+        }
+    }
+    *own += frames;
+}
+
+static int
+protocol_mask_report (void)
+{
+    static long         lines[IRMP_N_PROTOCOLS + 1];
+    long                own[2];
+    long                foreign[2];
+    unsigned long       checksum[2];
+    int                 checks[2];
+    int                 lookups[2];
+    int                 entries = IRMP_START_BITS;
+    IRMP_DATA           first;
+    unsigned long       first_checksum;
+    uint8_t             protocol;
+    int                 differ = 0;
+    int                 mode;
+    int                 i;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+    irmp_set_protocols (0, 0);
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        if (first_frame_line (benchmark_lines + i, &first, &first_checksum) >= 0)
+        {
+            lines[first.protocol]++;
+        }
+    }
+
+    printf ("%d lines, %d start bit table entries\n", benchmark_n_lines, (int) IRMP_START_BITS);
+    printf ("%-12s %6s %8s %8s %8s %8s %12s %12s\n", "protocol", "lines", "entries", "frames", "foreign", "masked", "checks/bit", "masked");
+
+    for (protocol = 1; protocol <= IRMP_N_PROTOCOLS; protocol++)
+    {
+        if (! lines[protocol] || protocol == IRMP_HASH_PROTOCOL)                // enabled alone, HASH gets all frames, see ./irmp -u
+        {
+            continue;
+        }
+
+        for (mode = 0; mode < 2; mode++)
+        {
+            irmp_set_protocols (&protocol, mode);
+            entries = irmp_start_bit_count;
+
+            own[mode]               = 0;
+            foreign[mode]           = 0;
+            checksum[mode]          = 0;
+            checks[mode]            = start_bit_table_checks;
+            lookups[mode]           = start_bit_table_lookups;
+
+            for (i = 0; i < benchmark_n_lines; i++)
+            {
+                protocol_mask_line (benchmark_lines + i, protocol, own + mode, foreign + mode, checksum + mode);
+            }
+
+            checks[mode]            = start_bit_table_checks - checks[mode];
+            lookups[mode]           = start_bit_table_lookups - lookups[mode];
+        }
+
+        if (own[0] != own[1] || checksum[0] != checksum[1] || foreign[1])
+        {
+            printf ("%s: frames differ with protocol mask\n", irmp_protocol_names[protocol]);
+            differ++;
+        }
+
+        printf ("%-12s %6ld %8d %8ld %8ld %8ld %12.2f %12.2f\n", irmp_protocol_names[protocol], lines[protocol], entries, own[0], foreign[0], foreign[1],
+                lookups[0] ? (double) checks[0] / lookups[0] : 0.0, lookups[1] ? (double) checks[1] / lookups[1] : 0.0);
+    }
+
+    irmp_set_protocols (0, 0);
+    printf ("%d differences\n", differ);
+    return differ ? 1 : 0;
+}
+#endif // IRMP_USE_PROTOCOL_MASK == 1
+
+#if IRMP_DYNAMIC_PROTOCOLS > 0 && IRMP_USE_PROTOCOL_MASK == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * dynamic protocol: generates an IRMP_DYNAMIC_DESCRIPTOR from the 1st frame of every line, all lines should be scans of one remote.
+ * The bit coding is pulse distance if the pauses of the data bits have two lengths, else pulse width if the pulses have two lengths.
+ * Windows are the measured ranges plus 20 percent. Only frames with the most frequent number of bits are used. Address and command are
+ * the last 32 bits. Prints the descriptor and an Intel HEX record at the given EEPROM address, then decodes all lines as DYN1.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#define DYNAMIC_MAX_PULSES      128                                             // max. number of data pulses of a frame
+
+typedef struct
+{
+    int             lo;                                                         // shortest length
+    int             hi;                                                         // longest length
+} DYNAMIC_RANGE;
+
+static int
+dynamic_frame (BENCHMARK_LINE * l, int * start_pulse, int * start_pause, int * pulses, int * pauses)
+{
+    int             n = -1;                                                     // -1: start bit pulse, then data pulses
+    int             len = 0;
+    int             i = 0;
+
+    while (i < l->len && l->levels[i])                                          // skip darkness before 1st pulse
+    {
+        i++;
+    }
+
+    for ( ; i < l->len; i++)
+    {
+        len++;
+
+        if (i + 1 < l->len && l->levels[i + 1] == l->levels[i])
+        {
+            continue;
+        }
+
+        if (! l->levels[i])                                                     // end of pulse
+        {
+            if (n < 0)
+            {
+                *start_pulse = len;
+            }
+            else if (n < DYNAMIC_MAX_PULSES)
+            {
+                pulses[n] = len;
+            }
+            n++;
+        }
+        else if (len > IRMP_TIMEOUT_LEN || i + 1 == l->len)                     // end of frame
+        {
+            break;
+        }
+        else if (n == 0)
+        {
+            *start_pause = len;
+        }
+        else if (n <= DYNAMIC_MAX_PULSES)
+        {
+            pauses[n - 1] = len;
+        }
+        len = 0;
+    }
+    return n < DYNAMIC_MAX_PULSES ? n : DYNAMIC_MAX_PULSES;
+}
+
+static void
+dynamic_range (DYNAMIC_RANGE * r, int len)
+{
+    if (len < r->lo)
+    {
+        r->lo = len;
+    }
+    if (len > r->hi)
+    {
+        r->hi = len;
+    }
+}
 
-#if IRMP_SUPPORT_NUBERT_PROTOCOL == 1
-                // if NUBERT protocol and the code will be repeated within 50 ms, we will ignore every 2nd frame
-                if (irmp_param.protocol == IRMP_NUBERT_PROTOCOL && (repetition_frame_number & 0x01))
-                {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF ("code skipped: NUBERT auto repetition frame #%d, counter = %d, auto repetition len = %d\n",
-                                    repetition_frame_number + 1, key_repetition_len, AUTO_FRAME_REPETITION_LEN);
-#endif // ANALYZE
-                    key_repetition_len = 0;
-                }
-                else
-#endif
+static void
+dynamic_window (DYNAMIC_RANGE * r, uint8_t * min, uint8_t * max)
+{
+    int             lo = r->lo - (r->lo + 4) / 5;
+    int             hi = r->hi + (r->hi + 4) / 5;
 
-#if IRMP_SUPPORT_SPEAKER_PROTOCOL == 1
-                // if SPEAKER protocol and the code will be repeated within 50 ms, we will ignore every 2nd frame
-                if (irmp_param.protocol == IRMP_SPEAKER_PROTOCOL && (repetition_frame_number & 0x01))
-                {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF ("code skipped: SPEAKER auto repetition frame #%d, counter = %d, auto repetition len = %d\n",
-                                    repetition_frame_number + 1, key_repetition_len, AUTO_FRAME_REPETITION_LEN);
-#endif // ANALYZE
-                    key_repetition_len = 0;
-                }
-                else
-#endif
+    *min = lo < 1 ? 1 : lo;
+    *max = hi > 255 ? 255 : hi;
+}
 
-                {
-#ifdef ANALYZE
-                    ANALYZE_PRINTF ("%8.3fms code detected, length = %d\n", (double) (time_counter * 1000) / F_INTERRUPTS, irmp_bit);
-#endif // ANALYZE
-                    irmp_ir_detected = TRUE;
+static int
+dynamic_protocol_report (unsigned int address)
+{
+    static int          counts[DYNAMIC_MAX_PULSES + 1];
+    int                 pulses[DYNAMIC_MAX_PULSES];
+    int                 pauses[DYNAMIC_MAX_PULSES];
+    DYNAMIC_RANGE       start_pulse = { 255, 0 };
+    DYNAMIC_RANGE       start_pause = { 255, 0 };
+    DYNAMIC_RANGE       pulse = { 255, 0 };
+    DYNAMIC_RANGE       pause = { 255, 0 };
+    DYNAMIC_RANGE       r[2] = { { 255, 0 }, { 255, 0 } };                      // short and long lengths of the coding
+    IRMP_DYNAMIC_DESCRIPTOR d;
+    IRMP_DYNAMIC_DESCRIPTOR empty;
+    IRMP_DATA           first;
+    unsigned long       checksum;
+    uint8_t *           b = (uint8_t *) &d;
+    uint8_t             protocol = IRMP_DYNAMIC1_PROTOCOL;
+    int                 distance;
+    int                 threshold;
+    int                 frames = 0;
+    int                 decoded = 0;
+    int                 pulse_len;
+    int                 pause_len;
+    int                 n_pulses = 0;
+    int                 bits;
+    int                 sum;
+    int                 i;
+    int                 n;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        n = dynamic_frame (benchmark_lines + i, &pulse_len, &pause_len, pulses, pauses);
 
-#if IRMP_SUPPORT_DENON_PROTOCOL == 1
-                    if (irmp_param.protocol == IRMP_DENON_PROTOCOL)
-                    {                                                               // check for repetition frame
-                        if ((~irmp_tmp_command & 0x3FF) == last_irmp_denon_command) // command bits must be inverted
-                        {
-                            irmp_tmp_command = last_irmp_denon_command;             // use command received before!
-                            last_irmp_denon_command = 0;
+        if (n > 0)
+        {
+            counts[n]++;
+        }
+    }
 
-                            irmp_protocol = irmp_param.protocol;                    // store protocol
-                            irmp_address = irmp_tmp_address;                        // store address
-                            irmp_command = irmp_tmp_command;                        // store command
-                        }
-                        else
-                        {
-                            if ((irmp_tmp_command & 0x01) == 0x00)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("%8.3fms info Denon: waiting for inverted command repetition\n", (double) (time_counter * 1000) / F_INTERRUPTS);
-#endif // ANALYZE
-                                last_irmp_denon_command = irmp_tmp_command;
-                                denon_repetition_len = 0;
-                                irmp_ir_detected = FALSE;
-                            }
-                            else
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("%8.3fms warning Denon: got unexpected inverted command, ignoring it\n", (double) (time_counter * 1000) / F_INTERRUPTS);
-#endif // ANALYZE
-                                last_irmp_denon_command = 0;
-                                irmp_ir_detected = FALSE;
-                            }
-                        }
-                    }
-                    else
-#endif // IRMP_SUPPORT_DENON_PROTOCOL
+    for (n = 1; n <= DYNAMIC_MAX_PULSES; n++)
+    {
+        if (counts[n] > counts[n_pulses])
+        {
+            n_pulses = n;
+        }
+    }
 
-#if IRMP_SUPPORT_GRUNDIG_PROTOCOL == 1
-                    if (irmp_param.protocol == IRMP_GRUNDIG_PROTOCOL && irmp_tmp_command == 0x01ff)
-                    {                                                               // Grundig start frame?
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("Detected GRUNDIG start frame, ignoring it\n");
-#endif // ANALYZE
-                        irmp_ir_detected = FALSE;
-                    }
-                    else
-#endif // IRMP_SUPPORT_GRUNDIG_PROTOCOL
+    if (n_pulses < 2)
+    {
+        printf ("no frames found\n");
+        return 1;
+    }
 
-#if IRMP_SUPPORT_NOKIA_PROTOCOL == 1
-                    if (irmp_param.protocol == IRMP_NOKIA_PROTOCOL && irmp_tmp_address == 0x00ff && irmp_tmp_command == 0x00fe)
-                    {                                                               // Nokia start frame?
-#ifdef ANALYZE
-                        ANALYZE_PRINTF ("Detected NOKIA start frame, ignoring it\n");
-#endif // ANALYZE
-                        irmp_ir_detected = FALSE;
-                    }
-                    else
-#endif // IRMP_SUPPORT_NOKIA_PROTOCOL
-                    {
-#if IRMP_SUPPORT_NEC_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_NEC_PROTOCOL && irmp_bit == 0)  // repetition frame
-                        {
-                            if (key_repetition_len < NEC_FRAME_REPEAT_PAUSE_LEN_MAX)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Detected NEC repetition frame, key_repetition_len = %d\n", key_repetition_len);
-                                ANALYZE_ONLY_NORMAL_PRINTF("REPETETION FRAME                ");
-#endif // ANALYZE
-                                irmp_tmp_address = last_irmp_address;                   // address is last address
-                                irmp_tmp_command = last_irmp_command;                   // command is last command
-                                irmp_flags |= IRMP_FLAG_REPETITION;
-                                key_repetition_len = 0;
-                            }
-                            else
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("Detected NEC repetition frame, ignoring it: timeout occured, key_repetition_len = %d > %d\n",
-                                                key_repetition_len, NEC_FRAME_REPEAT_PAUSE_LEN_MAX);
-#endif // ANALYZE
-                                irmp_ir_detected = FALSE;
-                            }
-                        }
-#endif // IRMP_SUPPORT_NEC_PROTOCOL
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        if (dynamic_frame (benchmark_lines + i, &pulse_len, &pause_len, pulses, pauses) == n_pulses)
+        {
+            dynamic_range (&start_pulse, pulse_len);
+            dynamic_range (&start_pause, pause_len);
 
-#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_KASEIKYO_PROTOCOL)
-                        {
-                            uint_fast8_t xor_value;
+            for (n = 0; n < n_pulses; n++)
+            {
+                dynamic_range (&pulse, pulses[n]);
 
-                            xor_value = (xor_check[0] & 0x0F) ^ ((xor_check[0] & 0xF0) >> 4) ^ (xor_check[1] & 0x0F) ^ ((xor_check[1] & 0xF0) >> 4);
+                if (n < n_pulses - 1)                                           // pause after last pulse is not measured
+                {
+                    dynamic_range (&pause, pauses[n]);
+                }
+            }
+            frames++;
+        }
+    }
 
-                            if (xor_value != (xor_check[2] & 0x0F))
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("error 4: wrong XOR check for customer id: 0x%1x 0x%1x\n", xor_value, xor_check[2] & 0x0F);
-#endif // ANALYZE
-                                irmp_ir_detected = FALSE;
-                            }
+    if (2 * pause.hi >= 3 * pause.lo && 2 * pulse.hi < 3 * pulse.lo)
+    {
+        distance    = TRUE;
+        threshold   = (pause.lo + pause.hi) / 2;
+        bits        = n_pulses - 1;                                             // last pulse is stop bit
+    }
+    else if (2 * pulse.hi >= 3 * pulse.lo && 2 * pause.hi < 3 * pause.lo)
+    {
+        distance    = FALSE;
+        threshold   = (pulse.lo + pulse.hi) / 2;
+        bits        = n_pulses;
+    }
+    else
+    {
+        printf ("%d frames with %d pulses: neither pulse distance nor pulse width coding\n", frames, n_pulses);
+        return 1;
+    }
 
-                            xor_value = xor_check[2] ^ xor_check[3] ^ xor_check[4];
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        if (dynamic_frame (benchmark_lines + i, &pulse_len, &pause_len, pulses, pauses) == n_pulses)
+        {
+            for (n = 0; n < n_pulses - distance; n++)
+            {
+                int len = distance ? pauses[n] : pulses[n];
+                dynamic_range (r + (len > threshold), len);
+            }
+        }
+    }
 
-                            if (xor_value != xor_check[5])
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("error 5: wrong XOR check for data bits: 0x%02x 0x%02x\n", xor_value, xor_check[5]);
-#endif // ANALYZE
-                                irmp_ir_detected = FALSE;
-                            }
+    memset (&d, 0, sizeof (d));
+    d.interrupts = (F_INTERRUPTS + 50) / 100;
+    dynamic_window (&start_pulse, &d.start_pulse_len_min, &d.start_pulse_len_max);
+    dynamic_window (&start_pause, &d.start_pause_len_min, &d.start_pause_len_max);
 
-                            irmp_flags |= genre2;       // write the genre2 bits into MSB of the flag byte
-                        }
-#endif // IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+    if (distance)
+    {
+        dynamic_window (&pulse, &d.pulse_1_len_min, &d.pulse_1_len_max);
+        dynamic_window (&pulse, &d.pulse_0_len_min, &d.pulse_0_len_max);
+        dynamic_window (r + 0, &d.pause_0_len_min, &d.pause_0_len_max);
+        dynamic_window (r + 1, &d.pause_1_len_min, &d.pause_1_len_max);
 
-#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_ORTEK_PROTOCOL)
-                        {
-                            if (parity == PARITY_CHECK_FAILED)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("error 6: parity check failed\n");
-#endif // ANALYZE
-                                irmp_ir_detected = FALSE;
-                            }
+        if (d.pause_0_len_max >= d.pause_1_len_min)
+        {
+            d.pause_0_len_max = threshold;
+            d.pause_1_len_min = threshold + 1;
+        }
+    }
+    else
+    {
+        dynamic_window (&pause, &d.pause_1_len_min, &d.pause_1_len_max);
+        dynamic_window (&pause, &d.pause_0_len_min, &d.pause_0_len_max);
+        dynamic_window (r + 0, &d.pulse_0_len_min, &d.pulse_0_len_max);
+        dynamic_window (r + 1, &d.pulse_1_len_min, &d.pulse_1_len_max);
 
-                            if ((irmp_tmp_address & 0x03) == 0x02)
-                            {
-#ifdef ANALYZE
-                                ANALYZE_PRINTF ("code skipped: ORTEK end of transmission frame (key release)\n");
-#endif // ANALYZE
-                                irmp_ir_detected = FALSE;
-                            }
-                            irmp_tmp_address >>= 2;
-                        }
-#endif // IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+        if (d.pulse_0_len_max >= d.pulse_1_len_min)
+        {
+            d.pulse_0_len_max = threshold;
+            d.pulse_1_len_min = threshold + 1;
+        }
+    }
 
-#if IRMP_SUPPORT_RC6_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_RC6_PROTOCOL && irmp_param.complete_len == RC6_COMPLETE_DATA_LEN_LONG)     // RC6 mode = 6?
-                        {
-                            irmp_protocol = IRMP_RC6A_PROTOCOL;
-                        }
-                        else
-#endif // IRMP_SUPPORT_RC6_PROTOCOL == 1
-                        {
-                            irmp_protocol = irmp_param.protocol;
-                        }
+    d.complete_len      = bits;
+    d.command_end       = bits;
+    d.command_offset    = bits > 16 ? bits - 16 : 0;
+    d.address_end       = d.command_offset;
+    d.address_offset    = d.address_end > 16 ? d.address_end - 16 : 0;
+    d.stop_bit          = distance;
+    d.lsb_first         = 1;
+
+    printf ("%d lines, %d frames with %d bits, %s coding\n", benchmark_n_lines, frames, bits, distance ? "pulse distance" : "pulse width");
+    printf ("start bit pulse: %3d - %3d ticks, window %3d - %3d\n", start_pulse.lo, start_pulse.hi, d.start_pulse_len_min, d.start_pulse_len_max);
+    printf ("start bit pause: %3d - %3d ticks, window %3d - %3d\n", start_pause.lo, start_pause.hi, d.start_pause_len_min, d.start_pause_len_max);
+    printf ("bit 0 pulse:     window %3d - %3d, pause: window %3d - %3d\n", d.pulse_0_len_min, d.pulse_0_len_max, d.pause_0_len_min, d.pause_0_len_max);
+    printf ("bit 1 pulse:     window %3d - %3d, pause: window %3d - %3d\n", d.pulse_1_len_min, d.pulse_1_len_max, d.pause_1_len_min, d.pause_1_len_max);
+    printf ("address: bits %d - %d, command: bits %d - %d\n", d.address_offset, d.address_end, d.command_offset, d.command_end);
+
+    if (d.address_offset > 0)
+    {
+        printf ("warning: bits 0 - %d are not stored\n", d.address_offset);
+    }
 
-#if IRMP_SUPPORT_FDC_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_FDC_PROTOCOL)
-                        {
-                            if (irmp_tmp_command & 0x000F)                          // released key?
-                            {
-                                irmp_tmp_command = (irmp_tmp_command >> 4) | 0x80;  // yes, set bit 7
-                            }
-                            else
-                            {
-                                irmp_tmp_command >>= 4;                             // no, it's a pressed key
-                            }
-                            irmp_tmp_command |= (irmp_tmp_address << 2) & 0x0F00;   // 000000CCCCAAAAAA -> 0000CCCC00000000
-                            irmp_tmp_address &= 0x003F;
-                        }
-#endif
+    printf ("descriptor: {");
 
-                        irmp_address = irmp_tmp_address;                            // store address
-#if IRMP_SUPPORT_NEC_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_NEC_PROTOCOL)
-                        {
-                            last_irmp_address = irmp_tmp_address;                   // store as last address, too
-                        }
-#endif
+    for (i = 0; i < (int) sizeof (d); i++)
+    {
+        printf (i ? ", %d" : " %d", b[i]);
+    }
 
-#if IRMP_SUPPORT_RC5_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_RC5_PROTOCOL)
-                        {
-                            irmp_tmp_command |= rc5_cmd_bit6;                       // store bit 6
-                        }
-#endif
-#if IRMP_SUPPORT_S100_PROTOCOL == 1
-                        if (irmp_param.protocol == IRMP_S100_PROTOCOL)
-                        {
-                            irmp_tmp_command |= rc5_cmd_bit6;                       // store bit 6
-                        }
-#endif
-                        irmp_command = irmp_tmp_command;                            // store command
+    printf (" }\n");
 
-#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
-                        irmp_id = irmp_tmp_id;
-#endif
-                    }
-                }
+    sum = sizeof (d) + (address >> 8) + (address & 0xFF);                      // Intel HEX: data record, end of file record
+    printf (":%02X%04X00", (int) sizeof (d), address & 0xFFFF);
 
-                if (irmp_ir_detected)
-                {
-                    if (last_irmp_command == irmp_tmp_command &&
-                        last_irmp_address == irmp_tmp_address &&
-                        key_repetition_len < IRMP_KEY_REPETITION_LEN)
-                    {
-                        irmp_flags |= IRMP_FLAG_REPETITION;
-                    }
+    for (i = 0; i < (int) sizeof (d); i++)
+    {
+        printf ("%02X", b[i]);
+        sum += b[i];
+    }
 
-                    last_irmp_address = irmp_tmp_address;                           // store as last address, too
-                    last_irmp_command = irmp_tmp_command;                           // store as last command, too
+    printf ("%02X\n:00000001FF\n", (-sum) & 0xFF);
 
-                    key_repetition_len = 0;
-                }
-                else
-                {
-#ifdef ANALYZE
-                    ANALYZE_ONLY_NORMAL_PUTCHAR ('\n');
-#endif // ANALYZE
-                }
+    if (! irmp_set_dynamic_protocol (0, &d))
+    {
+        printf ("error: descriptor rejected by irmp_set_dynamic_protocol()\n");
+        return 1;
+    }
 
-                irmp_start_bit_detected = 0;                                        // and wait for next start bit
-                irmp_tmp_command        = 0;
-                irmp_pulse_time         = 0;
-                irmp_pause_time         = 0;
+    irmp_set_protocols (&protocol, 1);                                          // decode scans as DYN1 only
 
-#if IRMP_SUPPORT_JVC_PROTOCOL == 1
-                if (irmp_protocol == IRMP_JVC_PROTOCOL)                             // the stop bit of JVC frame is also start bit of next frame
-                {                                                                   // set pulse time here!
-                    irmp_pulse_time = ((uint_fast8_t)(F_INTERRUPTS * JVC_START_BIT_PULSE_TIME));
-                }
-#endif // IRMP_SUPPORT_JVC_PROTOCOL == 1
-            }
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        if (first_frame_line (benchmark_lines + i, &first, &checksum) >= 0 && first.protocol == IRMP_DYNAMIC1_PROTOCOL)
+        {
+            decoded++;
         }
     }
 
-#if defined(STELLARIS_ARM_CORTEX_M4)
-    // Clear the timer interrupt
-    TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
-#endif
+    memset (&empty, 0, sizeof (empty));
+    (void) irmp_set_dynamic_protocol (0, &empty);
+    irmp_set_protocols (0, 0);
 
-    return (irmp_ir_detected);
+    printf ("%d of %d lines decoded as %s\n", decoded, benchmark_n_lines, irmp_protocol_names[IRMP_DYNAMIC1_PROTOCOL]);
+    return decoded >= frames ? 0 : 1;
 }
+#endif // IRMP_DYNAMIC_PROTOCOLS > 0 && IRMP_USE_PROTOCOL_MASK == 1
 
-#ifdef ANALYZE
-
+#if IRMP_USE_HASH == 1 && IRMP_USE_PROTOCOL_MASK == 1
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
- * main functions - for Unix/Linux + Windows only!
- *
- * AVR: see main.c!
- *
- * Compile it under linux with:
- * cc irmp.c -o irmp
- *
- * usage: ./irmp [-v|-s|-a|-l] < file
- *
- * options:
- *   -v verbose
- *   -s silent
- *   -a analyze
- *   -l list pulse/pauses
+ * hash fallback: decode every line once with all protocols and once with only IRMP_HASH_PROTOCOL enabled, so all frames are hashed.
+ * The 1st frame decoded with all protocols is the key of a line, lines without key are skipped. Reports per protocol of the key:
+ *   - repeatability: frames of a line with the hash of its 1st frame, lines with the hash of the 1st line of the same key
+ *   - collisions: keys with the hash of an earlier, different key
  *---------------------------------------------------------------------------------------------------------------------------------------------------
  */
-
-void
-print_spectrum (char * text, int * buf, int is_pulse)
+typedef struct
 {
-    int     i;
-    int     j;
-    int     min;
-    int     max;
-    int     max_value = 0;
-    int     value;
-    int     sum = 0;
-    int     counter = 0;
-    double  average = 0;
-    double  tolerance;
+    long            lines;                                                      // lines with key of protocol
+    long            unhashed;                                                   // lines without hash
+    long            frames;                                                     // hashed frames
+    long            repeats;                                                    // hashed frames after the 1st of a line
+    long            repeats_same;                                               // repeats with the hash of the 1st frame
+    long            keys;                                                       // different keys
+    long            presses;                                                    // lines with a key of an earlier line
+    long            presses_same;                                               // presses with the hash of the 1st line of the key
+    long            collisions;                                                 // keys with the hash of an earlier key
+} HASH_STAT;
+
+static int
+hash_line (BENCHMARK_LINE * l, unsigned long * hash, HASH_STAT * s)
+{
+    IRMP_DATA       d;
+    unsigned long   h;
+    int             frames = 0;
+    int             i;
 
-    puts ("-----------------------------------------------------------------------------");
-    printf ("%s:\n", text);
+    analyze_reset ();
 
-    for (i = 0; i < 256; i++)
+    for (i = 0; i < l->len + F_INTERRUPTS; i++)                                 // line, followed by one second of darkness
     {
-        if (buf[i] > max_value)
+        IRMP_PIN = (i >= l->len || l->levels[i]) ? 0xff : 0x00;
+
+        if (irmp_ISR () && irmp_get_data (&d) && d.protocol == IRMP_HASH_PROTOCOL)
         {
-            max_value = buf[i];
+            h = ((unsigned long) d.address << 16) | d.command;
+
+            if (! frames)
+            {
+                *hash = h;
+            }
+            else
+            {
+                s->repeats++;
+
+                if (h == *hash)
+                {
+                    s->repeats_same++;
+                }
+            }
+            frames++;
         }
     }
+    s->frames += frames;
+    return frames;
+}
 
-    for (i = 1; i < 200; i++)
+static int
+hash_report (void)
+{
+    static HASH_STAT        stat[IRMP_N_PROTOCOLS + 1];
+    static IRMP_DATA        keys[BENCHMARK_MAX_LINES];                          // 1st frame with all protocols, protocol 0: none
+    static unsigned long    hashes[BENCHMARK_MAX_LINES];                        // hash of 1st frame with hash only
+    static int              hashed[BENCHMARK_MAX_LINES];                        // number of hashed frames
+    unsigned long           checksum;
+    uint8_t                 protocol = IRMP_HASH_PROTOCOL;
+    long                    failed = 0;
+    int                     i;
+    int                     j;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+    irmp_set_protocols (0, 0);
+
+    for (i = 0; i < benchmark_n_lines; i++)
     {
-        if (buf[i] > 0)
+        if (first_frame_line (benchmark_lines + i, keys + i, &checksum) < 0 || keys[i].protocol == IRMP_HASH_PROTOCOL)
         {
-            printf ("%3d ", i);
-            value = (buf[i] * 60) / max_value;
+            keys[i].protocol = 0;
+        }
+    }
 
-            for (j = 0; j < value; j++)
-            {
-                putchar ('o');
-            }
-            printf (" %d\n", buf[i]);
+    irmp_set_protocols (&protocol, 1);                                          // no start bit: every burst is hashed
 
-            sum += i * buf[i];
-            counter += buf[i];
-        }
-        else
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        if (keys[i].protocol)
         {
-            max = i - 1;
+            hashed[i] = hash_line (benchmark_lines + i, hashes + i, &stat[keys[i].protocol]);
+        }
+    }
 
-            if (counter > 0)
-            {
-                average = (float) sum / (float) counter;
+    irmp_set_protocols (0, 0);
 
-                if (is_pulse)
-                {
-                    printf ("pulse ");
-                }
-                else
-                {
-                    printf ("pause ");
-                }
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        HASH_STAT * s = &stat[keys[i].protocol];
 
-                printf ("avg: %4.1f=%6.1f us, ", average, (1000000. * average) / (float) F_INTERRUPTS);
-                printf ("min: %2d=%6.1f us, ", min, (1000000. * min) / (float) F_INTERRUPTS);
-                printf ("max: %2d=%6.1f us, ", max, (1000000. * max) / (float) F_INTERRUPTS);
+        if (! keys[i].protocol)
+        {
+            continue;
+        }
 
-                tolerance = (max - average);
+        s->lines++;
 
-                if (average - min > tolerance)
-                {
-                    tolerance = average - min;
-                }
+        if (! hashed[i])
+        {
+            s->unhashed++;
+            continue;
+        }
 
-                tolerance = tolerance * 100 / average;
-                printf ("tol: %4.1f%%\n", tolerance);
+        for (j = 0; j < i; j++)                                                 // 1st line of key
+        {
+            if (hashed[j] && keys[j].protocol == keys[i].protocol && keys[j].address == keys[i].address && keys[j].command == keys[i].command)
+            {
+                break;
             }
+        }
 
-            counter = 0;
-            sum = 0;
-            min = i + 1;
+        if (j < i)
+        {
+            s->presses++;
+
+            if (hashes[j] == hashes[i])
+            {
+                s->presses_same++;
+            }
+            else
+            {
+                printf ("line %d: hash 0x%08lx differs from hash 0x%08lx of line %d, same key\n", i + 1, hashes[i], hashes[j], j + 1);
+                failed++;
+            }
+            continue;
+        }
+
+        s->keys++;
+
+        for (j = 0; j < i; j++)                                                 // earlier lines have other keys
+        {
+            if (hashed[j] && hashes[j] == hashes[i])
+            {
+                printf ("line %d: hash 0x%08lx collides with line %d, other key\n", i + 1, hashes[i], j + 1);
+                s->collisions++;
+                failed++;
+                break;
+            }
         }
     }
-}
 
-#define STATE_LEFT_SHIFT    0x01
-#define STATE_RIGHT_SHIFT   0x02
-#define STATE_LEFT_CTRL     0x04
-#define STATE_LEFT_ALT      0x08
-#define STATE_RIGHT_ALT     0x10
+    printf ("%d lines, frames hashed with all protocols disabled, the 1st frame with all protocols is the key of a line\n", benchmark_n_lines);
+    printf ("%-12s %6s %8s %8s %12s %6s %12s %10s\n", "protocol", "lines", "unhashed", "frames", "repeats", "keys", "presses", "collisions");
 
-#define KEY_ESCAPE          0x1B            // keycode = 0x006e
-#define KEY_MENUE           0x80            // keycode = 0x0070
-#define KEY_BACK            0x81            // keycode = 0x0071
-#define KEY_FORWARD         0x82            // keycode = 0x0072
-#define KEY_ADDRESS         0x83            // keycode = 0x0073
-#define KEY_WINDOW          0x84            // keycode = 0x0074
-#define KEY_1ST_PAGE        0x85            // keycode = 0x0075
-#define KEY_STOP            0x86            // keycode = 0x0076
-#define KEY_MAIL            0x87            // keycode = 0x0077
-#define KEY_FAVORITES       0x88            // keycode = 0x0078
-#define KEY_NEW_PAGE        0x89            // keycode = 0x0079
-#define KEY_SETUP           0x8A            // keycode = 0x007a
-#define KEY_FONT            0x8B            // keycode = 0x007b
-#define KEY_PRINT           0x8C            // keycode = 0x007c
-#define KEY_ON_OFF          0x8E            // keycode = 0x007c
+    for (i = 1; i <= IRMP_N_PROTOCOLS; i++)
+    {
+        HASH_STAT * s = &stat[i];
 
-#define KEY_INSERT          0x90            // keycode = 0x004b
-#define KEY_DELETE          0x91            // keycode = 0x004c
-#define KEY_LEFT            0x92            // keycode = 0x004f
-#define KEY_HOME            0x93            // keycode = 0x0050
-#define KEY_END             0x94            // keycode = 0x0051
-#define KEY_UP              0x95            // keycode = 0x0053
-#define KEY_DOWN            0x96            // keycode = 0x0054
-#define KEY_PAGE_UP         0x97            // keycode = 0x0055
-#define KEY_PAGE_DOWN       0x98            // keycode = 0x0056
-#define KEY_RIGHT           0x99            // keycode = 0x0059
-#define KEY_MOUSE_1         0x9E            // keycode = 0x0400
-#define KEY_MOUSE_2         0x9F            // keycode = 0x0800
+        if (s->lines)
+        {
+            printf ("%-12s %6ld %8ld %8ld %5ld / %4ld %6ld %5ld / %4ld %10ld\n", irmp_protocol_names[i], s->lines, s->unhashed, s->frames,
+                    s->repeats_same, s->repeats, s->keys, s->presses_same, s->presses, s->collisions);
+        }
+    }
 
-static uint_fast8_t
-get_fdc_key (uint_fast16_t cmd)
+    return failed ? 1 : 0;
+}
+#endif // IRMP_USE_HASH == 1 && IRMP_USE_PROTOCOL_MASK == 1
+
+#if IRMP_USE_QUALITY == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * signal quality: decode every line, reports per protocol the range of the deviations of pulses and pauses from the middle of their
+ * windows and the smallest and average margin to the window limits of the frames with data bits, all in ticks
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct
 {
-    static uint8_t key_table[128] =
-    {
-     // 0    1    2    3    4    5    6    7    8    9    A    B    C    D    E    F
-        0,  '^', '1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '�', '�',  0,  '\b',
-       '\t','q', 'w', 'e', 'r', 't', 'z', 'u', 'i', 'o', 'p', '�', '+',  0,   0,  'a',
-       's', 'd', 'f', 'g', 'h', 'j', 'k', 'l', '�', '�', '#',  '\r', 0,  '<', 'y', 'x',
-       'c', 'v', 'b', 'n', 'm', ',', '.', '-',  0,   0,   0,   0,   0,  ' ',  0,   0,
+    long            frames;                                                     // frames with data bits
+    int             pulse_min;                                                  // min. deviation of pulses
+    int             pulse_max;                                                  // max. deviation of pulses
+    int             pause_min;                                                  // min. deviation of pauses
+    int             pause_max;                                                  // max. deviation of pauses
+    int             margin_min;                                                 // min. margin
+    long            margin;                                                     // sum of margins
+} QUALITY_STAT;
+
+static int
+quality_report (void)
+{
+    static QUALITY_STAT stat[IRMP_N_PROTOCOLS + 1];
+    IRMP_DATA_EX        d;
+    long                frames = 0;
+    int                 i;
+    int                 j;
 
-        0,  '�', '!', '"', '�', '$', '%', '&', '/', '(', ')', '=', '?', '`',  0,  '\b',
-       '\t','Q', 'W', 'E', 'R', 'T', 'Z', 'U', 'I', 'O', 'P', '�', '*',  0,   0,  'A',
-       'S', 'D', 'F', 'G', 'H', 'J', 'K', 'L', '�', '�', '\'','\r', 0,  '>', 'Y', 'X',
-       'C', 'V', 'B', 'N', 'M', ';', ':', '_',  0,   0,   0,   0,   0,  ' ',  0,   0
-    };
-    static uint_fast8_t state;
+    silent  = TRUE;
+    verbose = FALSE;
 
-    uint_fast8_t key = 0;
+    benchmark_read_lines ();
 
-    switch (cmd)
+    for (i = 0; i < benchmark_n_lines; i++)
     {
-        case 0x002C: state |=  STATE_LEFT_SHIFT;    break;              // pressed left shift
-        case 0x00AC: state &= ~STATE_LEFT_SHIFT;    break;              // released left shift
-        case 0x0039: state |=  STATE_RIGHT_SHIFT;   break;              // pressed right shift
-        case 0x00B9: state &= ~STATE_RIGHT_SHIFT;   break;              // released right shift
-        case 0x003A: state |=  STATE_LEFT_CTRL;     break;              // pressed left ctrl
-        case 0x00BA: state &= ~STATE_LEFT_CTRL;     break;              // released left ctrl
-        case 0x003C: state |=  STATE_LEFT_ALT;      break;              // pressed left alt
-        case 0x00BC: state &= ~STATE_LEFT_ALT;      break;              // released left alt
-        case 0x003E: state |=  STATE_RIGHT_ALT;     break;              // pressed left alt
-        case 0x00BE: state &= ~STATE_RIGHT_ALT;     break;              // released left alt
+        BENCHMARK_LINE * l = benchmark_lines + i;
 
-        case 0x006e: key = KEY_ESCAPE;              break;
-        case 0x004b: key = KEY_INSERT;              break;
-        case 0x004c: key = KEY_DELETE;              break;
-        case 0x004f: key = KEY_LEFT;                break;
-        case 0x0050: key = KEY_HOME;                break;
-        case 0x0051: key = KEY_END;                 break;
-        case 0x0053: key = KEY_UP;                  break;
-        case 0x0054: key = KEY_DOWN;                break;
-        case 0x0055: key = KEY_PAGE_UP;             break;
-        case 0x0056: key = KEY_PAGE_DOWN;           break;
-        case 0x0059: key = KEY_RIGHT;               break;
-        case 0x0400: key = KEY_MOUSE_1;             break;
-        case 0x0800: key = KEY_MOUSE_2;             break;
+        analyze_reset ();
 
-        default:
+        for (j = 0; j < l->len + F_INTERRUPTS; j++)                             // line, followed by one second of darkness
         {
-            if (!(cmd & 0x80))                      // pressed key
+            IRMP_PIN = (j >= l->len || l->levels[j]) ? 0xff : 0x00;
+
+            if (irmp_ISR () && irmp_get_data_ex (&d))
             {
-                if (cmd >= 0x70 && cmd <= 0x7F)     // function keys
+                QUALITY_STAT * s = &stat[d.data.protocol];
+
+                frames++;
+
+                if (d.quality.margin == 0xFF)                                   // no data bits, e.g. NEC repetition frame
                 {
-                    key = cmd + 0x10;               // 7x -> 8x
+                    continue;
                 }
-                else if (cmd < 64)                  // key listed in key_table
+
+                if (! s->frames)
                 {
-                    if (state & (STATE_LEFT_ALT | STATE_RIGHT_ALT))
-                    {
-                        switch (cmd)
-                        {
-                            case 0x0003: key = '�';     break;
-                            case 0x0008: key = '{';     break;
-                            case 0x0009: key = '[';     break;
-                            case 0x000A: key = ']';     break;
-                            case 0x000B: key = '}';     break;
-                            case 0x000C: key = '\\';    break;
-                            case 0x001C: key = '~';     break;
-                            case 0x002D: key = '|';     break;
-                            case 0x0034: key = 0xB5;    break; // Mu
-                        }
-                    }
-                    else if (state & (STATE_LEFT_CTRL))
-                    {
-                        if (key_table[cmd] >= 'a' && key_table[cmd] <= 'z')
-                        {
-                            key = key_table[cmd] - 'a' + 1;
-                        }
-                        else
-                        {
-                            key = key_table[cmd];
-                        }
-                    }
-                    else
-                    {
-                        int idx = cmd + ((state & (STATE_LEFT_SHIFT | STATE_RIGHT_SHIFT)) ? 64 : 0);
+                    s->pulse_min    = s->pause_min  = 127;
+                    s->pulse_max    = s->pause_max  = -128;
+                    s->margin_min   = 0xFF;
+                }
 
-                        if (key_table[idx])
-                        {
-                            key = key_table[idx];
-                        }
-                    }
+                s->frames++;
+                s->margin += d.quality.margin;
+
+                if (s->pulse_min > d.quality.pulse_min)
+                {
+                    s->pulse_min = d.quality.pulse_min;
+                }
+                if (s->pulse_max < d.quality.pulse_max)
+                {
+                    s->pulse_max = d.quality.pulse_max;
+                }
+                if (s->pause_min > d.quality.pause_min)
+                {
+                    s->pause_min = d.quality.pause_min;
+                }
+                if (s->pause_max < d.quality.pause_max)
+                {
+                    s->pause_max = d.quality.pause_max;
+                }
+                if (s->margin_min > d.quality.margin)
+                {
+                    s->margin_min = d.quality.margin;
                 }
             }
-            break;
         }
     }
 
-    return (key);
-}
+    printf ("%d lines, %ld frames, deviation from middle of window and margin to window limits of data bits in ticks\n", benchmark_n_lines, frames);
+    printf ("%-12s %8s %12s %12s %10s %10s\n", "protocol", "frames", "pulse", "pause", "margin", "avg margin");
 
-static int         analyze = FALSE;
-static int         list = FALSE;
-static IRMP_DATA   irmp_data;
-static int         expected_protocol;
-static int         expected_address;
-static int         expected_command;
-static int         do_check_expected_values;
+    for (i = 0; i <= IRMP_N_PROTOCOLS; i++)
+    {
+        QUALITY_STAT * s = &stat[i];
 
-static void
-next_tick (void)
+        if (s->frames)
+        {
+            printf ("%-12s %8ld %5d ... %2d %5d ... %2d %10d %10.1f\n", irmp_protocol_names[i], s->frames,
+                    s->pulse_min, s->pulse_max, s->pause_min, s->pause_max, s->margin_min, (double) s->margin / s->frames);
+        }
+    }
+
+    return 0;
+}
+#endif // IRMP_USE_QUALITY == 1
+
+#if IRMP_LEARNED_WINDOWS > 0
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * learned windows: for every protocol, the 1st frame with data bits of its 1st line is learned in slot 0, see irmp_set_learned_windows().
+ * All lines are decoded with the original and with the learned windows. Reports the learned start bit windows, the frames of the learned
+ * remote (protocol and address), the frames of other remotes (without HASH) and the accepted start bits. Frames of the learned remote
+ * must not change.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static int
+learned_frame_line (BENCHMARK_LINE * l, IRMP_DATA_EX * learned)
 {
-    if (! analyze && ! list)
+    IRMP_DATA_EX    d;
+    int             found = FALSE;
+    int             i;
+
+    analyze_reset ();
+
+    for (i = 0; i < l->len + F_INTERRUPTS; i++)                                 // line, followed by one second of darkness
     {
-        (void) irmp_ISR ();
+        IRMP_PIN = (i >= l->len || l->levels[i]) ? 0xff : 0x00;
 
-        if (irmp_get_data (&irmp_data))
+        if (irmp_ISR () && irmp_get_data_ex (&d) && ! found && d.quality.margin != 0xFF && d.quality.start_bit)
         {
-            uint_fast8_t key;
+            *learned    = d;
+            found       = TRUE;
+        }
+    }
+    return found;
+}
 
-            ANALYZE_ONLY_NORMAL_PUTCHAR (' ');
+static void
+learned_line (BENCHMARK_LINE * l, IRMP_DATA * remote, long * own, long * foreign, unsigned long * checksum)
+{
+    IRMP_DATA       d;
+    uint_fast8_t    p;
+    int             frames = 0;
+    int             i;
 
-            if (verbose)
+    analyze_reset ();
+
+    for (i = 0; i < l->len + F_INTERRUPTS; i++)                                 // line, followed by one second of darkness
+    {
+        IRMP_PIN = (i >= l->len || l->levels[i]) ? 0xff : 0x00;
+
+        if (irmp_ISR () && irmp_get_data (&d))
+        {
+            if (d.protocol == remote->protocol && d.address == remote->address)
             {
-                printf ("%8.3fms ", (double) (time_counter * 1000) / F_INTERRUPTS);
+                benchmark_frame (&d, &frames, &p, checksum);
+            }
+            else if (d.protocol != IRMP_HASH_PROTOCOL)
+            {
+                (*foreign)++;
             }
+        }
+    }
+    *own += frames;
+}
 
-            if (irmp_data.protocol == IRMP_ACP24_PROTOCOL)
+static int
+learned_windows_report (void)
+{
+    static long         lines[IRMP_N_PROTOCOLS + 1];
+    static IRMP_DATA_EX learned[IRMP_N_PROTOCOLS + 1];
+    IRMP_DATA_EX        d;
+    IRMP_START_BIT      original;
+    IRMP_START_BIT      narrowed;
+    long                own[2];
+    long                foreign[2];
+    unsigned long       checksum[2];
+    int                 found[2];
+    uint_fast8_t        protocol;
+    int                 differ = 0;
+    int                 mode;
+    int                 i;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        if (learned_frame_line (benchmark_lines + i, &d))
+        {
+            if (! lines[d.data.protocol])
             {
-                uint16_t    temp = (irmp_data.command & 0x000F) + 15;
+                learned[d.data.protocol] = d;
+            }
+            lines[d.data.protocol]++;
+        }
+    }
 
-                printf ("p=%2d (%s), a=0x%04x, c=0x%04x, f=0x%02x, temp=%d",
-                        irmp_data.protocol, irmp_protocol_names[irmp_data.protocol], irmp_data.address, irmp_data.command, irmp_data.flags, temp);
+    printf ("%d lines, learned windows of start bit pulse and pause in ticks, original windows in brackets\n", benchmark_n_lines);
+    printf ("%-12s %6s %-32s %8s %8s %8s %8s %8s\n", "protocol", "lines", "start bit", "frames", "foreign", "learned", "starts", "learned");
+
+    for (protocol = 1; protocol <= IRMP_N_PROTOCOLS; protocol++)
+    {
+        if (! lines[protocol])
+        {
+            continue;
+        }
+
+        for (mode = 0; mode < 2; mode++)
+        {
+            if (! irmp_set_learned_windows (0, mode ? &learned[protocol].quality : 0) && mode)
+            {
+                printf ("%s: quality of learned frame rejected\n", irmp_protocol_names[protocol]);
+                differ++;
             }
-            else if (irmp_data.protocol == IRMP_FDC_PROTOCOL && (key = get_fdc_key (irmp_data.command)) != 0)
+
+            own[mode]       = 0;
+            foreign[mode]   = 0;
+            checksum[mode]  = 0;
+            found[mode]     = start_bit_table_found;
+
+            for (i = 0; i < benchmark_n_lines; i++)
             {
-                if ((key >= 0x20 && key < 0x7F) || key >= 0xA0)
-                {
-                    printf ("p=%2d (%s), a=0x%04x, c=0x%04x, f=0x%02x, asc=0x%02x, key='%c'",
-                            irmp_data.protocol,  irmp_protocol_names[irmp_data.protocol], irmp_data.address, irmp_data.command, irmp_data.flags, key, key);
-                }
-                else if (key == '\r' || key == '\t' || key == KEY_ESCAPE || (key >= 0x80 && key <= 0x9F))                 // function keys
-                {
-                    char * p = (char *) NULL;
+                learned_line (benchmark_lines + i, &learned[protocol].data, own + mode, foreign + mode, checksum + mode);
+            }
 
-                    switch (key)
-                    {
-                        case '\t'                : p = "TAB";           break;
-                        case '\r'                : p = "CR";            break;
-                        case KEY_ESCAPE          : p = "ESCAPE";        break;
-                        case KEY_MENUE           : p = "MENUE";         break;
-                        case KEY_BACK            : p = "BACK";          break;
-                        case KEY_FORWARD         : p = "FORWARD";       break;
-                        case KEY_ADDRESS         : p = "ADDRESS";       break;
-                        case KEY_WINDOW          : p = "WINDOW";        break;
-                        case KEY_1ST_PAGE        : p = "1ST_PAGE";      break;
-                        case KEY_STOP            : p = "STOP";          break;
-                        case KEY_MAIL            : p = "MAIL";          break;
-                        case KEY_FAVORITES       : p = "FAVORITES";     break;
-                        case KEY_NEW_PAGE        : p = "NEW_PAGE";      break;
-                        case KEY_SETUP           : p = "SETUP";         break;
-                        case KEY_FONT            : p = "FONT";          break;
-                        case KEY_PRINT           : p = "PRINT";         break;
-                        case KEY_ON_OFF          : p = "ON_OFF";        break;
+            found[mode]     = start_bit_table_found - found[mode];
+        }
 
-                        case KEY_INSERT          : p = "INSERT";        break;
-                        case KEY_DELETE          : p = "DELETE";        break;
-                        case KEY_LEFT            : p = "LEFT";          break;
-                        case KEY_HOME            : p = "HOME";          break;
-                        case KEY_END             : p = "END";           break;
-                        case KEY_UP              : p = "UP";            break;
-                        case KEY_DOWN            : p = "DOWN";          break;
-                        case KEY_PAGE_UP         : p = "PAGE_UP";       break;
-                        case KEY_PAGE_DOWN       : p = "PAGE_DOWN";     break;
-                        case KEY_RIGHT           : p = "RIGHT";         break;
-                        case KEY_MOUSE_1         : p = "KEY_MOUSE_1";   break;
-                        case KEY_MOUSE_2         : p = "KEY_MOUSE_2";   break;
-                        default                  : p = "<UNKNWON>";     break;
-                    }
+        IRMP_START_BIT_ENTRY_GET (original, learned[protocol].quality.start_bit - 1);
+        IRMP_START_BIT_GET (narrowed, learned[protocol].quality.start_bit - 1);
+        (void) irmp_set_learned_windows (0, 0);
 
-                    printf ("p=%2d (%s), a=0x%04x, c=0x%04x, f=0x%02x, asc=0x%02x, key=%s",
-                            irmp_data.protocol, irmp_protocol_names[irmp_data.protocol], irmp_data.address, irmp_data.command, irmp_data.flags, key, p);
-                }
-                else
-                {
-                    printf ("p=%2d (%s), a=0x%04x, c=0x%04x, f=0x%02x, asc=0x%02x",
-                            irmp_data.protocol,  irmp_protocol_names[irmp_data.protocol], irmp_data.address, irmp_data.command, irmp_data.flags, key);
-                }
-            }
-            else
+        if (own[0] != own[1] || checksum[0] != checksum[1])
+        {
+            printf ("%s: frames of learned remote differ with learned windows\n", irmp_protocol_names[protocol]);
+            differ++;
+        }
+
+        printf ("%-12s %6ld %3d-%-3d (%3d-%-3d) %4d-%-4d (%4d-%-4d) %8ld %8ld %8ld %8d %8d\n", irmp_protocol_names[protocol], lines[protocol],
+                narrowed.pulse_min, narrowed.pulse_max, original.pulse_min, original.pulse_max,
+                (int) narrowed.pause_min, (int) narrowed.pause_max, (int) original.pause_min, (int) original.pause_max,
+                own[0], foreign[0], foreign[1], found[0], found[1]);
+    }
+
+    printf ("%d differences\n", differ);
+    return differ ? 1 : 0;
+}
+#endif // IRMP_LEARNED_WINDOWS > 0
+
+#if IRMP_CANDIDATES > 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * candidates: decode every line
+ *   - without candidates and with up to IRMP_CANDIDATES - 1 candidates: reports frames per protocol and lines decoded differently
+ *   - BENCHMARK_LOOPS times with k = 0 ... IRMP_CANDIDATES - 1 copies of the decoded protocol as candidates, which live as long as
+ *     the frame: reports cpu time per tick against the number of live candidates, frames must not change
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+static int
+candidates_report (void)
+{
+    static long         frames[2][IRMP_N_PROTOCOLS + 1];
+    clock_t             cpu[IRMP_CANDIDATES];
+    unsigned long       checksums[IRMP_CANDIDATES];
+    unsigned long       checksum;
+    clock_t             line_cpu;
+    long                interrupts;
+    long                ticks = 0;
+    long                switches;
+    uint_fast8_t        protocol;
+    int                 n;
+    int                 changed = 0;
+    int                 differ = 0;
+    int                 mode;
+    int                 loop;
+    int                 k;
+    int                 i;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    benchmark_read_lines ();
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        BENCHMARK_LINE * l = benchmark_lines + i;
+
+        for (mode = 0; mode < 2; mode++)
+        {
+            candidates_limit = mode ? IRMP_CANDIDATES - 1 : 0;
+            analyze_reset ();
+            n = benchmark_line (0, l, &interrupts, &line_cpu, &protocol, checksums + mode);
+            frames[mode][protocol] += n;
+        }
+
+        if (checksums[0] != checksums[1])
+        {
+            printf ("line %d: decoded frames differ with candidates\n", i + 1);
+            changed++;
+        }
+    }
+
+    switches            = candidates_switches;
+    candidates_limit    = 0;                                                    // forced candidates only
+
+    for (k = 0; k < IRMP_CANDIDATES; k++)
+    {
+        cpu[k] = 0;
+    }
+
+    for (i = 0; i < benchmark_n_lines; i++)
+    {
+        BENCHMARK_LINE * l = benchmark_lines + i;
+
+        for (k = 0; k < IRMP_CANDIDATES; k++)
+        {
+            candidates_forced = k;
+
+            for (loop = 0; loop < BENCHMARK_LOOPS; loop++)
             {
-                printf ("p=%2d (%s), a=0x%04x, c=0x%04x, f=0x%02x",
-                        irmp_data.protocol, irmp_protocol_names[irmp_data.protocol], irmp_data.address, irmp_data.command, irmp_data.flags);
+                analyze_reset ();
+                (void) benchmark_line (0, l, &interrupts, &line_cpu, &protocol, &checksum);
+                cpu[k] += line_cpu;
             }
 
-            if (do_check_expected_values)
+            if (k == 0)
             {
-                if (irmp_data.protocol != expected_protocol ||
-                    irmp_data.address  != expected_address  ||
-                    irmp_data.command  != expected_command)
-                {
-                    printf ("\nerror 7: expected values differ: p=%2d (%s), a=0x%04x, c=0x%04x\n",
-                            expected_protocol, irmp_protocol_names[expected_protocol], expected_address, expected_command);
-                }
-                else
-                {
-                    printf (" checked!\n");
-                }
-                do_check_expected_values = FALSE;                           // only check 1st frame in a line!
+                checksums[0] = checksum;
             }
-            else
+            else if (checksum != checksums[0])
             {
-                putchar ('\n');
+                printf ("line %d: decoded frames differ with %d forced candidates\n", i + 1, k);
+                differ++;
+            }
+        }
+        ticks += l->len;
+    }
+
+    candidates_forced   = 0;
+    candidates_limit    = IRMP_CANDIDATES - 1;
+
+    printf ("%d lines, %d decoded differently with candidates, %ld switches to a candidate\n", benchmark_n_lines, changed, switches);
+    printf ("%-12s %12s %12s\n", "protocol", "frames", "candidates");
+
+    for (i = 0; i <= IRMP_N_PROTOCOLS; i++)
+    {
+        if (frames[0][i] || frames[1][i])
+        {
+            printf ("%-12s %12ld %12ld\n", irmp_protocol_names[i], frames[0][i], frames[1][i]);
+        }
+    }
+
+    printf ("%d loops, %d differences\n", BENCHMARK_LOOPS, differ);
+    printf ("%-12s %12s\n", "candidates", "ns/tick");
+
+    for (k = 0; k < IRMP_CANDIDATES; k++)
+    {
+        printf ("%-12d %12.1f\n", k, (double) cpu[k] * 1e9 / CLOCKS_PER_SEC / BENCHMARK_LOOPS / ticks);
+    }
+
+    return differ ? 1 : 0;
+}
+#endif // IRMP_CANDIDATES > 1
+
+#if IRMP_USE_START_BIT_TABLE == 1
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * test start bit table: feed all combinations of start bit pulse and pause, irmp_ISR() checks table against classification
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#if IRMP_SUPPORT_NIKON_PROTOCOL == 1
+#  define TEST_TIMEOUT_LEN      ((int) IRMP_TIMEOUT_NIKON_LEN)                  // max. pause after a start bit
+#else
+#  define TEST_TIMEOUT_LEN      ((int) IRMP_TIMEOUT_LEN)
+#endif
+
+static void
+test_feed (uint_fast8_t input, int len)
+{
+    int i;
+
+    IRMP_PIN = input;
+
+    for (i = 0; i < len; i++)
+    {
+        if (irmp_ISR ())
+        {
+            (void) irmp_get_data (&irmp_data);
+        }
+    }
+}
+
+static int
+test_start_bit_table (void)
+{
+#if IRMP_USE_CONTEXT == 1
+    IRMP_CONTEXT *  ctx = &irmp_context;                                        // irmp_protocol of irmp_ISR()
+#endif
+    int             after_jvc;
+    int             pulse;
+    int             pause;
+
+    silent  = TRUE;
+    verbose = FALSE;
+
+    for (after_jvc = 0; after_jvc <= IRMP_SUPPORT_JVC_PROTOCOL; after_jvc++)
+    {
+        for (pulse = 1; pulse < 256; pulse++)
+        {
+            for (pause = 1; pause <= TEST_TIMEOUT_LEN; pause++)
+            {
+                irmp_protocol = after_jvc ? IRMP_JVC_PROTOCOL : 0;
+                test_feed (0x00, pulse);
+                test_feed (0xff, pause);
+                test_feed (0x00, 1);                                            // 1st data pulse: start bit is classified
+                test_feed (0xff, 2 * TEST_TIMEOUT_LEN);                         // timeout, wait for next start bit
             }
         }
     }
+
+    printf ("start bit table: %d entries, %d start bits checked, %d errors\n", (int) IRMP_START_BITS, start_bit_table_lookups, start_bit_table_errors);
+    return start_bit_table_errors ? 1 : 0;
 }
+#endif // IRMP_USE_START_BIT_TABLE == 1
 
 int
 main (int argc, char ** argv)
@@ -5219,7 +10455,13 @@ main (int argc, char ** argv)
     int         first_pulse = TRUE;
     int         first_pause = TRUE;
 
-    if (argc == 2)
+    memcpy (&irmp_context_initial, (void *) &irmp_context, sizeof (IRMP_CONTEXT));
+
+#if IRMP_USE_START_BIT_TABLE == 1
+    irmp_start_bit_init ();
+#endif
+
+    if (argc >= 2)
     {
         if (! strcmp (argv[1], "-v"))
         {
@@ -5237,10 +10479,103 @@ main (int argc, char ** argv)
         {
             silent = TRUE;
         }
+#if IRMP_TRACE_LEN > 0
+        else if (! strcmp (argv[1], "-x"))
+        {
+            silent  = TRUE;
+            trace   = TRUE;
+        }
+#endif
         else if (! strcmp (argv[1], "-r"))
         {
             radio = TRUE;
         }
+        else if (! strcmp (argv[1], "-b"))
+        {
+            return benchmark ();
+        }
+#if IRMP_CHANNEL_MASK != 0x00
+        else if (! strcmp (argv[1], "-m"))
+        {
+            return multi_context ();
+        }
+#endif
+#if IRMP_EARLY_MATCH_LEN > 0
+        else if (! strcmp (argv[1], "-e"))
+        {
+            return early_match_report ();
+        }
+#endif
+#if IRMP_ADDRESS_FILTER_LEN > 0
+        else if (! strcmp (argv[1], "-f"))
+        {
+            return address_filter_report ();
+        }
+#endif
+        else if (! strcmp (argv[1], "-d"))
+        {
+            return latency_report ();
+        }
+#if IRMP_GLITCH_FILTER_LEN > 0
+        else if (! strcmp (argv[1], "-g"))
+        {
+            return glitch_report ();
+        }
+#endif
+#if IRMP_IDLE_DIVIDER > 0
+        else if (! strcmp (argv[1], "-i"))
+        {
+            return idle_report ();
+        }
+#endif
+#if IRMP_USE_COUNTERS == 1
+        else if (! strcmp (argv[1], "-n"))
+        {
+            return counters_report ();
+        }
+#endif
+#if IRMP_USE_QUALITY == 1
+        else if (! strcmp (argv[1], "-q"))
+        {
+            return quality_report ();
+        }
+#endif
+#if IRMP_LEARNED_WINDOWS > 0
+        else if (! strcmp (argv[1], "-w"))
+        {
+            return learned_windows_report ();
+        }
+#endif
+#if IRMP_USE_PROTOCOL_MASK == 1
+        else if (! strcmp (argv[1], "-p"))
+        {
+            return protocol_mask_report ();
+        }
+#endif
+#if IRMP_DYNAMIC_PROTOCOLS > 0 && IRMP_USE_PROTOCOL_MASK == 1
+        else if (! strcmp (argv[1], "-y"))
+        {
+            return dynamic_protocol_report (argc > 2 ? strtoul (argv[2], (char **) 0, 0) : 0);
+        }
+#endif
+#if IRMP_USE_HASH == 1 && IRMP_USE_PROTOCOL_MASK == 1
+        else if (! strcmp (argv[1], "-u"))
+        {
+            return hash_report ();
+        }
+#endif
+#if IRMP_CANDIDATES > 1
+        else if (! strcmp (argv[1], "-c"))
+        {
+            return candidates_report ();
+        }
+#endif
+#if IRMP_USE_START_BIT_TABLE == 1
+        else if (! strcmp (argv[1], "-t"))
+        {
+            return test_start_bit_table ();
+        }
+#endif
     }
 
     for (i = 0; i < 256; i++)
@@ -226,9 +226,480 @@
 #error F_INTERRUPTS too high (should be not greater than 20000)
 #endif
 
+#if IRMP_USE_EDGE_ISR == 1 && IRMP_LOGGING == 1
+#  warning IRMP_LOGGING needs polling, IRMP_LOGGING disabled
+#  undef IRMP_LOGGING
+#  define IRMP_LOGGING                          0
+#endif
+
+#if IRMP_USE_CONTEXT == 1 && IRMP_LOGGING == 1
+#  warning IRMP_LOGGING does not work with IRMP_USE_CONTEXT, IRMP_LOGGING disabled
+#  undef IRMP_LOGGING
+#  define IRMP_LOGGING                          0
+#endif
+
+#if IRMP_IDLE_DIVIDER > 0 && IRMP_LOGGING == 1
+#  warning IRMP_LOGGING needs polling at full rate, IRMP_LOGGING disabled
+#  undef IRMP_LOGGING
+#  define IRMP_LOGGING                          0
+#endif
+
+#if IRMP_IDLE_DIVIDER > 32 || (IRMP_IDLE_DIVIDER & (IRMP_IDLE_DIVIDER - 1)) != 0 || IRMP_IDLE_DIVIDER == 1
+#  error IRMP_IDLE_DIVIDER must be 0 or a power of 2, 2 ... 32
+#endif
+
+#if IRMP_IDLE_DIVIDER > 0                                                   // first pulse of a frame must last IRMP_IDLE_DIVIDER ticks
+#  define IRMP_IDLE_PULSE_TOO_SHORT(usec)       ((usec) * F_INTERRUPTS < IRMP_IDLE_DIVIDER * 1000000L)
+#  if IRMP_IDLE_PULSE_TOO_SHORT(158) && (IRMP_SUPPORT_RECS80_PROTOCOL == 1 || IRMP_SUPPORT_RECS80EXT_PROTOCOL == 1 || IRMP_SUPPORT_LEGO_PROTOCOL == 1)
+#    error IRMP_IDLE_DIVIDER too high for the 158 usec start pulse of RECS80, RECS80EXT and LEGO
+#  endif
+#  if IRMP_IDLE_PULSE_TOO_SHORT(200) && IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
+#    error IRMP_IDLE_DIVIDER too high for the 200 usec start pulse of BANG_OLUFSEN
+#  endif
+#  if IRMP_IDLE_PULSE_TOO_SHORT(210) && (IRMP_SUPPORT_KATHREIN_PROTOCOL == 1 || IRMP_SUPPORT_MERLIN_PROTOCOL == 1)
+#    error IRMP_IDLE_DIVIDER too high for the 210 usec start pulse of KATHREIN and MERLIN
+#  endif
+#  if IRMP_IDLE_PULSE_TOO_SHORT(300) && IRMP_SUPPORT_A1TVBOX_PROTOCOL == 1
+#    error IRMP_IDLE_DIVIDER too high for the 300 usec start pulse of A1TVBOX
+#  endif
+#  if IRMP_IDLE_PULSE_TOO_SHORT(310) && IRMP_SUPPORT_DENON_PROTOCOL == 1
+#    error IRMP_IDLE_DIVIDER too high for the 310 usec first pulse of DENON
+#  endif
+#  if IRMP_IDLE_PULSE_TOO_SHORT(370) && (IRMP_SUPPORT_SIEMENS_PROTOCOL == 1 || IRMP_SUPPORT_RUWIDO_PROTOCOL == 1)
+#    error IRMP_IDLE_DIVIDER too high for the 370 usec start pulse of SIEMENS and RUWIDO
+#  endif
+#  if IRMP_IDLE_PULSE_TOO_SHORT(390) && IRMP_SUPPORT_ACP24_PROTOCOL == 1
+#    error IRMP_IDLE_DIVIDER too high for the 390 usec start pulse of ACP24
+#  endif
+#  if IRMP_IDLE_PULSE_TOO_SHORT(440) && IRMP_SUPPORT_SPEAKER_PROTOCOL == 1
+#    error IRMP_IDLE_DIVIDER too high for the 440 usec start pulse of SPEAKER
+#  endif
+#  if IRMP_IDLE_PULSE_TOO_SHORT(500) && IRMP_SUPPORT_RCMM_PROTOCOL == 1
+#    error IRMP_IDLE_DIVIDER too high for the 500 usec start pulse of RCMM
+#  endif
+#  if IRMP_IDLE_PULSE_TOO_SHORT(528) && (IRMP_SUPPORT_GRUNDIG_PROTOCOL == 1 || IRMP_SUPPORT_NOKIA_PROTOCOL == 1 || IRMP_SUPPORT_IR60_PROTOCOL == 1)
+#    error IRMP_IDLE_DIVIDER too high for the 528 usec first pulse of GRUNDIG, NOKIA and IR60
+#  endif
+#  if IRMP_IDLE_PULSE_TOO_SHORT(550) && IRMP_SUPPORT_THOMSON_PROTOCOL == 1
+#    error IRMP_IDLE_DIVIDER too high for the 550 usec first pulse of THOMSON
+#  endif
+#endif
+
+#if IRMP_QUEUE_LEN > 128 || (IRMP_QUEUE_LEN & (IRMP_QUEUE_LEN - 1)) != 0
+#  error IRMP_QUEUE_LEN must be 0 or a power of 2, not greater than 128
+#endif
+
+#if IRMP_CHANNEL_MASK != 0x00 && (IRMP_USE_CONTEXT == 0 || IRMP_USE_EDGE_ISR == 0)
+#  error IRMP_CHANNEL_MASK needs IRMP_USE_CONTEXT and IRMP_USE_EDGE_ISR
+#endif
+
+#if IRMP_CANDIDATES < 1 || IRMP_CANDIDATES > 8
+#  error IRMP_CANDIDATES must be 1 ... 8
+#endif
+
+#if IRMP_CANDIDATES > 1 && IRMP_USE_START_BIT_TABLE == 0
+#  error IRMP_CANDIDATES needs IRMP_USE_START_BIT_TABLE
+#endif
+
+#if IRMP_EARLY_MATCH_LEN > 0 && IRMP_QUEUE_LEN == 0
+#  error IRMP_EARLY_MATCH_LEN needs IRMP_QUEUE_LEN > 0
+#endif
+
+#if IRMP_TRACE_LEN > 128 || (IRMP_TRACE_LEN & (IRMP_TRACE_LEN - 1)) != 0
+#  error IRMP_TRACE_LEN must be 0 or a power of 2, not greater than 128
+#endif
+
+#if IRMP_TRACE_LEN > 0 && IRMP_USE_TIMESTAMP == 0
+#  error IRMP_TRACE_LEN needs IRMP_USE_TIMESTAMP
+#endif
+
+#if IRMP_TRACE_DETAIL == 1 && IRMP_TRACE_LEN == 0
+#  error IRMP_TRACE_DETAIL needs IRMP_TRACE_LEN
+#endif
+
+#if IRMP_EARLY_ABORT_NEC42 == 1 && IRMP_EARLY_ABORT == 0
+#  error IRMP_EARLY_ABORT_NEC42 needs IRMP_EARLY_ABORT
+#endif
+
+#if IRMP_USE_PROTOCOL_MASK == 1 && IRMP_USE_START_BIT_TABLE == 0
+#  error IRMP_USE_PROTOCOL_MASK needs IRMP_USE_START_BIT_TABLE
+#endif
+
+#if IRMP_DYNAMIC_PROTOCOLS > 2
+#  error IRMP_DYNAMIC_PROTOCOLS must be 0, 1 or 2
+#endif
+
+#if IRMP_DYNAMIC_PROTOCOLS > 0 && IRMP_USE_START_BIT_TABLE == 0
+#  error IRMP_DYNAMIC_PROTOCOLS needs IRMP_USE_START_BIT_TABLE
+#endif
+
+#if IRMP_LEARNED_WINDOWS > 2
+#  error IRMP_LEARNED_WINDOWS must be 0, 1 or 2
+#endif
+
+#if IRMP_LEARNED_WINDOWS > 0 && (IRMP_USE_START_BIT_TABLE == 0 || IRMP_USE_QUALITY == 0)
+#  error IRMP_LEARNED_WINDOWS needs IRMP_USE_START_BIT_TABLE and IRMP_USE_QUALITY
+#endif
+
 #include "irmpprotocols.h"
 
 #define IRMP_FLAG_REPETITION            0x01
+#define IRMP_FLAG_AUTO_REPETITION       0x02                                // auto repetition frame, see IRMP_SIRCS_LOW_LATENCY
+#define IRMP_FLAG_RELEASE               0x04                                // key released, see IRMP_USE_KEY_RELEASE
+
+#if IRMP_USE_EDGE_ISR == 1
+#  if IRMP_SUPPORT_NIKON_PROTOCOL == 1
+#    define IRMP_EDGE_TIMEOUT_LEN       ((uint_fast16_t)(F_INTERRUPTS * IRMP_TIMEOUT_NIKON_TIME + 0.5))  // max. ticks between two calls of irmp_ISR_edge()
+#  else
+#    define IRMP_EDGE_TIMEOUT_LEN       ((uint_fast16_t)(F_INTERRUPTS * IRMP_TIMEOUT_TIME + 0.5))        // max. ticks between two calls of irmp_ISR_edge()
+#  endif
+#endif
+
+#define IRMP_CHANNELS                   (((IRMP_CHANNEL_MASK >> 0) & 1) + ((IRMP_CHANNEL_MASK >> 1) & 1) + ((IRMP_CHANNEL_MASK >> 2) & 1) + \
+                                         ((IRMP_CHANNEL_MASK >> 3) & 1) + ((IRMP_CHANNEL_MASK >> 4) & 1) + ((IRMP_CHANNEL_MASK >> 5) & 1) + \
+                                         ((IRMP_CHANNEL_MASK >> 6) & 1) + ((IRMP_CHANNEL_MASK >> 7) & 1))     // number of IR inputs
+
+#if IRMP_SUPPORT_GRUNDIG_PROTOCOL == 1 || IRMP_SUPPORT_NOKIA_PROTOCOL == 1 || IRMP_SUPPORT_IR60_PROTOCOL == 1
+#  define IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL  1
+#else
+#  define IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL  0
+#endif
+
+#if IRMP_SUPPORT_SIEMENS_PROTOCOL == 1 || IRMP_SUPPORT_RUWIDO_PROTOCOL == 1
+#  define IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL   1
+#else
+#  define IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL   0
+#endif
+
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 ||                   \
+    IRMP_SUPPORT_S100_PROTOCOL == 1 ||                  \
+    IRMP_SUPPORT_RC6_PROTOCOL == 1 ||                   \
+    IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1 ||    \
+    IRMP_SUPPORT_SIEMENS_OR_RUWIDO_PROTOCOL == 1 ||     \
+    IRMP_SUPPORT_IR60_PROTOCOL == 1 ||                  \
+    IRMP_SUPPORT_A1TVBOX_PROTOCOL == 1 ||               \
+    IRMP_SUPPORT_MERLIN_PROTOCOL == 1 ||                \
+    IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+#  define IRMP_SUPPORT_MANCHESTER                   1
+#else
+#  define IRMP_SUPPORT_MANCHESTER                   0
+#endif
+
+#if IRMP_SUPPORT_NETBOX_PROTOCOL == 1
+#  define IRMP_SUPPORT_SERIAL                       1
+#else
+#  define IRMP_SUPPORT_SERIAL                       0
+#endif
+
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1 ||              \
+    IRMP_SUPPORT_RCCAR_PROTOCOL == 1 ||                 \
+    IRMP_SUPPORT_ACP24_PROTOCOL == 1
+#  define IRMP_SUPPORT_BIT_REMAP                    1
+#else
+#  define IRMP_SUPPORT_BIT_REMAP                    0
+#endif
+
+typedef struct
+{
+    uint_fast8_t    protocol;                                                // ir protocol
+    uint_fast8_t    pulse_1_len_min;                                         // minimum length of pulse with bit value 1
+    uint_fast8_t    pulse_1_len_max;                                         // maximum length of pulse with bit value 1
+    uint_fast8_t    pause_1_len_min;                                         // minimum length of pause with bit value 1
+    uint_fast8_t    pause_1_len_max;                                         // maximum length of pause with bit value 1
+    uint_fast8_t    pulse_0_len_min;                                         // minimum length of pulse with bit value 0
+    uint_fast8_t    pulse_0_len_max;                                         // maximum length of pulse with bit value 0
+    uint_fast8_t    pause_0_len_min;                                         // minimum length of pause with bit value 0
+    uint_fast8_t    pause_0_len_max;                                         // maximum length of pause with bit value 0
+    uint_fast8_t    address_offset;                                          // address offset
+    uint_fast8_t    address_end;                                             // end of address
+    uint_fast8_t    command_offset;                                          // command offset
+    uint_fast8_t    command_end;                                             // end of command
+    uint_fast8_t    complete_len;                                            // complete length of frame
+    uint_fast8_t    stop_bit;                                                // flag: frame has stop bit
+    uint_fast8_t    lsb_first;                                               // flag: LSB first
+    uint_fast8_t    flags;                                                   // some flags
+} IRMP_PARAMETER;
+
+#if IRMP_DYNAMIC_PROTOCOLS > 0
+typedef struct
+{
+    uint8_t                 interrupts;                                     // F_INTERRUPTS / 100 the lengths below are measured with
+    uint8_t                 start_pulse_len_min;                            // minimum length of start bit pulse
+    uint8_t                 start_pulse_len_max;                            // maximum length of start bit pulse
+    uint8_t                 start_pause_len_min;                            // minimum length of start bit pause
+    uint8_t                 start_pause_len_max;                            // maximum length of start bit pause
+    uint8_t                 pulse_1_len_min;                                // minimum length of pulse with bit value 1
+    uint8_t                 pulse_1_len_max;                                // maximum length of pulse with bit value 1
+    uint8_t                 pause_1_len_min;                                // minimum length of pause with bit value 1
+    uint8_t                 pause_1_len_max;                                // maximum length of pause with bit value 1
+    uint8_t                 pulse_0_len_min;                                // minimum length of pulse with bit value 0
+    uint8_t                 pulse_0_len_max;                                // maximum length of pulse with bit value 0
+    uint8_t                 pause_0_len_min;                                // minimum length of pause with bit value 0
+    uint8_t                 pause_0_len_max;                                // maximum length of pause with bit value 0
+    uint8_t                 address_offset;                                 // address offset
+    uint8_t                 address_end;                                    // end of address
+    uint8_t                 command_offset;                                 // command offset
+    uint8_t                 command_end;                                    // end of command
+    uint8_t                 complete_len;                                   // complete length of frame
+    uint8_t                 stop_bit;                                       // flag: frame has stop bit
+    uint8_t                 lsb_first;                                      // flag: LSB first
+} IRMP_DYNAMIC_DESCRIPTOR;                                                  // all lengths in ticks, see irmp_set_dynamic_protocol()
+#endif
+
+#if IRMP_CANDIDATES > 1
+#define IRMP_CANDIDATE_BITS             64                                  // max. number of bits stored by a candidate
+
+typedef struct
+{
+    IRMP_PARAMETER          param;                                          // protocol parameters
+    uint8_t                 len;                                            // number of received bits
+    uint8_t                 bits[IRMP_CANDIDATE_BITS / 8];                  // received bits, 1st bit is bit 0 of bits[0]
+} IRMP_CANDIDATE;
+#endif
+
+#if IRMP_TRACE_LEN > 0 || defined (ANALYZE)
+#define IRMP_TRACE_START_BIT            1                                   // arg: pulse, value: pause of start bit in ticks
+#define IRMP_TRACE_PROTOCOL             2                                   // arg: protocol fitting the start bit
+#define IRMP_TRACE_ERROR                3                                   // arg: error number, see IRMP_COUNTERS, value: pause or XOR values
+#define IRMP_TRACE_FRAME                4                                   // arg: protocol, value: number of bits
+#define IRMP_TRACE_DROPPED              5                                   // arg: protocol, frame lost, queue was full
+#define IRMP_TRACE_PULSE                16                                  // 1st pulse of a frame begins, see IRMP_TRACE_DETAIL
+#define IRMP_TRACE_BIT_TIMING           17                                  // value: pause of data bit, see bit and pulse
+#define IRMP_TRACE_BIT                  18                                  // arg: stored value '0', '1', 'S', 'T', '?' or 0, value: 1: bit done
+
+#define IRMP_TRACE_ERROR_MANCHESTER     0x10                                // upper nibble of arg of IRMP_TRACE_ERROR 3: check which failed
+#define IRMP_TRACE_ERROR_SAMSUNG        0x20
+#define IRMP_TRACE_ERROR_BANG_OLUFSEN(n) (0x30 + ((n) << 4))                // n = 0 ... 3: 1st ... 4th check of BANG_OLUFSEN
+
+typedef struct
+{
+    uint16_t                ticks;                                          // low 16 bits of irmp_get_ticks()
+    uint8_t                 event;                                          // event, e.g. IRMP_TRACE_ERROR
+    uint8_t                 arg;                                            // 1st value, see event
+    uint16_t                value;                                          // 2nd value, see event
+    uint8_t                 bit;                                            // irmp_bit at the event: number of received data bits
+    uint8_t                 pulse;                                          // irmp_pulse_time at the event
+} IRMP_TRACE_ENTRY;
+#endif
+
+#if IRMP_USE_QUALITY == 1
+#define IRMP_QUALITY_PULSE_1            0                                   // data bit windows, see IRMP_QUALITY.window_min
+#define IRMP_QUALITY_PAUSE_1            1
+#define IRMP_QUALITY_PULSE_0            2
+#define IRMP_QUALITY_PAUSE_0            3
+#define IRMP_QUALITY_WINDOWS            4
+
+typedef struct
+{
+    int8_t                  pulse_min;                                      // min. deviation of pulse lengths from middle of window in ticks
+    int8_t                  pulse_max;                                      // max. deviation of pulse lengths from middle of window in ticks
+    int8_t                  pause_min;                                      // min. deviation of pause lengths from middle of window in ticks
+    int8_t                  pause_max;                                      // max. deviation of pause lengths from middle of window in ticks
+    uint8_t                 margin;                                         // min. distance of a length to its window limits, 0xFF: no data bit
+#if IRMP_LEARNED_WINDOWS > 0
+    uint8_t                 start_bit;                                      // start bit table entry + 1, 0: none or learned, see irmp_set_learned_windows()
+    uint8_t                 start_protocol;                                 // protocol of the entry, e.g. NEC42 for NEC frames
+    uint8_t                 start_pulse;                                    // length of start bit pulse in ticks
+    PAUSE_LEN               start_pause;                                    // length of start bit pause in ticks
+    int8_t                  window_min[IRMP_QUALITY_WINDOWS];               // min. deviation per data bit window, e.g. IRMP_QUALITY_PAUSE_1
+    int8_t                  window_max[IRMP_QUALITY_WINDOWS];               // max. deviation per data bit window
+#endif
+} IRMP_QUALITY;
+#endif
+
+#if IRMP_USE_COUNTERS == 1
+typedef struct
+{
+    uint16_t                frames;                                         // frames returned by irmp_get_data() or queued, incl. release events
+    uint16_t                dropped;                                        // frames lost, queue was full
+    uint16_t                check;                                          // frames rejected by irmp_get_data(), e.g. NEC command not inverted
+    uint16_t                start_pause;                                    // error 1: pause after start bit too long
+    uint16_t                data_pause;                                     // error 2: pause after data bit too long
+    uint16_t                timing;                                         // error 3: pulse or pause of data bit outside windows
+    uint16_t                xor_address;                                    // error 4: wrong XOR check of KASEIKYO customer id
+    uint16_t                xor_data;                                       // error 5: wrong XOR check of KASEIKYO data bits
+    uint16_t                ortek_parity;                                   // error 6: ORTEK parity check failed
+    uint16_t                technics;                                       // error 8: TECHNICS frame error
+    uint16_t                disabled;                                       // frames of protocols disabled by irmp_set_protocols()
+} IRMP_COUNTERS;
+#endif
+
+#if IRMP_USE_TIMESTAMP == 1 || IRMP_USE_RAW_FRAME == 1 || IRMP_USE_KEY_RELEASE == 1 || IRMP_USE_QUALITY == 1
+typedef struct
+{
+    IRMP_DATA               data;                                           // decoded frame
+#  if IRMP_USE_TIMESTAMP == 1
+    uint32_t                ticks;                                          // irmp_get_ticks() at end of frame
+#  endif
+#  if IRMP_USE_RAW_FRAME == 1
+    uint64_t                raw;                                            // received bits, last bit is bit 0
+    uint8_t                 raw_len;                                        // number of received bits, raw holds the last 64
+#  endif
+#  if IRMP_USE_KEY_RELEASE == 1
+    uint8_t                 hold;                                           // number of repetition frames of the key so far, saturates at 255
+#  endif
+#  if IRMP_USE_QUALITY == 1
+    IRMP_QUALITY            quality;                                        // timing of the data bits
+#  endif
+} IRMP_DATA_EX;
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * decoder state of one IR receiver, see irmp_init_ctx()
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct
+{
+    uint_fast8_t            irmp_bit;                                       // current bit position
+    IRMP_PARAMETER          irmp_param;
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)
+    IRMP_PARAMETER          irmp_param2;
+#endif
+
+    volatile uint_fast8_t   irmp_ir_detected;
+    volatile uint_fast8_t   irmp_protocol;
+    volatile uint_fast16_t  irmp_address;
+    volatile uint_fast16_t  irmp_command;
+    volatile uint_fast16_t  irmp_id;                                        // only used for SAMSUNG protocol
+    volatile uint_fast8_t   irmp_flags;
+
+    uint_fast16_t           irmp_tmp_address;                               // ir address
+    uint_fast16_t           irmp_tmp_command;                               // ir command
+#if (IRMP_SUPPORT_RC5_PROTOCOL == 1 && (IRMP_SUPPORT_FDC_PROTOCOL == 1 || IRMP_SUPPORT_RCCAR_PROTOCOL == 1)) || IRMP_SUPPORT_NEC42_PROTOCOL == 1
+    uint_fast16_t           irmp_tmp_address2;                              // ir address
+    uint_fast16_t           irmp_tmp_command2;                              // ir command
+#endif
+#if IRMP_SUPPORT_LGAIR_PROTOCOL == 1
+    uint_fast16_t           irmp_lgair_address;                             // ir address
+    uint_fast16_t           irmp_lgair_command;                             // ir command
+#endif
+#if IRMP_SUPPORT_SAMSUNG_PROTOCOL == 1
+    uint_fast16_t           irmp_tmp_id;                                    // ir id (only SAMSUNG)
+#endif
+#if IRMP_SUPPORT_KASEIKYO_PROTOCOL == 1
+    uint8_t                 irmp_xor_check[6];                              // check kaseikyo "parity" bits
+    uint_fast8_t            irmp_genre2;                                    // save genre2 bits here, later copied to MSB in flags
+#endif
+#if IRMP_SUPPORT_ORTEK_PROTOCOL == 1
+    uint_fast8_t            irmp_parity;                                    // number of '1' of the first 14 bits, check if even.
+#endif
+#if IRMP_SUPPORT_GRUNDIG_NOKIA_IR60_PROTOCOL == 1
+    uint_fast8_t            irmp_first_bit;
+#endif
+
+    uint_fast8_t            irmp_start_bit_detected;                        // flag: start bit detected
+    uint_fast8_t            irmp_pulse_time;                                // count bit time for pulse
+    uint_fast16_t           irmp_repetition_ticks;                          // SIRCS repeats frame 2-5 times with 45 ms pause
+#if IRMP_SUPPORT_DENON_PROTOCOL == 1
+    uint_fast16_t           last_irmp_denon_command;                        // save last irmp command to recognize DENON frame repetition
+    uint_fast16_t           irmp_denon_repetition_len;                      // denon repetition len of 2nd auto generated frame
+#endif
+    uint_fast8_t            irmp_wait_for_space;                            // flag: wait for data bit space
+    uint_fast8_t            irmp_wait_for_start_space;                      // flag: wait for start bit space
+    PAUSE_LEN               irmp_pause_time;                                // count bit time for pause
+    uint_fast16_t           last_irmp_address;                              // save last irmp address to recognize key repetition
+    uint_fast16_t           last_irmp_command;                              // save last irmp command to recognize key repetition
+    uint_fast8_t            irmp_repetition_frame_number;
+#if IRMP_SUPPORT_RC5_PROTOCOL == 1 || IRMP_SUPPORT_S100_PROTOCOL == 1
+    uint_fast8_t            irmp_rc5_cmd_bit6;                              // bit 6 of RC5 command is the inverted 2nd start bit
+#endif
+#if IRMP_SUPPORT_MANCHESTER == 1
+    PAUSE_LEN               irmp_last_pause;                                // last pause value
+#endif
+#if IRMP_SUPPORT_MANCHESTER == 1 || IRMP_SUPPORT_BANG_OLUFSEN_PROTOCOL == 1
+    uint_fast8_t            irmp_last_value;                                // last bit value
+#endif
+
+#if IRMP_USE_RAW_FRAME == 1
+    uint64_t                irmp_tmp_raw;                                   // received bits, last bit is bit 0
+    uint_fast8_t            irmp_tmp_raw_len;                               // number of received bits
+    uint_fast8_t            irmp_raw_pending;                               // flag: address and command not yet extracted, see irmp_raw_extract()
+#endif
+
+#if IRMP_EARLY_ABORT == 1 && (IRMP_SUPPORT_NEC_PROTOCOL == 1 || (IRMP_SUPPORT_NEC42_PROTOCOL == 1 && IRMP_EARLY_ABORT_NEC42 == 1))
+    uint_fast8_t            irmp_check_failed;                              // NEC/NEC42 inverted bits which did not fit, see irmp_check_bit()
+#endif
+
+#if IRMP_CANDIDATES > 1
+    IRMP_CANDIDATE          irmp_candidate[IRMP_CANDIDATES - 1];            // other protocols fitting the start bit, see irmp_candidate_bit()
+    uint_fast8_t            irmp_candidate_count;                           // number of candidates still fitting
+#endif
+
+#if IRMP_USE_KEY_RELEASE == 1
+    uint_fast8_t            irmp_key_protocol;                              // protocol of key held down, 0: released, see irmp_key_release()
+    uint_fast16_t           irmp_key_address;                               // address of key held down
+    uint_fast16_t           irmp_key_command;                               // command of key held down
+    uint_fast8_t            irmp_key_hold;                                  // number of repetition frames of key held down
+#endif
+
+#if IRMP_USE_QUALITY == 1
+    IRMP_QUALITY            irmp_tmp_quality;                               // timing of the data bits received so far, see irmp_quality_bit()
+#endif
+
+#if IRMP_USE_COUNTERS == 1
+    volatile IRMP_COUNTERS  irmp_counters;                                  // frames and decode errors, see IRMP_COUNT()
+#endif
+
+#if IRMP_TRACE_LEN > 0
+    volatile IRMP_TRACE_ENTRY irmp_trace_buf[IRMP_TRACE_LEN];               // trace events, see irmp_trace()
+    volatile uint8_t        irmp_trace_write;                               // number of events put, only changed by irmp_ISR()
+    volatile uint8_t        irmp_trace_read;                                // number of events got, only changed by irmp_get_trace()
+#endif
+
+#if IRMP_USE_HASH == 1
+    uint32_t                irmp_hash;                                      // hash of the pulses and pauses of the burst, see irmp_hash_sample()
+    uint16_t                irmp_hash_len;                                  // length of current pulse or pause
+    uint16_t                irmp_hash_last[2];                              // length of last pulse and last pause
+    uint8_t                 irmp_hash_light;                                // TRUE: current level is a pulse
+    uint8_t                 irmp_hash_count;                                // pulses and pauses of the burst so far, 0: no burst
+    uint8_t                 irmp_hash_decoded;                              // a frame was decoded during the burst
+#endif
+
+#if IRMP_EARLY_MATCH_LEN > 0
+    uint_fast8_t            irmp_early_protocol;                            // protocol of frame reported by irmp_early_match(), 0: none
+#endif
+
+#if IRMP_GLITCH_FILTER_LEN > 0
+    uint_fast8_t            irmp_filter_light;                              // filtered input level, TRUE: pulse, see irmp_glitch_filter()
+    uint_fast8_t            irmp_filter_count;                              // samples since input level differs from filtered level
+#endif
+
+#if IRMP_USE_EDGE_ISR == 1
+    uint_fast8_t            irmp_last_input;                                // input level before last call of irmp_ISR_edge()
+    uint_fast8_t            irmp_ticks_ahead;                               // 1st sample of irmp_last_input already processed
+#endif
+#if IRMP_USE_CALLBACK == 1
+    uint_fast8_t            irmp_last_inverted_input;
+#endif
+
+#if IRMP_QUEUE_LEN > 0
+    volatile IRMP_DATA      irmp_queue[IRMP_QUEUE_LEN];                     // detected frames, see irmp_queue_put()
+    volatile uint8_t        irmp_queue_write;                               // number of frames put, only changed by irmp_ISR()
+    volatile uint8_t        irmp_queue_read;                                // number of frames got, only changed by irmp_get_data()
+    volatile uint_fast16_t  irmp_queue_overflows;                           // number of frames lost, queue was full
+#endif
+
+#if IRMP_USE_TIMESTAMP == 1
+    volatile uint32_t       irmp_ticks;                                     // free-running tick counter
+    uint32_t                irmp_frame_ticks;                               // irmp_ticks at end of detected frame
+#  if IRMP_QUEUE_LEN > 0
+    volatile uint32_t       irmp_queue_ticks[IRMP_QUEUE_LEN];               // irmp_frame_ticks of queued frames
+#  endif
+#endif
+
+#if IRMP_USE_RAW_FRAME == 1 && IRMP_QUEUE_LEN > 0
+    volatile uint64_t       irmp_queue_raw[IRMP_QUEUE_LEN];                 // irmp_tmp_raw of queued frames
+    volatile uint8_t        irmp_queue_raw_len[IRMP_QUEUE_LEN];             // irmp_tmp_raw_len of queued frames
+#endif
+
+#if IRMP_USE_KEY_RELEASE == 1 && IRMP_QUEUE_LEN > 0
+    volatile uint8_t        irmp_queue_hold[IRMP_QUEUE_LEN];                // irmp_key_hold of queued frames
+#endif
+
+#if IRMP_USE_QUALITY == 1 && IRMP_QUEUE_LEN > 0
+    IRMP_QUALITY            irmp_queue_quality[IRMP_QUEUE_LEN];             // irmp_tmp_quality of queued frames
+#endif
+} IRMP_CONTEXT;
 
 #ifdef __cplusplus
 extern "C"
@@ -238,6 +709,91 @@ extern "C"
 extern void                             irmp_init (void);
 extern uint_fast8_t                     irmp_get_data (IRMP_DATA *);
 extern uint_fast8_t                     irmp_ISR (void);
+#if IRMP_IDLE_DIVIDER > 0
+extern uint_fast8_t                     irmp_ISR_idle (void);
+extern uint_fast8_t                     irmp_idle (void);
+#endif
+extern void                             irmp_set_key_repetition_len (uint_fast16_t);
+#if IRMP_GLITCH_FILTER_LEN > 0
+extern void                             irmp_set_glitch_filter (uint_fast8_t);
+#endif
+
+#if IRMP_USE_EDGE_ISR == 1
+extern uint_fast8_t                     irmp_ISR_edge (uint_fast8_t, uint_fast16_t);
+#endif
+
+#if IRMP_USE_CONTEXT == 1
+extern void                             irmp_init_ctx (IRMP_CONTEXT *);
+extern uint_fast8_t                     irmp_get_data_ctx (IRMP_CONTEXT *, IRMP_DATA *);
+extern uint_fast8_t                     irmp_ISR_ctx (IRMP_CONTEXT *, uint_fast8_t);
+#  if IRMP_USE_EDGE_ISR == 1
+extern uint_fast8_t                     irmp_ISR_edge_ctx (IRMP_CONTEXT *, uint_fast8_t, uint_fast16_t);
+#  endif
+#endif
+
+#if IRMP_QUEUE_LEN > 0
+extern uint_fast16_t                    irmp_get_queue_overflows (void);
+#  if IRMP_USE_CONTEXT == 1
+extern uint_fast16_t                    irmp_get_queue_overflows_ctx (IRMP_CONTEXT *);
+#  endif
+#endif
+
+#if IRMP_TRACE_LEN > 0
+extern uint_fast8_t                     irmp_get_trace (IRMP_TRACE_ENTRY *);
+#  if IRMP_USE_CONTEXT == 1
+extern uint_fast8_t                     irmp_get_trace_ctx (IRMP_CONTEXT *, IRMP_TRACE_ENTRY *);
+#  endif
+#endif
+
+#if IRMP_USE_COUNTERS == 1
+extern void                             irmp_get_counters (IRMP_COUNTERS *);
+#  if IRMP_USE_CONTEXT == 1
+extern void                             irmp_get_counters_ctx (IRMP_CONTEXT *, IRMP_COUNTERS *);
+#  endif
+#endif
+
+#if IRMP_USE_TIMESTAMP == 1 || IRMP_USE_RAW_FRAME == 1 || IRMP_USE_KEY_RELEASE == 1 || IRMP_USE_QUALITY == 1
+extern uint_fast8_t                     irmp_get_data_ex (IRMP_DATA_EX *);
+#  if IRMP_USE_CONTEXT == 1
+extern uint_fast8_t                     irmp_get_data_ex_ctx (IRMP_CONTEXT *, IRMP_DATA_EX *);
+#  endif
+#endif
+
+#if IRMP_USE_TIMESTAMP == 1
+extern uint32_t                         irmp_get_ticks (void);
+#  if IRMP_USE_CONTEXT == 1
+extern uint32_t                         irmp_get_ticks_ctx (IRMP_CONTEXT *);
+#  endif
+#endif
+
+#if IRMP_ADDRESS_FILTER_LEN > 0
+extern void                             irmp_set_address_filter (uint_fast8_t, uint_fast8_t, uint_fast16_t);
+#endif
+
+#if IRMP_USE_PROTOCOL_MASK == 1
+extern void                             irmp_set_protocols (const uint8_t *, uint_fast8_t);
+#endif
+
+#if IRMP_DYNAMIC_PROTOCOLS > 0
+extern uint_fast8_t                     irmp_set_dynamic_protocol (uint_fast8_t, const IRMP_DYNAMIC_DESCRIPTOR *);
+#endif
+
+#if IRMP_LEARNED_WINDOWS > 0
+extern uint_fast8_t                     irmp_set_learned_windows (uint_fast8_t, const IRMP_QUALITY *);
+#endif
+
+#if IRMP_EARLY_MATCH_LEN > 0
+extern void                             irmp_set_early_match (uint_fast8_t, IRMP_DATA *);
+#endif
+
+#if IRMP_FAST_NEC == 1
+extern void                             irmp_set_nec42_expected (uint_fast8_t);
+#endif
+
+#if IRMP_CHANNEL_MASK != 0x00
+extern uint_fast8_t                     irmp_get_data_multi (IRMP_DATA *);
+extern uint_fast8_t                     irmp_ISR_multi (uint_fast8_t);
+#endif
 
 #if IRMP_PROTOCOL_NAMES == 1
 extern const char * const               irmp_protocol_names[IRMP_N_PROTOCOLS + 1] PROGMEM;
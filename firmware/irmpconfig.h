@@ -204,4 +204,276 @@
 #  define IRMP_USE_CALLBACK                     0       // 1: use callbacks. 0: do not. default is 0
 #endif
 
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Use start bit table: look up the protocol by the start bit in a table sorted by pulse length instead of checking all protocols one by one
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_USE_START_BIT_TABLE
+#  define IRMP_USE_START_BIT_TABLE              0       // 1: use start bit table, 0: do not. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Use edge driven input: call irmp_ISR_edge() from a pin change interrupt instead of polling the pin with irmp_ISR() F_INTERRUPTS times
+ * per second. irmp_ISR_edge() must also be called at least every IRMP_EDGE_TIMEOUT_LEN ticks without an edge, see irmp.h.
+ * IRMP_LOGGING needs polling, it does not work with edge driven input.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_USE_EDGE_ISR
+#  define IRMP_USE_EDGE_ISR                     0       // 1: use edge driven input, 0: poll input. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Use decoder contexts: keep the decoder state in an IRMP_CONTEXT per IR receiver and decode several receivers at once with irmp_ISR_ctx()
+ * and irmp_get_data_ctx(). irmp_ISR() and irmp_get_data() still work, they use a built-in context.
+ * IRMP_LOGGING logs one receiver only, it does not work with decoder contexts.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_USE_CONTEXT
+#  define IRMP_USE_CONTEXT                      0       // 1: use decoder contexts, 0: do not. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Queue of detected frames between irmp_ISR() and irmp_get_data(). The decoder goes on while up to IRMP_QUEUE_LEN frames wait for
+ * irmp_get_data(). Without queue, irmp_ISR() ignores the input until the frame is fetched. Frames lost because the queue was full are
+ * counted, see irmp_get_queue_overflows(). Every frame needs 6 bytes of RAM.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_QUEUE_LEN
+#  define IRMP_QUEUE_LEN                        0       // number of queued frames, power of 2 up to 128. 0: no queue. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Timestamp frames: count ticks (1/F_INTERRUPTS sec) in a free-running 32 bit counter, irmp_get_data_ex() returns the counter value at
+ * the end of the frame. Compare it with irmp_get_ticks() to get the age of a frame.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_USE_TIMESTAMP
+#  define IRMP_USE_TIMESTAMP                    0       // 1: timestamp frames, 0: do not. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Decode several IR receivers on one port: every set bit of IRMP_CHANNEL_MASK is an IR input of port IRMP_PORT_LETTER, e.g. 0x05 for PB0 + PB2.
+ * irmp_ISR_multi() reads the port once per tick and only decodes the inputs with an edge, see irmp.c. Get the frames with irmp_get_data_multi().
+ * Needs IRMP_USE_CONTEXT and IRMP_USE_EDGE_ISR. Every receiver needs RAM for one IRMP_CONTEXT.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_CHANNEL_MASK
+#  define IRMP_CHANNEL_MASK                     0x00    // bit mask of IR inputs, 0x00: decode IRMP_BIT_NUMBER only. default is 0x00
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Early match of learned keys: irmp_set_early_match() registers up to IRMP_EARLY_MATCH_LEN keys (protocol, address, command). A frame of a
+ * registered key is reported as soon as its address and command bits are received, the remaining bits (inverted command of NEC/NEC42) and
+ * the stop bit are not checked. Only NEC and NEC42 gain something: 29 ms and 14 ms per frame, measured with ./irmp -e (ANALYZE).
+ * Needs IRMP_QUEUE_LEN > 0. Every key needs 6 bytes of RAM.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_EARLY_MATCH_LEN
+#  define IRMP_EARLY_MATCH_LEN                  0       // number of learned keys, 0: no early match. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Address filter: irmp_set_address_filter() sets up to IRMP_ADDRESS_FILTER_LEN accepted remotes (protocol, address). Frames of other
+ * remotes are not detected, they neither reach irmp_get_data() nor use the queue. NEC frames of foreign remotes are dropped as soon as
+ * the address is received, others at frame end. An empty list accepts all frames. Every remote needs 3 bytes of RAM.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_ADDRESS_FILTER_LEN
+#  define IRMP_ADDRESS_FILTER_LEN               0       // number of accepted remotes, 0: no address filter. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Protocol candidates: if a start bit fits several pulse distance protocols, the one found first in the start bit table is decoded and up to
+ * IRMP_CANDIDATES - 1 others are checked with every data bit. A candidate is dropped as soon as a bit does not fit its timing. If the decoded
+ * protocol gets a wrong bit, the first remaining candidate takes over the frame. Needs IRMP_USE_START_BIT_TABLE.
+ * Every candidate needs about 26 bytes of RAM per context.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_CANDIDATES
+#  define IRMP_CANDIDATES                       1       // number of protocol candidates, 1: decide at start bit. default is 1
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Raw frame: every data bit is shifted into a 64 bit register, irmp_get_data_ex() returns it with the number of received bits, so keys can
+ * be compared by their complete payload. For SIRCS and NEC/NEC16/NEC42 irmp_store_bit() only shifts the bit, address and command are
+ * extracted once at frame end with offsets and lengths of IRMP_PARAMETER. Needs 10 bytes of RAM plus 9 bytes per queue entry.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_USE_RAW_FRAME
+#  define IRMP_USE_RAW_FRAME                    0       // 1: store raw frame, 0: do not. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Early abort: check inverted and XOR bits with every received bit instead of at frame end. A NEC frame with a wrong inverted command
+ * and a KASEIKYO frame with a wrong XOR nibble or byte is dropped at the first wrong bit, the decoder waits for the next start bit at once
+ * and the frame does not reach irmp_get_data(). The rest of the dropped frame is searched for start bits, too: with protocols like SIEMENS,
+ * RUWIDO or TELEFUNKEN or IRMP_USE_HASH enabled, it may be decoded as another frame, which may even swallow the next frame of the remote.
+ * See irmpscans.py for the scans and ./irmp command lines. Needs 1 byte of RAM.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_EARLY_ABORT
+#  define IRMP_EARLY_ABORT                      0       // 1: check inverted and XOR bits with every bit, 0: at frame end. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Early abort of NEC42: also check the 13 inverted address bits and 8 inverted command bits of NEC42, which are not checked at all without
+ * it. Changes which frames are accepted: a NEC42 frame with a wrong inverted address or command is dropped instead of returned. A NEC
+ * frame is received as NEC42 until its stop bit, so with NEC42 enabled, a NEC frame is dropped early only with this option, else its
+ * inverted command is checked at frame end. Needs IRMP_EARLY_ABORT.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_EARLY_ABORT_NEC42
+#  define IRMP_EARLY_ABORT_NEC42                0       // 1: drop NEC42 frames with wrong inverted bits, 0: accept them. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Low latency SIRCS: a Sony remote sends every frame 3 times. By default the 2nd and 3rd frame are skipped, with IRMP_SIRCS_LOW_LATENCY they
+ * are returned like the 1st frame, flagged with IRMP_FLAG_AUTO_REPETITION. The 1st frame is returned as soon as its bits are received,
+ * the latency from its last pulse is measured with ./irmp -d (ANALYZE).
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_SIRCS_LOW_LATENCY
+#  define IRMP_SIRCS_LOW_LATENCY                0       // 1: return SIRCS auto repetition frames with flag, 0: skip them. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Fast NEC: with NEC and NEC42 enabled, a NEC frame is received as NEC42 and finished by the timeout after its stop bit (IRMP_TIMEOUT_TIME).
+ * With IRMP_FAST_NEC it is finished as soon as the pause after the stop bit is longer than a NEC42 data bit, about 2 ms. If no NEC42 remote
+ * is used, irmp_set_nec42_expected (FALSE) finishes it right after the stop bit. The delay from the last pulse of a frame to irmp_get_data()
+ * is measured with ./irmp -d (ANALYZE).
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_FAST_NEC
+#  define IRMP_FAST_NEC                         0       // 1: finish NEC frames after stop bit, 0: after timeout. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Key release: if no repetition of the key returned last arrives within the repetition window (150 ms, see irmp_set_key_repetition_len()),
+ * a release event is returned with protocol, address and command of that key and flag IRMP_FLAG_RELEASE. A frame of another key ends the
+ * hold without release event. irmp_get_data_ex() returns the hold counter, the number of repetition frames of the key so far.
+ * Needs 6 bytes of RAM plus 1 byte per queue entry.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_USE_KEY_RELEASE
+#  define IRMP_USE_KEY_RELEASE                  0       // 1: return release events and hold counter, 0: do not. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Glitch filter: the decoder sees a new input level only after it lasted IRMP_GLITCH_FILTER_LEN samples, shorter pulses and pauses, e.g.
+ * dropouts caused by fluorescent lamps or LED backlights, are masked. Both edges are delayed by the same time, so pulse and pause lengths
+ * do not change. irmp_set_glitch_filter() changes the length at runtime, 1 switches the filter off. Success rate and cpu time with
+ * injected glitches are measured with ./irmp -g (ANALYZE). Needs 2 bytes of RAM per context.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_GLITCH_FILTER_LEN
+#  define IRMP_GLITCH_FILTER_LEN                0       // samples a level must last, 1: off, 0: no filter code. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Signal quality: irmp_get_data_ex() returns per frame the min. and max. deviation of the pulse and pause lengths of its data bits from the
+ * middle of their windows and the smallest margin of a length to its window limits, all in ticks. A small margin means the remote is about
+ * to fall out of tolerance. Measured for pulse distance and pulse width protocols, e.g. NEC and SIRCS, frames without data bits report
+ * margin 0xFF. Deviations and margins per protocol are listed with ./irmp -q (ANALYZE). Needs 5 bytes of RAM plus 5 bytes per queue entry.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_USE_QUALITY
+#  define IRMP_USE_QUALITY                      0       // 1: measure signal quality of frames, 0: do not. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Decode counters: count frames, frames lost because the queue was full and the decode errors per class, e.g. timing of a data bit outside
+ * the windows or a pause after a data bit too long. The counters saturate at 0xFFFF and are never reset, irmp_get_counters() reads them.
+ * Without IRMP_USE_COUNTERS the increments compile to nothing. Needs 22 bytes of RAM per context.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_USE_COUNTERS
+#  define IRMP_USE_COUNTERS                     0       // 1: count frames and decode errors, 0: do not. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Trace: irmp_ISR() writes decode events into a buffer of IRMP_TRACE_LEN entries: start bit timing, protocol fitting the start bit, decode
+ * errors and complete frames, each with irmp_get_ticks(), irmp_bit, the pulse and up to two values, see IRMP_TRACE_ENTRY. irmp_get_trace()
+ * reads them, events are lost while the buffer is full. Without IRMP_TRACE_LEN the trace points compile to nothing. ./irmp -x prints the
+ * events as text (ANALYZE). Must be 0 or a power of 2, needs IRMP_USE_TIMESTAMP and 8 bytes of RAM per entry.
+ * The analyzer always compiles the trace points and prints the starting pulse, start bit, data bit and decode error lines of ./irmp -v
+ * from the events. The protocol windows, protocol switches and other per frame text is still printed by irmp_ISR() itself.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_TRACE_LEN
+#  define IRMP_TRACE_LEN                        0       // number of buffered events, 0: no trace. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Trace detail: also put the starting pulse and every data bit into the trace buffer, two events per bit. The buffer then holds the bits
+ * of a frame instead of the frames of a burst, so IRMP_TRACE_LEN should be 128 for 32 bit protocols. Needs IRMP_TRACE_LEN.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_TRACE_DETAIL
+#  define IRMP_TRACE_DETAIL                     0       // 1: trace data bits, 0: frame events only. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Idle sampling: while no frame is in flight, the timer calls irmp_ISR_idle() F_INTERRUPTS / IRMP_IDLE_DIVIDER times per second instead
+ * of irmp_ISR() F_INTERRUPTS times. The first light sample switches back to the full rate, the start pulse is credited with the half of
+ * the idle period, so its length is known to +/- IRMP_IDLE_DIVIDER / 2 ticks only. irmp_idle() tells when to switch to the low rate,
+ * IRMP_TIMEOUT_LEN after the last frame. Interrupts per line and frames with and without idle sampling are compared with ./irmp -i
+ * (ANALYZE). For polling only, edge driven input (IRMP_USE_EDGE_ISR) is idle anyway. Protocols whose first pulse is shorter than
+ * IRMP_IDLE_DIVIDER ticks, e.g. RECS80 or KATHREIN, are rejected by irmp.h. Start pulses close to their window limits may still be
+ * classified differently, e.g. of RC5, RC6, TELEFUNKEN, THOMSON, FDC or jittered SIRCS frames, so check the remotes with ./irmp -i.
+ * With SIRCS and NEC remotes, 8 saves about 78% of the interrupts, see irmpscans.py. Must be 0 or a power of 2.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_IDLE_DIVIDER
+#  define IRMP_IDLE_DIVIDER                     0       // full rate / idle rate, 0: no idle sampling. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Protocol mask: irmp_set_protocols() enables a subset of the protocols above at runtime, e.g. the protocols of the learned keys. Start bits
+ * of disabled protocols are removed from the start bit table, so irmp_ISR() neither checks them nor decodes frames of foreign remotes which
+ * happen to fit them. Frames of disabled protocols are dropped at frame end. Start bits converted into an enabled protocol later, e.g. NEC42
+ * into NEC, are kept. Needs IRMP_USE_START_BIT_TABLE and about 8 bytes of RAM.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_USE_PROTOCOL_MASK
+#  define IRMP_USE_PROTOCOL_MASK                0       // 1: protocols can be disabled at runtime, 0: all are enabled. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Dynamic protocols: irmp_set_dynamic_protocol() loads up to IRMP_DYNAMIC_PROTOCOLS pulse distance or pulse width protocols at runtime,
+ * e.g. from EEPROM at boot. A descriptor holds the start bit windows and the IRMP_PARAMETER fields in ticks, see IRMP_DYNAMIC_DESCRIPTOR.
+ * Its start bit is sorted into the start bit table like the built-in ones, built-in protocols win if windows overlap. Frames are returned
+ * as IRMP_DYNAMIC1_PROTOCOL or IRMP_DYNAMIC2_PROTOCOL. ./irmp -y < scanfile generates a descriptor from scans of one remote (ANALYZE,
+ * needs IRMP_USE_PROTOCOL_MASK). Must be 0, 1 or 2, needs IRMP_USE_START_BIT_TABLE and 24 bytes of RAM per protocol.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_DYNAMIC_PROTOCOLS
+#  define IRMP_DYNAMIC_PROTOCOLS                0       // number of protocols loaded at runtime, 0: none. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Hash fallback: every pulse and pause of a burst is compared with the last one of the same level (shorter, about equal or longer) and
+ * the results are hashed. A burst of at least 16 pulses and pauses no protocol decoded is returned as IRMP_HASH_PROTOCOL,
+ * address and command are the upper and lower 16 bits of the hash. So keys of remotes unknown to IRMP can be learned, too, but the hash
+ * of a garbled frame is just another key, glitches before a frame change its hash: use IRMP_GLITCH_FILTER_LEN. ./irmp -u checks hashes
+ * for repeatability and collisions (ANALYZE). Needs 13 bytes of RAM.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_USE_HASH
+#  define IRMP_USE_HASH                         0       // 1: return frames of unknown protocols as hash, 0: drop them. default is 0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------------------------
+ * Learned windows: the start bit and data bit windows above are wide enough for all remotes of a protocol. irmp_set_learned_windows()
+ * narrows them around the timing of one remote, taken from the signal quality of a learned frame (see IRMP_USE_QUALITY), so start bits of
+ * other remotes and noise are rejected before a frame is decoded. Only the start bit table entry of the learned frame is narrowed, e.g.
+ * not the one of NEC repetition frames. Slots with the same entry share the union of their windows. Windows stay inside the original ones
+ * and keep a tolerance of 1/8 plus one tick, start pulses plus IRMP_IDLE_DIVIDER ticks, so the remote's timing must not drift further.
+ * Learn frames with the windows cleared, e.g. in programming mode. Own and foreign frames with and without learned windows are compared
+ * with ./irmp -w (ANALYZE). Needs IRMP_USE_START_BIT_TABLE, IRMP_USE_QUALITY and about 50 bytes of RAM per slot.
+ *---------------------------------------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef IRMP_LEARNED_WINDOWS
+#  define IRMP_LEARNED_WINDOWS                  0       // number of learned remotes, e.g. 2 for up- and down-button, 0: none. default is 0
+#endif
+
 #endif // _IRMPCONFIG_H_
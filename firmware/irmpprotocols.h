@@ -76,7 +76,12 @@
 
 #define IRMP_RADIO1_PROTOCOL                    49              // Radio protocol (experimental status), do not use it yet!
 
-#define IRMP_N_PROTOCOLS                        50              // number of supported protocols
+#define IRMP_DYNAMIC1_PROTOCOL                  50              // 1st protocol loaded at runtime, see IRMP_DYNAMIC_PROTOCOLS
+#define IRMP_DYNAMIC2_PROTOCOL                  51              // 2nd protocol loaded at runtime, see IRMP_DYNAMIC_PROTOCOLS
+
+#define IRMP_HASH_PROTOCOL                      52              // hash of a frame no protocol decoded, see IRMP_USE_HASH
+
+#define IRMP_N_PROTOCOLS                        53              // number of supported protocols
 
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
  * timing constants:
@@ -108,6 +113,8 @@ typedef uint8_t     PAUSE_LEN;
 #define IRMP_PARAM_FLAG_IS_MANCHESTER           0x01
 #define IRMP_PARAM_FLAG_1ST_PULSE_IS_1          0x02
 #define IRMP_PARAM_FLAG_IS_SERIAL               0x04
+#define IRMP_PARAM_FLAG_RAW_FIELDS              0x08                            // address and command are plain bit fields, see IRMP_USE_RAW_FRAME
+#define IRMP_PARAM_FLAG_BIT_REMAP               0x10                            // bits are stored via remap table, see irmp_store_bit_remap()
 
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
  * SIRCS:
@@ -129,7 +136,7 @@ typedef uint8_t     PAUSE_LEN;
 #define SIRCS_COMPLETE_DATA_LEN                 20                              // complete length - may be up to 20
 #define SIRCS_STOP_BIT                          0                               // has no stop bit
 #define SIRCS_LSB                               1                               // LSB...MSB
-#define SIRCS_FLAGS                             0                               // flags
+#define SIRCS_FLAGS                             IRMP_PARAM_FLAG_RAW_FIELDS      // flags
 
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
  * NEC & NEC42 & NEC16 & LGAIR:
@@ -149,7 +156,7 @@ typedef uint8_t     PAUSE_LEN;
 #define NEC_COMPLETE_DATA_LEN                   32                              // complete length
 #define NEC_STOP_BIT                            1                               // has stop bit
 #define NEC_LSB                                 1                               // LSB...MSB
-#define NEC_FLAGS                               0                               // flags
+#define NEC_FLAGS                               IRMP_PARAM_FLAG_RAW_FIELDS      // flags
 
 #define NEC42_ADDRESS_OFFSET                    0                               // skip 0 bits
 #define NEC42_ADDRESS_LEN                      13                               // read 13 address bits
@@ -251,7 +258,7 @@ typedef uint8_t     PAUSE_LEN;
 #define KASEIKYO_STOP_BIT                       1                               // has stop bit
 #define KASEIKYO_LSB                            1                               // LSB...MSB?
 #define KASEIKYO_FRAMES                         2                               // KASEIKYO sends 1st frame 2 times
-#define KASEIKYO_FLAGS                          0                               // flags
+#define KASEIKYO_FLAGS                          IRMP_PARAM_FLAG_BIT_REMAP       // flags
 
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
  * PANASONIC (Beamer), start bit timings similar to KASEIKYO
@@ -595,7 +602,7 @@ typedef uint8_t     PAUSE_LEN;
 #define RCCAR_COMPLETE_DATA_LEN                 13                              // complete length
 #define RCCAR_STOP_BIT                          1                               // has stop bit
 #define RCCAR_LSB                               1                               // LSB...MSB
-#define RCCAR_FLAGS                             0                               // flags
+#define RCCAR_FLAGS                             IRMP_PARAM_FLAG_BIT_REMAP       // flags
 
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
  * JVC:
@@ -897,7 +904,7 @@ typedef uint8_t     PAUSE_LEN;
 #define ACP24_COMPLETE_DATA_LEN                 70                              // complete length
 #define ACP24_STOP_BIT                          1                               // has stop bit
 #define ACP24_LSB                               0                               // LSB...MSB
-#define ACP24_FLAGS                             0                               // flags
+#define ACP24_FLAGS                             IRMP_PARAM_FLAG_BIT_REMAP       // flags
 
 /*---------------------------------------------------------------------------------------------------------------------------------------------------
  * RADIO1 - e.g. Tevion
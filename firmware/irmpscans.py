@@ -0,0 +1,290 @@
+#!/usr/bin/env python3
+#----------------------------------------------------------------------------------------------------------------------------------------------------
+# irmpscans.py - generate the scan files used to measure IRMP with the analyzer (irmp.c compiled with ANALYZE)
+#
+# The scan files have the format read by ./irmp: a comment line starting with '#', then one line of samples at F_INTERRUPTS = 15000,
+# '0' for pulse (IR light) and '1' for pause. All output is deterministic, the seeds are fixed.
+#
+# usage: python3 irmpscans.py sircs-nec [jitter] [count] > file
+#        python3 irmpscans.py random seed [lines] [clean] > file
+#        python3 irmpscans.py check-bits > file
+#
+#   sircs-nec  count x 6 lines of NEC (with 0 ... 2 repetition frames), SIRCS12, SIRCS15, SIRCS20 (3 frames each), NEC16 and NEC42 with
+#              random address and command, every pulse and pause scaled by 1 +/- jitter. count defaults to 20.
+#   random     lines of 1 ... 3 random frames each of a protocol picked from irmpprotocols.h: start bit, LEN - 2 ... LEN + 1 data bits with
+#              pulses and pauses picked from the protocol's timings, then a random pause. Every pulse and pause is scaled by 1 +/- 0.08,
+#              one frame in 10 is followed by a very long pulse. With 'clean', neither. lines defaults to 400.
+#   check-bits 6 x NEC, NEC with inverted command bit 27 flipped, NEC42, NEC42 with inverted address bit 20 flipped and NEC42 with
+#              inverted command bit 38 flipped, then one APPLE frame, then 3 x KASEIKYO, KASEIKYO with XOR nibble bit 17 flipped and
+#              KASEIKYO with XOR byte bit 44 flipped.
+#
+# Scan files of the figures in the commit messages:
+#
+#   python3 irmpscans.py sircs-nec 0 20 > clean.txt
+#   python3 irmpscans.py sircs-nec 0.08 20 > jitter.txt
+#   python3 irmpscans.py sircs-nec 0.1 600 > big.txt
+#   for n in 1 2 3 4 5 6 7 8; do python3 irmpscans.py random $n > fz$n.txt; done
+#   for n in 1 2 3; do python3 irmpscans.py random $n 400 clean; done > fzc.txt
+#   python3 irmpscans.py check-bits > checkbits.txt
+#
+# All-protocol build: a copy of the firmware directory with every protocol enabled in irmpconfig.h:
+#
+#   sed -i -E 's/^(#define IRMP_SUPPORT_[A-Z0-9_]+_PROTOCOL +)0/\11/' irmpconfig.h
+#
+# IRMP_CANDIDATES (-c), firmware's protocols; cpu time per tick grows by about 0.1 ns per live candidate:
+#
+#   cc -O2 -DIRMP_USE_START_BIT_TABLE=1 -DIRMP_CANDIDATES=4 irmp.c -o irmp
+#   ./irmp -c < big.txt
+#
+# IRMP_EARLY_ABORT, firmware's protocols and KASEIKYO (set IRMP_SUPPORT_KASEIKYO_PROTOCOL to 1 in irmpconfig.h): in all 3 builds the
+# frames without flipped bits and APPLE are received, the NEC and KASEIKYO frames with a flipped bit are not. NEC42 frames with a flipped
+# bit are received without IRMP_EARLY_ABORT_NEC42 only. With IRMP_EARLY_ABORT, -v prints 'early abort' for the 6 KASEIKYO frames, with
+# IRMP_EARLY_ABORT_NEC42 also for the 12 NEC and NEC42 frames with a flipped bit 27 or 20 (at bit 31) and the 6 with bit 38 (at bit 38):
+#
+#   cc -O2 -DIRMP_USE_START_BIT_TABLE=1 [-DIRMP_EARLY_ABORT=1 [-DIRMP_EARLY_ABORT_NEC42=1]] irmp.c -o irmp
+#   ./irmp < checkbits.txt
+#   ./irmp -v < checkbits.txt | grep 'early abort'
+#
+# IRMP_EARLY_ABORT, all-protocol build: clean.txt, jitter.txt and big.txt decode identically with and without the option. fz1.txt ...
+# fz8.txt contain no valid NEC, NEC42 or KASEIKYO frame. The rest of a dropped frame is searched for start bits, so frames of other
+# protocols are gained, mostly HASH (+87), TELEFUNKEN (+42), RUWIDO (+28) and SIEMENS (+21), and 1 or 2 each of 12 protocols are lost:
+#
+#   cc -O2 -DIRMP_USE_START_BIT_TABLE=1 -DIRMP_USE_PROTOCOL_MASK=1 -DIRMP_USE_HASH=1 -DIRMP_EARLY_ABORT=0 irmp.c -o irmp0
+#   cc -O2 -DIRMP_USE_START_BIT_TABLE=1 -DIRMP_USE_PROTOCOL_MASK=1 -DIRMP_USE_HASH=1 -DIRMP_EARLY_ABORT=1 irmp.c -o irmp1
+#   for n in 1 2 3 4 5 6 7 8; do ./irmp0 -s < fz$n.txt; done | grep -o 'p=[ 0-9]* ([A-Z0-9]*)' | sort | uniq -c > frames0
+#   for n in 1 2 3 4 5 6 7 8; do ./irmp1 -s < fz$n.txt; done | grep -o 'p=[ 0-9]* ([A-Z0-9]*)' | sort | uniq -c > frames1
+#   diff frames0 frames1
+#
+# In the all-protocol build, the rest of a dropped frame may be decoded as SIEMENS, which swallows the start bit of the next line. Of the
+# 16 frames of checkbits.txt without flipped bits, 16 are received without IRMP_EARLY_ABORT, 15 with it (1 KASEIKYO frame is lost) and
+# 6 with IRMP_EARLY_ABORT_NEC42 as well:
+#
+#   cc -O2 -DIRMP_USE_START_BIT_TABLE=1 [-DIRMP_EARLY_ABORT=1 [-DIRMP_EARLY_ABORT_NEC42=1]] irmp.c -o irmp
+#   ./irmp < checkbits.txt
+#
+# IRMP_IDLE_DIVIDER (-i), firmware's protocols: clean.txt and jitter.txt decode identically, about 78% of the interrupts are saved (78.1%
+# SIRCS, 77.7% NEC, 82.4% NEC16, 79.6% NEC42 on clean.txt). With +/- 10% jitter, 10 of the 3600 lines of big.txt differ, all SIRCS.
+# With IRMP_USE_HASH, 11 of the 120 lines of jitter.txt differ, all SIRCS:
+#
+#   cc -O2 -DIRMP_IDLE_DIVIDER=8 irmp.c -o irmp
+#   ./irmp -i < clean.txt; ./irmp -i < jitter.txt; ./irmp -i < big.txt
+#   cc -O2 -DIRMP_IDLE_DIVIDER=8 -DIRMP_USE_START_BIT_TABLE=1 -DIRMP_USE_PROTOCOL_MASK=1 -DIRMP_USE_HASH=1 irmp.c -o irmp
+#   ./irmp -i < jitter.txt
+#
+# IRMP_IDLE_DIVIDER, all-protocol build without the protocols irmp.h rejects for a divider of 8: 21 of the 1200 lines of fzc.txt differ,
+# 1st frame RC5 (9), THOMSON (5), FDC (3), TELEFUNKEN (3) and RC6 (1), and 1 line of jitter.txt, SIRCS:
+#
+#   sed -i -E 's/^(#define IRMP_SUPPORT_(RECS80|RECS80EXT|LEGO|BANG_OLUFSEN|KATHREIN|MERLIN|A1TVBOX|DENON|SIEMENS|RUWIDO|ACP24|SPEAKER|RCMM|GRUNDIG|NOKIA|IR60)_PROTOCOL +)1/\10/' irmpconfig.h
+#   cc -O2 -DIRMP_IDLE_DIVIDER=8 irmp.c -o irmp
+#   ./irmp -i < fzc.txt; ./irmp -i < jitter.txt
+#----------------------------------------------------------------------------------------------------------------------------------------------------
+
+import os
+import random
+import re
+import sys
+
+F_INTERRUPTS = 15000
+
+def ticks (usec):
+    return max (1, int (round (usec * 1e-6 * F_INTERRUPTS)))
+
+def render (seq, jitter, rnd):
+    return ''.join (sym * ticks (usec * (1 + rnd.uniform (-jitter, jitter))) for sym, usec in seq)
+
+def line (frames, comment, jitter, rnd):
+    seq = []
+
+    for frame in frames:
+        seq += frame
+
+    return '# ' + comment + '\n' + '1' * 20 + render (seq, jitter, rnd) + '1' * 300 + '\n'
+
+def bits_of (value, n):
+    return [(value >> i) & 1 for i in range (n)]
+
+def nec_frame (bits):
+    frame = [('0', 9000), ('1', 4500)]
+
+    for b in bits:
+        frame += [('0', 560), ('1', 1690 if b else 560)]
+
+    return frame
+
+def nec (address, command, n = 32, repetitions = 0):
+    if n == 32:
+        frame = nec_frame (bits_of (address, 16) + bits_of (command, 8) + bits_of (~command, 8))
+    elif n == 16:
+        frame = nec_frame (bits_of (address, 8)) + [('0', 560), ('1', 4500)]
+
+        for b in bits_of (command, 8):
+            frame += [('0', 560), ('1', 1690 if b else 560)]
+    else:
+        frame = nec_frame (bits_of (address, 13) + bits_of (~address, 13) + bits_of (command, 8) + bits_of (~command, 8))
+
+    frames = [frame + [('0', 560)]]
+
+    for r in range (repetitions):
+        frames.append ([('1', 40000), ('0', 9000), ('1', 2250), ('0', 560)])
+
+    return frames
+
+def sircs (command, address, n, count = 3):
+    frame = [('0', 2400), ('1', 600)]
+
+    for b in bits_of (command | (address << 7), n):
+        frame += [('0', 1200 if b else 600), ('1', 600)]
+
+    frame = frame[:-1]
+    frames = []
+
+    for k in range (count):
+        if k:
+            frames.append ([('1', 45000)])
+        frames.append (frame)
+
+    return frames
+
+def sircs_nec (jitter, count):
+    rnd = random.Random (42)
+    out = []
+
+    for i in range (count):
+        a = rnd.randrange (0, 256) | (rnd.randrange (0, 256) << 8)
+        c = rnd.randrange (0, 256)
+        out.append (line (nec (a, c, 32, rnd.randrange (0, 3)), 'NEC [2 0x%04x 0x%04x]' % (a, c), jitter, rnd))
+        c = rnd.randrange (0, 128)
+        a = rnd.randrange (0, 32)
+        out.append (line (sircs (c, a, 12), 'SIRCS12 [1 0x%04x 0x%04x]' % (0, c | (a << 7)), jitter, rnd))
+        c = rnd.randrange (0, 128)
+        a = rnd.randrange (0, 256)
+        out.append (line (sircs (c, a, 15), 'SIRCS15', jitter, rnd))
+        c = rnd.randrange (0, 128)
+        a = rnd.randrange (0, 8192)
+        out.append (line (sircs (c, a, 20), 'SIRCS20', jitter, rnd))
+        a = rnd.randrange (0, 256)
+        c = rnd.randrange (0, 256)
+        out.append (line (nec (a, c, 16), 'NEC16', jitter, rnd))
+        a = rnd.randrange (0, 8192)
+        c = rnd.randrange (0, 256)
+        out.append (line (nec (a, c, 42), 'NEC42', jitter, rnd))
+
+    return ''.join (out)
+
+def check_bits ():
+    rnd = random.Random (3)
+    clean = random.Random (0)                                          # draws of render() without jitter, keeps rnd's sequence
+    out = []
+
+    for i in range (6):
+        a = rnd.randint (0, 0xffff)
+        c = rnd.randint (0, 255)
+        bits = bits_of (a, 16) + bits_of (c, 8) + bits_of (~c, 8)
+        out.append (line ([nec_frame (bits) + [('0', 560)]], 'NEC ok %04x %02x' % (a, c), 0.0, clean))
+        bits[27] ^= 1
+        out.append (line ([nec_frame (bits) + [('0', 560)]], 'NEC bad bit 27', 0.0, clean))
+        a = rnd.randint (0, 0x1fff)
+        c = rnd.randint (0, 255)
+        bits = bits_of (a, 13) + bits_of (~a, 13) + bits_of (c, 8) + bits_of (~c, 8)
+        out.append (line ([nec_frame (bits) + [('0', 560)]], 'NEC42 ok %04x %02x' % (a, c), 0.0, clean))
+
+        for k, name in ((20, 'addr'), (38, 'cmd')):
+            bad = list (bits)
+            bad[k] ^= 1
+            out.append (line ([nec_frame (bad) + [('0', 560)]], 'NEC42 bad %s bit %d' % (name, k), 0.0, clean))
+
+    bits = bits_of (0x87EE, 16) + bits_of (0x55, 8) + bits_of (0x12, 8)
+    out.append (line ([nec_frame (bits) + [('0', 560)]], 'APPLE', 0.0, clean))
+
+    for i in range (3):
+        data = [0x02, 0x20, rnd.randint (0, 15) << 4, rnd.randint (0, 255), rnd.randint (0, 255)]
+        data[2] |= 0x02 ^ 0x00 ^ 0x02 ^ 0x00                                    # XOR nibble of customer id 0x2002: 0
+        data.append (data[2] ^ data[3] ^ data[4])
+        bits = []
+
+        for byte in data:
+            bits += bits_of (byte, 8)
+
+        for k, name in ((None, 'ok %02x%02x%02x' % tuple (data[2:5])), (17, 'bad xor nibble bit 17'), (44, 'bad xor byte bit 44')):
+            bad = list (bits)
+            if k is not None:
+                bad[k] ^= 1
+            frame = [('0', 3380), ('1', 1690)]
+            for b in bad:
+                frame += [('0', 423), ('1', 1269 if b else 423)]
+            out.append (line ([frame + [('0', 423)]], 'KASEIKYO ' + name, 0.0, clean))
+
+    return ''.join (out)
+
+def protocol_timings ():
+    timings = {}
+
+    with open (os.path.join (os.path.dirname (os.path.abspath (__file__)), 'irmpprotocols.h')) as f:
+        for l in f:
+            m = re.match (r'#define\s+([A-Z0-9]+?)_([A-Z0-9_]*TIME)\s+([0-9.]+e-[0-9]+)', l)
+            if m:
+                timings.setdefault (m.group (1), {})[m.group (2)] = float (m.group (3)) * 1e6
+            m = re.match (r'#define\s+([A-Z0-9]+?)_COMPLETE_DATA_LEN\s+([0-9]+)', l)
+            if m:
+                timings.setdefault (m.group (1), {})['LEN'] = int (m.group (2))
+
+    return timings
+
+def random_frames (seed, lines, clean):
+    rnd = random.Random (seed)
+    timings = protocol_timings ()
+    protocols = [k for k, v in timings.items () if any ('PULSE' in x or x == 'BIT_TIME' for x in v)]
+
+    def pick (v, kinds):
+        c = [v[k] for k in kinds if k in v]
+        if 'BIT_TIME' in v:
+            c += [v['BIT_TIME'], 2 * v['BIT_TIME']]
+        return rnd.choice (c) if c else 500.0
+
+    out = []
+
+    for n in range (lines):
+        name = rnd.choice (protocols)
+        v = timings[name]
+        seq = []
+
+        for f in range (rnd.randint (1, 3)):
+            if 'START_BIT_PULSE_TIME' in v:
+                seq.append (('0', v['START_BIT_PULSE_TIME']))
+                if 'START_BIT_PAUSE_TIME' in v:
+                    seq.append (('1', v['START_BIT_PAUSE_TIME']))
+
+            for b in range (max (1, v.get ('LEN', 32) + rnd.randint (-2, 1))):
+                seq.append (('0', pick (v, ['PULSE_TIME', '1_PULSE_TIME', '0_PULSE_TIME'])))
+                seq.append (('1', pick (v, ['PAUSE_TIME', '1_PAUSE_TIME', '0_PAUSE_TIME'])))
+
+            seq.append (('0', pick (v, ['PULSE_TIME', '0_PULSE_TIME', '1_PULSE_TIME'])))
+
+            if rnd.random () < 0.1 and not clean:
+                seq.append (('1', rnd.uniform (100, 3000)))
+                seq.append (('0', rnd.uniform (15000, 40000)))                 # very long pulse
+
+            seq.append (('1', rnd.uniform (500, 60000)))
+
+        s = ''.join (c * max (1, int (round (usec * (1.0 if clean else rnd.uniform (0.92, 1.08)) * 1e-6 * F_INTERRUPTS))) for c, usec in seq)
+        out.append ('# %s\n%s' % (name, s))
+
+    return '\n'.join (out) + '\n'
+
+def main (argv):
+    if len (argv) >= 1 and argv[0] == 'sircs-nec':
+        sys.stdout.write (sircs_nec (float (argv[1]) if len (argv) > 1 else 0.0, int (argv[2]) if len (argv) > 2 else 20))
+    elif len (argv) >= 2 and argv[0] == 'random':
+        sys.stdout.write (random_frames (int (argv[1]), int (argv[2]) if len (argv) > 2 else 400, len (argv) > 3 and argv[3] == 'clean'))
+    elif len (argv) >= 1 and argv[0] == 'check-bits':
+        sys.stdout.write (check_bits ())
+    else:
+        sys.stderr.write ('usage: python3 irmpscans.py sircs-nec [jitter] [count] > file\n'
+                          '       python3 irmpscans.py random seed [lines] [clean] > file\n'
+                          '       python3 irmpscans.py check-bits > file\n')
+        return 1
+
+    return 0
+
+if __name__ == '__main__':
+    sys.exit (main (sys.argv[1:]))
@@ -70,6 +70,7 @@
 #ifdef UNIX_OR_WINDOWS                                                              // Analyze on Unix/Linux or Windows
 #  include <stdio.h>
 #  include <stdlib.h>
+#  include <time.h>
 #  define F_CPU 8000000L
 #  define ANALYZE
 #  ifdef unix
@@ -20,17 +20,30 @@
 #define DOWN_PIN                 PB4                  // pin for down-relais
 #define SLEEP_TIMEOUT_SECONDS    2                    // seconds to elapse until hibernate
 #define ASUME_INITIALLY_UP       true                 // whether to asume the silver screen is entirely hidden after power up
+#define MAX_COMMAND_AGE          0.25                 // seconds an IR-command may wait until it is processed
 
 /*
  * globals
  */
 IRMP_DATA EEMEM up_button_signature;                  // EEPROM memory address for signature of the up-button
 IRMP_DATA EEMEM down_button_signature;                // EEPROM memory address for signature of the down-button
+#if IRMP_DYNAMIC_PROTOCOLS > 0
+IRMP_DYNAMIC_DESCRIPTOR EEMEM dynamic_protocols[IRMP_DYNAMIC_PROTOCOLS]; // EEPROM memory address for protocols generated by "irmp -y"
+#endif
+#if IRMP_LEARNED_WINDOWS >= 2
+IRMP_QUALITY EEMEM up_button_quality;                 // EEPROM memory address for timing of the up-button's remote
+IRMP_QUALITY EEMEM down_button_quality;               // EEPROM memory address for timing of the down-button's remote
+static IRMP_QUALITY command_quality;                  // timing of the last IR-command
+static bool learned_windows_set = false;              // whether the windows are narrowed to the learned remotes
+#endif
 static IRMP_DATA up_button;                           // signature of the up-button
 static IRMP_DATA down_button;                         // signature of the down-button
 static void (*command)();                             // command executed after n seconds
 static int number_of_interrupts;                      // number of interrupts necessary to wait n seconds
 static bool entirely_hidden = ASUME_INITIALLY_UP;     // whether and action was interrupted
+#if IRMP_ADDRESS_FILTER_LEN >= 2 || IRMP_FAST_NEC == 1 || IRMP_USE_PROTOCOL_MASK == 1 || IRMP_LEARNED_WINDOWS >= 2
+static volatile bool woken_up = true;                 // whether the poti has to be checked for programming mode
+#endif
 
 /*
  * bring MCU into hibernate
@@ -50,6 +63,9 @@ static void go_asleep() {
 
 	set_sleep_mode(SLEEP_MODE_PWR_DOWN);              // power down - mode (<1mA current)
 	sleep_mode();                                     // enter sleep mode
+#if IRMP_ADDRESS_FILTER_LEN >= 2 || IRMP_FAST_NEC == 1 || IRMP_USE_PROTOCOL_MASK == 1 || IRMP_LEARNED_WINDOWS >= 2
+	woken_up = true;                                  // poti may have been turned while sleeping
+#endif
 
 }
 
@@ -163,9 +179,125 @@ ISR(INT0_vect) {
 #else
 #define COMPA_VECT  TIMER1_COMPA_vect                 // ATmega
 #endif
+
+#if IRMP_USE_EDGE_ISR == 1
+
+#if ! defined (__AVR_ATtiny25__) && ! defined (__AVR_ATtiny45__) && ! defined (__AVR_ATtiny85__)
+#error IRMP_USE_EDGE_ISR is only supported on ATtiny25/45/85
+#endif
+
+/*
+ * Timer1 runs free with a prescaler of 512 and is read on every edge of the IR-input;
+ * the compare-match is moved ahead on every edge to call IRMP if no edge occurs (timeout).
+ * IRMP counts the pulse or pause since the last call in one step, so an interrupt decodes
+ * a few samples (at most 4 in the analyzer, see "irmp -b"), whatever time elapsed
+ */
+#define EDGE_TIMER_PRESCALER     512
+#define EDGE_TICKS_PER_COUNT     ((uint16_t) (256.0 * F_INTERRUPTS * EDGE_TIMER_PRESCALER / F_CPU + 0.5)) // IRMP-ticks per timer count * 256
+#define EDGE_TIMEOUT_COUNTS      ((uint32_t) IRMP_EDGE_TIMEOUT_LEN * (F_CPU / EDGE_TIMER_PRESCALER) / F_INTERRUPTS < 255 ? \
+		(uint8_t) ((uint32_t) IRMP_EDGE_TIMEOUT_LEN * (F_CPU / EDGE_TIMER_PRESCALER) / F_INTERRUPTS) : 255)
+
+/*
+ * hand over the current IR-input and the time elapsed since the last call to IRMP
+ */
+static void irmp_edge(void) {
+
+	static uint8_t last_count;                        // timer value of last call
+	static uint8_t fraction;                          // fraction of IRMP-tick left over by last call
+
+	uint8_t count = TCNT1;
+	uint16_t ticks = (uint8_t) (count - last_count) * EDGE_TICKS_PER_COUNT + fraction;
+
+	last_count = count;
+	fraction = ticks & 0xFF;
+	OCR1A = count + EDGE_TIMEOUT_COUNTS;              // next timeout if no edge occurs
+
+	(void) irmp_ISR_edge(input(IRMP_PIN), ticks >> 8);
+
+}
+
+/*
+ * pin-change interrupt on IR-input
+ */
+ISR(PCINT0_vect) {
+
+	irmp_edge();
+
+}
+
+/*
+ * no edge on IR-input within timeout
+ */
 ISR(COMPA_VECT) {
 
+	irmp_edge();
+
+}
+
+/*
+ * initialize Timer1 as time base and pin-change interrupt on IR-input
+ */
+static void timer1_init(void) {
+
+	TCCR1 = (1 << CS13) | (1 << CS11);                // normal mode, prescaler 512
+	OCR1A = EDGE_TIMEOUT_COUNTS;                      // first timeout
+	TIMSK = 1 << OCIE1A;                              // OCIE1A: Interrupt by timer compare
+
+	PCMSK |= _BV(IRMP_BIT);                           // pin-change interrupt on IR-input
+	GIMSK |= _BV(PCIE);
+
+}
+
+#else
+
+#if IRMP_IDLE_DIVIDER > 0
+
+#if F_CPU >= 16000000L
+#define TIMER1_CS                ((1 << CS12))        // ATtiny45 / ATtiny85: prescaler bits of full rate, presc = 8
+#else
+#define TIMER1_CS                ((1 << CS11) | (1 << CS10)) // ATtiny45 / ATtiny85: prescaler bits of full rate, presc = 4
+#endif
+#define IDLE_DIVIDER_LOG2        (IRMP_IDLE_DIVIDER == 2 ? 1 : IRMP_IDLE_DIVIDER == 4 ? 2 : IRMP_IDLE_DIVIDER == 8 ? 3 : \
+		IRMP_IDLE_DIVIDER == 16 ? 4 : 5)
+
+static bool idle_sampling;                            // whether Timer1 runs at F_INTERRUPTS / IRMP_IDLE_DIVIDER
+
+/*
+ * switch Timer1 between full rate and idle rate; the compare value stays, the prescaler is
+ * multiplied by IRMP_IDLE_DIVIDER (ATtiny) or the compare value is (ATmega)
+ */
+static void timer1_set_rate(bool idle) {
+
+	idle_sampling = idle;
+
+	#if defined (__AVR_ATtiny45__) || defined (__AVR_ATtiny85__)
+		TCCR1 = (TCCR1 & ~((1 << CS13) | (1 << CS12) | (1 << CS11) | (1 << CS10)))
+				| (TIMER1_CS + (idle ? IDLE_DIVIDER_LOG2 : 0));
+	#else
+		OCR1A = (F_CPU / F_INTERRUPTS) * (idle ? IRMP_IDLE_DIVIDER : 1) - 1;
+	#endif
+
+}
+
+#endif // IRMP_IDLE_DIVIDER > 0
+
+ISR(COMPA_VECT) {
+
+#if IRMP_IDLE_DIVIDER > 0
+	if (idle_sampling) {
+		if (irmp_ISR_idle()) {                        // start pulse: decode the frame at full rate
+			timer1_set_rate(false);
+		}
+	}
+	else {
+		(void) irmp_ISR();                            // call IRMP ISR
+		if (irmp_idle()) {                            // no frame in flight: save interrupts while waiting
+			timer1_set_rate(true);
+		}
+	}
+#else
 	(void) irmp_ISR();                                // call IRMP ISR
+#endif
 
 }
 
@@ -197,6 +329,8 @@ static void timer1_init(void) {
 
 }
 
+#endif // IRMP_USE_EDGE_ISR
+
 /*
  * initialize activity indicator and up/down-pins
  */
@@ -234,6 +368,127 @@ static void read_button_signatures_from_eeprom() {
 
 }
 
+/*
+ * loads the protocols of remotes unknown to IRMP out of EEPROM,
+ * erased or invalid descriptors are ignored
+ */
+static void read_dynamic_protocols_from_eeprom() {
+
+#if IRMP_DYNAMIC_PROTOCOLS > 0
+	IRMP_DYNAMIC_DESCRIPTOR descriptor;
+
+	for (uint8_t i = 0; i < IRMP_DYNAMIC_PROTOCOLS; i++) {
+		eeprom_read_block(&descriptor, &dynamic_protocols[i], sizeof(IRMP_DYNAMIC_DESCRIPTOR));
+		irmp_set_dynamic_protocol(i, &descriptor);   // interrupts are not enabled yet
+	}
+#endif
+
+}
+
+/*
+ * report the up- and down-button as soon as their address and command is received
+ */
+static void register_button_signatures() {
+
+#if IRMP_EARLY_MATCH_LEN >= 2
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {               // the list is read by the IRMP-interrupt
+		irmp_set_early_match(0, &up_button);
+		irmp_set_early_match(1, &down_button);
+	}
+#endif
+
+}
+
+/*
+ * accept IR-commands of the up- and down-button's remotes only,
+ * in programming mode all IR-commands are accepted
+ */
+static void update_address_filter(int poti) {
+
+#if IRMP_ADDRESS_FILTER_LEN >= 2
+	bool programming = poti < POTI_PROGRAMMING;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {               // the filter is read by the IRMP-interrupt
+		irmp_set_address_filter(0, programming ? 0 : up_button.protocol, up_button.address);
+		irmp_set_address_filter(1, programming ? 0 : down_button.protocol, down_button.address);
+	}
+#else
+	(void) poti;
+#endif
+
+}
+
+/*
+ * decode the protocols of the up- and down-button only,
+ * in programming mode all protocols are decoded
+ */
+static void update_protocol_mask(int poti) {
+
+#if IRMP_USE_PROTOCOL_MASK == 1
+	bool programming = poti < POTI_PROGRAMMING;
+	uint8_t protocols[2] = { up_button.protocol, down_button.protocol };
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {               // the start bits are looked up by the IRMP-interrupt
+		irmp_set_protocols(protocols, programming ? 0 : 2);
+	}
+#else
+	(void) poti;
+#endif
+
+}
+
+/*
+ * narrow the start bit and data bit windows to the timing of the up- and down-button's remotes,
+ * in programming mode the original windows are used
+ */
+static void update_learned_windows(int poti) {
+
+#if IRMP_LEARNED_WINDOWS >= 2
+	bool programming = poti < POTI_PROGRAMMING;
+	IRMP_QUALITY up_quality;
+	IRMP_QUALITY down_quality;
+
+	if (learned_windows_set == !programming) {        // mode unchanged: narrowing the windows again
+		return;                                       // would cost time on every button press
+	}
+
+	if (!programming) {                               // buttons are learned in programming mode,
+		                                              // so leaving it reads their new timing
+		eeprom_read_block(&up_quality, &up_button_quality, sizeof(IRMP_QUALITY));
+		eeprom_read_block(&down_quality, &down_button_quality, sizeof(IRMP_QUALITY));
+	}
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {               // the start bits are looked up by the IRMP-interrupt
+		irmp_set_learned_windows(0, programming ? 0 : &up_quality);
+		irmp_set_learned_windows(1, programming ? 0 : &down_quality);
+	}
+	learned_windows_set = !programming;
+#else
+	(void) poti;
+#endif
+
+}
+
+/*
+ * finish NEC-frames right after their stop bit unless a NEC42-button is learned,
+ * in programming mode NEC42-buttons have to be received entirely
+ */
+static void update_nec42_expected(int poti) {
+
+#if IRMP_FAST_NEC == 1
+	bool programming = poti < POTI_PROGRAMMING;
+	bool nec42 = (up_button.protocol == IRMP_NEC42_PROTOCOL)
+			|| (down_button.protocol == IRMP_NEC42_PROTOCOL);
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {               // the flag is read by the IRMP-interrupt
+		irmp_set_nec42_expected(programming || nec42);
+	}
+#else
+	(void) poti;
+#endif
+
+}
+
 /*
  * initialize IRMP for IR-decoding
  */
@@ -266,6 +521,16 @@ static void store_command_to_eeprom(bool down, IRMP_DATA *irmp_data) {
 
 	}
 
+#if IRMP_LEARNED_WINDOWS >= 2
+	if (!(irmp_data->flags & (IRMP_FLAG_REPETITION
+			| IRMP_FLAG_AUTO_REPETITION))) {          // keep timing of the button's 1st frame
+		eeprom_write_block(&command_quality, down ? &down_button_quality : &up_button_quality,
+				sizeof(IRMP_QUALITY));
+	}
+#endif
+
+	register_button_signatures();                     // early match the new signature
+
 }
 
 /*
@@ -345,12 +610,67 @@ static void disable_down() {
 
 }
 
+/*
+ * fetch next IR-command, commands which waited too long are dropped
+ */
+static bool get_ir_command(IRMP_DATA *irmp_data) {
+
+#if IRMP_USE_TIMESTAMP == 1 || IRMP_LEARNED_WINDOWS >= 2
+	IRMP_DATA_EX irmp_data_ex;
+	while (irmp_get_data_ex(&irmp_data_ex)) {
+
+#if IRMP_USE_TIMESTAMP == 1
+		uint32_t age = irmp_get_ticks() - irmp_data_ex.ticks;
+		if (age > (uint32_t) (F_INTERRUPTS * MAX_COMMAND_AGE)) {
+
+			continue;
+
+		}
+#endif
+		*irmp_data = irmp_data_ex.data;
+#if IRMP_LEARNED_WINDOWS >= 2
+		command_quality = irmp_data_ex.quality;
+#endif
+		return true;
+
+	}
+	return false;
+#else
+	return irmp_get_data(irmp_data);
+#endif
+
+}
+
 /*
  * user pressed a button of the remote control
  */
 static void process_irmp(IRMP_DATA *irmp_data) {
 
+#if IRMP_USE_KEY_RELEASE == 1
+	if (irmp_data->flags & IRMP_FLAG_RELEASE) {       // button released:
+
+		if ((command == disable_down_soon)
+				&& is_down_button_pressed(irmp_data)) {// if a down-step is in progress
+
+			wait_n_seconds(0, disable_down_soon);     // then stop it immediately
+
+		}
+		return;                                       // a release is no button press
+
+	}
+#endif
+
+	if (irmp_data->flags & IRMP_FLAG_AUTO_REPETITION) {// 2nd or 3rd frame of the same button press:
+
+		return;                                       // already handled with its 1st frame
+
+	}
+
 	int poti = get_potentiometer_position();          // read potentiometer position
+	update_address_filter(poti);                      // poti might have been turned
+	update_nec42_expected(poti);
+	update_protocol_mask(poti);
+	update_learned_windows(poti);
 
 	/*
 	 * programming mode
@@ -415,7 +735,8 @@ static void process_irmp(IRMP_DATA *irmp_data) {
 
 			} else {                                  // otherwise
 
-				wait_n_seconds(0.5, disable_down_soon);// do a small step
+				wait_n_seconds(0.5, disable_down_soon);// do a small step, renewed by each repetition
+				                                      // and stopped by the release of the button
 
 			}
 
@@ -442,6 +763,8 @@ int main() {
 	initialize_adc();
 	initialize_irmp();
 	read_button_signatures_from_eeprom();
+	read_dynamic_protocols_from_eeprom();
+	register_button_signatures();
 	sei();                                            // enable interrupts
 
 	/*
@@ -450,7 +773,20 @@ int main() {
 	IRMP_DATA irmp_data;
 	while (1) {
 
-		if (irmp_get_data(&irmp_data)) {              // was an IR-command received?
+#if IRMP_ADDRESS_FILTER_LEN >= 2 || IRMP_FAST_NEC == 1 || IRMP_USE_PROTOCOL_MASK == 1 || IRMP_LEARNED_WINDOWS >= 2
+		if (woken_up) {                               // check for programming mode after wake up
+
+			woken_up = false;
+			int poti = get_potentiometer_position();
+			update_address_filter(poti);
+			update_nec42_expected(poti);
+			update_protocol_mask(poti);
+			update_learned_windows(poti);
+
+		}
+#endif
+
+		if (get_ir_command(&irmp_data)) {             // was an IR-command received?
 
 			process_irmp(&irmp_data);                 // process the button being pressed
 			reset_n_seconds(SLEEP_TIMEOUT_SECONDS,
@@ -464,6 +800,11 @@ int main() {
 
 		}
 
+#if IRMP_USE_EDGE_ISR == 1
+		set_sleep_mode(SLEEP_MODE_IDLE);              // nothing to do until next edge or timeout
+		sleep_mode();
+#endif
+
 	}
 
 }